@@ -10,12 +10,13 @@ setfenv(1, ns);
 -- 10100,  -- Fire burst - 7 SP
 -- 10120   -- Wave - 7 SP
 
--- Instance local vars
-local atk_spell_ratio = 0;
+-- The ai_state table of Banesore keeps:
+-- atk_spell_ratio: the number of actions done since the last attack spell.
 
 -- The battle_actor parameter is the enemy thinking, useful to exclude itself from other opponents.
-function DecideAction(battle_instance, battle_actor)
+function DecideAction(battle_instance, battle_actor, ai_state)
     local Battle = battle_instance;
+    local atk_spell_ratio = ai_state.atk_spell_ratio or 0;
 
     -- Get actors
     local Banesore = battle_actor;
@@ -29,7 +30,7 @@ function DecideAction(battle_instance, battle_actor)
             spell_skill_id = 10120; -- Wave
         end
         Banesore:SetAction(spell_skill_id, Bronann);
-        atk_spell_ratio = 0;
+        ai_state.atk_spell_ratio = 0;
         return;
     end
 
@@ -46,6 +47,6 @@ function DecideAction(battle_instance, battle_actor)
     end
 
     -- Since no atk spell has been done, increase this value for the next action.
-    atk_spell_ratio = atk_spell_ratio + 1
+    ai_state.atk_spell_ratio = atk_spell_ratio + 1
 
 end
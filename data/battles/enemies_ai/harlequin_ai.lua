@@ -61,11 +61,11 @@ end
 -- 10007, -- Magical poison - 40 SP
 -- 21002, -- Dark Wish (Revives an ally) - 10 SP
 
--- Instance local vars
-local war_god_done = false;
+-- The ai_state table of each Harlequin keeps:
+-- war_god_done: whether War God has already been cast.
 
 -- The battle_actor parameter is the enemy thinking, useful to exclude itself from other opponents.
-function DecideAction(battle_instance, battle_actor)
+function DecideAction(battle_instance, battle_actor, ai_state)
     local Battle = battle_instance;
 
     local nb_enemies = Battle:GetNumberOfEnemies();
@@ -100,9 +100,9 @@ function DecideAction(battle_instance, battle_actor)
     end
 
     -- At least 3 enemies are alive
-    if (war_god_done == false and battle_actor:GetSkillPoints() >= 96) then
+    if (ai_state.war_god_done ~= true and battle_actor:GetSkillPoints() >= 96) then
         battle_actor:SetAction(10011); -- War God (def - on all heroes)
-        war_god_done = true;
+        ai_state.war_god_done = true;
         return;
     elseif (battle_actor:GetSkillPoints() >= 64 and enemies_have_enough_atk == false) then
         battle_actor:SetAction(10004); -- Holy Veil (atk + on all enemies)
@@ -62,12 +62,12 @@ end
 -- 21004, -- Shield up (Max out physical defence) - 0 SP
 -- 21005, -- Shield down (physical defence is back to normal) - 0 SP
 
--- Instance local vars
-local war_god_done = false
-local shield_is_up = false
+-- The ai_state table of each Harlequin keeps:
+-- war_god_done: whether War God has already been cast.
+-- shield_is_up: whether the shield is up.
 
 -- The battle_actor parameter is the enemy thinking, useful to exclude itself from other opponents.
-function DecideAction(battle_instance, battle_actor)
+function DecideAction(battle_instance, battle_actor, ai_state)
     local Battle = battle_instance;
 
     local nb_enemies = Battle:GetNumberOfEnemies()
@@ -95,16 +95,16 @@ function DecideAction(battle_instance, battle_actor)
         index = index + 1;
     end
 
-    if (dead_enemies >= 5 and shield_is_up == true) then
+    if (dead_enemies >= 5 and ai_state.shield_is_up == true) then
         -- All other enemies are dead, the shield is down
         battle_actor:SetAction(21005, enemy)
-        shield_is_up = false
+        ai_state.shield_is_up = false
         return
     end
-    if (dead_enemies == 0 and shield_is_up == false) then
+    if (dead_enemies == 0 and ai_state.shield_is_up ~= true) then
         -- Everybody is alive, the shield is up
         battle_actor:SetAction(21004, enemy)
-        shield_is_up = true
+        ai_state.shield_is_up = true
         return
     end
 
@@ -114,9 +114,9 @@ function DecideAction(battle_instance, battle_actor)
         return;
     end
 
-    if (war_god_done == false and battle_actor:GetSkillPoints() >= 96) then
+    if (ai_state.war_god_done ~= true and battle_actor:GetSkillPoints() >= 96) then
         battle_actor:SetAction(10011); -- War God (def - on all heroes)
-        war_god_done = true;
+        ai_state.war_god_done = true;
         return;
     elseif (battle_actor:GetSkillPoints() >= 64 and enemies_have_enough_atk == false) then
         battle_actor:SetAction(10004); -- Holy Veil (atk + on all enemies)
@@ -0,0 +1,32 @@
+------------------------------------------------------------------------------[[
+-- Filename: battle_simulation.lua
+--
+-- Description: An example of battle simulation, run with:
+-- valyriatear --simulate-battles data/debug/battle_simulation.lua
+--
+-- The battles are played by the real battle mode, headless: the actors are
+-- given by their ids in data/entities/characters.lua and
+-- data/entities/enemies.lua, and use their skills, status effects and AI.
+-- The characters commands are given by the auto-battle.
+--
+-- The optional fields are:
+-- {save_game}: A save game whose active party fights instead of the characters,
+-- e.g. to simulate a party leveled up through the skill tree.
+-- {workers}: The number of worker processes, 0 using one per CPU.
+--
+-- This file only contains data: it can't call the game functions.
+------------------------------------------------------------------------------]]
+
+simulation = {
+    battles = 200,
+    workers = 0,
+    seed = 1,
+    -- The battles lasting longer are counted as timeouts, in milliseconds.
+    max_battle_time = 600000,
+
+    -- Bronann, Kalya
+    characters = { 1, 2 },
+
+    -- Green Slime, Spider, and Dorver using its Lua AI.
+    enemies = { 1, 2, 20 },
+}
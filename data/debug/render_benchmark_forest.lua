@@ -0,0 +1,51 @@
+------------------------------------------------------------------------------[[
+-- Filename: render_benchmark_forest.lua
+--
+-- Description: A render benchmark scrolling across the Layna forest entrance, run with:
+-- valyriatear --offscreen --disable-audio --benchmark-render data/debug/render_benchmark_forest.lua 600
+--
+-- Initialize() pushes the map to render, and Update(frame) moves the camera
+-- along a fixed path, so that every run renders the same frames.
+------------------------------------------------------------------------------]]
+
+local ns = {};
+setmetatable(ns, {__index = _G});
+render_benchmark_forest = ns;
+setfenv(1, ns);
+
+-- The map mode rendered.
+local Map = nil
+
+-- The camera path waypoints, in map collision coordinates.
+local camera_path = {
+    { 10.0, 10.0 },
+    { 54.0, 10.0 },
+    { 54.0, 38.0 },
+    { 10.0, 38.0 }
+}
+
+-- The number of frames spent between two waypoints.
+local frames_per_waypoint = 150
+
+function Initialize()
+    GlobalManager:GetCharacterHandler():AddCharacter(BRONANN);
+
+    Map = vt_map.MapMode("data/story/ep1/layna_forest/layna_forest_entrance_map.lua",
+                         "data/story/ep1/layna_forest/layna_forest_entrance_script.lua");
+    ModeManager:Push(Map, false, false);
+end
+
+function Update(frame)
+    if (Map == nil) then
+        return
+    end
+
+    local waypoint = math.floor(frame / frames_per_waypoint) % #camera_path
+    local ratio = (frame % frames_per_waypoint) / frames_per_waypoint
+    local from = camera_path[waypoint + 1]
+    local to = camera_path[(waypoint + 1) % #camera_path + 1]
+
+    Map:SetCamera(Map:GetVirtualFocus());
+    Map:MoveVirtualFocus(from[1] + (to[1] - from[1]) * ratio,
+                         from[2] + (to[2] - from[2]) * ratio);
+end
@@ -9,6 +9,8 @@
 -- {name} - The name of the status effect as it will be shown to the player
 -- {default_duration} - The default duration that the effect lasts, in milliseconds
 -- {update_every} - Tells the time the effect is waiting before calling the Update() function again, in milliseconds.
+--                  Without it, the Update() functions are only called when the effect intensity has changed,
+--                  and the UpdatePassive() functions are never called.
 -- {BattleApply} - A function executed when the status effect is applied to the target
 -- {BattleUpdate} - A function executed periodically while the status is still in effect
 -- {BattleUpdatePassive} - A function executed periodically while the passive (from equipment) status is in effect in battles.
@@ -40,6 +42,8 @@
 -- in ms
 local default_status_duration = 15000
 local default_status_update_every = 5000
+-- The time between two checks of effects that must be kept applied, like being stunned.
+local default_status_check_every = 250
 
 -- All item definitions are stored in this table
 if (status_effects == nil) then
@@ -762,6 +766,8 @@ status_effects[vt_global.GameGlobal.GLOBAL_STATUS_SP] = {
 status_effects[vt_global.GameGlobal.GLOBAL_STATUS_PARALYSIS] = {
     name = vt_system.Translate("Paralysis"),
     default_duration = math.floor(default_status_duration / 2.0),
+    -- Used to keep the passive paralysis stun applied.
+    update_every = default_status_check_every,
 
     -- Battle status effects related functions
     BattleApply = function(battle_actor, battle_effect)
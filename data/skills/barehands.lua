@@ -14,6 +14,9 @@
 -- {action_name}: The sprite action played before executing the battle scripted function.
 -- {target_type}: The type of target the skill affects, which may be an attack point, actor, or party.
 --
+-- The optional {battle_particle_effects} and {battle_animations} tables list the files used by the
+-- skill and its animation scripts, so that they are preloaded when a battle starts.
+--
 -- Each skill entry requires a function called {BattleExecute} to be defined. This function implements the
 -- execution of the skill in battle, dealing damage, causing status changes, playing sounds, and animating
 -- sprites.
@@ -32,6 +35,8 @@ skills[30001] = {
    cooldown_time = 200,
    action_name = "attack",
    target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+   battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+   battle_animations = { "data/entities/battle/effects/hit_splash.lua" },
 
    BattleExecute = function(user, target)
        local target_actor = target:GetActor();
@@ -60,6 +65,7 @@ skills[30002] = {
    cooldown_time = 200,
    action_name = "throw_stone",
    target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+   battle_animations = { "data/entities/battle/effects/hit_splash.lua" },
 
    BattleExecute = function(user, target)
        local target_actor = target:GetActor();
@@ -87,6 +93,7 @@ skills[30003] = {
    cooldown_time = 200,
    action_name = "throw_stone",
    target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+   battle_animations = { "data/entities/battle/effects/hit_splash.lua" },
 
    BattleExecute = function(user, target)
        local target_actor = target:GetActor();
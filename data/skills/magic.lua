@@ -24,6 +24,9 @@
 --                  executing the skill before their stamina begins regenrating (zero is valid).
 -- {target_type}: The type of target the skill affects, which may be an attack point, actor, or party.
 --
+-- The optional {battle_particle_effects} and {battle_animations} tables list the files used by the
+-- skill and its animation scripts, so that they are preloaded when a battle starts.
+--
 -- Each skill entry requires a function called {BattleExecute} to be defined. This function implements the
 -- execution of the skill in battle, buffing defense, causing status changes, playing sounds, and animating
 -- sprites.
@@ -57,6 +60,10 @@ skills[10001] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALLY,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/shield.lua",
+        "data/visuals/particle_effects/shield_big_sprites.lua"
+    },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -106,6 +113,7 @@ skills[10002] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALLY,
+    battle_particle_effects = { "data/visuals/particle_effects/heal_particle.lua" },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -367,6 +375,10 @@ skills[10100] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALL_FOES,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/fire_circle.lua",
+        "data/visuals/particle_effects/fire_spell.lua"
+    },
 
     BattleWarmup = function(user, target)
         local Battle = ModeManager:GetTop()
@@ -376,24 +388,19 @@ skills[10100] = {
     end,
 
     BattleExecute = function(user, target)
-        local target_actor = target:GetActor()
-        local index = 0;
-        local effect_duration = clampDuration(user:GetMagAtk() * 3000)
         local Battle = ModeManager:GetTop()
+        vt_battle.RndMagicalAttack(user, target, vt_global.GameGlobal.GLOBAL_ELEMENTAL_FIRE, 30);
+
+        local index = 0;
         while true do
-            local target_actor = target:GetPartyActor(index)
+            local target_actor = target:GetHitActor(index)
             if (target_actor == nil) then
                 break;
             end
-            if (target_actor:IsAlive() == true and vt_battle.RndEvade(target_actor) == false) then
-                target_actor:RegisterDamage(vt_battle.RndMagicalDamage(user, target_actor, vt_global.GameGlobal.GLOBAL_ELEMENTAL_FIRE, 30), target);
-                -- trigger the fire effect slightly under the sprite to make it appear before it from the player's point of view.
-                Battle:TriggerBattleParticleEffect("data/visuals/particle_effects/fire_spell.lua",
-                      target_actor:GetXLocation(), target_actor:GetYLocation() + 5)
-                AudioManager:PlaySound("data/sounds/fire1_spell.ogg")
-            else
-              target_actor:RegisterMiss(true);
-            end
+            -- trigger the fire effect slightly under the sprite to make it appear before it from the player's point of view.
+            Battle:TriggerBattleParticleEffect("data/visuals/particle_effects/fire_spell.lua",
+                  target_actor:GetXLocation(), target_actor:GetYLocation() + 5)
+            AudioManager:PlaySound("data/sounds/fire1_spell.ogg")
             index = index + 1
         end
     end,
@@ -579,6 +586,10 @@ skills[10111] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALLY,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/earth_circle.lua",
+        "data/visuals/particle_effects/earth_circle_outer_particles.lua"
+    },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -736,6 +747,10 @@ skills[10120] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALL_FOES,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/water_circle.lua",
+        "data/visuals/particle_effects/wave_spell.lua"
+    },
 
     BattleWarmup = function(user, target)
         local Battle = ModeManager:GetTop()
@@ -745,26 +760,23 @@ skills[10120] = {
     end,
 
     BattleExecute = function(user, target)
+        local Battle = ModeManager:GetTop();
+        local effect_duration = clampDuration(user:GetMagAtk() * 1000)
+        vt_battle.RndMagicalAttack(user, target, vt_global.GameGlobal.GLOBAL_ELEMENTAL_WATER, 45);
+
         local index = 0;
         while true do
-            local target_actor = target:GetPartyActor(index)
+            local target_actor = target:GetHitActor(index)
             if (target_actor == nil) then
                 break;
             end
-            if (target_actor:IsAlive() == true and vt_battle.RndEvade(target_actor) == false) then
-              target_actor:RegisterDamage(vt_battle.RndMagicalDamage(user, target_actor, vt_global.GameGlobal.GLOBAL_ELEMENTAL_WATER, 45), target);
-              local effect_duration = clampDuration(user:GetMagAtk() * 1000)
-              target_actor:ApplyActiveStatusEffect(vt_global.GameGlobal.GLOBAL_STATUS_PHYS_ATK,
-                                                   vt_global.GameGlobal.GLOBAL_INTENSITY_NEG_LESSER,
-                                                   effect_duration);
-              -- trigger the fire effect slightly under the sprite to make it appear before it from the player's point of view.
-              local Battle = ModeManager:GetTop();
-              Battle:TriggerBattleParticleEffect("data/visuals/particle_effects/wave_spell.lua",
-                      target_actor:GetXLocation(), target_actor:GetYLocation() + 5);
-              AudioManager:PlaySound("data/sounds/wave1_spell.ogg");
-            else
-              target_actor:RegisterMiss(true);
-            end
+            target_actor:ApplyActiveStatusEffect(vt_global.GameGlobal.GLOBAL_STATUS_PHYS_ATK,
+                                                 vt_global.GameGlobal.GLOBAL_INTENSITY_NEG_LESSER,
+                                                 effect_duration);
+            -- trigger the fire effect slightly under the sprite to make it appear before it from the player's point of view.
+            Battle:TriggerBattleParticleEffect("data/visuals/particle_effects/wave_spell.lua",
+                    target_actor:GetXLocation(), target_actor:GetYLocation() + 5);
+            AudioManager:PlaySound("data/sounds/wave1_spell.ogg");
             index = index + 1
         end
     end,
@@ -780,6 +792,10 @@ skills[10121] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALLY,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/water_circle.lua",
+        "data/visuals/particle_effects/water_circle_outer_particles.lua"
+    },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -869,6 +885,11 @@ skills[10126] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/dust.lua",
+        "data/visuals/particle_effects/hp_drain.lua"
+    },
+    battle_animations = { "data/entities/battle/effects/fangs_crush.lua" },
 
     animation_scripts = {
         -- N.B.: [11] is the enemy ID.
@@ -894,6 +915,7 @@ skills[10127] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+    battle_particle_effects = { "data/visuals/particle_effects/stun_star.lua" },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -971,6 +993,10 @@ skills[10131] = {
     warmup_action_name = "magic_prepare",
     action_name = "magic_cast",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALLY,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/wind_circle.lua",
+        "data/visuals/particle_effects/wind_circle_outer_particles.lua"
+    },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -24,6 +24,9 @@
 --                  executing the skill before their stamina begins regenrating (zero is valid).
 -- {target_type}: The type of target the skill affects, which may be an attack point, actor, or party.
 --
+-- The optional {battle_particle_effects} and {battle_animations} tables list the files used by the
+-- skill and its animation scripts, so that they are preloaded when a battle starts.
+--
 -- Each skill entry requires a function called {BattleExecute} to be defined. This function implements the
 -- execution of the skill in battle, buffing defense, causing status changes, playing sounds, and animating
 -- sprites.
@@ -194,6 +197,11 @@ skills[21001] = {
     warmup_time = 1400,
     cooldown_time = 750,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_SELF,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/dust.lua",
+        "data/visuals/particle_effects/small_burst_particles.lua"
+    },
+    battle_animations = { "data/entities/battle/effects/hit_splash.lua" },
 
     animation_scripts = {
         -- N.B.: [5] is the enemy ID.
@@ -265,6 +273,7 @@ skills[21004] = {
     warmup_time = 900,
     cooldown_time = 300,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_SELF,
+    battle_animations = { "data/entities/battle/effects/magic_shield.lua" },
 
     animation_scripts = {
         -- N.B.: [14] is the enemy ID.
@@ -285,6 +294,7 @@ skills[21005] = {
     warmup_time = 900,
     cooldown_time = 300,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_SELF,
+    battle_animations = { "data/entities/battle/effects/magic_shield_breaking.lua" },
 
     animation_scripts = {
         -- N.B.: [14] is the enemy ID.
@@ -21,6 +21,9 @@
 -- {action_name}: The sprite action played before executing the battle scripted function.
 -- {target_type}: The type of target the skill affects, which may be an attack point, actor, or party.
 --
+-- The optional {battle_particle_effects} and {battle_animations} tables list the files used by the
+-- skill and its animation scripts, so that they are preloaded when a battle starts.
+--
 -- Each skill entry requires a function called {BattleExecute} to be defined. This function implements the
 -- execution of the skill in battle, dealing damage, causing status changes, playing sounds, and animating
 -- sprites.
@@ -88,6 +91,8 @@ skills[1] = {
     cooldown_time = 200,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/sword_slash.lua" },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -117,6 +122,11 @@ skills[2] = {
     cooldown_time = 200,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = {
+        "data/entities/battle/effects/hit_splash.lua",
+        "data/entities/battle/effects/sword_forward_slash.lua"
+    },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -147,6 +157,14 @@ skills[3] = {
     cooldown_time = 200,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/dust.lua",
+        "data/visuals/particle_effects/stun_star.lua"
+    },
+    battle_animations = {
+        "data/entities/battle/effects/hit_splash.lua",
+        "data/entities/battle/effects/sword_slash.lua"
+    },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -183,6 +201,8 @@ skills[4] = {
     cooldown_time = 1000,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/sword_slash.lua" },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -216,6 +236,7 @@ skills[5] = {
     cooldown_time = 200,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+    battle_animations = { "data/entities/battle/effects/hit_splash.lua" },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -243,6 +264,8 @@ skills[6] = {
     cooldown_time = 3000,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/sword_slash.lua" },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -277,6 +300,7 @@ skills[101] = {
     cooldown_time = 600,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_animations = { "data/entities/battle/effects/hit_splash.lua" },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -307,21 +331,13 @@ skills[102] = {
     cooldown_time = 1000,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALL_FOES,
+    battle_animations = { "data/entities/battle/effects/hit_splash.lua" },
 
     BattleExecute = function(user, target)
-        local index = 0;
-        while (target:GetPartyActor(index) ~= nil) do
-            local target_actor = target:GetPartyActor(index)
-
-            if (vt_battle.RndEvade(target_actor) == false) then
-                target_actor:RegisterDamage(vt_battle.RndPhysicalDamage(user, target_actor, 5), target);
-                AudioManager:PlaySound("data/sounds/crossbow.ogg");
-            else
-                target_actor:RegisterMiss(true);
-                AudioManager:PlaySound("data/sounds/crossbow_miss.ogg");
-            end
-
-            index = index + 1
+        if (vt_battle.RndPhysicalAttack(user, target, 5) > 0) then
+            AudioManager:PlaySound("data/sounds/crossbow.ogg");
+        else
+            AudioManager:PlaySound("data/sounds/crossbow_miss.ogg");
         end
     end,
 
@@ -438,6 +454,7 @@ skills[300] = {
     cooldown_time = 500,
     action_name = "attack",
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
 
     BattleExecute = function(user, target)
         local target_actor = target:GetActor();
@@ -491,6 +508,8 @@ skills[1001] = {
     warmup_time = 1100,
     cooldown_time = 500,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/claw_slash.lua" },
 
     animation_scripts = {
         -- N.B.: [1] is the enemy ID.
@@ -518,6 +537,8 @@ skills[1002] = {
     warmup_time = 1400,
     cooldown_time = 0,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/claw_slash.lua" },
 
     animation_scripts = {
         -- N.B.: [2] is the enemy ID.
@@ -544,6 +565,8 @@ skills[1003] = {
     warmup_time = 900,
     cooldown_time = 0,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/claw_slash.lua" },
 
     animation_scripts = {
         -- N.B.: [4] is the enemy ID.
@@ -572,6 +595,11 @@ skills[1004] = {
     warmup_time = 3000,
     cooldown_time = 1000,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/dust.lua",
+        "data/visuals/particle_effects/stun_star.lua"
+    },
+    battle_animations = { "data/entities/battle/effects/claw_slash.lua" },
 
     animation_scripts = {
         -- N.B.: [4] is the enemy ID.
@@ -605,6 +633,8 @@ skills[1005] = {
     warmup_time = 5000,
     cooldown_time = 2000,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/green_tentacles_attack.lua" },
 
     animation_scripts = {
         -- N.B.: [4] is the enemy ID.
@@ -661,6 +691,11 @@ skills[1007] = {
     warmup_time = 5000,
     cooldown_time = 2000,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/dust.lua",
+        "data/visuals/particle_effects/hp_drain.lua"
+    },
+    battle_animations = { "data/entities/battle/effects/fangs_crush.lua" },
 
     animation_scripts = {
         -- N.B.: [6] is the enemy ID.
@@ -694,6 +729,8 @@ skills[1008] = {
     warmup_time = 1200,
     cooldown_time = 300,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/wolf_claws.lua" },
 
     animation_scripts = {
         -- N.B.: [3] is the enemy ID.
@@ -725,6 +762,8 @@ skills[1009] = {
     warmup_time = 1600,
     cooldown_time = 500,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALL_FOES,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = { "data/entities/battle/effects/fangs_crush.lua" },
 
     animation_scripts = {
         -- N.B.: [3] is the enemy ID.
@@ -734,21 +773,8 @@ skills[1009] = {
     },
 
     BattleExecute = function(user, target)
-        local index = 0;
-        while true do
-            local target_actor = target:GetPartyActor(index);
-            if (target_actor == nil) then
-                break;
-            end
-
-            if (target_actor:IsAlive() == true and vt_battle.RndEvade(target_actor) == false) then
-                target_actor:RegisterDamage(vt_battle.RndPhysicalDamage(user, target_actor, 40));
-                AudioManager:PlaySound("data/sounds/bite_02.ogg")
-            else
-                target_actor:RegisterMiss(true);
-            end
-
-            index = index + 1;
+        if (vt_battle.RndPhysicalAttack(user, target, 40) > 0) then
+            AudioManager:PlaySound("data/sounds/bite_02.ogg")
         end
     end
 }
@@ -759,6 +785,14 @@ skills[1010] = {
     warmup_time = 900,
     cooldown_time = 100,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = {
+        "data/visuals/particle_effects/dust.lua",
+        "data/visuals/particle_effects/hp_drain.lua"
+    },
+    battle_animations = {
+        "data/entities/battle/effects/fangs_crush.lua",
+        "data/entities/battle/effects/magic_flame.lua"
+    },
 
     animation_scripts = {
         -- N.B.: [X] is the enemy ID.
@@ -797,6 +831,11 @@ skills[1011] = {
     warmup_time = 2400,
     cooldown_time = 500,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_ALL_FOES,
+    battle_particle_effects = { "data/visuals/particle_effects/dust.lua" },
+    battle_animations = {
+        "data/entities/battle/effects/hit_splash.lua",
+        "data/entities/battle/effects/sword_slash.lua"
+    },
 
     animation_scripts = {
         -- N.B.: [19] is the enemy ID.
@@ -804,22 +843,10 @@ skills[1011] = {
     },
 
     BattleExecute = function(user, target)
-        local index = 0;
-        while true do
-            local target_actor = target:GetPartyActor(index);
-            if (target_actor == nil) then
-                break;
-            end
-
-            if (target_actor:IsAlive() == true and vt_battle.RndEvade(target_actor) == false) then
-                target_actor:RegisterDamage(vt_battle.RndPhysicalDamage(user, target_actor, 25), target);
-                AudioManager:PlaySound("data/sounds/skeleton_attack.wav");
-            else
-                target_actor:RegisterMiss(true);
-                AudioManager:PlaySound("data/sounds/missed_target.wav");
-            end
-
-            index = index + 1;
+        if (vt_battle.RndPhysicalAttack(user, target, 25) > 0) then
+            AudioManager:PlaySound("data/sounds/skeleton_attack.wav");
+        else
+            AudioManager:PlaySound("data/sounds/missed_target.wav");
         end
     end
 }
@@ -831,6 +858,7 @@ skills[1012] = {
     warmup_time = 2400,
     cooldown_time = 500,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
+    battle_particle_effects = { "data/visuals/particle_effects/waterspray_skill.lua" },
 
     animation_scripts = {
         -- N.B.: [X] is the enemy ID.
@@ -916,6 +944,7 @@ skills[1015] = {
     warmup_time = 1100,
     cooldown_time = 500,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
+    battle_particle_effects = { "data/visuals/particle_effects/waterspray_skill.lua" },
 
     animation_scripts = {
         -- N.B.: [1] is the slime enemy ID.
@@ -73,6 +73,9 @@ local Map = nil
 local Script = nil
 local Effects = nil
 
+-- The event triggering the script
+local event_id = nil
+
 function Initialize(map_instance)
     Map = map_instance;
 
@@ -104,15 +107,18 @@ function Initialize(map_instance)
 
     -- Init the random seed
     math.randomseed(os.time());
+
+    -- Get the event id once, as it is checked on every frame.
+    event_id = GlobalManager:GetGameEvents():GetEventId("story", "layna_forest_crystal_appearance");
 end
 
 function Update()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("story", "layna_forest_crystal_appearance") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("story", "layna_forest_crystal_appearance") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
@@ -126,7 +132,7 @@ function Update()
     if (display_time > 17000) then
         display_time = 0;
         -- Disable the event at the end of it
-        GlobalManager:GetGameEvents():SetEventValue("story", "layna_forest_crystal_appearance", 0);
+        GlobalManager:GetGameEvents():SetEventValue(event_id, 0);
         return;
     end
 
@@ -298,11 +304,11 @@ local flash_color = vt_video.Color(1.0, 1.0, 1.0, 1.0);
 
 function DrawPostEffects()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("story", "layna_forest_crystal_appearance") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("story", "layna_forest_crystal_appearance") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
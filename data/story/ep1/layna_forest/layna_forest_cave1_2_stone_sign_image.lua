@@ -17,21 +17,27 @@ local display_time = 0;
 local Map = {};
 local Script = {};
 
+-- The event triggering the script
+local event_id = nil
+
 function Initialize(map_instance)
     Map = map_instance;
 
     Script = Map:GetScriptSupervisor();
     stone_sign = Script:CreateImage("data/story/ep1/layna_forest/stone_sign.png");
     stone_sign:SetDimensions(512.0, 256.0);
+
+    -- Get the event id once, as it is checked on every frame.
+    event_id = GlobalManager:GetGameEvents():GetEventId("story", "layna_forest_cave1_2_show_sign_image");
 end
 
 function Update()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("story", "layna_forest_cave1_2_show_sign_image") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("story", "layna_forest_cave1_2_show_sign_image") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
@@ -44,7 +50,7 @@ function Update()
     if (display_time > 8000) then
         display_time = 0
         -- Disable the event at the end of it
-        GlobalManager:GetGameEvents():SetEventValue("story", "layna_forest_cave1_2_show_sign_image", 0);
+        GlobalManager:GetGameEvents():SetEventValue(event_id, 0);
     end
 
 
@@ -55,11 +61,11 @@ local stone_sign_color = vt_video.Color(1.0, 1.0, 1.0, 0.9);
 
 function DrawPostEffects()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("story", "layna_forest_cave1_2_show_sign_image") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("story", "layna_forest_cave1_2_show_sign_image") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
@@ -22,6 +22,9 @@ local script_triggered = false;
 local Map = nil
 local Script = nil
 
+-- The event triggering the script
+local event_id = nil
+
 function Initialize(map_instance)
     Map = map_instance;
 
@@ -41,15 +44,18 @@ function Initialize(map_instance)
     crystal2_alpha = 0.0;
 
     script_triggered = false;
+
+    -- Get the event id once, as it is checked on every frame.
+    event_id = GlobalManager:GetGameEvents():GetEventId("scripts_events", "layna_village_riverbank_show_crystals");
 end
 
 function Update()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("scripts_events", "layna_village_riverbank_show_crystals") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("scripts_events", "layna_village_riverbank_show_crystals") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
@@ -93,7 +99,7 @@ function Update()
     if (display_time > 8000) then
         display_time = 0
         -- Disable the event at the end of it
-        GlobalManager:GetGameEvents():SetEventValue("scripts_events", "layna_village_riverbank_show_crystals", 0);
+        GlobalManager:GetGameEvents():SetEventValue(event_id, 0);
     end
 end
 
@@ -103,11 +109,11 @@ local red_crystal_color = vt_video.Color(1.0, 0.0, 0.0, 1.0);
 
 function DrawPostEffects()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("scripts_events", "layna_village_riverbank_show_crystals") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("scripts_events", "layna_village_riverbank_show_crystals") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
@@ -14,6 +14,9 @@ local smoke_sound_triggered = false;
 local Map = nil
 local Script = nil
 
+-- The event triggering the script
+local event_id = nil
+
 function Initialize(map_instance)
     Map = map_instance;
 
@@ -27,17 +30,20 @@ function Initialize(map_instance)
     cloud_alpha = 0.0;
 
     smoke_sound_triggered = false;
+
+    -- Get the event id once, as it is checked on every frame.
+    event_id = GlobalManager:GetGameEvents():GetEventId("scripts_events", "layna_village_riverbank_smoke");
 end
 
 local flash_color = vt_video.Color(1.0, 1.0, 1.0, 1.0);
 
 function Update()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("scripts_events", "layna_village_riverbank_smoke") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("scripts_events", "layna_village_riverbank_smoke") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
@@ -55,7 +61,7 @@ function Update()
     if (display_time > 4300) then
         display_time = 0
         -- Disable the event at the end of it
-        GlobalManager:GetGameEvents():SetEventValue("scripts_events", "layna_village_riverbank_smoke", 0);
+        GlobalManager:GetGameEvents():SetEventValue(event_id, 0);
     end
 
     -- The flash alpha
@@ -84,11 +90,11 @@ local cloud_color = vt_video.Color(1.0, 1.0, 1.0, 1.0);
 
 function DrawForeground()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("scripts_events", "layna_village_riverbank_smoke") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("scripts_events", "layna_village_riverbank_smoke") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
@@ -32,6 +32,9 @@ local Map = nil
 local Script = nil
 local Effects = nil
 
+-- The event triggering the script
+local event_id = nil
+
 function Initialize(map_instance)
     Map = map_instance;
 
@@ -76,15 +79,18 @@ function Initialize(map_instance)
 
     help_text = Script:CreateText(vt_system.VTranslate("Help Menu: %s", vt_system.Translate(InputManager:GetHelpKeyName())),
                 vt_video.TextStyle("text22"));
+
+    -- Get the event id once, as it is checked on every frame.
+    event_id = GlobalManager:GetGameEvents():GetEventId("game", "show_move_interact_info");
 end
 
 function Update()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("game", "show_move_interact_info") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("game", "show_move_interact_info") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
@@ -105,11 +111,11 @@ end
 
 function DrawPostEffects()
     -- Only show the image if requested by the events
-    if (GlobalManager:GetGameEvents():DoesEventExist("game", "show_move_interact_info") == false) then
+    if (GlobalManager:GetGameEvents():DoesEventExist(event_id) == false) then
         return;
     end
 
-    if (GlobalManager:GetGameEvents():GetEventValue("game", "show_move_interact_info") == 0) then
+    if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 0) then
         return;
     end
 
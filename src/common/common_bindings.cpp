@@ -371,9 +371,13 @@ void BindCommonCode()
         luabind::module(vt_script::ScriptManager->GetGlobalState(), "vt_global")
         [
             luabind::class_<GameEvents>("GameEvents")
-            .def("DoesEventExist", &GameEvents::DoesEventExist)
-            .def("GetEventValue", &GameEvents::GetEventValue)
-            .def("SetEventValue", &GameEvents::SetEventValue)
+            .def("GetEventId", &GameEvents::GetEventId)
+            .def("DoesEventExist", (bool(GameEvents::*)(const std::string&, const std::string&) const)&GameEvents::DoesEventExist)
+            .def("DoesEventExist", (bool(GameEvents::*)(uint32_t) const)&GameEvents::DoesEventExist)
+            .def("GetEventValue", (int32_t(GameEvents::*)(const std::string&, const std::string&) const)&GameEvents::GetEventValue)
+            .def("GetEventValue", (int32_t(GameEvents::*)(uint32_t) const)&GameEvents::GetEventValue)
+            .def("SetEventValue", (void(GameEvents::*)(const std::string&, const std::string&, int32_t))&GameEvents::SetEventValue)
+            .def("SetEventValue", (void(GameEvents::*)(uint32_t, int32_t))&GameEvents::SetEventValue)
         ];
 
         luabind::module(vt_script::ScriptManager->GetGlobalState(), "vt_global")
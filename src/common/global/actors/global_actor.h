@@ -445,7 +445,7 @@ protected:
     virtual void _CalculateDefenseRatings();
 
     //! \brief Calculates the evade rating for each attack point
-    void _CalculateEvadeRatings();
+    virtual void _CalculateEvadeRatings();
 }; // class GlobalActor
 
 } // namespace vt_global
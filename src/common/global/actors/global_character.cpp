@@ -16,6 +16,7 @@
 #include "common/global/objects/global_weapon.h"
 
 #include "script/script_read.h"
+#include "engine/script_profiler.h"
 #include "utils/utils_files.h"
 
 using namespace vt_utils;
@@ -324,7 +325,7 @@ GlobalCharacter::~GlobalCharacter()
     _equipped_armors.clear();
 }
 
-bool GlobalCharacter::LoadCharacter(ReadScriptDescriptor& file)
+bool GlobalCharacter::LoadCharacter(SaveGameReader& file)
 {
     if(!file.IsFileOpen()) {
         PRINT_WARNING << "Can't load character, the file " << file.GetFilename()
@@ -469,36 +470,36 @@ bool GlobalCharacter::LoadCharacter(ReadScriptDescriptor& file)
     return true;
 }
 
-bool GlobalCharacter::SaveCharacter(WriteScriptDescriptor& file)
+bool GlobalCharacter::SaveCharacter(SaveGameBuffer& file)
 {
     if(!file.IsFileOpen()) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
         return false;
     }
 
-    file.WriteLine("\t[" + NumberToString(GetID()) + "] = {");
+    file.BeginTable(GetID());
 
     // Store whether the character is available
-    file.WriteLine("\t\tenabled = " + std::string(IsEnabled() ? "true" : "false") + ",");
+    file.WriteBool("enabled", IsEnabled());
 
     // Write out the character's stats
-    file.WriteLine("\t\texperience_level = " + NumberToString(GetExperienceLevel()) + ",");
-    file.WriteLine("\t\tunspent_experience_points = " + NumberToString(GetUnspentExperiencePoints()) + ", ");
-    file.WriteLine("\t\ttotal_experience_points = " + NumberToString(GetTotalExperiencePoints()) + ",");
-    file.WriteLine("\t\texperience_points_next = " + NumberToString(GetExperienceForNextLevel()) + ", ");
+    file.WriteUInt("experience_level", GetExperienceLevel());
+    file.WriteUInt("unspent_experience_points", GetUnspentExperiencePoints());
+    file.WriteUInt("total_experience_points", GetTotalExperiencePoints());
+    file.WriteInt("experience_points_next", GetExperienceForNextLevel());
 
     // The values stored are the unmodified ones.
-    file.WriteLine("\t\tmax_hit_points = " + NumberToString(GetMaxHitPoints()) + ",");
-    file.WriteLine("\t\thit_points = " + NumberToString(GetHitPoints()) + ",");
-    file.WriteLine("\t\tmax_skill_points = " + NumberToString(GetMaxSkillPoints()) + ",");
-    file.WriteLine("\t\tskill_points = " + NumberToString(GetSkillPoints()) + ",");
-
-    file.WriteLine("\t\tphys_atk = " + NumberToString(GetPhysAtkBase()) + ",");
-    file.WriteLine("\t\tmag_atk = " + NumberToString(GetMagAtkBase()) + ",");
-    file.WriteLine("\t\tphys_def = " + NumberToString(GetPhysDefBase()) + ",");
-    file.WriteLine("\t\tmag_def = " + NumberToString(GetMagDefBase()) + ",");
-    file.WriteLine("\t\tstamina = " + NumberToString(GetStaminaBase()) + ",");
-    file.WriteLine("\t\tevade = " + NumberToString(GetEvadeBase()) + ",");
+    file.WriteUInt("max_hit_points", GetMaxHitPoints());
+    file.WriteUInt("hit_points", GetHitPoints());
+    file.WriteUInt("max_skill_points", GetMaxSkillPoints());
+    file.WriteUInt("skill_points", GetSkillPoints());
+
+    file.WriteUInt("phys_atk", GetPhysAtkBase());
+    file.WriteUInt("mag_atk", GetMagAtkBase());
+    file.WriteUInt("phys_def", GetPhysDefBase());
+    file.WriteUInt("mag_def", GetMagDefBase());
+    file.WriteUInt("stamina", GetStaminaBase());
+    file.WriteFloat("evade", GetEvadeBase());
 
     // Write out the character's equipment
     uint32_t weapon_id = GetEquippedWeapon() ? GetEquippedWeapon()->GetID() : 0;
@@ -507,66 +508,38 @@ bool GlobalCharacter::SaveCharacter(WriteScriptDescriptor& file)
     uint32_t arm_id = GetEquippedArmor(GLOBAL_OBJECT_ARM_ARMOR) ? GetEquippedArmor(GLOBAL_OBJECT_ARM_ARMOR)->GetID() : 0;
     uint32_t leg_id = GetEquippedArmor(GLOBAL_OBJECT_LEG_ARMOR) ? GetEquippedArmor(GLOBAL_OBJECT_LEG_ARMOR)->GetID() : 0;
 
-    file.InsertNewLine();
-    file.WriteLine("\t\tequipment = {");
-    file.WriteLine("\t\t\tweapon = " + NumberToString(weapon_id) + ",");
-    file.WriteLine("\t\t\thead_armor = " + NumberToString(head_id) + ",");
-    file.WriteLine("\t\t\ttorso_armor = " + NumberToString(torso_id) + ",");
-    file.WriteLine("\t\t\tarm_armor = " + NumberToString(arm_id) + ",");
-    file.WriteLine("\t\t\tleg_armor = " + NumberToString(leg_id));
-    file.WriteLine("\t\t},");
+    file.BeginTable("equipment");
+    file.WriteUInt("weapon", weapon_id);
+    file.WriteUInt("head_armor", head_id);
+    file.WriteUInt("torso_armor", torso_id);
+    file.WriteUInt("arm_armor", arm_id);
+    file.WriteUInt("leg_armor", leg_id);
+    file.EndTable(); // equipment
 
     // Write out the character's permanent skills.
     // The equipment skills will be reloaded through equipment.
-    file.InsertNewLine();
-    file.WriteLine("\t\tskills = {");
-    const std::vector<uint32_t>& skill_vector = GetPermanentSkills();
-    for(uint32_t i = 0; i < skill_vector.size(); i++) {
-        uint32_t skill_id = skill_vector.at(i);
-
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        file.WriteLine(NumberToString(skill_id), false);
-    }
-    file.WriteLine("\n\t\t},");
+    file.WriteUIntVector("skills", GetPermanentSkills());
 
     // Write out the character's obtained skill nodes.
-    file.InsertNewLine();
-    file.WriteLine("\t\tobtained_skill_nodes = {");
-    const std::vector<uint32_t>& skill_nodes = GetObtainedSkillNodes();
-    for(uint32_t i = 0; i < skill_nodes.size(); i++) {
-        uint32_t skill_node = skill_nodes.at(i);
-
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        bool newline = (i > 0) && !(i % 10);
-        file.WriteLine(NumberToString(skill_node), newline);
-    }
-    file.WriteLine("\n\t\t},");
-    file.WriteLine("\t\tcurrent_skill_node = " + NumberToString(GetSkillNodeLocation()) + ",");
+    file.WriteUIntVector("obtained_skill_nodes", GetObtainedSkillNodes());
+    file.WriteUInt("current_skill_node", GetSkillNodeLocation());
 
     // Writes active status effects at the time of the save
-    file.InsertNewLine();
-    file.WriteLine("\t\tactive_status_effects = {");
+    file.BeginTable("active_status_effects");
     for(uint32_t i = 0; i < _active_status_effects.size(); ++i) {
         const ActiveStatusEffect& effect = _active_status_effects.at(i);
         if (!effect.IsActive())
             continue;
 
-        std::string effect_str = "\t\t\t[" + NumberToString((int32_t)effect.GetEffect()) + "] = { ";
-        effect_str += "intensity = " + NumberToString((int32_t)effect.GetIntensity()) + ", ";
-        effect_str += "duration = " + NumberToString((int32_t)effect.GetEffectTime()) + ", ";
-        effect_str += "elapsed_time = " + NumberToString((int32_t)effect.GetElapsedTime()) + "},";
-
-        file.WriteLine(effect_str);
+        file.BeginTable(static_cast<int32_t>(effect.GetEffect()));
+        file.WriteInt("intensity", static_cast<int32_t>(effect.GetIntensity()));
+        file.WriteInt("duration", static_cast<int32_t>(effect.GetEffectTime()));
+        file.WriteInt("elapsed_time", static_cast<int32_t>(effect.GetElapsedTime()));
+        file.EndTable(); // effect
     }
-    file.WriteLine("\n\t\t}");
+    file.EndTable(); // active_status_effects
 
-    file.WriteLine("\t},");
+    file.EndTable(); // character id
     return true;
 }
 
@@ -808,6 +781,7 @@ void GlobalCharacter::_UpdateEquipmentStatusEffects()
             }
 
             try {
+                vt_system::ScriptProfilerCall profiler_call(remove_passive_function);
                 luabind::call_function<void>(remove_passive_function, this);
             } catch(const luabind::error &e) {
                 PRINT_ERROR << "Error while loading status effect RemovePassive() function" << std::endl;
@@ -834,6 +808,7 @@ void GlobalCharacter::_UpdateEquipmentStatusEffects()
             }
 
             try {
+                vt_system::ScriptProfilerCall profiler_call(apply_passive_function);
                 luabind::call_function<void>(apply_passive_function, this, intensity);
             } catch(const luabind::error &e) {
                 PRINT_ERROR << "Error while loading status effect ApplyPassive() function" << std::endl;
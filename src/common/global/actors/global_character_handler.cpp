@@ -148,7 +148,7 @@ void CharacterHandler::ClearAllData()
     _active_party.RemoveAllCharacters();
 }
 
-bool CharacterHandler::LoadCharacters(vt_script::ReadScriptDescriptor& file)
+bool CharacterHandler::LoadCharacters(SaveGameReader& file)
 {
     // Load characters into the party in the correct order
     if (!file.OpenTable("characters")) {
@@ -200,25 +200,20 @@ bool CharacterHandler::LoadCharacters(vt_script::ReadScriptDescriptor& file)
     return true;
 }
 
-void CharacterHandler::SaveCharacters(vt_script::WriteScriptDescriptor& file)
+void CharacterHandler::SaveCharacters(SaveGameBuffer& file)
 {
-    file.InsertNewLine();
-    file.WriteLine("characters = {");
+    file.BeginTable("characters");
     // First save the order of the characters in the party
-    file.WriteLine("\t[\"order\"] = {");
-    for(uint32_t i = 0; i < _ordered_characters.size(); ++i) {
-        if(i == 0)
-            file.WriteLine("\t\t" + NumberToString(_ordered_characters[i]->GetID()), false);
-        else
-            file.WriteLine(", " + NumberToString(_ordered_characters[i]->GetID()), false);
-    }
-    file.WriteLine("\n\t},"); // order
+    std::vector<uint32_t> order;
+    for(uint32_t i = 0; i < _ordered_characters.size(); ++i)
+        order.push_back(_ordered_characters[i]->GetID());
+    file.WriteUIntVector("order", order);
 
     // Now save each individual character's data
     for(uint32_t i = 0; i < _ordered_characters.size(); ++i) {
         _ordered_characters[i]->SaveCharacter(file);
     }
-    file.WriteLine("},"); // characters
+    file.EndTable(); // characters
 }
 
 } // namespace vt_global
@@ -14,7 +14,8 @@
 #include "global_party.h"
 
 #include "script/script_read.h"
-#include "script/script_write.h"
+#include "common/global/save/save_game_reader.h"
+#include "common/global/save/save_game_writer.h"
 
 #include <map>
 
@@ -103,8 +104,8 @@ public:
     //! \brief Resets the data. Used in new games
     void ClearAllData();
 
-    bool LoadCharacters(vt_script::ReadScriptDescriptor& file);
-    void SaveCharacters(vt_script::WriteScriptDescriptor& file);
+    bool LoadCharacters(SaveGameReader& file);
+    void SaveCharacters(SaveGameBuffer& file);
 
 private:
     /** \brief A map containing all characters that the player has discovered
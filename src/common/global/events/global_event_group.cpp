@@ -16,35 +16,20 @@ namespace vt_global {
 
 extern bool GLOBAL_DEBUG;
 
-void GlobalEventGroup::AddNewEvent(const std::string &event_name, int32_t event_value)
+uint32_t GlobalEventGroup::GetEventId(const std::string &event_name) const
 {
-    if(DoesEventExist(event_name)) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "an event with the desired name \"" << event_name << "\" already existed in this group: "
-                                       << _group_name << std::endl;
-        return;
-    }
-    _events.insert(std::make_pair(event_name, event_value));
-}
-
-int32_t GlobalEventGroup::GetEvent(const std::string &event_name)
-{
-    std::map<std::string, int32_t>::iterator event_iter = _events.find(event_name);
-    if(event_iter == _events.end()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "an event with the specified name \"" << event_name << "\" did not exist in this group: "
-                                       << _group_name << std::endl;
-        return 0;
-    }
+    std::unordered_map<std::string, uint32_t>::const_iterator event_iter = _event_ids.find(event_name);
+    if(event_iter == _event_ids.end())
+        return GLOBAL_EVENT_INVALID_ID;
     return event_iter->second;
 }
 
-void GlobalEventGroup::SetEvent(const std::string &event_name, int32_t event_value)
+void GlobalEventGroup::AddEventId(const std::string &event_name, uint32_t event_id)
 {
-    std::map<std::string, int32_t>::iterator event_iter = _events.find(event_name);
-    if(event_iter == _events.end()) {
-        AddNewEvent(event_name, event_value);
-        return;
+    if(!_event_ids.insert(std::make_pair(event_name, event_id)).second) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "an event with the desired name \"" << event_name << "\" already existed in this group: "
+                                       << _group_name << std::endl;
     }
-    event_iter->second = event_value;
 }
 
 } // namespace vt_global
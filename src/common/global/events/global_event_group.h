@@ -11,14 +11,18 @@
 #ifndef __GLOBAL_EVENT_GROUP_HEADER__
 #define __GLOBAL_EVENT_GROUP_HEADER__
 
+#include <cstdint>
 #include <string>
-#include <map>
+#include <unordered_map>
 
 namespace vt_global
 {
 
+//! \brief The id returned for an unknown event.
+const uint32_t GLOBAL_EVENT_INVALID_ID = 0xFFFFFFFF;
+
 /** ****************************************************************************
-*** \brief A container that manages the occurences of several related game events
+*** \brief A container that manages the names of several related game events
 ***
 *** Events are nothing more than a string-integer pair. The string
 *** represents the name of the event while the integer takes on various meanings
@@ -29,17 +33,15 @@ namespace vt_global
 *** possible actions to take, in which the integer value would represent the
 *** option taken.
 ***
-*** Because we want to continually look-up whether or not an event has occured,
-*** it is not efficient to store all game events in a single container (the
-*** larger the number of events, the longer the event search time). Instead,
-*** this class collectively represents a group of related events. A typical
-*** event group could represent all of the events that occured on a particular
-*** map, for instance.
+*** Each event name of the group is given an id once, which is the index of its
+*** value in the GameEvents class. The ids never change during the game, so that
+*** the scripts polling events often can get them once and skip the names
+*** look up afterwards.
 ***
 *** \note Other parts of the code should not have a need to construct objects of
-*** this class. The GameGlobal class maintains a container of GlobalEventGroup
+*** this class. The GameEvents class maintains a container of GlobalEventGroup
 *** objects and provides methods to allow the creation, modification, and
-*** retrieval of these objects.
+*** retrieval of the events.
 *** ***************************************************************************/
 class GlobalEventGroup
 {
@@ -50,57 +52,34 @@ public:
 
     ~GlobalEventGroup() {}
 
-    /** \brief Queries whether or not an event of a given name exists in the group
-    *** \param event_name The name of the event to check for
-    *** \return True if the event name was found in the group, false if it was not
-    **/
-    bool DoesEventExist(const std::string &event_name) {
-        if(_events.find(event_name) != _events.end()) return true;
-        else return false;
-    }
-
-    /** \brief Adds a new event to the group
-    *** \param event_name The name of the event to add
-    *** \param event_value The value of the event to add (default value is zero)
-    *** \note If an event by the given name already exists, a warning will be printed and no addition
-    *** or modification of any kind will take place
+    /** \brief Returns the id of an event of the group
+    *** \param event_name The name of the event
+    *** \return The event id, or GLOBAL_EVENT_INVALID_ID if the name has no id yet
     **/
-    void AddNewEvent(const std::string &event_name, int32_t event_value = 0);
+    uint32_t GetEventId(const std::string &event_name) const;
 
-    /** \brief Retrieves the value of a specific event in the group
-    *** \param event_name The name of the event to retrieve
-    *** \return The value of the event, or 0 if there is no event corresponding to
-    *** the requested event named
+    /** \brief Gives an id to a new event name
+    *** \note If the event name already has an id, a warning will be printed and
+    *** the id will not be changed
     **/
-    int32_t GetEvent(const std::string &event_name);
-
-    /** \brief Sets the value for an existing event
-    *** \param event_name The name of the event whose value should be changed
-    *** \param event_value The value to set for the event.
-    *** \note If the event by the given name is not found, the event group will be created.
-    **/
-    void SetEvent(const std::string &event_name, int32_t event_value);
+    void AddEventId(const std::string &event_name, uint32_t event_id);
 
     //! \brief Returns a copy of the name of this group
     std::string GetGroupName() const {
         return _group_name;
     }
 
-    //! \brief Returns an immutable reference to the private _events container
-    const std::map<std::string, int32_t>& GetEvents() const {
-        return _events;
+    //! \brief Returns an immutable reference to the private _event_ids container
+    const std::unordered_map<std::string, uint32_t>& GetEventIds() const {
+        return _event_ids;
     }
 
 private:
     //! \brief The name given to this group of events
     std::string _group_name;
 
-    /** \brief The map container for all the events in the group
-    *** The string is the name of the event, which is unique within the group. The integer value
-    *** represents the event's state and can take on multiple meanings depending on the context
-    *** of this specific event.
-    **/
-    std::map<std::string, int32_t> _events;
+    //! \brief The id of each event name of the group.
+    std::unordered_map<std::string, uint32_t> _event_ids;
 }; // class GlobalEventGroup
 
 } // namespace vt_global
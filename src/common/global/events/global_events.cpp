@@ -10,6 +10,8 @@
 
 #include "global_events.h"
 
+#include <map>
+
 using namespace vt_utils;
 using namespace vt_script;
 
@@ -22,50 +24,23 @@ GameEvents::GameEvents()
 
 GameEvents::~GameEvents()
 {
-    Clear();
-}
-
-void GameEvents::Clear()
-{
-    // Delete all event groups
-    for(std::map<std::string, GlobalEventGroup *>::iterator it = _event_groups.begin(); it != _event_groups.end(); ++it) {
+    for(std::unordered_map<std::string, GlobalEventGroup *>::iterator it = _event_groups.begin(); it != _event_groups.end(); ++it) {
         delete(it->second);
     }
     _event_groups.clear();
 }
 
-bool GameEvents::DoesEventExist(const std::string& group_name, const std::string& event_name) const
-{
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end())
-        return false;
-
-    std::map<std::string, int32_t>::const_iterator event_iter = group_iter->second->GetEvents().find(event_name);
-    if(event_iter == group_iter->second->GetEvents().end())
-        return false;
-
-    return true;
-}
-
-int32_t GameEvents::GetEventValue(const std::string& group_name, const std::string& event_name) const
+void GameEvents::Clear()
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end())
-        return 0;
-
-    std::map<std::string, int32_t>::const_iterator event_iter = group_iter->second->GetEvents().find(event_name);
-    if(event_iter == group_iter->second->GetEvents().end())
-        return 0;
-
-    return event_iter->second;
+    // Only the values are reset, so that the event ids given to the scripts stay valid.
+    for(uint32_t i = 0; i < _events.size(); ++i)
+        _events[i] = GlobalEvent();
 }
 
-void GameEvents::SetEventValue(const std::string& group_name,
-                               const std::string& event_name,
-                               int32_t event_value)
+uint32_t GameEvents::GetEventId(const std::string& group_name, const std::string& event_name)
 {
     GlobalEventGroup* geg = nullptr;
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
+    std::unordered_map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
     if(group_iter == _event_groups.end()) {
         geg = new GlobalEventGroup(group_name);
         _event_groups.insert(std::make_pair(group_name, geg));
@@ -73,50 +48,56 @@ void GameEvents::SetEventValue(const std::string& group_name,
         geg = group_iter->second;
     }
 
-    geg->SetEvent(event_name, event_value);
+    uint32_t event_id = geg->GetEventId(event_name);
+    if(event_id == GLOBAL_EVENT_INVALID_ID) {
+        event_id = _events.size();
+        _events.push_back(GlobalEvent());
+        geg->AddEventId(event_name, event_id);
+    }
+    return event_id;
 }
 
-void GameEvents::SaveEvents(WriteScriptDescriptor& file)
+void GameEvents::SetEventValue(uint32_t event_id, int32_t event_value)
+{
+    if(event_id >= _events.size()) {
+        PRINT_WARNING << "Invalid event id: " << event_id << std::endl;
+        return;
+    }
+
+    _events[event_id]._value = event_value;
+    _events[event_id]._exists = true;
+}
+
+void GameEvents::SaveEvents(SaveGameBuffer& file)
 {
     if(file.IsFileOpen() == false) {
         PRINT_WARNING << "the file provided in the function argument was not open" << std::endl;
         return;
     }
 
-    file.InsertNewLine();
-    file.WriteLine("event_groups = {");
+    // Sort the groups and events by name, so that the save games content doesn't depend
+    // on the order the ids were given in. Only the events set are written.
+    std::map<std::string, std::map<std::string, int32_t> > event_groups;
     for(auto it = _event_groups.begin(); it != _event_groups.end(); ++it) {
-        GlobalEventGroup* event_group = it->second;
-
-        file.WriteLine("\t" + event_group->GetGroupName() + " = {");
-
-        uint32_t i = 0;
-        for(auto it = event_group->GetEvents().begin(); it != event_group->GetEvents().end(); ++it) {
-            if(it == event_group->GetEvents().begin())
-                file.WriteLine("\t\t", false);
-            else
-                file.WriteLine(", ", false);
-
-            // Add a new line every 4 entries for better readability and debugging
-            if ((i > 0) && !(i % 4)) {
-                file.InsertNewLine();
-                file.WriteLine("\t\t", false);
-            }
-
-            file.WriteLine("[\"" + it->first + "\"] = " + NumberToString(it->second), false);
-
-            ++i;
+        const std::unordered_map<std::string, uint32_t>& event_ids = it->second->GetEventIds();
+        for(auto event_it = event_ids.begin(); event_it != event_ids.end(); ++event_it) {
+            const GlobalEvent& event = _events[event_it->second];
+            if(event._exists)
+                event_groups[it->first][event_it->first] = event._value;
         }
-        file.WriteLine("\n\t},");
-
     }
 
-    file.WriteLine("},"); // event_groups
-    file.InsertNewLine();
-
+    file.BeginTable("event_groups");
+    for(auto it = event_groups.begin(); it != event_groups.end(); ++it) {
+        file.BeginTable(it->first);
+        for(auto event_it = it->second.begin(); event_it != it->second.end(); ++event_it)
+            file.WriteInt(event_it->first, event_it->second);
+        file.EndTable();
+    }
+    file.EndTable(); // event_groups
 }
 
-void GameEvents::LoadEvents(ReadScriptDescriptor& file)
+void GameEvents::LoadEvents(SaveGameReader& file)
 {
     if(file.IsFileOpen() == false) {
         PRINT_WARNING << "The file provided in the function argument was not open" << std::endl;
@@ -129,17 +110,14 @@ void GameEvents::LoadEvents(ReadScriptDescriptor& file)
 
     file.ReadTableKeys(group_names);
     for(uint32_t i = 0; i < group_names.size(); i++) {
-        std::string group_name = group_names[i];
-        _AddNewEventGroup(group_name);
-        // new_group is guaranteed not to be nullptr
-        GlobalEventGroup* new_group = _GetEventGroup(group_name);
+        const std::string& group_name = group_names[i];
 
         std::vector<std::string> event_names;
 
         if (file.OpenTable(group_name)) {
             file.ReadTableKeys(event_names);
             for(uint32_t i = 0; i < event_names.size(); i++) {
-                new_group->AddNewEvent(event_names[i], file.ReadInt(event_names[i]));
+                SetEventValue(group_name, event_names[i], file.ReadInt(event_names[i]));
             }
             file.CloseTable();
         }
@@ -151,26 +129,13 @@ void GameEvents::LoadEvents(ReadScriptDescriptor& file)
     file.CloseTable(); // event_groups
 }
 
-void GameEvents::_AddNewEventGroup(const std::string& group_name)
+uint32_t GameEvents::_FindEventId(const std::string& group_name, const std::string& event_name) const
 {
-    if(_DoesEventGroupExist(group_name)) {
-        PRINT_WARNING << "failed because there was already an event group that existed for "
-                      << "the requested group name: " << group_name << std::endl;
-        return;
-    }
-
-    GlobalEventGroup* geg = new GlobalEventGroup(group_name);
-    _event_groups.insert(std::make_pair(group_name, geg));
-}
+    std::unordered_map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
+    if(group_iter == _event_groups.end())
+        return GLOBAL_EVENT_INVALID_ID;
 
-GlobalEventGroup* GameEvents::_GetEventGroup(const std::string& group_name) const
-{
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
-        PRINT_WARNING << "could not find any event group by the requested name: " << group_name << std::endl;
-        return nullptr;
-    }
-    return (group_iter->second);
+    return group_iter->second->GetEventId(event_name);
 }
 
 } // namespace vt_global
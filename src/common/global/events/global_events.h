@@ -12,15 +12,32 @@
 #define __GLOBAL_EVENTS_HEADER__
 
 #include "script/script_read.h"
-#include "script/script_write.h"
+#include "common/global/save/save_game_reader.h"
+#include "common/global/save/save_game_writer.h"
 
 #include "global_event_group.h"
 
+#include <unordered_map>
+#include <vector>
+
 //! \brief All calls to global code are wrapped inside this namespace.
 namespace vt_global
 {
 
-//! \brief Handle in-game events dictionary.
+/** ****************************************************************************
+*** \brief Handle in-game events dictionary.
+***
+*** Every event is given an id, the first time its group and name are used,
+*** and the event values are stored by id. The ids are kept for the whole game,
+*** even when the events are cleared or another game is loaded, so that the
+*** scripts checking events often, like in map Update() functions, can get them
+*** once when loaded and then read the values without any name look up:
+***
+*** local event_id = GlobalManager:GetGameEvents():GetEventId("story", "event_name");
+*** if (GlobalManager:GetGameEvents():GetEventValue(event_id) == 1) then ... end
+***
+*** The functions taking the group and event names look the id up first.
+*** ***************************************************************************/
 class GameEvents
 {
 
@@ -28,22 +45,43 @@ public:
     GameEvents();
     ~GameEvents();
 
-    //! \brief Deletes all data.
+    //! \brief Deletes all event values. The event ids stay valid.
     void Clear();
 
+    /** \brief Returns the id of an event, giving it one if needed
+    *** \param group_name The name of the event group where the event is contained
+    *** \param event_name The name of the event
+    *** \return The event id, valid for the whole game, whether the event exists or not
+    **/
+    uint32_t GetEventId(const std::string& group_name, const std::string& event_name);
+
     /** \brief Determines if an event of a given name exists within a given group
     *** \param group_name The name of the event group where the event to check is contained
     *** \param event_name The name of the event to check for
     *** \return True if the event was found, or false if the event name or group name was not found
     **/
-    bool DoesEventExist(const std::string& group_name, const std::string& event_name) const;
+    bool DoesEventExist(const std::string& group_name, const std::string& event_name) const {
+        return DoesEventExist(_FindEventId(group_name, event_name));
+    }
+
+    //! \brief Determines if the event of the given id exists
+    bool DoesEventExist(uint32_t event_id) const {
+        return event_id < _events.size() && _events[event_id]._exists;
+    }
 
     /** \brief Returns the value of an event inside of a specified group
     *** \param group_name The name of the event group where the event is contained
     *** \param event_name The name of the event whose value should be retrieved
     *** \return The value of the requested event, or 0 if the event was not found
     **/
-    int32_t GetEventValue(const std::string& group_name, const std::string& event_name) const;
+    int32_t GetEventValue(const std::string& group_name, const std::string& event_name) const {
+        return GetEventValue(_FindEventId(group_name, event_name));
+    }
+
+    //! \brief Returns the value of the event of the given id, or 0 if the event was not found
+    int32_t GetEventValue(uint32_t event_id) const {
+        return event_id < _events.size() ? _events[event_id]._value : 0;
+    }
 
     /** \brief Set the value of an event inside of a specified group
     *** \param group_name The name of the event group where the event is contained
@@ -51,47 +89,48 @@ public:
     *** \return The event value.
     *** \note Events and event groups will be created when necessary.
     **/
-    void SetEventValue(const std::string& group_name, const std::string& event_name, int32_t event_value);
+    void SetEventValue(const std::string& group_name, const std::string& event_name, int32_t event_value) {
+        SetEventValue(GetEventId(group_name, event_name), event_value);
+    }
+
+    //! \brief Set the value of the event of the given id, creating the event when necessary.
+    void SetEventValue(uint32_t event_id, int32_t event_value);
 
     /** \brief A helper function to GameGlobal::SaveGame() that writes a group of event data to the saved game file
     *** \param file A reference to the open and valid file where to write the event data
     *** This method will need to be called once for each GlobalEventGroup contained by this class.
     **/
-    void SaveEvents(vt_script::WriteScriptDescriptor& file);
+    void SaveEvents(SaveGameBuffer& file);
 
     /** \brief A helper function to GameGlobal::LoadGame() that loads a group of game events from a saved game file
     *** \param file A reference to the open and valid file from where to read the event data from
     **/
-    void LoadEvents(vt_script::ReadScriptDescriptor& file);
+    void LoadEvents(SaveGameReader& file);
 
 private:
-    /** \brief Queries whether or not an event group of a given name exists
-    *** \param group_name The name of the event group to check for
-    *** \return True if the event group name was found, false if it was not
-    **/
-    bool _DoesEventGroupExist(const std::string& group_name) const {
-        return (_event_groups.find(group_name) != _event_groups.end());
-    }
+    //! \brief The value of an event.
+    struct GlobalEvent {
+        GlobalEvent():
+            _value(0),
+            _exists(false)
+        {}
 
-    /** \brief Adds a new event group for the class to manage
-    *** \param group_name The name of the new event group to add
-    *** \note If an event group  by the given name already exists, the function will abort
-    *** and not add the new event group. Otherwise, this class will automatically construct
-    *** a new event group of the given name and place it in its map of event groups.
-    **/
-    void _AddNewEventGroup(const std::string& group_name);
+        int32_t _value;
 
-    /** \brief Returns a pointer to an event group of the specified name
-    *** \param group_name The name of the event group to retreive
-    *** \return A pointer to the GlobalEventGroup that represents the event group, or nullptr if no event group
-    *** of the specified name was found.
-    **/
-    GlobalEventGroup* _GetEventGroup(const std::string& group_name) const;
+        //! \brief Whether the event was set. Its id may exist without it.
+        bool _exists;
+    };
+
+    //! \brief Returns the id of an event, or GLOBAL_EVENT_INVALID_ID if it has none yet.
+    uint32_t _FindEventId(const std::string& group_name, const std::string& event_name) const;
 
     /** \brief The container which stores all of the groups of events that have occured in the game
     *** The name of each GlobalEventGroup object serves as its key in this map data structure.
     **/
-    std::map<std::string, GlobalEventGroup*> _event_groups;
+    std::unordered_map<std::string, GlobalEventGroup*> _event_groups;
+
+    //! \brief The event values, indexed by event id.
+    std::vector<GlobalEvent> _events;
 };
 
 } // namespace vt_global
@@ -16,6 +16,9 @@
 #include "objects/global_armor.h"
 #include "objects/global_spirit.h"
 
+#include "save/save_game_header.h"
+
+#include "engine/script_cache.h"
 #include "engine/system.h"
 #include "modes/map/map_mode.h"
 
@@ -61,6 +64,9 @@ bool GameGlobal::SingletonInitialize()
 }
 
 void GameGlobal::_CloseGlobalScripts() {
+    // The definitions hold references to the scripts functions.
+    _skill_definitions.clear();
+
     // Close all persistent script files
     _global_script.CloseFile();
 
@@ -101,28 +107,35 @@ bool GameGlobal::_LoadGlobalScripts()
     if (!_inventory_handler.LoadScripts())
         return false;
 
-    if(!_weapon_skills_script.OpenFile("data/skills/weapon.lua") || !_weapon_skills_script.OpenTable("skills"))
+    if(!OpenCachedScript(_weapon_skills_script, "data/skills/weapon.lua") || !_weapon_skills_script.OpenTable("skills"))
         return false;
 
-    if(!_magic_skills_script.OpenFile("data/skills/magic.lua") || !_magic_skills_script.OpenTable("skills"))
+    if(!OpenCachedScript(_magic_skills_script, "data/skills/magic.lua") || !_magic_skills_script.OpenTable("skills"))
        return false;
 
-    if(!_special_skills_script.OpenFile("data/skills/special.lua") || !_special_skills_script.OpenTable("skills"))
+    if(!OpenCachedScript(_special_skills_script, "data/skills/special.lua") || !_special_skills_script.OpenTable("skills"))
         return false;
 
-    if(!_bare_hands_skills_script.OpenFile("data/skills/barehands.lua") || !_bare_hands_skills_script.OpenTable("skills"))
+    if(!OpenCachedScript(_bare_hands_skills_script, "data/skills/barehands.lua") || !_bare_hands_skills_script.OpenTable("skills"))
         return false;
 
-    if(!_status_effects_script.OpenFile("data/entities/status_effects/status_effects.lua") || !_status_effects_script.OpenTable("status_effects"))
+    // Read every skill definition once, rather than for each skill instance.
+    _skill_definitions.clear();
+    _LoadSkillDefinitions(_weapon_skills_script, GLOBAL_SKILL_WEAPON);
+    _LoadSkillDefinitions(_magic_skills_script, GLOBAL_SKILL_MAGIC);
+    _LoadSkillDefinitions(_special_skills_script, GLOBAL_SKILL_SPECIAL);
+    _LoadSkillDefinitions(_bare_hands_skills_script, GLOBAL_SKILL_BARE_HANDS);
+
+    if(!OpenCachedScript(_status_effects_script, "data/entities/status_effects/status_effects.lua") || !_status_effects_script.OpenTable("status_effects"))
         return false;
 
-    if(!_characters_script.OpenFile("data/entities/characters.lua") || !_characters_script.OpenTable("characters"))
+    if(!OpenCachedScript(_characters_script, "data/entities/characters.lua") || !_characters_script.OpenTable("characters"))
         return false;
 
-    if(!_enemies_script.OpenFile("data/entities/enemies.lua") || !_enemies_script.OpenTable("enemies"))
+    if(!OpenCachedScript(_enemies_script, "data/entities/enemies.lua") || !_enemies_script.OpenTable("enemies"))
         return false;
 
-    if(!_map_sprites_script.OpenFile("data/entities/map_sprites.lua") || !_map_sprites_script.OpenTable("sprites"))
+    if(!OpenCachedScript(_map_sprites_script, "data/entities/map_sprites.lua") || !_map_sprites_script.OpenTable("sprites"))
         return false;
 
     if(!_map_objects_script.OpenFile("data/entities/map_objects.lua"))
@@ -143,6 +156,53 @@ bool GameGlobal::_LoadGlobalScripts()
     return true;
 }
 
+std::shared_ptr<const GlobalSkillDefinition> GameGlobal::GetSkillDefinition(uint32_t skill_id) const
+{
+    auto it = _skill_definitions.find(skill_id);
+    if (it == _skill_definitions.end())
+        return nullptr;
+    return it->second;
+}
+
+void GameGlobal::_LoadSkillDefinitions(ReadScriptDescriptor& script, GLOBAL_SKILL type)
+{
+    // The skill type is given by the id range.
+    uint32_t min_id = 1;
+    uint32_t max_id = MAX_WEAPON_SKILL_ID;
+    switch (type) {
+    case GLOBAL_SKILL_MAGIC:
+        min_id = MAX_WEAPON_SKILL_ID + 1;
+        max_id = MAX_MAGIC_SKILL_ID;
+        break;
+    case GLOBAL_SKILL_SPECIAL:
+        min_id = MAX_MAGIC_SKILL_ID + 1;
+        max_id = MAX_SPECIAL_SKILL_ID;
+        break;
+    case GLOBAL_SKILL_BARE_HANDS:
+        min_id = MAX_SPECIAL_SKILL_ID + 1;
+        max_id = MAX_BARE_HANDS_SKILL_ID;
+        break;
+    default:
+        break;
+    }
+
+    std::vector<uint32_t> skill_ids;
+    script.ReadTableKeys(skill_ids);
+
+    for (uint32_t i = 0; i < skill_ids.size(); ++i) {
+        uint32_t skill_id = skill_ids[i];
+        if (skill_id < min_id || skill_id > max_id) {
+            PRINT_WARNING << "Skill id out of its type range in: " << script.GetFilename()
+                          << ", id: " << skill_id << std::endl;
+            continue;
+        }
+
+        std::shared_ptr<GlobalSkillDefinition> definition = std::make_shared<GlobalSkillDefinition>();
+        if (definition->Load(script, skill_id, type))
+            _skill_definitions[skill_id] = definition;
+    }
+}
+
 void GameGlobal::ClearAllData()
 {
     _inventory_handler.ClearAllData();
@@ -222,20 +282,17 @@ bool GameGlobal::SaveGame(const std::string& filename,
     if (slot_id >= SystemManager->GetGameSaveSlots())
         return false;
 
-    WriteScriptDescriptor file;
-    if(file.OpenFile(filename) == false) {
-        return false;
-    }
+    // The save game is built in memory, and written to the disk in the background.
+    SaveGameBuffer file(filename);
 
     // Open the save_game1 table
-    file.WriteLine("save_game1 = {");
+    file.BeginTable("save_game1");
 
     // Save simple play data
-    file.InsertNewLine();
-    file.WriteLine("play_hours = " + NumberToString(SystemManager->GetPlayHours()) + ",");
-    file.WriteLine("play_minutes = " + NumberToString(SystemManager->GetPlayMinutes()) + ",");
-    file.WriteLine("play_seconds = " + NumberToString(SystemManager->GetPlaySeconds()) + ",");
-    file.WriteLine("drunes = " + NumberToString(_drunes) + ",");
+    file.WriteUInt("play_hours", SystemManager->GetPlayHours());
+    file.WriteUInt("play_minutes", SystemManager->GetPlayMinutes());
+    file.WriteUInt("play_seconds", SystemManager->GetPlaySeconds());
+    file.WriteUInt("drunes", _drunes);
 
     _map_data_handler.Save(file, x_position, y_position);
 
@@ -251,16 +308,40 @@ bool GameGlobal::SaveGame(const std::string& filename,
 
     _shop_data_handler.SaveShopData(file);
 
-    if(file.IsErrorDetected()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "One or more errors occurred while writing the save game file - they are listed below:" << std::endl
-            << file.GetErrorMessages() << std::endl;
-        file.ClearErrors();
+    file.EndTable(); // save_game1
+
+    // Write the data shown in the save menu separately, so that it can be read quickly.
+    SaveGameHeader header;
+    header._play_hours = SystemManager->GetPlayHours();
+    header._play_minutes = SystemManager->GetPlayMinutes();
+    header._play_seconds = SystemManager->GetPlaySeconds();
+    header._drunes = _drunes;
+    header._map_data_filename = _map_data_handler.GetMapDataFilename();
+    header._map_script_filename = _map_data_handler.GetMapScriptFilename();
+    header._map_name = _map_data_handler.GetMapName();
+    header._map_image_filename = _map_data_handler.GetMapImage().GetFilename();
+
+    const std::vector<GlobalCharacter*>& characters = *_character_handler.GetOrderedCharacters();
+    for (uint32_t i = 0; i < characters.size() && i < SAVE_HEADER_CHARACTERS; ++i) {
+        SaveGameHeaderCharacter character;
+        character._id = characters[i]->GetID();
+        character._experience_level = characters[i]->GetExperienceLevel();
+        character._total_experience_points = characters[i]->GetTotalExperiencePoints();
+        character._unspent_experience_points = characters[i]->GetUnspentExperiencePoints();
+        character._experience_points_next = characters[i]->GetExperienceForNextLevel();
+        character._max_hit_points = characters[i]->GetMaxHitPoints();
+        character._hit_points = characters[i]->GetHitPoints();
+        character._max_skill_points = characters[i]->GetMaxSkillPoints();
+        character._skill_points = characters[i]->GetSkillPoints();
+        header._characters.push_back(character);
     }
 
-    file.InsertNewLine();
-    file.WriteLine("} -- save_game1"); //save_game1
+    const std::string header_filename = SaveGameHeader::GetHeaderFilename(filename);
+    SaveGameBuffer header_file(header_filename);
+    header.Save(header_file);
 
-    file.CloseFile();
+    _save_writer.Write(filename, std::move(file.GetRoot()), SystemManager->GetBinarySaveGames(),
+                       header_filename, std::move(header_file.GetRoot()));
 
     // Store the game slot the game is coming from.
     _game_slot_id = slot_id;
@@ -270,7 +351,14 @@ bool GameGlobal::SaveGame(const std::string& filename,
 
 bool GameGlobal::LoadGame(const std::string &filename, uint32_t slot_id)
 {
-    ReadScriptDescriptor file;
+    // Don't read a save game still being written.
+    _save_writer.WaitForCompletion();
+
+    // The save menu trusted the header from the file size and modification time only.
+    SaveGameHeader::CheckSaveGameData(filename);
+
+    // The save game is either in the binary format or in Lua, and is read as a whole.
+    SaveGameReader file;
     if(!file.OpenFile(filename))
         return false;
 
@@ -97,9 +97,25 @@ public:
     *** \param slot_id The game slot id used for the save menu.
     *** \param positions When used in a save point, the save map tile positions are given there.
     *** \return True if the game was successfully saved, false if it was not
+    *** \note The file itself is written in the background. @see IsSaveInProgress()
     **/
     bool SaveGame(const std::string &filename, uint32_t slot_id, uint32_t x_position = 0, uint32_t y_position = 0);
 
+    //! \brief Tells whether save game files are still being written.
+    bool IsSaveInProgress() {
+        return _save_writer.IsWriting();
+    }
+
+    //! \brief Tells whether the last save game file was written successfully.
+    bool HasLastSaveSucceeded() {
+        return _save_writer.HasLastWriteSucceeded();
+    }
+
+    //! \brief Waits until every save game file is written.
+    void WaitForSaves() {
+        _save_writer.WaitForCompletion();
+    }
+
     //! \brief Attempts an autosave on the current slot, using given map and location.
     bool AutoSave(const std::string& map_data_file, const std::string& map_script_file,
                   uint32_t stamina,
@@ -139,6 +155,12 @@ public:
     //! \brief Tells whether an enemy id is existing in the enemy data.
     bool DoesEnemyExist(uint32_t enemy_id);
 
+    /** \brief Returns the shared definition of a skill.
+    *** \param skill_id The skill id.
+    *** \return The skill definition, or nullptr if there is no valid skill with that id.
+    **/
+    std::shared_ptr<const GlobalSkillDefinition> GetSkillDefinition(uint32_t skill_id) const;
+
     vt_script::ReadScriptDescriptor& GetWeaponSkillsScript() {
         return _weapon_skills_script;
     }
@@ -257,6 +279,9 @@ private:
 
     EmoteHandler _emote_handler;
 
+    //! \brief Writes the save game files without blocking the game.
+    SaveGameWriter _save_writer;
+
     //! \brief member storing all the common media files.
     GlobalMedia _global_media;
 
@@ -299,6 +324,15 @@ private:
     vt_script::ReadScriptDescriptor _map_treasures_script;
     //@}
 
+    //! \brief The definitions of all the valid skills, indexed by skill id.
+    std::map<uint32_t, std::shared_ptr<const GlobalSkillDefinition>> _skill_definitions;
+
+    /** \brief Reads all the skill definitions of a skill script.
+    *** \param script The skill script, with the skills table open.
+    *** \param type The type of the skills defined in the script.
+    **/
+    void _LoadSkillDefinitions(vt_script::ReadScriptDescriptor& script, GLOBAL_SKILL type);
+
     //! \brief Loads every persistent scripts, used at the global initialization time.
     bool _LoadGlobalScripts();
 
@@ -20,6 +20,8 @@
 #include "modes/battle/battle_target.h"
 
 #include "script/script.h"
+#include "engine/profiler.h"
+#include "engine/script_profiler.h"
 #include "engine/video/video.h"
 
 #include "global.h"
@@ -38,141 +40,93 @@ namespace vt_global
 
 //using namespace private_global;
 
-GlobalSkill::GlobalSkill(uint32_t id) :
-    _id(id),
-    _show_skill_notice(false),
-    _type(GLOBAL_SKILL_INVALID),
-    _sp_required(0),
-    _warmup_time(0),
-    _cooldown_time(0),
-    _target_type(GLOBAL_TARGET_INVALID)
+bool GlobalSkillDefinition::Load(ReadScriptDescriptor& skill_script, uint32_t id, GLOBAL_SKILL type)
 {
-    // A pointer to the skill script which will be used to load this skill
-    ReadScriptDescriptor *skill_script = nullptr;
-
-    if((_id > 0) && (_id <= MAX_WEAPON_SKILL_ID)) {
-        _type = GLOBAL_SKILL_WEAPON;
-        skill_script = &(GlobalManager->GetWeaponSkillsScript());
-    } else if((_id > MAX_WEAPON_SKILL_ID) && (_id <= MAX_MAGIC_SKILL_ID)) {
-        _type = GLOBAL_SKILL_MAGIC;
-        skill_script = &(GlobalManager->GetMagicSkillsScript());
-    } else if((_id > MAX_MAGIC_SKILL_ID) && (_id <= MAX_SPECIAL_SKILL_ID)) {
-        _type = GLOBAL_SKILL_SPECIAL;
-        skill_script = &(GlobalManager->GetSpecialSkillsScript());
-    } else if((_id > MAX_SPECIAL_SKILL_ID) && (_id <= MAX_BARE_HANDS_SKILL_ID)) {
-        _type = GLOBAL_SKILL_BARE_HANDS;
-        skill_script = &(GlobalManager->GetBareHandsSkillsScript());
-    } else {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "constructor received an invalid id argument: " << id << std::endl;
-        _id = 0; // Indicate that this skill is invalid
-        return;
-    }
-
-    // Load the skill properties from the script
-    if(!skill_script->DoesTableExist(_id)) {
-        PRINT_WARNING << "No valid data for skill in definition file: " << _id << std::endl;
-        _id = 0; // Indicate that this skill is invalid
-        return;
-    }
+    if(!skill_script.OpenTable(id))
+        return false;
 
-    skill_script->OpenTable(_id);
-    _name = MakeUnicodeString(skill_script->ReadString("name"));
-    if(skill_script->DoesStringExist("description"))
-        _description = MakeUnicodeString(skill_script->ReadString("description"));
-    if(skill_script->DoesStringExist("icon"))
-        _icon_filename = skill_script->ReadString("icon");
-    if(skill_script->DoesBoolExist("show_notice"))
-        _show_skill_notice = skill_script->ReadBool("show_notice");
-    _sp_required = skill_script->ReadUInt("sp_required");
-    _warmup_time = skill_script->ReadUInt("warmup_time");
-    _cooldown_time = skill_script->ReadUInt("cooldown_time");
-    _warmup_action_name = skill_script->ReadString("warmup_action_name");
-    _action_name = skill_script->ReadString("action_name");
-    _target_type = static_cast<GLOBAL_TARGET>(skill_script->ReadInt("target_type"));
-
-    _battle_warmup_function = skill_script->ReadFunctionPointer("BattleWarmup");
-    _battle_execute_function = skill_script->ReadFunctionPointer("BattleExecute");
-    _field_execute_function = skill_script->ReadFunctionPointer("FieldExecute");
+    _type = type;
+    _name = MakeUnicodeString(skill_script.ReadString("name"));
+    if(skill_script.DoesStringExist("description"))
+        _description = MakeUnicodeString(skill_script.ReadString("description"));
+    if(skill_script.DoesStringExist("icon"))
+        _icon_filename = skill_script.ReadString("icon");
+    if(skill_script.DoesBoolExist("show_notice"))
+        _show_skill_notice = skill_script.ReadBool("show_notice");
+    _sp_required = skill_script.ReadUInt("sp_required");
+    _warmup_time = skill_script.ReadUInt("warmup_time");
+    _cooldown_time = skill_script.ReadUInt("cooldown_time");
+    _warmup_action_name = skill_script.ReadString("warmup_action_name");
+    _action_name = skill_script.ReadString("action_name");
+    _target_type = static_cast<GLOBAL_TARGET>(skill_script.ReadInt("target_type"));
+
+    _battle_warmup_function = skill_script.ReadFunctionPointer("BattleWarmup");
+    _battle_execute_function = skill_script.ReadFunctionPointer("BattleExecute");
+    _field_execute_function = skill_script.ReadFunctionPointer("FieldExecute");
 
     // Read all the battle animation scripts linked to this skill, if any
-    if(skill_script->DoesTableExist("animation_scripts")) {
+    if(skill_script.DoesTableExist("animation_scripts")) {
         std::vector<uint32_t> characters_ids;
         _animation_scripts.clear();
-        skill_script->ReadTableKeys("animation_scripts", characters_ids);
-        skill_script->OpenTable("animation_scripts");
+        skill_script.ReadTableKeys("animation_scripts", characters_ids);
+        skill_script.OpenTable("animation_scripts");
         for(uint32_t i = 0; i < characters_ids.size(); ++i) {
-            _animation_scripts[characters_ids[i]] = skill_script->ReadString(characters_ids[i]);
+            _animation_scripts[characters_ids[i]] = skill_script.ReadString(characters_ids[i]);
         }
-        skill_script->CloseTable(); // animation_scripts table
+        skill_script.CloseTable(); // animation_scripts table
     }
 
-    skill_script->CloseTable(); // id.
-
-    if(skill_script->IsErrorDetected()) {
-        PRINT_WARNING << "One or more errors occurred while reading skill data - they are listed below:	"
-                      << std::endl << skill_script->GetErrorMessages() << std::endl;
-        _id = 0; // Indicate that this skill is invalid
+    // Read the battle effects used by the skill, if any
+    _battle_particle_effects.clear();
+    if(skill_script.DoesTableExist("battle_particle_effects"))
+        skill_script.ReadStringVector("battle_particle_effects", _battle_particle_effects);
+    _battle_animations.clear();
+    if(skill_script.DoesTableExist("battle_animations"))
+        skill_script.ReadStringVector("battle_animations", _battle_animations);
+
+    skill_script.CloseTable(); // id.
+
+    if(skill_script.IsErrorDetected()) {
+        PRINT_WARNING << "One or more errors occurred while reading skill data: " << id
+                      << " - they are listed below:" << std::endl
+                      << skill_script.GetErrorMessages() << std::endl;
+        // Don't report them again for the next definitions.
+        skill_script.ClearErrors();
+        return false;
     }
+    return true;
 }
 
-GlobalSkill::GlobalSkill(const GlobalSkill& copy):
-    _icon_filename(copy._icon_filename),
-    _show_skill_notice(false),
-    _warmup_action_name(copy._warmup_action_name),
-    _action_name(copy._action_name),
-    _animation_scripts(copy._animation_scripts)
+GlobalSkill::GlobalSkill(uint32_t id) :
+    _id(id)
 {
-    _name = copy._name;
-    _description = copy._description;
-    _id = copy._id;
-    _type = copy._type;
-    _sp_required = copy._sp_required;
-    _warmup_time = copy._warmup_time;
-    _cooldown_time = copy._cooldown_time;
-    _target_type = copy._target_type;
-
-    // Make copies of valid luabind::object function pointers
-    _battle_warmup_function = copy._battle_warmup_function;
-    _battle_execute_function = copy._battle_execute_function;
-    _field_execute_function = copy._field_execute_function;
-}
+    if(_id == 0 || _id > MAX_BARE_HANDS_SKILL_ID) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "constructor received an invalid id argument: " << id << std::endl;
+        _id = 0; // Indicate that this skill is invalid
+    } else {
+        _definition = GlobalManager->GetSkillDefinition(_id);
+        if(_definition == nullptr) {
+            PRINT_WARNING << "No valid data for skill in definition file: " << _id << std::endl;
+            _id = 0; // Indicate that this skill is invalid
+        }
+    }
 
-GlobalSkill &GlobalSkill::operator=(const GlobalSkill& copy)
-{
-    if(this == &copy)  // Handle self-assignment case
-        return *this;
-
-    _name = copy._name;
-    _description = copy._description;
-    _icon_filename = copy._icon_filename;
-    _id = copy._id;
-    _show_skill_notice = copy._show_skill_notice;
-    _type = copy._type;
-    _sp_required = copy._sp_required;
-    _warmup_time = copy._warmup_time;
-    _cooldown_time = copy._cooldown_time;
-    _warmup_action_name = copy._warmup_action_name;
-    _action_name = copy._action_name;
-    _target_type = copy._target_type;
-
-    // Make copies of valid luabind::object function pointers
-    _battle_warmup_function = copy._battle_warmup_function;
-    _battle_execute_function = copy._battle_execute_function;
-    _field_execute_function = copy._field_execute_function;
-    _animation_scripts = copy._animation_scripts;
-
-    return *this;
+    // Invalid skills get empty data, so that they can still be queried.
+    if(_definition == nullptr)
+        _definition = std::make_shared<GlobalSkillDefinition>();
 }
 
 void GlobalSkill::ExecuteBattleWarmupFunction(private_battle::BattleActor* battle_actor,
                                               private_battle::BattleTarget target)
 {
-    if(!_battle_warmup_function.is_valid()) {
+    const luabind::object& battle_warmup_function = _definition->_battle_warmup_function;
+    if(!battle_warmup_function.is_valid()) {
         return;
     }
 
     try {
-        luabind::call_function<void>(_battle_warmup_function, battle_actor, target);
+        vt_system::ScriptProfilerCall profiler_call(battle_warmup_function);
+        luabind::call_function<void>(battle_warmup_function, battle_actor, target);
     } catch(const luabind::error& err) {
         ScriptManager->HandleLuaError(err);
     } catch(const luabind::cast_failed& e) {
@@ -183,13 +137,17 @@ void GlobalSkill::ExecuteBattleWarmupFunction(private_battle::BattleActor* battl
 bool GlobalSkill::ExecuteBattleFunction(private_battle::BattleActor* battle_actor,
                                         private_battle::BattleTarget target)
 {
-    if(!_battle_execute_function.is_valid()) {
+    vt_system::ProfilerZone zone("GlobalSkill::ExecuteBattleFunction");
+
+    const luabind::object& battle_execute_function = _definition->_battle_execute_function;
+    if(!battle_execute_function.is_valid()) {
         IF_PRINT_WARNING(BATTLE_DEBUG) << "Can't execute invalid battle script function." << std::endl;
         return false;
     }
 
     try {
-        luabind::call_function<void>(_battle_execute_function, battle_actor, target);
+        vt_system::ScriptProfilerCall profiler_call(battle_execute_function);
+        luabind::call_function<void>(battle_execute_function, battle_actor, target);
     } catch(const luabind::error& err) {
         ScriptManager->HandleLuaError(err);
         return false;
@@ -200,12 +158,13 @@ bool GlobalSkill::ExecuteBattleFunction(private_battle::BattleActor* battle_acto
     return true;
 }
 
-std::string GlobalSkill::GetAnimationScript(uint32_t character_id)
+std::string GlobalSkill::GetAnimationScript(uint32_t character_id) const
 {
     std::string script_file; // Empty by default
 
-    std::map<uint32_t, std::string>::const_iterator it = _animation_scripts.find(character_id);
-    if(it != _animation_scripts.end())
+    const std::map<uint32_t, std::string>& animation_scripts = _definition->_animation_scripts;
+    std::map<uint32_t, std::string>::const_iterator it = animation_scripts.find(character_id);
+    if(it != animation_scripts.end())
         script_file = it->second;
     return script_file;
 }
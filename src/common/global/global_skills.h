@@ -25,6 +25,8 @@
 #include "script/script.h"
 #include "modes/battle/objects/battle_actor.h"
 
+#include <memory>
+
 namespace vt_global
 {
 
@@ -54,6 +56,104 @@ const uint32_t MAX_SPECIAL_SKILL_ID    = 30000;
 const uint32_t MAX_BARE_HANDS_SKILL_ID = 40000;
 //@}
 
+/** ****************************************************************************
+*** \brief The data shared by every instance of a given skill
+***
+*** Skill definitions are read once from the skill scripts when the global scripts
+*** are loaded, and are never modified afterwards.
+*** \see GameGlobal::GetSkillDefinition()
+*** ***************************************************************************/
+struct GlobalSkillDefinition {
+    GlobalSkillDefinition() :
+        _show_skill_notice(false),
+        _type(GLOBAL_SKILL_INVALID),
+        _sp_required(0),
+        _warmup_time(0),
+        _cooldown_time(0),
+        _target_type(GLOBAL_TARGET_INVALID)
+    {
+    }
+
+    //! \brief The name of the skill as it will be displayed on the screen.
+    vt_utils::ustring _name;
+
+    /** \brief A short description of what the skill does when executed
+    *** \note Not all defined skills have a description. For example, skills used only by enemies are
+    *** typically missing a description
+    **/
+    vt_utils::ustring _description;
+
+    //! \brief The potential skill icon filename
+    std::string _icon_filename;
+
+    //! \brief Whether to show a skill short notice before executing the action.
+    bool _show_skill_notice;
+
+    //! \brief The type identifier for the skill
+    GLOBAL_SKILL _type;
+
+    /** \brief The amount of skill points (SP) that the skill requires to be used
+    *** Zero is a valid value for this member and means that no skill points are required to use the
+    *** skill. Skills with this property are known as "innate skills".
+    **/
+    uint32_t _sp_required;
+
+    /** \brief The amount of time (in milliseconds) that must expire before a skill can be used after it is selected
+    *** When a character or enemy has selected to use the skill in a battle, this value instructs how
+    *** much time must pass before the skill may be executed. It is acceptable for this member to be zero.
+    **/
+    uint32_t _warmup_time;
+
+    /** \brief The amount of time (in milliseconds) that must expire after a skill hase been used
+    *** After a character or enemy uses a skill, this value instructs how much time must pass before
+    *** the actor who executed the skill can recover and begin recharging their battle stamina bar.
+    *** It is acceptable for this member to be zero.
+    **/
+    uint32_t _cooldown_time;
+
+    /** \brief The animation name played at warmup time, if any.
+    *** If none is given, the idle animation will be played.
+    **/
+    std::string _warmup_action_name;
+
+    /** \brief The animation name played before dealing the battle_execute_function.
+    *** When a character is ready to attack, it will first play an attack animation for instance
+    *** before dealing damage.
+    **/
+    std::string _action_name;
+
+    /** \brief The type of target for the skill
+    *** Target types include attack points, actors, and parties. This enum type is defined in global_actors.h
+    **/
+    GLOBAL_TARGET _target_type;
+
+    //! \brief A reference to the skill's prepare script function for battles
+    //! It is executed when the character is in the skill warmup time
+    luabind::object _battle_warmup_function;
+
+    //! \brief A reference to the skill's execution function for battles
+    luabind::object _battle_execute_function;
+
+    //! \brief A reference to the skill's execution function for menus
+    luabind::object _field_execute_function;
+
+    //! \brief map containing the animation scripts names linked to each characters id for the given skill.
+    std::map <uint32_t, std::string> _animation_scripts;
+
+    //! \brief The battle particle effects and animations files used by the skill and its animation scripts.
+    //! They are preloaded when a battle starts.
+    std::vector<std::string> _battle_particle_effects;
+    std::vector<std::string> _battle_animations;
+
+    /** \brief Reads the skill data from the skill table.
+    *** \param script The skill script file, with the skills table open.
+    *** \param id The skill id, used as table key.
+    *** \param type The skill type.
+    *** \return false if the table doesn't exist or if an error occurred while reading it.
+    **/
+    bool Load(vt_script::ReadScriptDescriptor& script, uint32_t id, GLOBAL_SKILL type);
+};
+
 /** ****************************************************************************
 *** \brief Represents skills that are used in the game by both characters and enemies
 ***
@@ -85,9 +185,6 @@ public:
     ~GlobalSkill()
     {}
 
-    GlobalSkill(const GlobalSkill &copy);
-    GlobalSkill &operator=(const GlobalSkill &copy);
-
     //! \brief Returns true if the skill is properly initialized and ready to be used
     bool IsValid() const {
         return (_id != 0);
@@ -95,12 +192,12 @@ public:
 
     //! \brief Returns true if the skill can be executed in battles
     bool IsExecutableInBattle() const {
-        return _battle_execute_function.is_valid();
+        return _definition->_battle_execute_function.is_valid();
     }
 
     //! \brief Returns true if the skill can be executed in menus
     bool IsExecutableInField() const {
-        return _field_execute_function.is_valid();
+        return _definition->_field_execute_function.is_valid();
     }
 
     /** \name Class member access functions
@@ -108,19 +205,19 @@ public:
     **/
     //@{
     const vt_utils::ustring& GetName() const {
-        return _name;
+        return _definition->_name;
     }
 
     const vt_utils::ustring& GetDescription() const {
-        return _description;
+        return _definition->_description;
     }
 
     const std::string& GetIconFilename() const {
-        return _icon_filename;
+        return _definition->_icon_filename;
     }
 
     bool ShouldShowSkillNotice() const {
-        return _show_skill_notice;
+        return _definition->_show_skill_notice;
     }
 
     uint32_t GetID() const {
@@ -128,38 +225,38 @@ public:
     }
 
     GLOBAL_SKILL GetType() const {
-        return _type;
+        return _definition->_type;
     }
 
     uint32_t GetSPRequired() const {
-        return _sp_required;
+        return _definition->_sp_required;
     }
 
     uint32_t GetWarmupTime() const {
-        return _warmup_time;
+        return _definition->_warmup_time;
     }
 
     uint32_t GetCooldownTime() const {
-        return _cooldown_time;
+        return _definition->_cooldown_time;
     }
 
     const std::string &GetWarmupActionName() const {
-        return _warmup_action_name;
+        return _definition->_warmup_action_name;
     }
 
     const std::string &GetActionName() const {
-        return _action_name;
+        return _definition->_action_name;
     }
 
     GLOBAL_TARGET GetTargetType() const {
-        return _target_type;
+        return _definition->_target_type;
     }
 
     /** \brief Returns a pointer to the luabind::object of the battle execution function
     *** \note This function will return nullptr if the skill is not executable in battle
     **/
     const luabind::object &GetBattleExecuteFunction() const {
-        return _battle_execute_function;
+        return _definition->_battle_execute_function;
     }
 
     //! \brief Execute the corresponding skill Warmup Battle function
@@ -174,84 +271,31 @@ public:
     *** \note This function will return nullptr if the skill is not executable in menus
     **/
     const luabind::object &GetFieldExecuteFunction() const {
-        return _field_execute_function;
+        return _definition->_field_execute_function;
     }
 
     /** \brief Tells the animation script filename linked to the skill for the given character,
     *** Or an empty value otherwise;
     **/
-    std::string GetAnimationScript(uint32_t character_id);
+    std::string GetAnimationScript(uint32_t character_id) const;
+
+    //! \brief Returns the battle particle effects files used by the skill, to preload them.
+    const std::vector<std::string>& GetBattleParticleEffects() const {
+        return _definition->_battle_particle_effects;
+    }
+
+    //! \brief Returns the battle animations files used by the skill, to preload them.
+    const std::vector<std::string>& GetBattleAnimations() const {
+        return _definition->_battle_animations;
+    }
     //@}
 
 private:
     //! \brief The unique identifier number of the skill.
     uint32_t _id;
 
-    //! \brief The name of the skill as it will be displayed on the screen.
-    vt_utils::ustring _name;
-
-    /** \brief A short description of what the skill does when executed
-    *** \note Not all defined skills have a description. For example, skills used only by enemies are
-    *** typically missing a description
-    **/
-    vt_utils::ustring _description;
-
-    //! \brief The potential skill icon filename
-    std::string _icon_filename;
-
-    //! \brief Whether to show a skill short notice before executing the action.
-    bool _show_skill_notice;
-
-    //! \brief The type identifier for the skill
-    GLOBAL_SKILL _type;
-
-    /** \brief The amount of skill points (SP) that the skill requires to be used
-    *** Zero is a valid value for this member and means that no skill points are required to use the
-    *** skill. Skills with this property are known as "innate skills".
-    **/
-    uint32_t _sp_required;
-
-    /** \brief The amount of time (in milliseconds) that must expire before a skill can be used after it is selected
-    *** When a character or enemy has selected to use the skill in a battle, this value instructs how
-    *** much time must pass before the skill may be executed. It is acceptable for this member to be zero.
-    **/
-    uint32_t _warmup_time;
-
-    /** \brief The amount of time (in milliseconds) that must expire after a skill hase been used
-    *** After a character or enemy uses a skill, this value instructs how much time must pass before
-    *** the actor who executed the skill can recover and begin recharging their battle stamina bar.
-    *** It is acceptable for this member to be zero.
-    **/
-    uint32_t _cooldown_time;
-
-    /** \brief The animation name played at warmup time, if any.
-    *** If none is given, the idle animation will be played.
-    **/
-    std::string _warmup_action_name;
-
-    /** \brief The animation name played before dealing the battle_execute_function.
-    *** When a character is ready to attack, it will first play an attack animation for instance
-    *** before dealing damage.
-    **/
-    std::string _action_name;
-
-    /** \brief The type of target for the skill
-    *** Target types include attack points, actors, and parties. This enum type is defined in global_actors.h
-    **/
-    GLOBAL_TARGET _target_type;
-
-    //! \brief A reference to the skill's prepare script function for battles
-    //! It is executed when the character is in the skill warmup time
-    luabind::object _battle_warmup_function;
-
-    //! \brief A reference to the skill's execution function for battles
-    luabind::object _battle_execute_function;
-
-    //! \brief A reference to the skill's execution function for menus
-    luabind::object _field_execute_function;
-
-    //! \brief map containing the animation scripts names linked to each characters id for the given skill.
-    std::map <uint32_t, std::string> _animation_scripts;
+    //! \brief The skill data, shared with all the other instances of the same skill.
+    std::shared_ptr<const GlobalSkillDefinition> _definition;
 }; // class GlobalSkill
 
 } // namespace vt_global
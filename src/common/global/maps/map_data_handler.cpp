@@ -47,7 +47,7 @@ void MapDataHandler::Clear()
     ClearHomeMap();
 }
 
-bool MapDataHandler::Load(vt_script::ReadScriptDescriptor& file)
+bool MapDataHandler::Load(SaveGameReader& file)
 {
     if(!file.IsFileOpen()) {
         return false;
@@ -81,7 +81,7 @@ bool MapDataHandler::Load(vt_script::ReadScriptDescriptor& file)
     return true;
 }
 
-bool MapDataHandler::Save(vt_script::WriteScriptDescriptor& file,
+bool MapDataHandler::Save(SaveGameBuffer& file,
                           uint32_t x_position,
                           uint32_t y_position)
 {
@@ -89,24 +89,22 @@ bool MapDataHandler::Save(vt_script::WriteScriptDescriptor& file,
         return false;
     }
 
-    file.InsertNewLine();
-    file.WriteLine("map_data_filename = \"" + _map_data_filename + "\",");
-    file.WriteLine("map_script_filename = \"" + _map_script_filename + "\",");
+    file.WriteString("map_data_filename", _map_data_filename);
+    file.WriteString("map_script_filename", _map_script_filename);
     //! \note Coords are in map tiles
-    file.WriteLine("location_x = " + NumberToString(x_position) + ",");
-    file.WriteLine("location_y = " + NumberToString(y_position) + ",");
-    file.WriteLine("stamina = " + NumberToString(_save_stamina) + ",");
+    file.WriteUInt("location_x", x_position);
+    file.WriteUInt("location_y", y_position);
+    file.WriteUInt("stamina", _save_stamina);
 
     // Save latest home map data, if any.
     if (_home_map.IsValid()) {
-        file.InsertNewLine();
-        file.WriteLine("home_map = {");
-        file.WriteLine("\tmap_data_filename = \"" + _home_map.GetMapDataFilename() + "\",");
-        file.WriteLine("\tmap_script_filename = \"" + _home_map.GetMapDataFilename() + "\",");
+        file.BeginTable("home_map");
+        file.WriteString("map_data_filename", _home_map.GetMapDataFilename());
+        file.WriteString("map_script_filename", _home_map.GetMapDataFilename());
         //! \note Coords are in map tiles
-        file.WriteLine("\tlocation_x = " + NumberToString(_home_map.GetMapPosition().x) + ",");
-        file.WriteLine("\tlocation_y = " + NumberToString(_home_map.GetMapPosition().y) + ",");
-        file.WriteLine("},");
+        file.WriteFloat("location_x", _home_map.GetMapPosition().x);
+        file.WriteFloat("location_y", _home_map.GetMapPosition().y);
+        file.EndTable(); // home_map
     }
     return true;
 }
@@ -13,7 +13,8 @@
 
 #include "utils/ustring.h"
 #include "script/script_read.h"
-#include "script/script_write.h"
+#include "common/global/save/save_game_reader.h"
+#include "common/global/save/save_game_writer.h"
 
 #include "modes/map/map_location.h"
 #include "engine/video/image.h"
@@ -33,10 +34,10 @@ public:
     void Clear();
 
     //! \brief Loads game map related data
-    bool Load(vt_script::ReadScriptDescriptor& file);
+    bool Load(SaveGameReader& file);
 
     //! \brief Saves map related data in file
-    bool Save(vt_script::WriteScriptDescriptor& file,
+    bool Save(SaveGameBuffer& file,
               uint32_t x_position,
               uint32_t y_position);
 
@@ -153,6 +154,15 @@ public:
         return _map_hud_name;
     }
 
+    //! \brief Sets the untranslated map hud name, written in the save games header.
+    void SetMapName(const std::string& map_name) {
+        _map_name = map_name;
+    }
+
+    const std::string& GetMapName() const {
+        return _map_name;
+    }
+
 private:
     //! \brief The map data and script filename the current party is on.
     std::string _map_data_filename;
@@ -168,6 +178,9 @@ private:
     //! \brief The graphical image which represents the current location
     vt_video::StillImage _map_image;
 
+    //! \brief The untranslated map hud name of the current location.
+    std::string _map_name;
+
     //! \brief Contains the previous "home" map location data.
     vt_map::MapLocation _home_map;
 
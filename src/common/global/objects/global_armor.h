@@ -18,6 +18,34 @@ namespace vt_global
 
 class GlobalSpirit;
 
+//! \brief The data shared by every instance of a given armor.
+struct GlobalArmorDefinition : public GlobalObjectDefinition {
+    GlobalArmorDefinition() :
+        _physical_defense(0),
+        _magical_defense(0),
+        _usable_by(0),
+        _spirit_slots_number(0)
+    {
+    }
+
+    //! \brief The amount of physical defense that the armor provides
+    uint32_t _physical_defense;
+
+    //! \brief The amount of magical defense that the armor provides against each elements
+    uint32_t _magical_defense;
+
+    /** \brief A bit-mask that determines which characters can use or equip the object
+    *** See the game character ID constants in global_actors.h for more information
+    **/
+    uint32_t _usable_by;
+
+    //! \brief The number of spirit slots available on each armor instance.
+    uint32_t _spirit_slots_number;
+
+protected:
+    void _LoadSpecificData(vt_script::ReadScriptDescriptor& script) override;
+};
+
 /** ****************************************************************************
 *** \brief Represents all types of armor that may be equipped on characters and enemies
 ***
@@ -46,15 +74,15 @@ public:
     GLOBAL_OBJECT GetObjectType() const override;
 
     uint32_t GetPhysicalDefense() const {
-        return _physical_defense;
+        return _GetDefinition()._physical_defense;
     }
 
     uint32_t GetMagicalDefense() const {
-        return _magical_defense;
+        return _GetDefinition()._magical_defense;
     }
 
     uint32_t GetUsableBy() const {
-        return _usable_by;
+        return _GetDefinition()._usable_by;
     }
 
     const std::vector<GlobalSpirit *>& GetSpiritSlots() const {
@@ -63,27 +91,21 @@ public:
 
     //! \brief Gives the list of learned skill thanks to this piece of equipment.
     const std::vector<uint32_t>& GetEquipmentSkills() const {
-        return _equipment_skills;
+        return _GetDefinition()._equipment_skills;
     }
 
 private:
-    //! \brief The amount of physical defense that the armor provides
-    uint32_t _physical_defense;
-
-    //! \brief The amount of magical defense that the armor provides against each elements
-    uint32_t _magical_defense;
-
-    /** \brief A bit-mask that determines which characters can use or equip the object
-    *** See the game character ID constants in global_actors.h for more information
-    **/
-    uint32_t _usable_by;
-
     /** \brief Sockets which may be used to place spirits on the armor
     *** Armor may have no sockets, so it is not uncommon for the size of this vector to be zero.
     *** When a socket is available but empty (has no attached spirit), the pointer at that index
     *** will be nullptr.
     **/
     std::vector<GlobalSpirit *> _spirit_slots;
+
+    //! \brief Returns the armor data.
+    const GlobalArmorDefinition& _GetDefinition() const {
+        return static_cast<const GlobalArmorDefinition&>(*_definition);
+    }
 }; // class GlobalArmor : public GlobalObject
 
 } // namespace vt_global
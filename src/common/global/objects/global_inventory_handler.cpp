@@ -10,6 +10,8 @@
 
 #include "global_inventory_handler.h"
 
+#include "engine/script_cache.h"
+
 #include "script/script_read.h"
 
 using namespace vt_script;
@@ -25,32 +27,45 @@ InventoryHandler::~InventoryHandler()
 bool InventoryHandler::LoadScripts()
 {
     // Open up the persistent script files
-    if(!_items_script.OpenFile("data/inventory/items.lua") || !_items_script.OpenTable("items"))
+    if(!OpenCachedScript(_items_script, "data/inventory/items.lua") || !_items_script.OpenTable("items"))
         return false;
 
-    if(!_weapons_script.OpenFile("data/inventory/weapons.lua") || !_weapons_script.OpenTable("weapons"))
+    if(!OpenCachedScript(_weapons_script, "data/inventory/weapons.lua") || !_weapons_script.OpenTable("weapons"))
         return false;
 
-    if(!_head_armor_script.OpenFile("data/inventory/head_armor.lua") || !_head_armor_script.OpenTable("armor"))
+    if(!OpenCachedScript(_head_armor_script, "data/inventory/head_armor.lua") || !_head_armor_script.OpenTable("armor"))
         return false;
 
-    if(!_torso_armor_script.OpenFile("data/inventory/torso_armor.lua") || !_torso_armor_script.OpenTable("armor"))
+    if(!OpenCachedScript(_torso_armor_script, "data/inventory/torso_armor.lua") || !_torso_armor_script.OpenTable("armor"))
         return false;
 
-    if(!_arm_armor_script.OpenFile("data/inventory/arm_armor.lua") || !_arm_armor_script.OpenTable("armor"))
+    if(!OpenCachedScript(_arm_armor_script, "data/inventory/arm_armor.lua") || !_arm_armor_script.OpenTable("armor"))
         return false;
 
-    if(!_leg_armor_script.OpenFile("data/inventory/leg_armor.lua") || !_leg_armor_script.OpenTable("armor"))
+    if(!OpenCachedScript(_leg_armor_script, "data/inventory/leg_armor.lua") || !_leg_armor_script.OpenTable("armor"))
         return false;
 
-    if(!_spirits_script.OpenFile("data/inventory/spirits.lua") || !_spirits_script.OpenTable("spirits"))
+    if(!OpenCachedScript(_spirits_script, "data/inventory/spirits.lua") || !_spirits_script.OpenTable("spirits"))
         return false;
 
+    // Read every object definition once, rather than for each object instance.
+    _object_definitions.clear();
+    _LoadObjectDefinitions<GlobalItemDefinition>(_items_script, GLOBAL_OBJECT_ITEM);
+    _LoadObjectDefinitions<GlobalWeaponDefinition>(_weapons_script, GLOBAL_OBJECT_WEAPON);
+    _LoadObjectDefinitions<GlobalArmorDefinition>(_head_armor_script, GLOBAL_OBJECT_HEAD_ARMOR);
+    _LoadObjectDefinitions<GlobalArmorDefinition>(_torso_armor_script, GLOBAL_OBJECT_TORSO_ARMOR);
+    _LoadObjectDefinitions<GlobalArmorDefinition>(_arm_armor_script, GLOBAL_OBJECT_ARM_ARMOR);
+    _LoadObjectDefinitions<GlobalArmorDefinition>(_leg_armor_script, GLOBAL_OBJECT_LEG_ARMOR);
+    _LoadObjectDefinitions<GlobalObjectDefinition>(_spirits_script, GLOBAL_OBJECT_SPIRIT);
+
     return true;
 }
 
 void InventoryHandler::CloseScripts()
 {
+    // The definitions hold references to the scripts functions.
+    _object_definitions.clear();
+
     // Close all persistent script files
     _items_script.CloseTable();
     _items_script.CloseFile();
@@ -87,6 +102,42 @@ void InventoryHandler::ClearAllData()
     _inventory_key_items.clear();
 }
 
+std::shared_ptr<const GlobalItemDefinition> InventoryHandler::GetItemDefinition(uint32_t id) const
+{
+    if ((id == 0 || id > MAX_ITEM_ID) && (id <= MAX_SPIRIT_ID || id > MAX_KEY_ITEM_ID))
+        return nullptr;
+    return std::static_pointer_cast<const GlobalItemDefinition>(_GetObjectDefinition(id));
+}
+
+std::shared_ptr<const GlobalWeaponDefinition> InventoryHandler::GetWeaponDefinition(uint32_t id) const
+{
+    if (id <= MAX_ITEM_ID || id > MAX_WEAPON_ID)
+        return nullptr;
+    return std::static_pointer_cast<const GlobalWeaponDefinition>(_GetObjectDefinition(id));
+}
+
+std::shared_ptr<const GlobalArmorDefinition> InventoryHandler::GetArmorDefinition(uint32_t id) const
+{
+    if (id <= MAX_WEAPON_ID || id > MAX_LEG_ARMOR_ID)
+        return nullptr;
+    return std::static_pointer_cast<const GlobalArmorDefinition>(_GetObjectDefinition(id));
+}
+
+std::shared_ptr<const GlobalObjectDefinition> InventoryHandler::GetSpiritDefinition(uint32_t id) const
+{
+    if (id <= MAX_LEG_ARMOR_ID || id > MAX_SPIRIT_ID)
+        return nullptr;
+    return _GetObjectDefinition(id);
+}
+
+std::shared_ptr<const GlobalObjectDefinition> InventoryHandler::_GetObjectDefinition(uint32_t id) const
+{
+    auto it = _object_definitions.find(id);
+    if (it == _object_definitions.end())
+        return nullptr;
+    return it->second;
+}
+
 std::vector<std::shared_ptr<GlobalArmor>>& InventoryHandler::GetInventoryArmors(GLOBAL_OBJECT object_type)
 {
     switch(object_type) {
@@ -352,7 +403,7 @@ void InventoryHandler::DecrementItemCount(uint32_t obj_id, uint32_t count)
         RemoveFromInventory(obj_id);
 }
 
-void InventoryHandler::SaveInventory(vt_script::WriteScriptDescriptor& file)
+void InventoryHandler::SaveInventory(SaveGameBuffer& file)
 {
     // Save the inventory (object id + object count pairs)
     // NOTE: This does not save any weapons/armor that are equipped on the characters. That data
@@ -366,7 +417,7 @@ void InventoryHandler::SaveInventory(vt_script::WriteScriptDescriptor& file)
     _SaveInventory(file, "spirits", _inventory_spirits);
 }
 
-void InventoryHandler::LoadInventory(vt_script::ReadScriptDescriptor& file)
+void InventoryHandler::LoadInventory(SaveGameReader& file)
 {
     ClearAllData();
 
@@ -379,7 +430,7 @@ void InventoryHandler::LoadInventory(vt_script::ReadScriptDescriptor& file)
     _LoadInventory(file, "spirits");
 }
 
-void InventoryHandler::_LoadInventory(ReadScriptDescriptor& file, const std::string& category_name)
+void InventoryHandler::_LoadInventory(SaveGameReader& file, const std::string& category_name)
 {
     if(file.IsFileOpen() == false) {
         PRINT_WARNING << "the file provided in the function argument was not open" << std::endl;
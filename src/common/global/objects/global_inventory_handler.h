@@ -16,7 +16,8 @@
 #include "global_spirit.h"
 #include "global_weapon.h"
 
-#include "script/script_write.h"
+#include "common/global/save/save_game_reader.h"
+#include "common/global/save/save_game_writer.h"
 
 namespace vt_global
 {
@@ -29,7 +30,9 @@ public:
 
     ~InventoryHandler();
 
-    //! \brief Handles lua script loading. This provides access to the lua data.
+    /** \brief Handles lua script loading. This provides access to the lua data.
+    *** The object definitions are read once there, and shared by all the object instances.
+    **/
     bool LoadScripts();
     void CloseScripts();
 
@@ -108,8 +111,8 @@ public:
         return (_inventory.find(id) != _inventory.end()) ? _inventory.at(id)->GetCount() : 0;
     }
 
-    void LoadInventory(vt_script::ReadScriptDescriptor& file);
-    void SaveInventory(vt_script::WriteScriptDescriptor& file);
+    void LoadInventory(SaveGameReader& file);
+    void SaveInventory(SaveGameBuffer& file);
 
     std::map<uint32_t, std::shared_ptr<GlobalObject>>& GetInventory() {
         return _inventory;
@@ -134,6 +137,15 @@ public:
         return _inventory_key_items;
     }
 
+    /** \brief Returns the shared definition of an object.
+    *** \param id The object id.
+    *** \return The object definition, or nullptr if there is no valid object with that id and type.
+    **/
+    std::shared_ptr<const GlobalItemDefinition> GetItemDefinition(uint32_t id) const;
+    std::shared_ptr<const GlobalWeaponDefinition> GetWeaponDefinition(uint32_t id) const;
+    std::shared_ptr<const GlobalArmorDefinition> GetArmorDefinition(uint32_t id) const;
+    std::shared_ptr<const GlobalObjectDefinition> GetSpiritDefinition(uint32_t id) const;
+
     vt_script::ReadScriptDescriptor &GetItemsScript() {
         return _items_script;
     }
@@ -210,6 +222,19 @@ private:
     //! \brief Contains data definitions for all spirits
     vt_script::ReadScriptDescriptor _spirits_script;
 
+    //! \brief The definitions of all the valid objects, indexed by object id.
+    std::map<uint32_t, std::shared_ptr<const GlobalObjectDefinition>> _object_definitions;
+
+    /** \brief Reads all the object definitions of an object script.
+    *** \param script The object script, with the table containing the object definitions open.
+    *** \param type The object type of the script. The ids out of its range are rejected.
+    *** \note The class type T must be a derived struct of GlobalObjectDefinition
+    **/
+    template <class T> void _LoadObjectDefinitions(vt_script::ReadScriptDescriptor& script, GLOBAL_OBJECT type);
+
+    //! \brief Returns the definition of an object, or nullptr if it doesn't exist.
+    std::shared_ptr<const GlobalObjectDefinition> _GetObjectDefinition(uint32_t id) const;
+
     /** \brief A helper template function that finds and removes an object from the inventory
     *** \param obj_id The ID of the object to remove from the inventory
     *** \param inv The vector container of the appropriate inventory type
@@ -230,7 +255,7 @@ private:
     *** \param inv A reference to the inventory vector to store
     *** \note The class type T must be a derived class of GlobalObject
     **/
-    template <class T> void _SaveInventory(vt_script::WriteScriptDescriptor& file,
+    template <class T> void _SaveInventory(SaveGameBuffer& file,
                                            const std::string& category_name,
                                            const std::vector<std::shared_ptr<T>>& inv);
 
@@ -238,10 +263,30 @@ private:
     *** \param file A reference to the open and valid file from where to read the inventory list
     *** \param category_name The name of the table in the file that should contain the inventory for a specific category
     **/
-    void _LoadInventory(vt_script::ReadScriptDescriptor& file, const std::string& category_name);
+    void _LoadInventory(SaveGameReader& file, const std::string& category_name);
 
 };
 
+template <class T> void InventoryHandler::_LoadObjectDefinitions(vt_script::ReadScriptDescriptor& script,
+                                                                  GLOBAL_OBJECT type)
+{
+    std::vector<uint32_t> object_ids;
+    script.ReadTableKeys(object_ids);
+
+    for (uint32_t i = 0; i < object_ids.size(); ++i) {
+        // The typed definition getters rely on the id range.
+        if (GetObjectTypeFromID(object_ids[i]) != type) {
+            PRINT_WARNING << "Object id out of its type range in: " << script.GetFilename()
+                          << ", id: " << object_ids[i] << std::endl;
+            continue;
+        }
+
+        std::shared_ptr<T> definition = std::make_shared<T>();
+        if (definition->Load(script, object_ids[i]))
+            _object_definitions[object_ids[i]] = definition;
+    }
+}
+
 template <class T> bool InventoryHandler::_RemoveFromInventory(uint32_t obj_id,
                                                                std::vector<std::shared_ptr<T>>& inv)
 {
@@ -272,7 +317,7 @@ template <class T> std::shared_ptr<T> InventoryHandler::_GetFromInventory(uint32
     return nullptr;
 }
 
-template <class T> void InventoryHandler::_SaveInventory(vt_script::WriteScriptDescriptor& file,
+template <class T> void InventoryHandler::_SaveInventory(SaveGameBuffer& file,
                                                          const std::string& category_name,
                                                          const std::vector<std::shared_ptr<T>>& inv)
 {
@@ -281,31 +326,15 @@ template <class T> void InventoryHandler::_SaveInventory(vt_script::WriteScriptD
         return;
     }
 
-    file.InsertNewLine();
-    file.WriteLine(category_name + " = {");
-
+    file.BeginTable(category_name);
     for (uint32_t i = 0; i < inv.size(); i++) {
         // Don't save inventory items with 0 count
         if (inv[i]->GetCount() == 0)
             continue;
 
-        if (i == 0)
-            file.WriteLine("\t", false);
-        else
-            file.WriteLine(", ", false);
-
-        // Add a new line every 10 entries for better readability and debugging
-        if ((i > 0) && !(i % 10)) {
-            file.InsertNewLine();
-            file.WriteLine("\t", false);
-        }
-
-        file.WriteLine("[" + vt_utils::NumberToString(inv[i]->GetID()) + "] = " +
-                       vt_utils::NumberToString(inv[i]->GetCount()), false);
+        file.WriteUInt(inv[i]->GetID(), inv[i]->GetCount());
     }
-
-    file.InsertNewLine();
-    file.WriteLine("},");
+    file.EndTable();
 }
 
 } // namespace vt_global
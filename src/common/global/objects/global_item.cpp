@@ -17,29 +17,8 @@ using namespace vt_script;
 namespace vt_global
 {
 
-GlobalItem::GlobalItem(uint32_t id, uint32_t count) :
-    GlobalObject(id, count),
-    _target_type(GLOBAL_TARGET_INVALID),
-    _warmup_time(0),
-    _cooldown_time(0)
+void GlobalItemDefinition::_LoadSpecificData(ReadScriptDescriptor& script_file)
 {
-    if(_id == 0 || (_id > MAX_ITEM_ID && (_id <= MAX_SPIRIT_ID && _id > MAX_KEY_ITEM_ID))) {
-        PRINT_WARNING << "invalid id in constructor: " << _id << std::endl;
-        _InvalidateObject();
-        return;
-    }
-
-    ReadScriptDescriptor& script_file = GlobalManager->GetInventoryHandler().GetItemsScript();
-    if(script_file.DoesTableExist(_id) == false) {
-        PRINT_WARNING << "no valid data for item in definition file: " << _id << std::endl;
-        _InvalidateObject();
-        return;
-    }
-
-    // Load the item data from the script
-    script_file.OpenTable(_id);
-    _LoadObjectData(script_file);
-
     _target_type = static_cast<GLOBAL_TARGET>(script_file.ReadInt("target_type"));
     _warmup_time = script_file.ReadUInt("warmup_time");
     _cooldown_time = script_file.ReadUInt("cooldown_time");
@@ -59,58 +38,36 @@ GlobalItem::GlobalItem(uint32_t id, uint32_t count) :
         }
         script_file.CloseTable(); // animation_scripts table
     }
-
-    script_file.CloseTable(); // id
-
-    if(script_file.IsErrorDetected()) {
-        PRINT_WARNING << "one or more errors occurred while reading item data - they are listed below"
-                        << std::endl << script_file.GetErrorMessages() << std::endl;
-        _InvalidateObject();
-    }
 }
 
-GlobalItem::GlobalItem(const GlobalItem &copy) :
-    GlobalObject(copy),
-    _animation_scripts(copy._animation_scripts)
+GlobalItem::GlobalItem(uint32_t id, uint32_t count) :
+    GlobalObject(id, count)
 {
-    _target_type = copy._target_type;
-    _warmup_time = copy._warmup_time;
-    _cooldown_time = copy._cooldown_time;
+    if(_id == 0 || (_id > MAX_ITEM_ID && (_id <= MAX_SPIRIT_ID && _id > MAX_KEY_ITEM_ID))) {
+        PRINT_WARNING << "invalid id in constructor: " << _id << std::endl;
+        _InvalidateObject();
+    } else {
+        _definition = GlobalManager->GetInventoryHandler().GetItemDefinition(_id);
+        if(_definition == nullptr) {
+            PRINT_WARNING << "no valid data for item in definition file: " << _id << std::endl;
+            _InvalidateObject();
+        }
+    }
 
-    // Make copies of valid luabind::object function pointers
-    _battle_warmup_function = copy._battle_warmup_function;
-    _battle_use_function = copy._battle_use_function;
-    _field_use_function = copy._field_use_function;
-    _animation_scripts = copy._animation_scripts;
+    // Invalid items get empty data, so that they can still be queried.
+    if(_definition == nullptr)
+        _definition = std::make_shared<GlobalItemDefinition>();
 }
 
 std::string GlobalItem::GetAnimationScript(uint32_t character_id) const
 {
     std::string script_file; // Empty by default
 
-    std::map<uint32_t, std::string>::const_iterator it = _animation_scripts.find(character_id);
-    if(it != _animation_scripts.end())
+    const std::map<uint32_t, std::string>& animation_scripts = _GetDefinition()._animation_scripts;
+    std::map<uint32_t, std::string>::const_iterator it = animation_scripts.find(character_id);
+    if(it != animation_scripts.end())
         script_file = it->second;
     return script_file;
 }
 
-GlobalItem& GlobalItem::operator=(const GlobalItem& copy)
-{
-    if(this == &copy)  // Handle self-assignment case
-        return *this;
-
-    GlobalObject::operator=(copy);
-    _target_type = copy._target_type;
-    _warmup_time = copy._warmup_time;
-    _cooldown_time = copy._cooldown_time;
-
-    // Make copies of valid luabind::object function pointers
-    _battle_warmup_function = copy._battle_warmup_function;
-    _battle_use_function = copy._battle_use_function;
-    _field_use_function = copy._field_use_function;
-    _animation_scripts = copy._animation_scripts;
-
-    return *this;
-}
-
 } // namespace vt_global
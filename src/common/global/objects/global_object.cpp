@@ -45,8 +45,33 @@ std::shared_ptr<GlobalObject> GlobalCreateNewObject(uint32_t id, uint32_t count)
     return new_object;
 }
 
-void GlobalObject::_LoadObjectData(vt_script::ReadScriptDescriptor &script)
+GLOBAL_OBJECT GetObjectTypeFromID(uint32_t id)
 {
+    if ((id > 0 && id <= MAX_ITEM_ID) ||
+        (id > MAX_SPIRIT_ID && id <= MAX_KEY_ITEM_ID))
+        return GLOBAL_OBJECT_ITEM;
+    else if ((id > MAX_ITEM_ID) && (id <= MAX_WEAPON_ID))
+        return GLOBAL_OBJECT_WEAPON;
+    else if ((id > MAX_WEAPON_ID) && (id <= MAX_HEAD_ARMOR_ID))
+        return GLOBAL_OBJECT_HEAD_ARMOR;
+    else if ((id > MAX_HEAD_ARMOR_ID) && (id <= MAX_TORSO_ARMOR_ID))
+        return GLOBAL_OBJECT_TORSO_ARMOR;
+    else if ((id > MAX_TORSO_ARMOR_ID) && (id <= MAX_ARM_ARMOR_ID))
+        return GLOBAL_OBJECT_ARM_ARMOR;
+    else if ((id > MAX_ARM_ARMOR_ID) && (id <= MAX_LEG_ARMOR_ID))
+        return GLOBAL_OBJECT_LEG_ARMOR;
+    else if ((id > MAX_LEG_ARMOR_ID) && (id <= MAX_SPIRIT_ID))
+        return GLOBAL_OBJECT_SPIRIT;
+
+    return GLOBAL_OBJECT_INVALID;
+}
+
+bool GlobalObjectDefinition::Load(vt_script::ReadScriptDescriptor& script, uint32_t id)
+{
+    if (!script.OpenTable(id))
+        return false;
+
+    _id = id;
     _name = vt_utils::MakeUnicodeString(script.ReadString("name"));
     _description = vt_utils::MakeUnicodeString(script.ReadString("description"));
     _price = script.ReadUInt("standard_price");
@@ -60,6 +85,20 @@ void GlobalObject::_LoadObjectData(vt_script::ReadScriptDescriptor &script)
         // try a default icon in that case
         _icon_image.Load("data/gui/battle/default_special.png");
     }
+
+    _LoadSpecificData(script);
+
+    script.CloseTable(); // id
+
+    if(script.IsErrorDetected()) {
+        PRINT_WARNING << "one or more errors occurred while reading object data: " << _id
+                      << " - they are listed below" << std::endl
+                      << script.GetErrorMessages() << std::endl;
+        // Don't report them again for the next definitions.
+        script.ClearErrors();
+        return false;
+    }
+    return true;
 }
 
 //! \brief Compares the status effect id, used to sort them.
@@ -70,7 +109,7 @@ static bool CompareStatusEffects(std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> one,
     return (status1 < status2);
 }
 
-void GlobalObject::_LoadStatusEffects(vt_script::ReadScriptDescriptor &script)
+void GlobalObjectDefinition::_LoadStatusEffects(vt_script::ReadScriptDescriptor &script)
 {
     if(!script.DoesTableExist("status_effects"))
         return;
@@ -102,7 +141,7 @@ void GlobalObject::_LoadStatusEffects(vt_script::ReadScriptDescriptor &script)
     script.CloseTable(); // status_effects
 }
 
-void GlobalObject::_LoadTradeConditions(vt_script::ReadScriptDescriptor &script)
+void GlobalObjectDefinition::_LoadTradeConditions(vt_script::ReadScriptDescriptor &script)
 {
     if(!script.DoesTableExist("trade_conditions"))
         return;
@@ -129,7 +168,7 @@ void GlobalObject::_LoadTradeConditions(vt_script::ReadScriptDescriptor &script)
     script.CloseTable(); // trade_conditions
 }
 
-void GlobalObject::_LoadEquipmentSkills(vt_script::ReadScriptDescriptor &script)
+void GlobalObjectDefinition::_LoadEquipmentSkills(vt_script::ReadScriptDescriptor &script)
 {
     _equipment_skills.clear();
     if(!script.DoesTableExist("equipment_skills"))
@@ -78,6 +78,89 @@ const uint32_t OBJECT_ID_EXCEEDS   = 80001;
 **/
 std::shared_ptr<GlobalObject> GlobalCreateNewObject(uint32_t id, uint32_t count = 1);
 
+//! \brief Returns the object type given by the id range, or GLOBAL_OBJECT_INVALID.
+GLOBAL_OBJECT GetObjectTypeFromID(uint32_t id);
+
+/** ****************************************************************************
+*** \brief The data shared by every instance of a given game object
+***
+*** Object definitions are read once from the data scripts when the inventory
+*** handler loads them, and are never modified afterwards. Object instances only
+*** keep a pointer to their definition, so that creating or copying them (for shop
+*** lists, menus, battle inventories, ...) doesn't read the scripts again.
+*** \see InventoryHandler::LoadScripts()
+*** ***************************************************************************/
+struct GlobalObjectDefinition {
+    GlobalObjectDefinition() :
+        _id(0),
+        _is_key_item(false),
+        _price(0),
+        _trade_price(0)
+    {
+    }
+
+    virtual ~GlobalObjectDefinition()
+    {
+    }
+
+    //! \brief The object identification number.
+    uint32_t _id;
+
+    //! \brief The name of the object as it would be displayed on a screen
+    vt_utils::ustring _name;
+
+    //! \brief A short description of the item to display on the screen
+    vt_utils::ustring _description;
+
+    //! \brief Tells whether an item is a key item, preventing from being consumed or sold.
+    bool _is_key_item;
+
+    //! \brief The base price of the object for purchase/sale in the game
+    uint32_t _price;
+
+    //! \brief The additional price of the object requested when trading it.
+    uint32_t _trade_price;
+
+    //! \brief The trade conditions of the item <item_id, number>
+    //! There is an exception: If the item_id is zero, the second value is the trade price.
+    std::vector<std::pair<uint32_t, uint32_t> > _trade_conditions;
+
+    //! \brief A loaded icon image of the object at its original size of 60x60 pixels
+    vt_video::StillImage _icon_image;
+
+    /** \brief Container that holds the intensity of each type of status effect of the object
+    *** Effects with an intensity of GLOBAL_INTENSITY_NEUTRAL indicate no status effect bonus
+    **/
+    std::vector<std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> > _status_effects;
+
+    //! \brief The skills that can be learned when equipping that piece of equipment.
+    std::vector<uint32_t> _equipment_skills;
+
+    /** \brief Reads the object data from the object table.
+    *** \param script The object script file, with the table containing the object definitions open.
+    *** \param id The object id, used as table key.
+    *** \return false if the table doesn't exist or if an error occurred while reading it.
+    **/
+    bool Load(vt_script::ReadScriptDescriptor& script, uint32_t id);
+
+protected:
+    /** \brief Reads the specific data of the derived definitions from the open object table.
+    *** Errors are checked by Load() once this returns.
+    **/
+    virtual void _LoadSpecificData(vt_script::ReadScriptDescriptor& /*script*/)
+    {
+    }
+
+    //! \brief Loads status effects data
+    void _LoadStatusEffects(vt_script::ReadScriptDescriptor &script);
+
+    //! \brief Loads trading conditions data
+    void _LoadTradeConditions(vt_script::ReadScriptDescriptor &script);
+
+    //! \brief Loads the object linked skills (used by equipment only)
+    void _LoadEquipmentSkills(vt_script::ReadScriptDescriptor &script);
+};
+
 /** ****************************************************************************
 *** \brief An abstract base class for representing a game object
 ***
@@ -89,9 +172,9 @@ std::shared_ptr<GlobalObject> GlobalCreateNewObject(uint32_t id, uint32_t count
 *** class object rather than having to create and managed 50 class objects, one for
 *** each potion. The _count member achieves this convenient function.
 ***
-*** A GlobalObject with an ID value of zero is considered invalid. Most of the
-*** protected members of this class can only be set by the constructors or methods
-*** of deriving classes.
+*** A GlobalObject with an ID value of zero is considered invalid. The object data
+*** itself is shared by all the instances of the same object, through their
+*** common GlobalObjectDefinition.
 ***
 *** \note The price of an object is not actually the price it is bought or sold
 *** at in the game. It is a "base price" from which all levels of buy and sell
@@ -102,19 +185,13 @@ class GlobalObject
 public:
     GlobalObject() :
         _id(0),
-        _is_key_item(false),
-        _count(0),
-        _price(0),
-        _trade_price(0)
+        _count(0)
     {
     }
 
     explicit GlobalObject(uint32_t id, uint32_t count = 1) :
         _id(id),
-        _is_key_item(false),
-        _count(count),
-        _price(0),
-        _trade_price(0)
+        _count(count)
     {
     }
 
@@ -129,7 +206,7 @@ public:
 
     //! \brief Returns true if the object is properly initialized and ready to be used
     bool IsKeyItem() const {
-        return _is_key_item;
+        return _definition->_is_key_item;
     }
 
     /** \brief Purely virtual function used to distinguish between object types
@@ -161,11 +238,11 @@ public:
     }
 
     const vt_utils::ustring &GetName() const {
-        return _name;
+        return _definition->_name;
     }
 
     const vt_utils::ustring &GetDescription() const {
-        return _description;
+        return _definition->_description;
     }
 
     void SetCount(uint32_t count) {
@@ -177,23 +254,23 @@ public:
     }
 
     uint32_t GetPrice() const {
-        return _price;
+        return _definition->_price;
     }
 
     uint32_t GetTradingPrice() const {
-        return _trade_price;
+        return _definition->_trade_price;
     }
 
     const std::vector<std::pair<uint32_t, uint32_t> >& GetTradeConditions() const {
-        return _trade_conditions;
+        return _definition->_trade_conditions;
     }
 
     const vt_video::StillImage& GetIconImage() const {
-        return _icon_image;
+        return _definition->_icon_image;
     }
 
     const std::vector<std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> >& GetStatusEffects() const {
-        return _status_effects;
+        return _definition->_status_effects;
     }
     //@}
 
@@ -203,62 +280,16 @@ protected:
     **/
     uint32_t _id;
 
-    //! \brief The name of the object as it would be displayed on a screen
-    vt_utils::ustring _name;
-
-    //! \brief A short description of the item to display on the screen
-    vt_utils::ustring _description;
-
-    //! \brief Tells whether an item is a key item, preventing from being consumed or sold.
-    bool _is_key_item;
-
     //! \brief Retains how many occurences of the object are represented by this class object instance
     uint32_t _count;
 
-    //! \brief The base price of the object for purchase/sale in the game
-    uint32_t _price;
-
-    //! \brief The additional price of the object requested when trading it.
-    uint32_t _trade_price;
-
-    //! \brief The trade conditions of the item <item_id, number>
-    //! There is an exception: If the item_id is zero, the second value is the trade price.
-    std::vector<std::pair<uint32_t, uint32_t> > _trade_conditions;
-
-    //! \brief A loaded icon image of the object at its original size of 60x60 pixels
-    vt_video::StillImage _icon_image;
-
-    /** \brief Container that holds the intensity of each type of status effect of the object
-    *** Effects with an intensity of GLOBAL_INTENSITY_NEUTRAL indicate no status effect bonus
-    **/
-    std::vector<std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> > _status_effects;
-
-    //! \brief The skills that can be learned when equipping that piece of equipment.
-    std::vector<uint32_t> _equipment_skills;
+    //! \brief The object data, shared with all the other instances of the same object.
+    std::shared_ptr<const GlobalObjectDefinition> _definition;
 
     //! \brief Causes the object to become invalid due to a loading error or other significant issue
     void _InvalidateObject() {
         _id = 0;
     }
-
-    /** \brief Reads object data from an open script file
-    *** \param script A reference to a script file that has been opened and prepared
-    ***
-    *** This method does not do any of its own error case checking. Only derived classes may call this
-    *** protected function and they are expected to have the script file successfully opened and the correct
-    *** table context prepared. This function will do nothing more but read the expected key/values of
-    *** the open table in the script file and return.
-    **/
-    void _LoadObjectData(vt_script::ReadScriptDescriptor &script);
-
-    //! \brief Loads status effects data
-    void _LoadStatusEffects(vt_script::ReadScriptDescriptor &script);
-
-    //! \brief Loads trading conditions data
-    void _LoadTradeConditions(vt_script::ReadScriptDescriptor &script);
-
-    //! \brief Loads the object linked skills (used by equipment only)
-    void _LoadEquipmentSkills(vt_script::ReadScriptDescriptor &script);
 }; // class GlobalObject
 
 } // namespace vt_global
@@ -20,26 +20,8 @@ using namespace vt_utils;
 namespace vt_global
 {
 
-GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
-    GlobalObject(id, count)
+void GlobalWeaponDefinition::_LoadSpecificData(ReadScriptDescriptor& script_file)
 {
-    if((_id <= MAX_ITEM_ID) || (_id > MAX_WEAPON_ID)) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << std::endl;
-        _InvalidateObject();
-        return;
-    }
-
-    ReadScriptDescriptor& script_file = GlobalManager->GetInventoryHandler().GetWeaponsScript();
-    if(script_file.DoesTableExist(_id) == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for weapon in definition file: " << _id << std::endl;
-        _InvalidateObject();
-        return;
-    }
-
-    // Load the weapon data from the script
-    script_file.OpenTable(_id);
-    _LoadObjectData(script_file);
-
     _LoadStatusEffects(script_file);
     _LoadEquipmentSkills(script_file);
 
@@ -48,13 +30,12 @@ GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
 
     _usable_by = script_file.ReadUInt("usable_by");
 
-    uint32_t spirits_number = script_file.ReadUInt("slots");
+    _spirit_slots_number = script_file.ReadUInt("slots");
     // Only permit a max of 5 spirits for equipment
-    if (spirits_number > 5) {
-        spirits_number = 5;
+    if (_spirit_slots_number > 5) {
+        _spirit_slots_number = 5;
         PRINT_WARNING << "More than 5 spirit slots declared in item " << _id << std::endl;
     }
-    _spirit_slots.resize(spirits_number, nullptr);
 
     // Load the possible battle ammo animated image filename.
     _ammo_animation_file = script_file.ReadString("battle_ammo_animation_file");
@@ -62,30 +43,43 @@ GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
     // Load the weapon battle animation info
     if (script_file.DoesTableExist("battle_animations"))
         _LoadWeaponBattleAnimations(script_file);
+}
 
-    script_file.CloseTable(); // id
-    if(script_file.IsErrorDetected()) {
-        if(GLOBAL_DEBUG) {
-            PRINT_WARNING << "one or more errors occurred while reading weapon data - they are listed below"
-                          << std::endl << script_file.GetErrorMessages() << std::endl;
-        }
+GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
+    GlobalObject(id, count)
+{
+    if((_id <= MAX_ITEM_ID) || (_id > MAX_WEAPON_ID)) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << std::endl;
         _InvalidateObject();
+    } else {
+        _definition = GlobalManager->GetInventoryHandler().GetWeaponDefinition(_id);
+        if(_definition == nullptr) {
+            IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for weapon in definition file: " << _id << std::endl;
+            _InvalidateObject();
+        }
     }
+
+    // Invalid weapons get empty data, so that they can still be queried.
+    if(_definition == nullptr)
+        _definition = std::make_shared<GlobalWeaponDefinition>();
+
+    _spirit_slots.resize(_GetDefinition()._spirit_slots_number, nullptr);
 }
 
-const std::string& GlobalWeapon::GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias)
+const std::string& GlobalWeapon::GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias) const
 {
-    if (_weapon_animations.find(character_id) == _weapon_animations.end())
+    const std::map<uint32_t, std::map<std::string, std::string> >& weapon_animations = _GetDefinition()._weapon_animations;
+    if (weapon_animations.find(character_id) == weapon_animations.end())
         return _empty_string;
 
-    const std::map<std::string, std::string>& char_map = _weapon_animations.at(character_id);
+    const std::map<std::string, std::string>& char_map = weapon_animations.at(character_id);
     if (char_map.find(animation_alias) == char_map.end())
         return _empty_string;
 
     return char_map.at(animation_alias);
 }
 
-void GlobalWeapon::_LoadWeaponBattleAnimations(ReadScriptDescriptor& script)
+void GlobalWeaponDefinition::_LoadWeaponBattleAnimations(ReadScriptDescriptor& script)
 {
     //std::map <uint32_t, std::map<std::string, std::string> > _weapon_animations;
     _weapon_animations.clear();
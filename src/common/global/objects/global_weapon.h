@@ -20,6 +20,45 @@ namespace vt_global
 
 class GlobalSpirit;
 
+//! \brief The data shared by every instance of a given weapon.
+struct GlobalWeaponDefinition : public GlobalObjectDefinition {
+    GlobalWeaponDefinition() :
+        _physical_attack(0),
+        _magical_attack(0),
+        _usable_by(0),
+        _spirit_slots_number(0)
+    {
+    }
+
+    //! \brief The battle image animation file used to display the weapon ammo.
+    std::string _ammo_animation_file;
+
+    //! \brief The amount of physical damage that the weapon causes
+    uint32_t _physical_attack;
+
+    //! \brief The amount of magical damage that the weapon causes for each elements.
+    uint32_t _magical_attack;
+
+    /** \brief A bit-mask that determines which characters can use or equip the object
+    *** See the game character ID constants in global_actors.h for more information
+    **/
+    uint32_t _usable_by;
+
+    //! \brief The number of spirit slots available on each weapon instance.
+    uint32_t _spirit_slots_number;
+
+    //! \brief The info about weapon animations for each global character.
+    //! map < character_id, map < animation alias, animation filename > >
+    std::map <uint32_t, std::map<std::string, std::string> > _weapon_animations;
+
+protected:
+    void _LoadSpecificData(vt_script::ReadScriptDescriptor& script) override;
+
+private:
+    //! \brief Loads the battle animations data for each character that can use the weapon.
+    void _LoadWeaponBattleAnimations(vt_script::ReadScriptDescriptor& script);
+};
+
 /** ****************************************************************************
 *** \brief Represents weapon that may be equipped by characters or enemies
 ***
@@ -51,15 +90,15 @@ public:
     //! \name Class Member Access Functions
     //@{
     uint32_t GetPhysicalAttack() const {
-        return _physical_attack;
+        return _GetDefinition()._physical_attack;
     }
 
     uint32_t GetMagicalAttack() const {
-        return _magical_attack;
+        return _GetDefinition()._magical_attack;
     }
 
     uint32_t GetUsableBy() const {
-        return _usable_by;
+        return _GetDefinition()._usable_by;
     }
 
     const std::vector<GlobalSpirit *>& GetSpiritSlots() const {
@@ -67,38 +106,20 @@ public:
     }
 
     const std::string& GetAmmoAnimationFile() const {
-        return _ammo_animation_file;
+        return _GetDefinition()._ammo_animation_file;
     }
 
     //! \brief Get the animation filename corresponding to the character weapon animation
     //! requested.
-    const std::string& GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias);
+    const std::string& GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias) const;
 
     //! \brief Gives the list of learned skill thanks to this piece of equipment.
     const std::vector<uint32_t>& GetEquipmentSkills() const {
-        return _equipment_skills;
+        return _GetDefinition()._equipment_skills;
     }
     //@}
 
 private:
-    //! \brief The battle image animation file used to display the weapon ammo.
-    std::string _ammo_animation_file;
-
-    //! \brief The amount of physical damage that the weapon causes
-    uint32_t _physical_attack;
-
-    //! \brief The amount of magical damage that the weapon causes for each elements.
-    uint32_t _magical_attack;
-
-    /** \brief A bit-mask that determines which characters can use or equip the object
-    *** See the game character ID constants in global_actors.h for more information
-    **/
-    uint32_t _usable_by;
-
-    //! \brief The info about weapon animations for each global character.
-    //! map < character_id, map < animation alias, animation filename > >
-    std::map <uint32_t, std::map<std::string, std::string> > _weapon_animations;
-
     /** \brief Spirit slots which may be used to place spirits on the weapon
     *** Weapons may have no slots, so it is not uncommon for the size of this vector to be zero.
     *** When spirit slots are available but empty (has no attached spirit), the pointer at that index
@@ -106,8 +127,10 @@ private:
     **/
     std::vector<GlobalSpirit *> _spirit_slots;
 
-    //! \brief Loads the battle animations data for each character that can use the weapon.
-    void _LoadWeaponBattleAnimations(vt_script::ReadScriptDescriptor& script);
+    //! \brief Returns the weapon data.
+    const GlobalWeaponDefinition& _GetDefinition() const {
+        return static_cast<const GlobalWeaponDefinition&>(*_definition);
+    }
 }; // class GlobalWeapon : public GlobalObject
 
 } // namespace vt_global
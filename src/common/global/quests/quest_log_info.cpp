@@ -29,6 +29,8 @@ QuestLogInfo::QuestLogInfo(const vt_utils::ustring &title,
     _completion_description(completion_description),
     _completion_event_group(completion_event_group),
     _completion_event_name(completion_event_name),
+    _completion_event_id(GLOBAL_EVENT_INVALID_ID),
+    _not_completable_event_id(GLOBAL_EVENT_INVALID_ID),
     _location_name(location_name),
     _location_subname(location_subname)
 {
@@ -14,6 +14,8 @@
 #include "utils/ustring.h"
 #include "engine/video/image.h"
 
+#include "common/global/events/global_event_group.h"
+
 namespace vt_global
 {
 
@@ -31,7 +33,9 @@ public:
                  const vt_utils::ustring& location_subname,
                  const std::string& location_subimage_filename);
 
-    QuestLogInfo()
+    QuestLogInfo():
+        _completion_event_id(GLOBAL_EVENT_INVALID_ID),
+        _not_completable_event_id(GLOBAL_EVENT_INVALID_ID)
     {}
 
     void SetNotCompletableIf(const std::string& not_completable_event_group,
@@ -55,6 +59,11 @@ public:
     std::string _not_completable_event_group;
     std::string _not_completable_event_name;
 
+    //! \brief The ids of the events above, set once the quests script is loaded.
+    //! GLOBAL_EVENT_INVALID_ID when the event isn't given.
+    uint32_t _completion_event_id;
+    uint32_t _not_completable_event_id;
+
     //! \brief location information
     vt_video::StillImage _location_image;
     vt_video::StillImage _location_subimage;
@@ -83,6 +83,14 @@ bool GameQuests::LoadQuestsScript(const std::string& quests_script_filename)
             if (quest_info.size() == 11) {
                 info.SetNotCompletableIf(quest_info[9], quest_info[10]);
             }
+
+            // Get the events ids once, so that checking the quests state doesn't look the names up.
+            GameEvents& events = GlobalManager->GetGameEvents();
+            if (!info._completion_event_group.empty() && !info._completion_event_name.empty())
+                info._completion_event_id = events.GetEventId(info._completion_event_group, info._completion_event_name);
+            if (!info._not_completable_event_group.empty() && !info._not_completable_event_name.empty())
+                info._not_completable_event_id = events.GetEventId(info._not_completable_event_group, info._not_completable_event_name);
+
             _quest_log_info[quest_id] = info;
         }
         //malformed quest log
@@ -119,7 +127,7 @@ uint32_t GameQuests::GetNumberQuestLogEntries() const
 
 const QuestLogInfo& GameQuests::GetQuestInfo(const std::string& quest_id) const
 {
-    std::map<std::string, QuestLogInfo>::const_iterator itr = _quest_log_info.find(quest_id);
+    std::unordered_map<std::string, QuestLogInfo>::const_iterator itr = _quest_log_info.find(quest_id);
     if(itr == _quest_log_info.end())
         return _empty_quest_log_info;
     return itr->second;
@@ -138,31 +146,31 @@ std::vector<QuestLogEntry *> GameQuests::GetActiveQuestIds() const
 
 bool GameQuests::IsQuestCompleted(const std::string& quest_id)
 {
-    std::map<std::string, vt_global::QuestLogInfo>::iterator it = _quest_log_info.find(quest_id);
+    std::unordered_map<std::string, vt_global::QuestLogInfo>::const_iterator it = _quest_log_info.find(quest_id);
     if (it == _quest_log_info.end())
         return false;
     const QuestLogInfo& info = it->second;
-    if (info._completion_event_group.empty() || info._completion_event_name.empty())
+    if (info._completion_event_id == GLOBAL_EVENT_INVALID_ID)
         return true;
 
     GameEvents &events = GlobalManager->GetGameEvents();
-    return (events.GetEventValue(info._completion_event_group, info._completion_event_name) == 1);
+    return (events.GetEventValue(info._completion_event_id) == 1);
 }
 
 bool GameQuests::IsQuestCompletable(const std::string& quest_id)
 {
-    std::map<std::string, vt_global::QuestLogInfo>::iterator it = _quest_log_info.find(quest_id);
+    std::unordered_map<std::string, vt_global::QuestLogInfo>::const_iterator it = _quest_log_info.find(quest_id);
     if (it == _quest_log_info.end())
         return true;
     const QuestLogInfo& info = it->second;
-    if (info._not_completable_event_group.empty() || info._not_completable_event_name.empty())
+    if (info._not_completable_event_id == GLOBAL_EVENT_INVALID_ID)
         return true;
 
     GameEvents &events = GlobalManager->GetGameEvents();
-    return (events.GetEventValue(info._not_completable_event_group, info._not_completable_event_name) == 0);
+    return (events.GetEventValue(info._not_completable_event_id) == 0);
 }
 
-void GameQuests::LoadQuests(ReadScriptDescriptor& file)
+void GameQuests::LoadQuests(SaveGameReader& file)
 {
     if(file.IsFileOpen() == false) {
         PRINT_WARNING << "The file provided in the function argument was not open" << std::endl;
@@ -204,7 +212,7 @@ void GameQuests::LoadQuests(ReadScriptDescriptor& file)
     file.CloseTable();
 }
 
-void GameQuests::SaveQuests(WriteScriptDescriptor& file)
+void GameQuests::SaveQuests(SaveGameBuffer& file)
 {
     if(file.IsFileOpen() == false)
     {
@@ -212,7 +220,7 @@ void GameQuests::SaveQuests(WriteScriptDescriptor& file)
         return;
     }
 
-    file.WriteLine("quest_log = {");
+    file.BeginTable("quest_log");
     for(auto itr = _quest_log_entries.begin(); itr != _quest_log_entries.end(); ++itr) {
 
         const QuestLogEntry* quest_log_entry = itr->second;
@@ -220,23 +228,18 @@ void GameQuests::SaveQuests(WriteScriptDescriptor& file)
         if(quest_log_entry == nullptr)
         {
             PRINT_WARNING << "SaveQuests function received a nullptr quest log entry pointer argument" << std::endl;
+            file.EndTable(); // quest_log
             return;
         }
 
-        // Start writting
-        file.WriteLine("\t" + quest_log_entry->GetQuestId() + " = {", false);
-        // Write the quest log number. this is written as a string
-        // because loading needs a uniform type of data in the array
-        file.WriteLine("\"" + NumberToString(quest_log_entry->GetQuestLogNumber()) + "\", ", false);
-        // Write the "false" or "true" string if this entry has been read or not
-        const std::string is_read(quest_log_entry->IsRead() ? "true" : "false");
-        file.WriteLine("\"" + is_read + "\"", false);
-        // End writing
-        file.WriteLine("},");
+        // Write the quest log number and whether the entry has been read.
+        // Both are written as strings because loading needs a uniform type of data in the array
+        std::vector<std::string> entry;
+        entry.push_back(NumberToString(quest_log_entry->GetQuestLogNumber()));
+        entry.push_back(quest_log_entry->IsRead() ? "true" : "false");
+        file.WriteStringVector(quest_log_entry->GetQuestId(), entry);
     }
-
-    file.WriteLine("},");
-    file.InsertNewLine();
+    file.EndTable(); // quest_log
 }
 
 bool GameQuests::_AddQuestLog(const std::string& quest_id,
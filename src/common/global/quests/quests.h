@@ -15,11 +15,13 @@
 #include "quest_log_info.h"
 
 #include "script/script_read.h"
-#include "script/script_write.h"
+#include "common/global/save/save_game_reader.h"
+#include "common/global/save/save_game_writer.h"
 
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 namespace vt_global
 {
@@ -76,12 +78,12 @@ public:
     *** based on the quest_entry_keys in the save game file
     *** \param file Reference to open and valid file set for reading the data
     **/
-    void LoadQuests(vt_script::ReadScriptDescriptor &file);
+    void LoadQuests(SaveGameReader& file);
 
     /** \brief Helper function that saves the Quest Log entries. this is called from SaveGame()
     *** \param file Reference to open and valid file set for writting the data
     **/
-    void SaveQuests(vt_script::WriteScriptDescriptor& file);
+    void SaveQuests(SaveGameBuffer& file);
 
 private:
     /** \brief The container which stores the quest log entries in the game. the quest log key
@@ -92,7 +94,7 @@ private:
     std::map<std::string, QuestLogEntry *> _quest_log_entries;
 
     //! \brief a map of the quest string ids to their info
-    std::map<std::string, QuestLogInfo> _quest_log_info;
+    std::unordered_map<std::string, QuestLogInfo> _quest_log_info;
 
     /** \brief adds a new quest log entry into the quest log entries table. also updates the quest log number
     *** \param quest_id for the quest
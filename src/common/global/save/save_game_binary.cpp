@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "save_game_binary.h"
+
+#include "save_game_data.h"
+
+#include "utils/utils_common.h"
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace vt_global
+{
+
+//! \brief The first bytes of a binary save game.
+const std::string SAVE_BINARY_MAGIC = "VTSB";
+
+//! \brief The deepest table nesting accepted, so that invalid data can't exhaust the stack.
+const uint32_t SAVE_BINARY_MAX_DEPTH = 32;
+
+typedef std::map<std::string, std::unique_ptr<SaveGameNode> > SaveGameFields;
+typedef std::map<int64_t, std::unique_ptr<SaveGameNode> > SaveGameItems;
+
+static void _WriteVarint(uint64_t value, std::string& data)
+{
+    while (value >= 0x80) {
+        data += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    data += static_cast<char>(value);
+}
+
+//! \brief Writes a signed integer, small negative values staying short.
+static void _WriteSignedVarint(int64_t value, std::string& data)
+{
+    _WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63), data);
+}
+
+//! \brief Gives every string key an index, in the order they are first met.
+static void _BuildKeyDictionary(const SaveGameNode& node, std::map<std::string, uint32_t>& dictionary,
+                                std::vector<const std::string*>& keys)
+{
+    if (!node.IsTable())
+        return;
+
+    for (SaveGameItems::const_iterator it = node.GetItems().begin(); it != node.GetItems().end(); ++it)
+        _BuildKeyDictionary(*it->second, dictionary, keys);
+
+    for (SaveGameFields::const_iterator it = node.GetFields().begin(); it != node.GetFields().end(); ++it) {
+        if (dictionary.find(it->first) == dictionary.end()) {
+            dictionary[it->first] = static_cast<uint32_t>(keys.size());
+            keys.push_back(&it->first);
+        }
+        _BuildKeyDictionary(*it->second, dictionary, keys);
+    }
+}
+
+static void _WriteValue(const SaveGameNode& node, const std::map<std::string, uint32_t>& dictionary,
+                        std::string& data)
+{
+    switch (node.GetType()) {
+    case SAVE_NODE_BOOLEAN:
+        data += static_cast<char>(node.GetBoolean() ? SAVE_BINARY_TRUE : SAVE_BINARY_FALSE);
+        break;
+    case SAVE_NODE_INTEGER:
+        data += static_cast<char>(SAVE_BINARY_INTEGER);
+        _WriteSignedVarint(node.GetInteger(), data);
+        break;
+    case SAVE_NODE_NUMBER: {
+        data += static_cast<char>(SAVE_BINARY_NUMBER);
+        double number = node.GetNumber();
+        uint64_t bits = 0;
+        memcpy(&bits, &number, sizeof(bits));
+        for (uint32_t i = 0; i < 8; ++i)
+            data += static_cast<char>((bits >> (i * 8)) & 0xFF);
+        break;
+    }
+    case SAVE_NODE_STRING:
+        data += static_cast<char>(SAVE_BINARY_STRING);
+        _WriteVarint(node.GetString().size(), data);
+        data += node.GetString();
+        break;
+    case SAVE_NODE_TABLE: {
+        // The content is written first, to know its size.
+        std::string content;
+        _WriteVarint(node.GetItems().size(), content);
+        for (SaveGameItems::const_iterator it = node.GetItems().begin(); it != node.GetItems().end(); ++it) {
+            _WriteSignedVarint(it->first, content);
+            _WriteValue(*it->second, dictionary, content);
+        }
+        _WriteVarint(node.GetFields().size(), content);
+        for (SaveGameFields::const_iterator it = node.GetFields().begin(); it != node.GetFields().end(); ++it) {
+            _WriteVarint(dictionary.find(it->first)->second, content);
+            _WriteValue(*it->second, dictionary, content);
+        }
+
+        data += static_cast<char>(SAVE_BINARY_TABLE);
+        _WriteVarint(content.size(), data);
+        data += content;
+        break;
+    }
+    }
+}
+
+bool IsBinarySaveGame(const std::string& data)
+{
+    return data.compare(0, SAVE_BINARY_MAGIC.size(), SAVE_BINARY_MAGIC) == 0;
+}
+
+void WriteBinarySaveGame(const SaveGameNode& root, std::string& data)
+{
+    std::map<std::string, uint32_t> dictionary;
+    std::vector<const std::string*> keys;
+    _BuildKeyDictionary(root, dictionary, keys);
+
+    data = SAVE_BINARY_MAGIC;
+    _WriteVarint(SAVE_BINARY_VERSION, data);
+
+    _WriteVarint(keys.size(), data);
+    for (uint32_t i = 0; i < keys.size(); ++i) {
+        _WriteVarint(keys[i]->size(), data);
+        data += *keys[i];
+    }
+
+    _WriteValue(root, dictionary, data);
+}
+
+//! \brief Reads the binary data, never going past its end.
+class BinarySaveReader
+{
+public:
+    BinarySaveReader(const std::string& data):
+        _data(data),
+        _position(0)
+    {}
+
+    bool ReadSaveGame(SaveGameNode& root) {
+        _position = SAVE_BINARY_MAGIC.size();
+
+        uint64_t version = 0;
+        if (!_ReadVarint(version) || version > SAVE_BINARY_VERSION) {
+            PRINT_WARNING << "Unsupported binary save game version: " << version << std::endl;
+            return false;
+        }
+
+        uint64_t key_count = 0;
+        if (!_ReadVarint(key_count) || key_count > _data.size())
+            return false;
+
+        _keys.resize(static_cast<size_t>(key_count));
+        for (uint32_t i = 0; i < _keys.size(); ++i) {
+            if (!_ReadString(_keys[i]))
+                return false;
+        }
+
+        uint8_t type = 0;
+        if (!_ReadByte(type) || type != SAVE_BINARY_TABLE)
+            return false;
+
+        return _ReadValue(type, root, 0) && _position == _data.size();
+    }
+
+private:
+    bool _ReadByte(uint8_t& value) {
+        if (_position >= _data.size())
+            return false;
+        value = static_cast<uint8_t>(_data[_position++]);
+        return true;
+    }
+
+    bool _ReadVarint(uint64_t& value) {
+        value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = 0;
+            if (!_ReadByte(byte))
+                return false;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool _ReadSignedVarint(int64_t& value) {
+        uint64_t encoded = 0;
+        if (!_ReadVarint(encoded))
+            return false;
+        value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+        return true;
+    }
+
+    bool _ReadString(std::string& value) {
+        uint64_t length = 0;
+        if (!_ReadVarint(length) || length > _data.size() - _position)
+            return false;
+        value.assign(_data, _position, static_cast<size_t>(length));
+        _position += static_cast<size_t>(length);
+        return true;
+    }
+
+    bool _ReadValue(uint8_t type, SaveGameNode& node, uint32_t depth) {
+        switch (type) {
+        case SAVE_BINARY_FALSE:
+        case SAVE_BINARY_TRUE:
+            node.SetBoolean(type == SAVE_BINARY_TRUE);
+            return true;
+        case SAVE_BINARY_INTEGER: {
+            int64_t integer = 0;
+            if (!_ReadSignedVarint(integer))
+                return false;
+            node.SetInteger(integer);
+            return true;
+        }
+        case SAVE_BINARY_NUMBER: {
+            if (_data.size() - _position < 8)
+                return false;
+            uint64_t bits = 0;
+            for (uint32_t i = 0; i < 8; ++i)
+                bits |= static_cast<uint64_t>(static_cast<uint8_t>(_data[_position++])) << (i * 8);
+            double number = 0.0;
+            memcpy(&number, &bits, sizeof(number));
+            node.SetNumber(number);
+            return true;
+        }
+        case SAVE_BINARY_STRING: {
+            std::string text;
+            if (!_ReadString(text))
+                return false;
+            node.SetString(text);
+            return true;
+        }
+        case SAVE_BINARY_TABLE:
+            return _ReadTable(node, depth + 1);
+        default:
+            return false;
+        }
+    }
+
+    bool _ReadTable(SaveGameNode& node, uint32_t depth) {
+        node.SetTable();
+        if (depth > SAVE_BINARY_MAX_DEPTH)
+            return false;
+
+        uint64_t size = 0;
+        if (!_ReadVarint(size) || size > _data.size() - _position)
+            return false;
+        const size_t end = _position + static_cast<size_t>(size);
+
+        uint64_t item_count = 0;
+        if (!_ReadVarint(item_count) || item_count > size)
+            return false;
+        for (uint64_t i = 0; i < item_count; ++i) {
+            int64_t key = 0;
+            uint8_t type = 0;
+            if (!_ReadSignedVarint(key) || !_ReadByte(type) || !_ReadValue(type, *node.AddItem(key), depth))
+                return false;
+        }
+
+        uint64_t field_count = 0;
+        if (!_ReadVarint(field_count) || field_count > size)
+            return false;
+        for (uint64_t i = 0; i < field_count; ++i) {
+            uint64_t key_index = 0;
+            uint8_t type = 0;
+            if (!_ReadVarint(key_index) || key_index >= _keys.size() || !_ReadByte(type)
+                    || !_ReadValue(type, *node.AddField(_keys[static_cast<size_t>(key_index)]), depth)) {
+                return false;
+            }
+        }
+
+        // The size must match the content read.
+        return _position == end;
+    }
+
+    const std::string& _data;
+
+    //! \brief The next byte to read.
+    size_t _position;
+
+    //! \brief The key dictionary.
+    std::vector<std::string> _keys;
+};
+
+bool ReadBinarySaveGame(const std::string& data, SaveGameNode& root)
+{
+    if (!IsBinarySaveGame(data))
+        return false;
+
+    BinarySaveReader reader(data);
+    return reader.ReadSaveGame(root);
+}
+
+} // namespace vt_global
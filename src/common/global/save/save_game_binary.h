@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** The binary save game format
+***
+*** It stores the same tables as the Lua save games, but can be read without
+*** compiling and running any Lua code:
+***
+*** - The "VTSB" magic, followed by the format version, as a varint.
+*** - The key dictionary: the number of keys, then each table string key once,
+***   as a varint length followed by the characters.
+*** - The root table, holding the save game global tables.
+***
+*** Each value starts with its type byte (SAVE_BINARY_VALUE_TYPE):
+*** - Booleans have no content.
+*** - Integers are zigzag encoded varints, and other numbers 8 little endian bytes.
+*** - Strings are a varint length followed by the characters.
+*** - Tables are the varint byte size of their content, so that a whole section
+***   can be skipped, followed by the number of integer keys and those entries,
+***   then the number of string keys and those entries. Integer keys are zigzag
+***   varints and string keys the varint index of the key in the dictionary.
+***
+*** The version is increased whenever the format changes, and the files written
+*** by a newer version are refused.
+*** ***************************************************************************/
+
+#ifndef __SAVE_GAME_BINARY_HEADER__
+#define __SAVE_GAME_BINARY_HEADER__
+
+#include <cstdint>
+#include <string>
+
+namespace vt_global
+{
+
+class SaveGameNode;
+
+//! \brief The binary save game format version written.
+const uint32_t SAVE_BINARY_VERSION = 1;
+
+//! \brief The value types of the binary save game format.
+enum SAVE_BINARY_VALUE_TYPE {
+    SAVE_BINARY_FALSE   = 0,
+    SAVE_BINARY_TRUE    = 1,
+    SAVE_BINARY_INTEGER = 2,
+    SAVE_BINARY_NUMBER  = 3,
+    SAVE_BINARY_STRING  = 4,
+    SAVE_BINARY_TABLE   = 5
+};
+
+//! \brief Tells whether the given file content is a binary save game.
+bool IsBinarySaveGame(const std::string& data);
+
+//! \brief Writes the save game global tables in the binary format.
+void WriteBinarySaveGame(const SaveGameNode& root, std::string& data);
+
+/** \brief Reads a binary save game.
+*** \return false if the data is invalid, truncated, or written by a newer format version.
+**/
+bool ReadBinarySaveGame(const std::string& data, SaveGameNode& root);
+
+} // namespace vt_global
+
+#endif // __SAVE_GAME_BINARY_HEADER__
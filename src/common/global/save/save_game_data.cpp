@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "save_game_data.h"
+
+#include "save_game_binary.h"
+
+#include "utils/utils_common.h"
+
+#include <luabind/lua_include.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace vt_global
+{
+
+//! \brief The deepest table nesting read from a Lua save game, as save games are never that deep.
+const uint32_t SAVE_LUA_MAX_DEPTH = 32;
+
+const SaveGameNode* SaveGameNode::GetField(const std::string& key) const
+{
+    std::map<std::string, std::unique_ptr<SaveGameNode> >::const_iterator it = _fields.find(key);
+    return it != _fields.end() ? it->second.get() : nullptr;
+}
+
+const SaveGameNode* SaveGameNode::GetItem(int64_t key) const
+{
+    std::map<int64_t, std::unique_ptr<SaveGameNode> >::const_iterator it = _items.find(key);
+    return it != _items.end() ? it->second.get() : nullptr;
+}
+
+SaveGameNode* SaveGameNode::AddField(const std::string& key)
+{
+    std::unique_ptr<SaveGameNode>& node = _fields[key];
+    node.reset(new SaveGameNode());
+    return node.get();
+}
+
+SaveGameNode* SaveGameNode::AddItem(int64_t key)
+{
+    std::unique_ptr<SaveGameNode>& node = _items[key];
+    node.reset(new SaveGameNode());
+    return node.get();
+}
+
+//! \brief Tells whether a Lua number can be stored as an integer.
+static bool _IsInteger(lua_Number number)
+{
+    // Keeps away from the double precision limits.
+    return std::floor(number) == number && std::fabs(number) < 9.0e15;
+}
+
+static void _ReadLuaTable(lua_State* lua_state, int32_t index, SaveGameNode& node, uint32_t depth);
+
+//! \brief Reads the value at the top of the Lua stack.
+//! \return false if the value type can't be stored in a save game.
+static bool _ReadLuaValue(lua_State* lua_state, SaveGameNode& node, uint32_t depth)
+{
+    switch (lua_type(lua_state, -1)) {
+    case LUA_TBOOLEAN:
+        node.SetBoolean(lua_toboolean(lua_state, -1) != 0);
+        return true;
+    case LUA_TNUMBER: {
+        lua_Number number = lua_tonumber(lua_state, -1);
+        if (_IsInteger(number))
+            node.SetInteger(static_cast<int64_t>(number));
+        else
+            node.SetNumber(static_cast<double>(number));
+        return true;
+    }
+    case LUA_TSTRING: {
+        size_t length = 0;
+        const char* text = lua_tolstring(lua_state, -1, &length);
+        node.SetString(std::string(text, length));
+        return true;
+    }
+    case LUA_TTABLE:
+        _ReadLuaTable(lua_state, lua_gettop(lua_state), node, depth + 1);
+        return true;
+    default:
+        return false;
+    }
+}
+
+//! \brief Reads the Lua table at the given absolute stack index.
+static void _ReadLuaTable(lua_State* lua_state, int32_t index, SaveGameNode& node, uint32_t depth)
+{
+    node.SetTable();
+    if (depth > SAVE_LUA_MAX_DEPTH)
+        return;
+
+    lua_pushnil(lua_state);
+    while (lua_next(lua_state, index) != 0) {
+        // The key is at -2 and the value at -1.
+        int32_t value_type = lua_type(lua_state, -1);
+        bool supported_value = (value_type == LUA_TBOOLEAN || value_type == LUA_TNUMBER
+                                || value_type == LUA_TSTRING || value_type == LUA_TTABLE);
+
+        // Avoids reading the globals table again through _G.
+        if (supported_value && !lua_rawequal(lua_state, -1, index)) {
+            SaveGameNode* child = nullptr;
+            if (lua_type(lua_state, -2) == LUA_TSTRING) {
+                // Don't use lua_tolstring() on number keys: it would break lua_next().
+                size_t length = 0;
+                const char* key = lua_tolstring(lua_state, -2, &length);
+                child = node.AddField(std::string(key, length));
+            }
+            else if (lua_type(lua_state, -2) == LUA_TNUMBER) {
+                lua_Number key = lua_tonumber(lua_state, -2);
+                if (_IsInteger(key))
+                    child = node.AddItem(static_cast<int64_t>(key));
+            }
+
+            if (child != nullptr)
+                _ReadLuaValue(lua_state, *child, depth);
+        }
+
+        lua_pop(lua_state, 1); // value
+    }
+}
+
+//! \brief Returns the placeholder value, stored as the function upvalue.
+static int _ReturnPlaceholder(lua_State* lua_state)
+{
+    lua_pushvalue(lua_state, lua_upvalueindex(1));
+    return 1;
+}
+
+//! \brief Makes the undefined globals of the Lua state return a placeholder table,
+//! which can also be indexed and called, returning itself.
+static void _SetPlaceholderGlobals(lua_State* lua_state)
+{
+    lua_newtable(lua_state); // placeholder
+    lua_newtable(lua_state); // placeholder metatable
+    lua_pushvalue(lua_state, -2);
+    lua_pushcclosure(lua_state, _ReturnPlaceholder, 1);
+    lua_setfield(lua_state, -2, "__index");
+    lua_pushvalue(lua_state, -2);
+    lua_pushcclosure(lua_state, _ReturnPlaceholder, 1);
+    lua_setfield(lua_state, -2, "__call");
+    lua_setmetatable(lua_state, -2);
+
+    lua_newtable(lua_state); // globals metatable
+    lua_pushvalue(lua_state, -2);
+    lua_pushcclosure(lua_state, _ReturnPlaceholder, 1);
+    lua_setfield(lua_state, -2, "__index");
+#if LUA_VERSION_NUM >= 502
+    lua_pushglobaltable(lua_state);
+#else
+    lua_pushvalue(lua_state, LUA_GLOBALSINDEX);
+#endif
+    lua_pushvalue(lua_state, -2);
+    lua_setmetatable(lua_state, -2);
+    lua_pop(lua_state, 3); // globals, globals metatable, placeholder
+}
+
+//! \brief Runs a Lua data text in a private Lua state and reads its global tables.
+static bool _ReadLuaData(const std::string& text, const std::string& name, SaveGameNode& root,
+                         bool placeholder_globals)
+{
+    root.SetTable();
+
+    // No library is opened: the text only defines data tables.
+    lua_State* lua_state = luaL_newstate();
+    if (lua_state == nullptr)
+        return false;
+
+    if (placeholder_globals)
+        _SetPlaceholderGlobals(lua_state);
+
+    // Like luaL_loadfile(), skip a first line starting with '#',
+    // such as the header of the compiled scripts.
+    size_t start = 0;
+    if (!text.empty() && text[0] == '#') {
+        start = text.find('\n');
+        start = (start == std::string::npos) ? text.size() : start + 1;
+    }
+
+    const std::string chunk_name = "@" + name;
+    if (luaL_loadbuffer(lua_state, text.data() + start, text.size() - start, chunk_name.c_str()) != 0
+            || lua_pcall(lua_state, 0, 0, 0) != 0) {
+        PRINT_WARNING << "Couldn't read the Lua data: " << lua_tostring(lua_state, -1) << std::endl;
+        lua_close(lua_state);
+        return false;
+    }
+
+#if LUA_VERSION_NUM >= 502
+    lua_pushglobaltable(lua_state);
+#else
+    lua_pushvalue(lua_state, LUA_GLOBALSINDEX);
+#endif
+    _ReadLuaTable(lua_state, lua_gettop(lua_state), root, 0);
+
+    lua_close(lua_state);
+    return true;
+}
+
+bool ReadLuaSaveGame(const std::string& text, const std::string& name, SaveGameNode& root)
+{
+    return _ReadLuaData(text, name, root, false);
+}
+
+bool ReadLuaDataFile(const std::string& filename, SaveGameNode& root)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        root.SetTable();
+        return false;
+    }
+
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    return _ReadLuaData(data, filename, root, true);
+}
+
+//! \brief Tells whether a key can be written as a Lua global variable name.
+static bool _IsIdentifier(const std::string& key)
+{
+    if (key.empty() || (key[0] >= '0' && key[0] <= '9'))
+        return false;
+
+    for (size_t i = 0; i < key.size(); ++i) {
+        char c = key[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+            return false;
+    }
+    return true;
+}
+
+//! \brief Appends a string as a quoted Lua string.
+static void _WriteLuaString(const std::string& value, std::string& text)
+{
+    text += '"';
+    for (size_t i = 0; i < value.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c == '"' || c == '\\') {
+            text += '\\';
+            text += static_cast<char>(c);
+        }
+        else if (c < 32 || c == 127) {
+            // Three digits, so that a following digit isn't read as part of it.
+            text += '\\';
+            text += static_cast<char>('0' + c / 100);
+            text += static_cast<char>('0' + (c / 10) % 10);
+            text += static_cast<char>('0' + c % 10);
+        }
+        else {
+            text += static_cast<char>(c);
+        }
+    }
+    text += '"';
+}
+
+static void _WriteLuaValue(const SaveGameNode& node, std::string& text, uint32_t indentation)
+{
+    switch (node.GetType()) {
+    case SAVE_NODE_BOOLEAN:
+        text += node.GetBoolean() ? "true" : "false";
+        break;
+    case SAVE_NODE_INTEGER: {
+        std::ostringstream number;
+        number << node.GetInteger();
+        text += number.str();
+        break;
+    }
+    case SAVE_NODE_NUMBER: {
+        std::ostringstream number;
+        number.precision(17);
+        number << (std::isfinite(node.GetNumber()) ? node.GetNumber() : 0.0);
+        text += number.str();
+        break;
+    }
+    case SAVE_NODE_STRING:
+        _WriteLuaString(node.GetString(), text);
+        break;
+    case SAVE_NODE_TABLE: {
+        const std::string tabs(indentation + 1, '\t');
+        text += "{\n";
+
+        const std::map<int64_t, std::unique_ptr<SaveGameNode> >& items = node.GetItems();
+        for (std::map<int64_t, std::unique_ptr<SaveGameNode> >::const_iterator it = items.begin();
+                it != items.end(); ++it) {
+            std::ostringstream key;
+            key << it->first;
+            text += tabs + "[" + key.str() + "] = ";
+            _WriteLuaValue(*it->second, text, indentation + 1);
+            text += ",\n";
+        }
+
+        const std::map<std::string, std::unique_ptr<SaveGameNode> >& fields = node.GetFields();
+        for (std::map<std::string, std::unique_ptr<SaveGameNode> >::const_iterator it = fields.begin();
+                it != fields.end(); ++it) {
+            text += tabs + "[";
+            _WriteLuaString(it->first, text);
+            text += "] = ";
+            _WriteLuaValue(*it->second, text, indentation + 1);
+            text += ",\n";
+        }
+
+        text += std::string(indentation, '\t') + "}";
+        break;
+    }
+    }
+}
+
+void WriteLuaSaveGame(const SaveGameNode& root, std::string& text)
+{
+    const std::map<std::string, std::unique_ptr<SaveGameNode> >& fields = root.GetFields();
+    for (std::map<std::string, std::unique_ptr<SaveGameNode> >::const_iterator it = fields.begin();
+            it != fields.end(); ++it) {
+        if (!_IsIdentifier(it->first)) {
+            PRINT_WARNING << "Invalid save game global name, skipped: " << it->first << std::endl;
+            continue;
+        }
+
+        text += it->first + " = ";
+        _WriteLuaValue(*it->second, text, 0);
+        text += " -- " + it->first + "\n";
+    }
+}
+
+bool ReadSaveGameFile(const std::string& filename, SaveGameNode& root)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    if (IsBinarySaveGame(data)) {
+        if (!ReadBinarySaveGame(data, root)) {
+            PRINT_WARNING << "Invalid binary save game: " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    return ReadLuaSaveGame(data, filename, root);
+}
+
+} // namespace vt_global
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SAVE_GAME_DATA_HEADER__
+#define __SAVE_GAME_DATA_HEADER__
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace vt_global
+{
+
+//! \brief The types of values found in a save game.
+enum SAVE_NODE_TYPE {
+    SAVE_NODE_BOOLEAN = 0,
+    SAVE_NODE_INTEGER = 1,
+    SAVE_NODE_NUMBER  = 2,
+    SAVE_NODE_STRING  = 3,
+    SAVE_NODE_TABLE   = 4
+};
+
+/** ****************************************************************************
+*** \brief A value of a save game: a boolean, a number, a string or a table.
+***
+*** A save game is only made of data tables, so that it is read into a tree
+*** of nodes whatever its format, and then given to the game state handlers
+*** through a SaveGameReader. The root node holds the save game global tables.
+*** ***************************************************************************/
+class SaveGameNode
+{
+public:
+    SaveGameNode():
+        _type(SAVE_NODE_TABLE),
+        _boolean(false),
+        _integer(0),
+        _number(0.0)
+    {}
+
+    SAVE_NODE_TYPE GetType() const {
+        return _type;
+    }
+
+    bool IsTable() const {
+        return _type == SAVE_NODE_TABLE;
+    }
+
+    //! \brief Tells whether the value is a number, either an integer or not.
+    bool IsNumber() const {
+        return _type == SAVE_NODE_INTEGER || _type == SAVE_NODE_NUMBER;
+    }
+
+    bool GetBoolean() const {
+        return _boolean;
+    }
+
+    int64_t GetInteger() const {
+        return _type == SAVE_NODE_INTEGER ? _integer : static_cast<int64_t>(_number);
+    }
+
+    double GetNumber() const {
+        return _type == SAVE_NODE_INTEGER ? static_cast<double>(_integer) : _number;
+    }
+
+    const std::string& GetString() const {
+        return _string;
+    }
+
+    void SetBoolean(bool value) {
+        _Reset(SAVE_NODE_BOOLEAN);
+        _boolean = value;
+    }
+
+    void SetInteger(int64_t value) {
+        _Reset(SAVE_NODE_INTEGER);
+        _integer = value;
+    }
+
+    void SetNumber(double value) {
+        _Reset(SAVE_NODE_NUMBER);
+        _number = value;
+    }
+
+    void SetString(const std::string& value) {
+        _Reset(SAVE_NODE_STRING);
+        _string = value;
+    }
+
+    void SetTable() {
+        _Reset(SAVE_NODE_TABLE);
+    }
+
+    //! \brief Returns the table value with the given key, or nullptr.
+    const SaveGameNode* GetField(const std::string& key) const;
+    const SaveGameNode* GetItem(int64_t key) const;
+
+    //! \brief Adds a value to the table, replacing any previous one with the same key.
+    SaveGameNode* AddField(const std::string& key);
+    SaveGameNode* AddItem(int64_t key);
+
+    //! \brief The table values, by key type.
+    const std::map<std::string, std::unique_ptr<SaveGameNode> >& GetFields() const {
+        return _fields;
+    }
+
+    const std::map<int64_t, std::unique_ptr<SaveGameNode> >& GetItems() const {
+        return _items;
+    }
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    SaveGameNode(const SaveGameNode& node);
+    SaveGameNode& operator=(const SaveGameNode& node);
+
+    //! \brief Changes the value type, clearing the table values.
+    void _Reset(SAVE_NODE_TYPE type) {
+        _type = type;
+        _string.clear();
+        _fields.clear();
+        _items.clear();
+    }
+
+    SAVE_NODE_TYPE _type;
+
+    bool _boolean;
+    int64_t _integer;
+    double _number;
+    std::string _string;
+
+    //! \brief The table values with a string key.
+    std::map<std::string, std::unique_ptr<SaveGameNode> > _fields;
+
+    //! \brief The table values with an integer key.
+    std::map<int64_t, std::unique_ptr<SaveGameNode> > _items;
+};
+
+/** \brief Reads a save game text written in Lua.
+*** The text is run in a private Lua state, not sharing anything with the game scripts.
+*** \param text The save game Lua text.
+*** \param name The name given to the text in error messages, usually the filename.
+*** \param root The node filled with the save game global tables.
+*** \return false if the text isn't a valid Lua data file.
+**/
+bool ReadLuaSaveGame(const std::string& text, const std::string& name, SaveGameNode& root);
+
+/** \brief Reads a Lua data file, such as an animation file, in a private Lua state.
+*** The engine tables the file may use, such as the vt_map constants, don't exist there.
+*** They are replaced by a placeholder table, which is not read into the nodes.
+*** \param filename The Lua data filename.
+*** \param root The node filled with the file global tables.
+*** \return false if the file couldn't be read or run.
+**/
+bool ReadLuaDataFile(const std::string& filename, SaveGameNode& root);
+
+//! \brief Writes the save game global tables as Lua text.
+void WriteLuaSaveGame(const SaveGameNode& root, std::string& text);
+
+/** \brief Reads a save game file, either in the binary format or in Lua.
+*** \return false if the file couldn't be read or is invalid.
+**/
+bool ReadSaveGameFile(const std::string& filename, SaveGameNode& root);
+
+} // namespace vt_global
+
+#endif // __SAVE_GAME_DATA_HEADER__
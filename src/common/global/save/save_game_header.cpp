@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "save_game_header.h"
+
+#include "save_game_reader.h"
+#include "save_game_writer.h"
+
+#include "utils/utils_common.h"
+#include "utils/utils_files.h"
+
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace vt_utils;
+
+namespace vt_global
+{
+
+extern bool GLOBAL_DEBUG;
+
+//! \brief Returns the FNV-1a hash of the data, telling whether a save game file changed.
+static uint32_t _ComputeChecksum(const std::string& data)
+{
+    uint32_t checksum = 2166136261u;
+    for (size_t i = 0; i < data.size(); ++i) {
+        checksum ^= static_cast<unsigned char>(data[i]);
+        checksum *= 16777619u;
+    }
+    return checksum;
+}
+
+/** \brief Gets the size and modification time of a save game file, without reading it.
+*** \return false if the file doesn't exist.
+**/
+static bool _GetSaveFileStatus(const std::string& filename, uint32_t& size, uint32_t& modification_time)
+{
+    struct stat file_status;
+    if (stat(filename.c_str(), &file_status) != 0)
+        return false;
+
+    size = static_cast<uint32_t>(file_status.st_size);
+    modification_time = static_cast<uint32_t>(file_status.st_mtime);
+    return true;
+}
+
+//! \brief Reads a character stats from the currently opened table.
+static void _ReadHeaderCharacter(SaveGameReader& file, SaveGameHeaderCharacter& character)
+{
+    character._experience_level = file.ReadUInt("experience_level");
+    character._total_experience_points = file.ReadUInt("total_experience_points");
+    character._unspent_experience_points = file.ReadUInt("unspent_experience_points");
+    character._experience_points_next = file.ReadInt("experience_points_next");
+    character._max_hit_points = file.ReadUInt("max_hit_points");
+    character._hit_points = file.ReadUInt("hit_points");
+    character._max_skill_points = file.ReadUInt("max_skill_points");
+    character._skill_points = file.ReadUInt("skill_points");
+}
+
+std::string SaveGameHeader::GetHeaderFilename(const std::string& save_filename)
+{
+    return save_filename + ".header";
+}
+
+bool SaveGameHeader::Load(const std::string& save_filename)
+{
+    const std::string header_filename = GetHeaderFilename(save_filename);
+
+    // Check for the file existence, prevents a useless warning
+    if (!DoesFileExist(header_filename) || !DoesFileExist(save_filename))
+        return false;
+
+    SaveGameReader file;
+    if (!file.OpenFile(header_filename))
+        return false;
+
+    // The header is only valid for the save game content it was written with.
+    if (!file.OpenTable("save_file")) {
+        file.CloseFile();
+        return false;
+    }
+    uint32_t save_size = file.ReadUInt("size");
+    uint32_t save_modification_time = file.ReadUInt("modification_time");
+    file.CloseTable(); // save_file
+
+    // The save game content is only checked when it is loaded, so that previewing it stays cheap.
+    uint32_t size = 0;
+    uint32_t modification_time = 0;
+    if (!_GetSaveFileStatus(save_filename, size, modification_time)
+            || size != save_size || modification_time != save_modification_time) {
+        file.CloseFile();
+        return false;
+    }
+
+    if (!file.OpenTable("save_header")) {
+        file.CloseFile();
+        return false;
+    }
+
+    _play_hours = file.ReadUInt("play_hours");
+    _play_minutes = file.ReadUInt("play_minutes");
+    _play_seconds = file.ReadUInt("play_seconds");
+    _drunes = file.ReadUInt("drunes");
+    _map_data_filename = file.ReadString("map_data_filename");
+    _map_script_filename = file.ReadString("map_script_filename");
+    _has_map_preview = file.DoesValueExist("map_name");
+    _map_name = file.ReadString("map_name");
+    _map_image_filename = file.ReadString("map_image_filename");
+
+    _characters.clear();
+    if (file.OpenTable("characters")) {
+        for (uint32_t i = 1; file.DoesTableExist(i) && _characters.size() < SAVE_HEADER_CHARACTERS; ++i) {
+            file.OpenTable(i);
+            SaveGameHeaderCharacter character;
+            character._id = file.ReadUInt("id");
+            _ReadHeaderCharacter(file, character);
+            _characters.push_back(character);
+            file.CloseTable(); // i
+        }
+        file.CloseTable(); // characters
+    }
+
+    bool valid = !file.IsErrorDetected();
+    if (!valid) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "One or more errors occurred while reading the save game header - they are listed below:"
+            << std::endl << file.GetErrorMessages() << std::endl;
+        file.ClearErrors();
+    }
+
+    file.CloseTable(); // save_header
+    file.CloseFile();
+    return valid;
+}
+
+bool SaveGameHeader::LoadFromSaveGame(const std::string& save_filename)
+{
+    // Check for the file existence, prevents a useless warning
+    if (!DoesFileExist(save_filename))
+        return false;
+
+    // The save game is either in the binary format or in Lua.
+    SaveGameReader file;
+    if (!file.OpenFile(save_filename))
+        return false;
+
+    if (!file.DoesTableExist("save_game1")) {
+        file.CloseFile();
+        return false;
+    }
+
+    // open the namespace that the save game is encapsulated in.
+    file.OpenTable("save_game1");
+
+    _map_script_filename = file.ReadString("map_script_filename");
+    _map_data_filename = file.ReadString("map_data_filename");
+    _has_map_preview = false;
+
+    _play_hours = file.ReadUInt("play_hours");
+    _play_minutes = file.ReadUInt("play_minutes");
+    _play_seconds = file.ReadUInt("play_seconds");
+    _drunes = file.ReadUInt("drunes");
+
+    if (!file.DoesTableExist("characters")) {
+        file.CloseTable(); // save_game1
+        file.CloseFile();
+        return false;
+    }
+
+    // Read characters table content
+    file.OpenTable("characters");
+    std::vector<uint32_t> char_ids;
+    file.ReadUIntVector("order", char_ids);
+
+    // Loads only the visible battle characters
+    _characters.clear();
+    for (uint32_t i = 0; i < char_ids.size() && i < SAVE_HEADER_CHARACTERS; ++i) {
+        if (!file.DoesTableExist(char_ids[i]))
+            continue;
+
+        file.OpenTable(char_ids[i]);
+        SaveGameHeaderCharacter character;
+        character._id = char_ids[i];
+        _ReadHeaderCharacter(file, character);
+        _characters.push_back(character);
+        file.CloseTable(); // character id
+    }
+    file.CloseTable(); // characters
+
+    // Report any errors detected from the previous read operations
+    if (file.IsErrorDetected()) {
+        PRINT_WARNING << "One or more errors occurred while reading the save game file - they are listed below:"
+            << std::endl << file.GetErrorMessages() << std::endl;
+        file.ClearErrors();
+    }
+
+    file.CloseTable(); // save_game1
+    file.CloseFile();
+    return true;
+}
+
+void SaveGameHeader::Save(SaveGameBuffer& file) const
+{
+    file.BeginTable("save_header");
+    file.WriteUInt("play_hours", _play_hours);
+    file.WriteUInt("play_minutes", _play_minutes);
+    file.WriteUInt("play_seconds", _play_seconds);
+    file.WriteUInt("drunes", _drunes);
+    file.WriteString("map_data_filename", _map_data_filename);
+    file.WriteString("map_script_filename", _map_script_filename);
+    file.WriteString("map_name", _map_name);
+    file.WriteString("map_image_filename", _map_image_filename);
+
+    file.BeginTable("characters");
+    for (uint32_t i = 0; i < _characters.size(); ++i) {
+        const SaveGameHeaderCharacter& character = _characters[i];
+        file.BeginTable(i + 1);
+        file.WriteUInt("id", character._id);
+        file.WriteUInt("experience_level", character._experience_level);
+        file.WriteUInt("total_experience_points", character._total_experience_points);
+        file.WriteUInt("unspent_experience_points", character._unspent_experience_points);
+        file.WriteInt("experience_points_next", character._experience_points_next);
+        file.WriteUInt("max_hit_points", character._max_hit_points);
+        file.WriteUInt("hit_points", character._hit_points);
+        file.WriteUInt("max_skill_points", character._max_skill_points);
+        file.WriteUInt("skill_points", character._skill_points);
+        file.EndTable(); // i + 1
+    }
+    file.EndTable(); // characters
+
+    file.EndTable(); // save_header
+}
+
+bool SaveGameHeader::CheckSaveGameData(const std::string& save_filename)
+{
+    const std::string header_filename = GetHeaderFilename(save_filename);
+    if (!DoesFileExist(header_filename))
+        return true;
+
+    SaveGameReader file;
+    if (!file.OpenFile(header_filename))
+        return true;
+
+    uint32_t save_checksum = 0;
+    bool has_checksum = file.OpenTable("save_file");
+    if (has_checksum) {
+        has_checksum = file.DoesValueExist("checksum");
+        save_checksum = file.ReadUInt("checksum");
+        file.CloseTable(); // save_file
+    }
+    file.CloseFile();
+
+    if (has_checksum) {
+        std::ifstream save_file(save_filename.c_str(), std::ios::in | std::ios::binary);
+        const std::string save_data((std::istreambuf_iterator<char>(save_file)), std::istreambuf_iterator<char>());
+        if (_ComputeChecksum(save_data) == save_checksum)
+            return true;
+    }
+
+    // The save game was changed while keeping its size and modification time.
+    PRINT_WARNING << "The save game header doesn't match its save game anymore, removing it: "
+        << header_filename << std::endl;
+    remove(header_filename.c_str());
+    return false;
+}
+
+void SaveGameHeader::SetSaveGameData(SaveGameNode& header_root, const std::string& save_filename,
+                                     const std::string& save_data)
+{
+    uint32_t size = 0;
+    uint32_t modification_time = 0;
+    if (!_GetSaveFileStatus(save_filename, size, modification_time))
+        return;
+
+    SaveGameNode* save_file = header_root.AddField("save_file");
+    save_file->AddField("size")->SetInteger(size);
+    save_file->AddField("modification_time")->SetInteger(modification_time);
+    save_file->AddField("checksum")->SetInteger(_ComputeChecksum(save_data));
+}
+
+} // namespace vt_global
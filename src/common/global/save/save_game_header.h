@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SAVE_GAME_HEADER_HEADER__
+#define __SAVE_GAME_HEADER_HEADER__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vt_global
+{
+
+class SaveGameBuffer;
+class SaveGameNode;
+
+//! \brief The number of characters kept in a save game header, the visible battle characters.
+const uint32_t SAVE_HEADER_CHARACTERS = 4;
+
+//! \brief The character data shown when previewing a save game.
+struct SaveGameHeaderCharacter {
+    SaveGameHeaderCharacter():
+        _id(0),
+        _experience_level(0),
+        _total_experience_points(0),
+        _unspent_experience_points(0),
+        _experience_points_next(0),
+        _max_hit_points(0),
+        _hit_points(0),
+        _max_skill_points(0),
+        _skill_points(0)
+    {}
+
+    uint32_t _id;
+    uint32_t _experience_level;
+    uint32_t _total_experience_points;
+    uint32_t _unspent_experience_points;
+    int32_t _experience_points_next;
+    uint32_t _max_hit_points;
+    uint32_t _hit_points;
+    uint32_t _max_skill_points;
+    uint32_t _skill_points;
+};
+
+/** ****************************************************************************
+*** \brief The data shown when previewing a save game.
+***
+*** It is written in a small file next to each save game, so that the save menu
+*** doesn't have to read a whole save game file to preview it. The header is
+*** written after its save game, along with the save game file size, modification
+*** time and checksum. The header is ignored when the file size or modification time
+*** don't match anymore, so that an outdated header is never used, while the checksum
+*** is only verified when the save game is loaded, as it needs the whole file.
+*** Save games without a valid header are still read as a whole.
+*** ***************************************************************************/
+struct SaveGameHeader {
+    SaveGameHeader():
+        _play_hours(0),
+        _play_minutes(0),
+        _play_seconds(0),
+        _drunes(0),
+        _has_map_preview(false)
+    {}
+
+    //! \brief Returns the header filename of the given save game.
+    static std::string GetHeaderFilename(const std::string& save_filename);
+
+    /** \brief Loads the header of the given save game.
+    *** \return false if there is no header, or if it doesn't match the save game anymore.
+    **/
+    bool Load(const std::string& save_filename);
+
+    /** \brief Reads the header data from the given save game itself.
+    *** Used for the save games written without a header.
+    *** \return false if the save game is invalid.
+    **/
+    bool LoadFromSaveGame(const std::string& save_filename);
+
+    //! \brief Writes the header in the given buffer.
+    void Save(SaveGameBuffer& file) const;
+
+    /** \brief Verifies the checksum of a loaded save game against its header.
+    *** An outdated header, e.g. after the save game was copied over, is removed.
+    *** \return false if the header didn't match the save game.
+    **/
+    static bool CheckSaveGameData(const std::string& save_filename);
+
+    /** \brief Adds the size, modification time and checksum of the save game file to a header tree.
+    *** \param header_root The header tree, written by Save().
+    *** \param save_filename The save game file, already written.
+    *** \param save_data The save game file content.
+    **/
+    static void SetSaveGameData(SaveGameNode& header_root, const std::string& save_filename,
+                                const std::string& save_data);
+
+    uint32_t _play_hours;
+    uint32_t _play_minutes;
+    uint32_t _play_seconds;
+    uint32_t _drunes;
+
+    std::string _map_data_filename;
+    std::string _map_script_filename;
+
+    //! \brief The untranslated map hud name, and the map image of the save location.
+    std::string _map_name;
+    std::string _map_image_filename;
+
+    //! \brief Whether the map name and image are known.
+    //! The headers of older save games, and the save games themselves, don't have them.
+    bool _has_map_preview;
+
+    //! \brief The first characters of the party, up to SAVE_HEADER_CHARACTERS.
+    std::vector<SaveGameHeaderCharacter> _characters;
+};
+
+} // namespace vt_global
+
+#endif // __SAVE_GAME_HEADER_HEADER__
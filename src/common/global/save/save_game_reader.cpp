@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "save_game_reader.h"
+
+namespace vt_global
+{
+
+SaveGameReader::SaveGameReader():
+    _is_open(false)
+{
+}
+
+bool SaveGameReader::OpenFile(const std::string& filename)
+{
+    CloseFile();
+
+    if (!ReadSaveGameFile(filename, _root)) {
+        _root.SetTable();
+        return false;
+    }
+
+    _filename = filename;
+    _is_open = true;
+    return true;
+}
+
+void SaveGameReader::CloseFile()
+{
+    _open_tables.clear();
+    _root.SetTable();
+    _filename.clear();
+    _is_open = false;
+}
+
+bool SaveGameReader::OpenTable(const std::string& key)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr || !node->IsTable())
+        return false;
+
+    _open_tables.push_back(node);
+    return true;
+}
+
+bool SaveGameReader::OpenTable(int32_t key)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr || !node->IsTable())
+        return false;
+
+    _open_tables.push_back(node);
+    return true;
+}
+
+void SaveGameReader::CloseTable()
+{
+    if (_open_tables.empty()) {
+        _error_messages << "* CloseTable() called with no table open in file: " << _filename << std::endl;
+        return;
+    }
+    _open_tables.pop_back();
+}
+
+void SaveGameReader::ReadTableKeys(std::vector<uint32_t>& keys) const
+{
+    keys.clear();
+    const std::map<int64_t, std::unique_ptr<SaveGameNode> >& items = _GetCurrentTable().GetItems();
+    for (std::map<int64_t, std::unique_ptr<SaveGameNode> >::const_iterator it = items.begin(); it != items.end(); ++it)
+        keys.push_back(static_cast<uint32_t>(it->first));
+}
+
+void SaveGameReader::ReadTableKeys(std::vector<int32_t>& keys) const
+{
+    keys.clear();
+    const std::map<int64_t, std::unique_ptr<SaveGameNode> >& items = _GetCurrentTable().GetItems();
+    for (std::map<int64_t, std::unique_ptr<SaveGameNode> >::const_iterator it = items.begin(); it != items.end(); ++it)
+        keys.push_back(static_cast<int32_t>(it->first));
+}
+
+void SaveGameReader::ReadTableKeys(std::vector<std::string>& keys) const
+{
+    keys.clear();
+    const SaveGameNode& table = _GetCurrentTable();
+
+    const std::map<int64_t, std::unique_ptr<SaveGameNode> >& items = table.GetItems();
+    for (std::map<int64_t, std::unique_ptr<SaveGameNode> >::const_iterator it = items.begin(); it != items.end(); ++it) {
+        std::ostringstream key;
+        key << it->first;
+        keys.push_back(key.str());
+    }
+
+    const std::map<std::string, std::unique_ptr<SaveGameNode> >& fields = table.GetFields();
+    for (std::map<std::string, std::unique_ptr<SaveGameNode> >::const_iterator it = fields.begin(); it != fields.end(); ++it)
+        keys.push_back(it->first);
+}
+
+void SaveGameReader::_ReadIntVector(const SaveGameNode& table, std::vector<int32_t>& values)
+{
+    for (int64_t i = 1; ; ++i) {
+        const SaveGameNode* node = table.GetItem(i);
+        if (node == nullptr)
+            return;
+
+        if (!node->IsNumber()) {
+            _AddTypeError(i, "number");
+            continue;
+        }
+        values.push_back(static_cast<int32_t>(node->GetInteger()));
+    }
+}
+
+void SaveGameReader::_ReadUIntVector(const SaveGameNode& table, std::vector<uint32_t>& values)
+{
+    for (int64_t i = 1; ; ++i) {
+        const SaveGameNode* node = table.GetItem(i);
+        if (node == nullptr)
+            return;
+
+        if (!node->IsNumber()) {
+            _AddTypeError(i, "number");
+            continue;
+        }
+        values.push_back(static_cast<uint32_t>(node->GetInteger()));
+    }
+}
+
+void SaveGameReader::_ReadStringVector(const SaveGameNode& table, std::vector<std::string>& values)
+{
+    for (int64_t i = 1; ; ++i) {
+        const SaveGameNode* node = table.GetItem(i);
+        if (node == nullptr)
+            return;
+
+        if (node->GetType() != SAVE_NODE_STRING) {
+            _AddTypeError(i, "string");
+            continue;
+        }
+        values.push_back(node->GetString());
+    }
+}
+
+} // namespace vt_global
@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SAVE_GAME_READER_HEADER__
+#define __SAVE_GAME_READER_HEADER__
+
+#include "save_game_data.h"
+
+#include <sstream>
+#include <vector>
+
+namespace vt_global
+{
+
+/** ****************************************************************************
+*** \brief Reads a save game file, whether in the binary format or in Lua.
+***
+*** The whole file is read into memory when opened, and the game state handlers
+*** then read it with the same calls they would use on a script file. The Lua
+*** save games are run in a private Lua state, and the binary ones don't need
+*** Lua at all, so that reading a save game doesn't touch the game scripts state.
+*** Other Lua data files, such as the map data files, are read the same way,
+*** which also makes it usable on a worker thread.
+*** ***************************************************************************/
+class SaveGameReader
+{
+public:
+    SaveGameReader();
+
+    /** \brief Reads a whole save game file.
+    *** \return false if the file couldn't be read or is invalid.
+    **/
+    bool OpenFile(const std::string& filename);
+
+    //! \brief Releases the file data.
+    void CloseFile();
+
+    bool IsFileOpen() const {
+        return _is_open;
+    }
+
+    const std::string& GetFilename() const {
+        return _filename;
+    }
+
+    /** \brief Opens a table of the current table, or a global table when none is opened.
+    *** \return false if there is no such table. Nothing is opened then.
+    **/
+    bool OpenTable(const std::string& key);
+    bool OpenTable(int32_t key);
+
+    //! \brief Closes the last opened table.
+    void CloseTable();
+
+    void CloseAllTables() {
+        _open_tables.clear();
+    }
+
+    template <class K> bool DoesTableExist(const K& key) const {
+        const SaveGameNode* node = _FindValue(key);
+        return node != nullptr && node->IsTable();
+    }
+
+    template <class K> bool DoesValueExist(const K& key) const {
+        return _FindValue(key) != nullptr;
+    }
+
+    /** \name Read functions
+    *** \brief Reads a value of the current table.
+    *** \param key The value key, a string or an integer.
+    *** \param default_value The value returned when the key doesn't exist, or holds another type.
+    *** \note An error is added when the key holds another type.
+    **/
+    //@{
+    template <class K> bool ReadBool(const K& key, bool default_value = false);
+    template <class K> int32_t ReadInt(const K& key, int32_t default_value = 0);
+    template <class K> uint32_t ReadUInt(const K& key, uint32_t default_value = 0);
+    template <class K> float ReadFloat(const K& key, float default_value = 0.0f);
+    template <class K> std::string ReadString(const K& key, const std::string& default_value = std::string());
+    //@}
+
+    //! \brief Reads the given table values, from index 1 to the first missing index.
+    template <class K> void ReadIntVector(const K& key, std::vector<int32_t>& values);
+    template <class K> void ReadUIntVector(const K& key, std::vector<uint32_t>& values);
+    template <class K> void ReadStringVector(const K& key, std::vector<std::string>& values);
+
+    //! \brief Returns the number of values of the current table.
+    uint32_t GetTableSize() const {
+        const SaveGameNode& table = _GetCurrentTable();
+        return static_cast<uint32_t>(table.GetItems().size() + table.GetFields().size());
+    }
+
+    //! \brief Reads the keys of the current table.
+    //! The integer vectors only get the integer keys, and the string vectors get all of them.
+    void ReadTableKeys(std::vector<uint32_t>& keys) const;
+    void ReadTableKeys(std::vector<int32_t>& keys) const;
+    void ReadTableKeys(std::vector<std::string>& keys) const;
+
+    //! \brief Reads the keys of the given table of the current table.
+    template <class K, class T> void ReadTableKeys(const K& key, std::vector<T>& keys) {
+        keys.clear();
+        if (!OpenTable(key))
+            return;
+        ReadTableKeys(keys);
+        CloseTable();
+    }
+
+    //! \name Error handling
+    //@{
+    bool IsErrorDetected() const {
+        return !_error_messages.str().empty();
+    }
+
+    std::string GetErrorMessages() const {
+        return _error_messages.str();
+    }
+
+    void ClearErrors() {
+        _error_messages.str("");
+    }
+    //@}
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    SaveGameReader(const SaveGameReader& reader);
+    SaveGameReader& operator=(const SaveGameReader& reader);
+
+    //! \brief Returns the current table, or the root one.
+    const SaveGameNode& _GetCurrentTable() const {
+        return _open_tables.empty() ? _root : *_open_tables.back();
+    }
+
+    //! \brief Returns the value of the current table with the given key, or nullptr.
+    const SaveGameNode* _FindValue(const std::string& key) const {
+        return _GetCurrentTable().GetField(key);
+    }
+
+    const SaveGameNode* _FindValue(int32_t key) const {
+        return _GetCurrentTable().GetItem(key);
+    }
+
+    //! \brief Adds an error about a value not holding the expected type.
+    template <class K> void _AddTypeError(const K& key, const std::string& expected_type) {
+        _error_messages << "* Key '" << key << "' isn't a " << expected_type
+                        << " in file: " << _filename << std::endl;
+    }
+
+    //! \brief Adds the values of a table, from index 1 to the first missing index.
+    void _ReadIntVector(const SaveGameNode& table, std::vector<int32_t>& values);
+    void _ReadUIntVector(const SaveGameNode& table, std::vector<uint32_t>& values);
+    void _ReadStringVector(const SaveGameNode& table, std::vector<std::string>& values);
+
+    std::string _filename;
+
+    bool _is_open;
+
+    //! \brief The save game global tables.
+    SaveGameNode _root;
+
+    //! \brief The opened tables, the last one being the current one.
+    std::vector<const SaveGameNode*> _open_tables;
+
+    std::ostringstream _error_messages;
+};
+
+template <class K> bool SaveGameReader::ReadBool(const K& key, bool default_value)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr)
+        return default_value;
+
+    if (node->GetType() != SAVE_NODE_BOOLEAN) {
+        _AddTypeError(key, "boolean");
+        return default_value;
+    }
+    return node->GetBoolean();
+}
+
+template <class K> int32_t SaveGameReader::ReadInt(const K& key, int32_t default_value)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr)
+        return default_value;
+
+    if (!node->IsNumber()) {
+        _AddTypeError(key, "number");
+        return default_value;
+    }
+    return static_cast<int32_t>(node->GetInteger());
+}
+
+template <class K> uint32_t SaveGameReader::ReadUInt(const K& key, uint32_t default_value)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr)
+        return default_value;
+
+    if (!node->IsNumber()) {
+        _AddTypeError(key, "number");
+        return default_value;
+    }
+    return static_cast<uint32_t>(node->GetInteger());
+}
+
+template <class K> float SaveGameReader::ReadFloat(const K& key, float default_value)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr)
+        return default_value;
+
+    if (!node->IsNumber()) {
+        _AddTypeError(key, "number");
+        return default_value;
+    }
+    return static_cast<float>(node->GetNumber());
+}
+
+template <class K> std::string SaveGameReader::ReadString(const K& key, const std::string& default_value)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr)
+        return default_value;
+
+    if (node->GetType() != SAVE_NODE_STRING) {
+        _AddTypeError(key, "string");
+        return default_value;
+    }
+    return node->GetString();
+}
+
+template <class K> void SaveGameReader::ReadIntVector(const K& key, std::vector<int32_t>& values)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr)
+        return;
+
+    if (!node->IsTable()) {
+        _AddTypeError(key, "table");
+        return;
+    }
+    _ReadIntVector(*node, values);
+}
+
+template <class K> void SaveGameReader::ReadUIntVector(const K& key, std::vector<uint32_t>& values)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr)
+        return;
+
+    if (!node->IsTable()) {
+        _AddTypeError(key, "table");
+        return;
+    }
+    _ReadUIntVector(*node, values);
+}
+
+template <class K> void SaveGameReader::ReadStringVector(const K& key, std::vector<std::string>& values)
+{
+    const SaveGameNode* node = _FindValue(key);
+    if (node == nullptr)
+        return;
+
+    if (!node->IsTable()) {
+        _AddTypeError(key, "table");
+        return;
+    }
+    _ReadStringVector(*node, values);
+}
+
+} // namespace vt_global
+
+#endif // __SAVE_GAME_READER_HEADER__
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "save_game_writer.h"
+
+#include "save_game_binary.h"
+#include "save_game_header.h"
+
+#include "utils/utils_common.h"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#   include <io.h>
+#   include <windows.h>
+#else
+#   include <unistd.h>
+#endif
+
+namespace vt_global
+{
+
+SaveGameWriter::SaveGameWriter() :
+    _writing(false),
+    _last_write_succeeded(true),
+    _quit(false),
+    _thread(nullptr),
+    _mutex(nullptr),
+    _condition(nullptr)
+{
+}
+
+SaveGameWriter::~SaveGameWriter()
+{
+    _Stop();
+}
+
+bool SaveGameWriter::Write(const std::string& filename, std::unique_ptr<SaveGameNode>&& root, bool binary,
+                           const std::string& header_filename,
+                           std::unique_ptr<SaveGameNode>&& header_root)
+{
+    SaveFile save_file;
+    save_file._filename = filename;
+    save_file._root.swap(root);
+    save_file._binary = binary;
+    save_file._header_filename = header_filename;
+    save_file._header_root.swap(header_root);
+
+    if (!_Start()) {
+        // Better a hitch than a lost save.
+        _last_write_succeeded = _WriteSaveFile(save_file);
+        return false;
+    }
+
+    SDL_LockMutex(_mutex);
+
+    // Don't write an outdated content first.
+    bool queued = false;
+    for (std::deque<SaveFile>::iterator it = _queue.begin(); it != _queue.end(); ++it) {
+        if (it->_filename == filename) {
+            it->_root.swap(save_file._root);
+            it->_binary = save_file._binary;
+            it->_header_filename.swap(save_file._header_filename);
+            it->_header_root.swap(save_file._header_root);
+            queued = true;
+            break;
+        }
+    }
+
+    if (!queued) {
+        _queue.emplace_back();
+        SaveFile& queued_file = _queue.back();
+        queued_file._filename.swap(save_file._filename);
+        queued_file._root.swap(save_file._root);
+        queued_file._binary = save_file._binary;
+        queued_file._header_filename.swap(save_file._header_filename);
+        queued_file._header_root.swap(save_file._header_root);
+    }
+
+    SDL_CondBroadcast(_condition);
+    SDL_UnlockMutex(_mutex);
+    return true;
+}
+
+bool SaveGameWriter::IsWriting()
+{
+    if (_thread == nullptr)
+        return false;
+
+    SDL_LockMutex(_mutex);
+    bool writing = _writing || !_queue.empty();
+    SDL_UnlockMutex(_mutex);
+    return writing;
+}
+
+void SaveGameWriter::WaitForCompletion()
+{
+    if (_thread == nullptr)
+        return;
+
+    SDL_LockMutex(_mutex);
+    while (_writing || !_queue.empty())
+        SDL_CondWait(_condition, _mutex);
+    SDL_UnlockMutex(_mutex);
+}
+
+bool SaveGameWriter::HasLastWriteSucceeded()
+{
+    if (_thread == nullptr)
+        return _last_write_succeeded;
+
+    SDL_LockMutex(_mutex);
+    bool succeeded = _last_write_succeeded;
+    SDL_UnlockMutex(_mutex);
+    return succeeded;
+}
+
+bool SaveGameWriter::_Start()
+{
+    if (_thread != nullptr)
+        return true;
+
+    _mutex = SDL_CreateMutex();
+    _condition = SDL_CreateCond();
+    if (_mutex == nullptr || _condition == nullptr) {
+        PRINT_WARNING << "Couldn't create the save game writer synchronization objects: "
+                      << SDL_GetError() << std::endl;
+        _Stop();
+        return false;
+    }
+
+    _quit = false;
+    _thread = SDL_CreateThread(_ThreadFunction, "SaveGameWriter", this);
+    if (_thread == nullptr) {
+        PRINT_WARNING << "Couldn't create the save game writer thread: " << SDL_GetError() << std::endl;
+        _Stop();
+        return false;
+    }
+
+    return true;
+}
+
+void SaveGameWriter::_Stop()
+{
+    if (_thread != nullptr) {
+        // The queued files are still written: they are the player's progress.
+        SDL_LockMutex(_mutex);
+        _quit = true;
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+
+        SDL_WaitThread(_thread, nullptr);
+        _thread = nullptr;
+    }
+
+    if (_condition != nullptr) {
+        SDL_DestroyCond(_condition);
+        _condition = nullptr;
+    }
+
+    if (_mutex != nullptr) {
+        SDL_DestroyMutex(_mutex);
+        _mutex = nullptr;
+    }
+}
+
+int SaveGameWriter::_ThreadFunction(void* data)
+{
+    SaveGameWriter* writer = static_cast<SaveGameWriter*>(data);
+    writer->_Run();
+    return 0;
+}
+
+void SaveGameWriter::_Run()
+{
+    SDL_LockMutex(_mutex);
+
+    while (true) {
+        while (_queue.empty() && !_quit)
+            SDL_CondWait(_condition, _mutex);
+
+        if (_queue.empty() && _quit)
+            break;
+
+        SaveFile save_file;
+        save_file._filename.swap(_queue.front()._filename);
+        save_file._root.swap(_queue.front()._root);
+        save_file._binary = _queue.front()._binary;
+        save_file._header_filename.swap(_queue.front()._header_filename);
+        save_file._header_root.swap(_queue.front()._header_root);
+        _queue.pop_front();
+        _writing = true;
+        SDL_UnlockMutex(_mutex);
+
+        // The writing is done without holding the lock.
+        bool succeeded = _WriteSaveFile(save_file);
+
+        SDL_LockMutex(_mutex);
+        _last_write_succeeded = succeeded;
+        _writing = false;
+        SDL_CondBroadcast(_condition);
+    }
+
+    SDL_UnlockMutex(_mutex);
+}
+
+bool SaveGameWriter::_WriteFile(const std::string& filename, const std::string& data)
+{
+    const std::string temp_filename = filename + ".tmp";
+
+    FILE* file = fopen(temp_filename.c_str(), "wb");
+    if (file == nullptr) {
+        PRINT_WARNING << "Couldn't open the save file for writing: " << temp_filename << std::endl;
+        return false;
+    }
+
+    bool written = (fwrite(data.data(), 1, data.size(), file) == data.size());
+    written = written && (fflush(file) == 0);
+
+    // Make sure the content is on the disk before replacing the previous save.
+#ifdef _WIN32
+    written = written && (_commit(_fileno(file)) == 0);
+#else
+    written = written && (fsync(fileno(file)) == 0);
+#endif
+
+    written = (fclose(file) == 0) && written;
+
+    if (!written) {
+        PRINT_WARNING << "Couldn't write the save file: " << temp_filename << std::endl;
+        remove(temp_filename.c_str());
+        return false;
+    }
+
+    // Replace the previous save in one step.
+#ifdef _WIN32
+    bool renamed = MoveFileExA(temp_filename.c_str(), filename.c_str(),
+                               MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    bool renamed = (rename(temp_filename.c_str(), filename.c_str()) == 0);
+#endif
+
+    if (!renamed) {
+        PRINT_WARNING << "Couldn't replace the save file: " << filename << std::endl;
+        remove(temp_filename.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+//! \brief Serializes a save game tree in the given format.
+static void _SerializeSaveGame(const SaveGameNode& root, bool binary, std::string& data)
+{
+    if (binary)
+        WriteBinarySaveGame(root, data);
+    else
+        WriteLuaSaveGame(root, data);
+}
+
+bool SaveGameWriter::_WriteSaveFile(SaveFile& save_file)
+{
+    if (save_file._root == nullptr)
+        return false;
+
+    // The serialization is done here, so that it doesn't slow down the game.
+    std::string data;
+    _SerializeSaveGame(*save_file._root, save_file._binary, data);
+
+    if (save_file._header_filename.empty() || save_file._header_root == nullptr)
+        return _WriteFile(save_file._filename, data);
+
+    // The previous header doesn't describe the new content.
+    remove(save_file._header_filename.c_str());
+
+    if (!_WriteFile(save_file._filename, data))
+        return false;
+
+    // The save file is still valid without its header.
+    SaveGameHeader::SetSaveGameData(*save_file._header_root, save_file._filename, data);
+    std::string header_data;
+    _SerializeSaveGame(*save_file._header_root, save_file._binary, header_data);
+    _WriteFile(save_file._header_filename, header_data);
+    return true;
+}
+
+} // namespace vt_global
@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SAVE_GAME_WRITER_HEADER__
+#define __SAVE_GAME_WRITER_HEADER__
+
+#include "save_game_data.h"
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vt_global
+{
+
+/** ****************************************************************************
+*** \brief Holds the data of a save game while it is being built.
+***
+*** The game state handlers write their save data there, on the game thread,
+*** directly as a tree of save game nodes. This is the snapshot of the game
+*** state: the file itself is then written by the SaveGameWriter, in the Lua
+*** or binary format, without going through the Lua compiler.
+*** ***************************************************************************/
+class SaveGameBuffer
+{
+public:
+    //! \param filename The save file the data will be written to.
+    explicit SaveGameBuffer(const std::string& filename) :
+        _filename(filename),
+        _root(new SaveGameNode())
+    {
+    }
+
+    //! \brief Always true, the buffer is written to memory.
+    bool IsFileOpen() const {
+        return true;
+    }
+
+    const std::string& GetFilename() const {
+        return _filename;
+    }
+
+    /** \brief Opens a new table in the current one. The values are written in it until EndTable().
+    *** \param key The table key, a string or an integer.
+    **/
+    template <class K> void BeginTable(const K& key) {
+        SaveGameNode* node = _AddValue(key);
+        _open_tables.push_back(node);
+    }
+
+    //! \brief Closes the last opened table.
+    void EndTable() {
+        if (!_open_tables.empty())
+            _open_tables.pop_back();
+    }
+
+    /** \name Write functions
+    *** \brief Writes a value in the current table.
+    *** \param key The value key, a string or an integer.
+    **/
+    //@{
+    template <class K> void WriteBool(const K& key, bool value) {
+        _AddValue(key)->SetBoolean(value);
+    }
+
+    template <class K> void WriteInt(const K& key, int32_t value) {
+        _AddValue(key)->SetInteger(value);
+    }
+
+    template <class K> void WriteUInt(const K& key, uint32_t value) {
+        _AddValue(key)->SetInteger(value);
+    }
+
+    template <class K> void WriteFloat(const K& key, float value) {
+        _AddValue(key)->SetNumber(value);
+    }
+
+    template <class K> void WriteString(const K& key, const std::string& value) {
+        _AddValue(key)->SetString(value);
+    }
+
+    //! \brief Writes the values as a table, indexed from 1.
+    template <class K> void WriteUIntVector(const K& key, const std::vector<uint32_t>& values) {
+        SaveGameNode* node = _AddValue(key);
+        for (uint32_t i = 0; i < values.size(); ++i)
+            node->AddItem(i + 1)->SetInteger(values[i]);
+    }
+
+    template <class K> void WriteStringVector(const K& key, const std::vector<std::string>& values) {
+        SaveGameNode* node = _AddValue(key);
+        for (uint32_t i = 0; i < values.size(); ++i)
+            node->AddItem(i + 1)->SetString(values[i]);
+    }
+    //@}
+
+    //! \brief Gives the save game tree, so that it can be moved to the writer without copying it.
+    std::unique_ptr<SaveGameNode>& GetRoot() {
+        return _root;
+    }
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    SaveGameBuffer(const SaveGameBuffer& buffer);
+    SaveGameBuffer& operator=(const SaveGameBuffer& buffer);
+
+    SaveGameNode* _GetCurrentTable() {
+        return _open_tables.empty() ? _root.get() : _open_tables.back();
+    }
+
+    //! \brief Adds a value to the current table, replacing any previous one with the same key.
+    SaveGameNode* _AddValue(const std::string& key) {
+        return _GetCurrentTable()->AddField(key);
+    }
+
+    SaveGameNode* _AddValue(int64_t key) {
+        return _GetCurrentTable()->AddItem(key);
+    }
+
+    //! \brief The save file the data will be written to.
+    std::string _filename;
+
+    //! \brief The save game global tables.
+    std::unique_ptr<SaveGameNode> _root;
+
+    //! \brief The currently opened tables, the last one being the current table.
+    std::vector<SaveGameNode*> _open_tables;
+};
+
+/** ****************************************************************************
+*** \brief Writes the save files on a worker thread.
+***
+*** Each file is first written to a temporary file, flushed to the disk and then
+*** renamed over the previous one, so that a crash or a power loss in the middle
+*** of a save never leaves a half-written save file behind.
+*** ***************************************************************************/
+class SaveGameWriter
+{
+public:
+    SaveGameWriter();
+
+    //! \brief Writes the remaining files and stops the worker thread.
+    ~SaveGameWriter();
+
+    /** \brief Queues a save file to write, starting the worker thread if needed.
+    *** If the same file is still waiting to be written, only the newest content is written.
+    *** \param filename The save file to write.
+    *** \param root The save game tree, moved into the writer.
+    *** \param binary Whether the file is written in the binary save game format, rather than in Lua.
+    *** \param header_filename The save file header to write, if any, in the same format.
+    *** \param header_root The header tree, moved into the writer.
+    *** The previous header is removed first, and the new one only written once the save file is,
+    *** along with the size and checksum of the save file, so that a header never describes
+    *** another save file content. \see SaveGameHeader::Load()
+    *** \return false if the file couldn't be queued. It is then written right away.
+    **/
+    bool Write(const std::string& filename, std::unique_ptr<SaveGameNode>&& root, bool binary = false,
+               const std::string& header_filename = std::string(),
+               std::unique_ptr<SaveGameNode>&& header_root = std::unique_ptr<SaveGameNode>());
+
+    //! \brief Tells whether save files are waiting to be written, or being written.
+    bool IsWriting();
+
+    //! \brief Waits until every queued save file is written.
+    void WaitForCompletion();
+
+    //! \brief Tells whether the last written save file was written successfully.
+    bool HasLastWriteSucceeded();
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    SaveGameWriter(const SaveGameWriter& writer);
+    SaveGameWriter& operator=(const SaveGameWriter& writer);
+
+    //! \brief A save file waiting to be written.
+    struct SaveFile {
+        SaveFile():
+            _binary(false)
+        {}
+
+        std::string _filename;
+        std::unique_ptr<SaveGameNode> _root;
+        std::string _header_filename;
+        std::unique_ptr<SaveGameNode> _header_root;
+        bool _binary;
+    };
+
+    //! \brief Starts the worker thread, if not done yet.
+    bool _Start();
+
+    //! \brief Stops the worker thread, once every queued file is written.
+    void _Stop();
+
+    //! \brief The thread entry point.
+    static int _ThreadFunction(void* data);
+
+    //! \brief The worker thread loop.
+    void _Run();
+
+    /** \brief Writes a file through a temporary file, and replaces the previous one.
+    *** \return Whether the file was written.
+    **/
+    static bool _WriteFile(const std::string& filename, const std::string& data);
+
+    /** \brief Writes a save file and its header.
+    *** \return Whether the save file was written.
+    **/
+    static bool _WriteSaveFile(SaveFile& save_file);
+
+    //! \brief The files waiting to be written.
+    std::deque<SaveFile> _queue;
+
+    //! \brief Whether the worker thread is writing a file.
+    bool _writing;
+
+    //! \brief Whether the last written file was written successfully.
+    bool _last_write_succeeded;
+
+    //! \brief Whether the worker thread should exit.
+    bool _quit;
+
+    SDL_Thread* _thread;
+    SDL_mutex* _mutex;
+    SDL_cond* _condition;
+};
+
+} // namespace vt_global
+
+#endif // __SAVE_GAME_WRITER_HEADER__
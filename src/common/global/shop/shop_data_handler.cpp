@@ -40,7 +40,7 @@ void ShopDataHandler::SetShopData(const std::string& shop_id, const ShopData& sh
     _shop_data[shop_id] = shop_data;
 }
 
-void ShopDataHandler::LoadShopData(vt_script::ReadScriptDescriptor& file)
+void ShopDataHandler::LoadShopData(SaveGameReader& file)
 {
     if(file.IsFileOpen() == false) {
         PRINT_WARNING << "The file provided in the function argument was not open" << std::endl;
@@ -84,48 +84,41 @@ void ShopDataHandler::LoadShopData(vt_script::ReadScriptDescriptor& file)
     file.CloseTable(); // shop_data
 }
 
-void ShopDataHandler::SaveShopData(vt_script::WriteScriptDescriptor& file)
+void ShopDataHandler::SaveShopData(SaveGameBuffer& file)
 {
     if(!file.IsFileOpen()) {
         PRINT_WARNING << "The file was not open: " << file.GetFilename() << std::endl;
         return;
     }
 
-    file.WriteLine("shop_data = {");
-    file.InsertNewLine();
+    file.BeginTable("shop_data");
 
     auto it = _shop_data.begin();
     auto it_end = _shop_data.end();
     for (; it != it_end; ++it) {
-        std::string shop_id = it->first;
+        const std::string& shop_id = it->first;
         const ShopData& shop_data = it->second;
 
-        file.WriteLine("\t[\"" + shop_id + "\"] = {");
+        file.BeginTable(shop_id);
 
-        file.WriteLine("\t\tavailable_buy = {");
+        // The item ids are written as strings.
+        file.BeginTable("available_buy");
         auto it2 = shop_data._available_buy.begin();
         auto it2_end = shop_data._available_buy.end();
-        for(; it2 != it2_end; ++it2) {
-            std::string item_id = NumberToString(it2->first);
-            std::string count = NumberToString(it2->second);
-            file.WriteLine("\t\t\t[\"" + item_id + "\"] = " + count + ",");
-        }
-        file.WriteLine("\t\t},");
+        for(; it2 != it2_end; ++it2)
+            file.WriteUInt(NumberToString(it2->first), it2->second);
+        file.EndTable(); // available_buy
 
-        file.WriteLine("\t\tavailable_trade = {");
+        file.BeginTable("available_trade");
         auto it3 = shop_data._available_trade.begin();
         auto it3_end = shop_data._available_trade.end();
-        for(; it3 != it3_end; ++it3) {
-            std::string item_id = NumberToString(it3->first);
-            std::string count = NumberToString(it3->second);
-            file.WriteLine("\t\t\t[\"" + item_id + "\"] = " + count + ",");
-        }
-        file.WriteLine("\t\t}");
+        for(; it3 != it3_end; ++it3)
+            file.WriteUInt(NumberToString(it3->first), it3->second);
+        file.EndTable(); // available_trade
 
-        file.WriteLine("\t},");
+        file.EndTable(); // shop_id
     }
-    file.WriteLine("},"); // Close the shop_data table
-    file.InsertNewLine();
+    file.EndTable(); // Close the shop_data table
 }
 
 } // namespace vt_global
@@ -14,7 +14,8 @@
 #include "shop_data.h"
 
 #include "script/script_read.h"
-#include "script/script_write.h"
+#include "common/global/save/save_game_reader.h"
+#include "common/global/save/save_game_writer.h"
 
 #include <string>
 #include <map>
@@ -44,12 +45,12 @@ public:
     /** \brief Load shop data from the save game
     *** \param file Reference to an open file for reading save game data
     **/
-    void LoadShopData(vt_script::ReadScriptDescriptor& file);
+    void LoadShopData(SaveGameReader& file);
 
     /** \brief saves the shop data information. this is called from SaveGame()
     *** \param file Reference to open and valid file for writting the data
     **/
-    void SaveShopData(vt_script::WriteScriptDescriptor& file);
+    void SaveShopData(SaveGameBuffer& file);
 
 private:
     //! \brief A map of the curent shop data.
@@ -76,6 +76,16 @@ public:
         return _use_update_timer;
     }
 
+    /** \brief Tells whether the effect script update function should be called.
+    *** Effects with an update interval are updated each time it elapses,
+    *** and the other ones only when their state has changed, so that the scripts
+    *** aren't called on every frame for effects with nothing to update.
+    *** \param state_changed Whether the effect state changed since its last update.
+    **/
+    bool IsUpdateDue(bool state_changed) const {
+        return _use_update_timer ? _update_timer.IsFinished() : state_changed;
+    }
+
     //! \brief Sets the effect as invalid
     void Disable() {
         _type = GLOBAL_STATUS_INVALID;
@@ -149,7 +149,7 @@ void WorldMapHandler::SetWorldLocationVisible(const std::string& location_id, bo
     }
 }
 
-void WorldMapHandler::LoadPlayerSaveGameWorldMap(vt_script::ReadScriptDescriptor& file)
+void WorldMapHandler::LoadPlayerSaveGameWorldMap(SaveGameReader& file)
 {
     if(file.IsFileOpen() == false) {
         PRINT_WARNING << "the file provided in the function argument was not open" << std::endl;
@@ -177,7 +177,7 @@ void WorldMapHandler::LoadPlayerSaveGameWorldMap(vt_script::ReadScriptDescriptor
     file.CloseTable(); // world_map
 }
 
-void WorldMapHandler::SavePlayerSaveGameWorldMap(vt_script::WriteScriptDescriptor& file)
+void WorldMapHandler::SavePlayerSaveGameWorldMap(SaveGameBuffer& file)
 {
     if(!file.IsFileOpen()) {
         PRINT_WARNING << "The file provided in the function argument was not open" << std::endl;
@@ -185,28 +185,23 @@ void WorldMapHandler::SavePlayerSaveGameWorldMap(vt_script::WriteScriptDescripto
     }
 
     // Write the 'world_map' table
-    file.WriteLine("world_map = {");
+    file.BeginTable("world_map");
 
     // Write the world map filename
-    file.WriteLine("\tworld_map_id = \"" + _current_world_map_id + "\",");
-    file.InsertNewLine();
+    file.WriteString("world_map_id", _current_world_map_id);
 
     // Write the viewable locations
-    file.WriteLine("\tviewable_locations = {");
+    std::vector<std::string> viewable_locations;
     if (_current_world_map) {
         auto world_map_locations = _current_world_map->GetVisibleWorldMapLocations();
-        for(auto iter = world_map_locations.begin(); iter != world_map_locations.end(); ++iter) {
-            const std::string& location_id = iter->first;
-            file.WriteLine("\t\t\"" + location_id + "\",");
-        }
+        for(auto iter = world_map_locations.begin(); iter != world_map_locations.end(); ++iter)
+            viewable_locations.push_back(iter->first);
     }
-    file.WriteLine("\t},");
-    file.InsertNewLine();
+    file.WriteStringVector("viewable_locations", viewable_locations);
 
-    file.WriteLine("\tcurrent_location = \"" + GetCurrentLocationId() + "\"");
+    file.WriteString("current_location", GetCurrentLocationId());
 
-    file.WriteLine("},"); // close the main table
-    file.InsertNewLine();
+    file.EndTable(); // close the main table
 }
 
 } // namespace vt_global
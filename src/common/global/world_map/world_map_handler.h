@@ -14,7 +14,8 @@
 #include "world_map.h"
 
 #include "script/script_read.h"
-#include "script/script_write.h"
+#include "common/global/save/save_game_reader.h"
+#include "common/global/save/save_game_writer.h"
 #include "engine/video/image.h"
 #include "utils/ustring.h"
 
@@ -95,11 +96,11 @@ public:
 
     //! \brief Load world map and viewable information from the save game
     //! \param file Reference to an open file for reading save game data
-    void LoadPlayerSaveGameWorldMap(vt_script::ReadScriptDescriptor& file);
+    void LoadPlayerSaveGameWorldMap(SaveGameReader& file);
 
     //! \brief Saves the current world map information. this is called from SaveGame()
     //! \param file Reference to open and valid file for writting the data
-    void SavePlayerSaveGameWorldMap(vt_script::WriteScriptDescriptor& file);
+    void SavePlayerSaveGameWorldMap(SaveGameBuffer& file);
 
 private:
     //! \brief The container which stores all the available world maps information
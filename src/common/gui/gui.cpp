@@ -191,7 +191,8 @@ using namespace private_gui;
 // *****************************************************************************
 
 GUISystem::GUISystem():
-    _default_skin(nullptr)
+    _default_skin(nullptr),
+    _content_version(0)
 {
     _DEBUG_draw_outlines = false;
 }
@@ -299,6 +300,7 @@ bool GUISystem::SetDefaultMenuSkin(const std::string &skin_id)
     }
 
     _default_skin = &_menu_skins[skin_id];
+    MarkContentChanged();
     return true;
 }
 
@@ -360,6 +360,19 @@ public:
         return _DEBUG_draw_outlines;
     }
 
+    /** \brief Tells the cached GUI renders that the drawn GUI content changed.
+    *** The GUI controls call it when their content or selection changes, or while animated.
+    *** \see GUIRenderCache
+    **/
+    void MarkContentChanged() {
+        ++_content_version;
+    }
+
+    //! \brief Returns a number changing each time the drawn GUI content changes.
+    uint32_t GetContentVersion() const {
+        return _content_version;
+    }
+
     /** \brief Debug functioning for enabling/disabling the drawing of GUI element boundaries
     *** \param enable Set to true to enable outlines, false to disable
     **/
@@ -396,6 +409,9 @@ private:
     **/
     bool _DEBUG_draw_outlines;
 
+    //! \brief Incremented each time the drawn GUI content changes.
+    uint32_t _content_version;
+
     // ---------- Private methods
 
     /** \brief Returns a pointer to the MenuSkin of a corresponding skin name
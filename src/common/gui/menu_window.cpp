@@ -145,6 +145,7 @@ bool MenuWindow::_RecreateImage()
     }
 
     _menu_image.Clear();
+    GUIManager->MarkContentChanged();
 
     // Get information about the border sizes
     float left_border_size   = _skin->borders[1][0].GetWidth();
@@ -186,11 +186,15 @@ public:
 
     //! \brief Makes the current window visible
     void Show() {
+        if(_window_state != VIDEO_MENU_STATE_SHOWN)
+            GUIManager->MarkContentChanged();
         _window_state = VIDEO_MENU_STATE_SHOWN;
     }
 
     //! \brief Makes the current window hidden.
     void Hide() {
+        if(_window_state != VIDEO_MENU_STATE_HIDDEN)
+            GUIManager->MarkContentChanged();
         _window_state = VIDEO_MENU_STATE_HIDDEN;
     }
 
@@ -23,6 +23,7 @@
 #include "utils/utils_common.h"
 #include "utils/utils_strings.h"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
@@ -55,7 +56,8 @@ Option::~Option()
 Option::Option(const Option &copy) :
     disabled(copy.disabled),
     elements(copy.elements),
-    text(copy.text)
+    text(copy.text),
+    text_strings(copy.text_strings)
 {
     if(copy.image == nullptr) {
         image = nullptr;
@@ -76,6 +78,7 @@ Option &Option::operator=(const Option &copy)
     disabled = copy.disabled;
     elements = copy.elements;
     text = copy.text;
+    text_strings = copy.text_strings;
     if(copy.image == nullptr) {
         image = nullptr;
     } else {
@@ -92,6 +95,7 @@ void Option::Clear()
     disabled = false;
     elements.clear();
     text.clear();
+    text_strings.clear();
     if(image != nullptr) {
         delete image;
         image = nullptr;
@@ -115,6 +119,7 @@ OptionBox::OptionBox() :
     _vertical_wrap_mode(VIDEO_WRAP_MODE_NONE),
     _skip_disabled(false),
     _enable_switching(false),
+    _virtualized(false),
     _draw_left_column(0),
     _draw_top_row(0),
     _cursor_offset(0.0f, 0.0f),
@@ -152,6 +157,7 @@ void OptionBox::Update(uint32_t frame_time)
         return;
     }
 
+    GUIManager->MarkContentChanged();
     _scroll_time += frame_time;
 
     // Clamp the scroll time to prevent over animation.
@@ -271,6 +277,15 @@ void OptionBox::Draw()
     // [phuedx] Align the scroll offset with the current coordinate system
     _scroll_offset *= cs.GetVerticalDirection();
 
+    // Render the text of the options around the visible ones only.
+    if (_virtualized) {
+        uint32_t first_index = _draw_top_row * _number_cell_columns + _draw_left_column;
+        uint32_t end_index = (_draw_top_row + _number_cell_rows) * _number_cell_columns + _draw_left_column;
+        uint32_t margin = VIDEO_OPTION_VIRTUALIZED_MARGIN_ROWS * _number_cell_columns;
+        first_index = (first_index > margin) ? first_index - margin : 0;
+        _MaterializeOptions(first_index, end_index + margin);
+    }
+
     OptionCellBounds bounds;
     bounds.y_top = top + _scroll_offset;
     bounds.y_center = bounds.y_top - (0.5f * _cell_height * cs.GetVerticalDirection());
@@ -414,13 +429,41 @@ void OptionBox::SetOptions(const std::vector<ustring>& option_text)
 
 void OptionBox::ClearOptions()
 {
+    // Keep the rendered text images for the next options.
+    for (uint32_t i = 0; i < _materialized_options.size(); ++i) {
+        if (_materialized_options[i] < _options.size())
+            _ReleaseOptionText(_options[_materialized_options[i]]);
+    }
+    _materialized_options.clear();
+
     _options.clear();
+    GUIManager->MarkContentChanged();
+}
+
+void OptionBox::SetVirtualized(bool virtualized)
+{
+    if (_virtualized == virtualized)
+        return;
+
+    _virtualized = virtualized;
+
+    if (_virtualized) {
+        // The text is rendered again when drawn.
+        for (uint32_t i = 0; i < _options.size(); ++i)
+            _ReleaseOptionText(_options[i]);
+        return;
+    }
+
+    _MaterializeOptions(0, _options.size());
+    _materialized_options.clear();
+    _text_image_pool.clear();
 }
 
 void OptionBox::ResetViewableOption()
 {
     _draw_top_row = 0;
     _draw_left_column = 0;
+    GUIManager->MarkContentChanged();
 }
 
 void OptionBox::AddOption()
@@ -460,11 +503,16 @@ void OptionBox::AddOptionElementText(uint32_t option_index, const ustring &text)
     OptionElement new_element;
 
     new_element.type = VIDEO_OPTION_ELEMENT_TEXT;
-    new_element.value = static_cast<int32_t>(this_option.text.size());
+    new_element.value = static_cast<int32_t>(this_option.text_strings.size());
 
-    TextImage text_image(text, _text_style);
-    this_option.text.push_back(text_image);
+    this_option.text_strings.push_back(text);
+    // In a virtualized option box, the text is rendered when the option is about to be shown.
+    if(!_virtualized)
+        this_option.text.push_back(TextImage(text, _text_style));
+    else
+        _ReleaseOptionText(this_option);
     this_option.elements.push_back(new_element);
+    GUIManager->MarkContentChanged();
 }
 
 
@@ -491,6 +539,7 @@ void OptionBox::AddOptionElementImage(uint32_t option_index, const std::string &
     }
 
     this_option.elements.push_back(new_element);
+    GUIManager->MarkContentChanged();
 }
 
 
@@ -514,6 +563,7 @@ void OptionBox::AddOptionElementImage(uint32_t option_index, const StillImage* i
 
     this_option.image = new StillImage(*image);
     this_option.elements.push_back(new_element);
+    GUIManager->MarkContentChanged();
 }
 
 
@@ -536,6 +586,7 @@ void OptionBox::AddOptionElementAlignment(uint32_t option_index, OptionElementTy
     new_element.type = position_type;
     new_element.value = 0;
     this_option.elements.push_back(new_element);
+    GUIManager->MarkContentChanged();
 }
 
 
@@ -553,6 +604,7 @@ void OptionBox::AddOptionElementPosition(uint32_t option_index, uint32_t positio
     new_element.type = VIDEO_OPTION_ELEMENT_POSITION;
     new_element.value = position_length;
     this_option.elements.push_back(new_element);
+    GUIManager->MarkContentChanged();
 }
 
 
@@ -578,6 +630,7 @@ void OptionBox::SetSelection(uint32_t index)
     }
 
     _selection = index;
+    GUIManager->MarkContentChanged();
     int32_t select_row = _selection / _number_columns;
 
     // If the new selection isn't currently being displayed, instantly scroll to it
@@ -604,6 +657,7 @@ void OptionBox::EnableOption(uint32_t index, bool enable)
     }
 
     _options[index].disabled = !enable;
+    GUIManager->MarkContentChanged();
 }
 
 
@@ -645,8 +699,15 @@ void OptionBox::InputConfirm()
     if(_scrolling || _event || _options[_selection].disabled)
         return;
 
+    GUIManager->MarkContentChanged();
+
     // Case #1: switch the position of two different options
     if(_enable_switching && _first_selection >= 0 && _selection != _first_selection) {
+        // The rendered text is tracked by option index.
+        if(_virtualized) {
+            _ReleaseOptionText(_options[_selection]);
+            _ReleaseOptionText(_options[_first_selection]);
+        }
         Option temp = _options[_selection];
         _options[_selection] = _options[_first_selection];
         _options[_first_selection] = temp;
@@ -677,8 +738,10 @@ void OptionBox::InputCancel()
         return;
 
     // If we're in switching mode unselect the first selection
-    if(_first_selection >= 0)
+    if(_first_selection >= 0) {
         _first_selection = -1;
+        GUIManager->MarkContentChanged();
+    }
     else
         _event = VIDEO_OPTION_CANCEL;
 }
@@ -823,6 +886,10 @@ void OptionBox::SetTextStyle(const TextStyle &style)
     }
 
     _text_style = style;
+    GUIManager->MarkContentChanged();
+
+    // The pooled text images are rendered in the previous style.
+    _text_image_pool.clear();
 
     // Update any existing TextImage texts with new font style
     for (uint32_t i = 0; i < _options.size(); ++i) {
@@ -841,6 +908,8 @@ void OptionBox::SetCursorState(CursorState state)
         return;
     }
 
+    if(_cursor_state != state)
+        GUIManager->MarkContentChanged();
     _cursor_state = state;
 }
 
@@ -864,7 +933,9 @@ void OptionBox::SetVerticalArrowsPosition(VERTICAL_ARROWS_POSITION position)
 
 bool OptionBox::_ConstructOption(const ustring &format_string, Option &op)
 {
+    _ReleaseOptionText(op);
     op.Clear();
+    GUIManager->MarkContentChanged();
 
     // This is a valid case. It simply means we add an option with no tags, text, or other data.
     if(format_string.empty()) {
@@ -939,20 +1010,22 @@ bool OptionBox::_ConstructOption(const ustring &format_string, Option &op)
 
         else { // If this isn't a tag, then it is raw text that should be added to the option
             new_element.type = VIDEO_OPTION_ELEMENT_TEXT;
-            new_element.value = static_cast<int32_t>(op.text.size());
+            new_element.value = static_cast<int32_t>(op.text_strings.size());
 
             // find the distance until the next tag
             size_t tag_begin = tmp.find(OPEN_TAG);
 
             if(tag_begin == ustring::npos) {  // There are no more tags remaining, so extract the entire string
-                TextImage text_image(tmp, _text_style);
-                op.text.push_back(text_image);
+                op.text_strings.push_back(tmp);
                 tmp.clear();
             } else { // Another tag remains to be processed, so extract the text substring
-                TextImage text_image(tmp.substr(0, tag_begin), _text_style);
-                op.text.push_back(text_image);
+                op.text_strings.push_back(tmp.substr(0, tag_begin));
                 tmp = tmp.substr(tag_begin, tmp.length() - tag_begin);
             }
+
+            // In a virtualized option box, the text is rendered when the option is about to be shown.
+            if(!_virtualized)
+                op.text.push_back(TextImage(op.text_strings.back(), _text_style));
         }
 
         op.elements.push_back(new_element);
@@ -963,6 +1036,62 @@ bool OptionBox::_ConstructOption(const ustring &format_string, Option &op)
 
 
 
+void OptionBox::_MaterializeOptions(uint32_t begin_index, uint32_t end_index)
+{
+    if(end_index > _options.size())
+        end_index = _options.size();
+
+    // Release the text of the options not around the view anymore first, so that it can be reused.
+    for(uint32_t i = 0; i < _materialized_options.size();) {
+        uint32_t index = _materialized_options[i];
+        if(index >= begin_index && index < end_index) {
+            ++i;
+            continue;
+        }
+
+        if(index < _options.size())
+            _ReleaseOptionText(_options[index]);
+        _materialized_options[i] = _materialized_options.back();
+        _materialized_options.pop_back();
+    }
+
+    for(uint32_t index = begin_index; index < end_index; ++index) {
+        Option &op = _options[index];
+        if(!op.text.empty() || op.text_strings.empty())
+            continue;
+
+        for(uint32_t i = 0; i < op.text_strings.size(); ++i) {
+            if(_text_image_pool.empty()) {
+                op.text.push_back(TextImage(op.text_strings[i], _text_style));
+                continue;
+            }
+
+            // Only renders the text again when it differs.
+            op.text.push_back(_text_image_pool.back());
+            _text_image_pool.pop_back();
+            op.text.back().SetText(op.text_strings[i]);
+        }
+
+        if(std::find(_materialized_options.begin(), _materialized_options.end(), index) == _materialized_options.end())
+            _materialized_options.push_back(index);
+    }
+}
+
+
+
+void OptionBox::_ReleaseOptionText(Option &option)
+{
+    if(!_virtualized) {
+        return;
+    }
+
+    for(uint32_t i = 0; i < option.text.size(); ++i)
+        _text_image_pool.push_back(option.text[i]);
+    option.text.clear();
+}
+
+
+
 bool OptionBox::_ChangeSelection(int32_t offset, bool horizontal)
 {
     // Do nothing if the movement is horizontal and there is only one column with no horizontal wrap shifting
@@ -973,6 +1102,8 @@ bool OptionBox::_ChangeSelection(int32_t offset, bool horizontal)
     if((horizontal == false) && (_number_cell_rows == 1) && (_vertical_wrap_mode != VIDEO_WRAP_MODE_SHIFTED))
         return false;
 
+    GUIManager->MarkContentChanged();
+
     // Get the row, column coordinates for the current selection
     int32_t row = _selection / _number_columns;
     int32_t col = _selection % _number_columns;
@@ -31,6 +31,9 @@ namespace vt_gui
 //! \brief The number of milliseconds it takes to scroll when the cursor goes past the end of an option box
 const int32_t VIDEO_OPTION_SCROLL_TIME = 100;
 
+//! \brief The number of rows of options kept rendered above and below the visible ones, in a virtualized option box
+const uint32_t VIDEO_OPTION_VIRTUALIZED_MARGIN_ROWS = 2;
+
 //! \brief These are the types of events that an option box can generate
 enum OptionBoxEvent {
     VIDEO_OPTION_INVALID          = -1,
@@ -214,8 +217,12 @@ public:
     std::vector<OptionElement> elements;
 
     //! \brief Contains all pieces of text for this option (as pre-rendered images)
+    //! In a virtualized option box, only the options around the visible ones have them.
     std::vector<vt_video::TextImage> text;
 
+    //! \brief The strings of the text pieces, used to render them again when needed
+    std::vector<vt_utils::ustring> text_strings;
+
     //! \brief Contains all images used for this option
     vt_video::StillImage *image;
 }; // class Option
@@ -281,6 +288,13 @@ public:
     //! \brief Removes all options and their allocated data from the OptionBox
     void ClearOptions();
 
+    /** \brief Only renders the text of the visible options, and of a few rows around them.
+    *** \param virtualized Whether the option box is virtualized
+    *** Meant for long lists, such as inventories: the options only keep their text strings,
+    *** and the rendered text images are recycled for the next options shown when scrolling.
+    **/
+    void SetVirtualized(bool virtualized);
+
     /** \brief Adds a blank new option to the OptionBox
     *** The option added is an empty string. Invoke the various AddOptionElement*() methods to construct the option after this call.
     **/
@@ -498,6 +512,10 @@ public:
     uint32_t GetNumberOptions() const {
         return _options.size();
     }
+
+    bool IsVirtualized() const {
+        return _virtualized;
+    }
     //@}
 
 private:
@@ -530,6 +548,15 @@ private:
 
     //! \brief When set to true, the user may switch the locations of two different options
     bool _enable_switching;
+
+    //! \brief When true, only the options around the visible ones have their text rendered
+    bool _virtualized;
+
+    //! \brief The indices of the options whose text is rendered, in a virtualized option box
+    std::vector<uint32_t> _materialized_options;
+
+    //! \brief The rendered text images not used anymore, recycled for the next options to render
+    std::vector<vt_video::TextImage> _text_image_pool;
     //@}
 
     //! \name Drawing Related Members
@@ -609,6 +636,16 @@ private:
     **/
     bool _ConstructOption(const vt_utils::ustring &format_string, private_gui::Option &option);
 
+    /** \brief Renders the text of the options in the given range, and releases the text of the other ones
+    *** \param begin_index The first option index to render
+    *** \param end_index The option index past the last one to render
+    *** Only used by virtualized option boxes.
+    **/
+    void _MaterializeOptions(uint32_t begin_index, uint32_t end_index);
+
+    //! \brief Puts the rendered text images of an option back in the pool for later use
+    void _ReleaseOptionText(private_gui::Option &option);
+
     /** \brief Changes the selected option by making a movement relative to the current selection
     *** \param offset The amount to move in specified direction (ie 1 row up, 1 column right, etc.)
     *** \param horizontal true if moving horizontally, false if moving vertically
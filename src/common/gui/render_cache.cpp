@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    render_cache.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the cached GUI renders
+*** ***************************************************************************/
+
+#include "render_cache.h"
+
+#include "common/gui/gui.h"
+#include "engine/input.h"
+#include "engine/video/video.h"
+#include "engine/video/gl/gl_render_target.h"
+
+#include "utils/utils_common.h"
+
+#include <SDL2/SDL_timer.h>
+
+using namespace vt_video;
+
+namespace vt_gui
+{
+
+GUIRenderCache::GUIRenderCache():
+    _render_target(nullptr),
+    _content_version(0),
+    _change_time(0),
+    _dirty(true),
+    _drawing(false),
+    _enabled(true)
+{
+}
+
+GUIRenderCache::~GUIRenderCache()
+{
+    if (_render_target == nullptr || VideoManager == nullptr)
+        return;
+
+    // The OpenGL objects are deleted by the thread owning the context.
+    gl::RenderTarget* render_target = _render_target;
+    VideoManager->SubmitGLCommand([render_target]() { delete render_target; });
+    _render_target = nullptr;
+}
+
+bool GUIRenderCache::BeginDraw()
+{
+    _drawing = false;
+
+    // The outlines are drawn over the controls, so caching is disabled meanwhile.
+    if (!_enabled || GUIManager->DEBUG_DrawOutlines())
+        return true;
+
+    if (!_UpdateRenderTarget()) {
+        _enabled = false;
+        return true;
+    }
+
+    const vt_input::InputEngine* input = vt_input::InputManager;
+    if (GUIManager->GetContentVersion() != _content_version
+            || input->AnyRegisteredKeyPress() || input->AnyRegisteredKeyRelease()
+            || input->UpState() || input->DownState() || input->LeftState() || input->RightState()) {
+        _dirty = true;
+    }
+
+    // The settle time is elapsed time, however often the content is drawn.
+    uint32_t ticks = SDL_GetTicks();
+    if (_dirty) {
+        _dirty = false;
+        _change_time = ticks;
+    }
+    else if (ticks - _change_time >= GUI_RENDER_CACHE_SETTLE_TIME) {
+        // Nothing changed: the cached frame is drawn as is.
+        return false;
+    }
+
+    _content_version = GUIManager->GetContentVersion();
+
+    VideoManager->BindRenderTarget(_render_target);
+    VideoManager->Clear();
+    _drawing = true;
+    return true;
+}
+
+void GUIRenderCache::EndDraw()
+{
+    if (!_enabled || _render_target == nullptr || GUIManager->DEBUG_DrawOutlines())
+        return;
+
+    if (_drawing) {
+        VideoManager->BindRenderTarget(nullptr);
+        _drawing = false;
+    }
+
+    VideoManager->DrawRenderTarget(_render_target);
+}
+
+bool GUIRenderCache::_UpdateRenderTarget()
+{
+    uint32_t width = static_cast<uint32_t>(VideoManager->GetScreenWidth());
+    uint32_t height = static_cast<uint32_t>(VideoManager->GetScreenHeight());
+    if (width == 0 || height == 0)
+        return false;
+
+    if (_render_target != nullptr) {
+        if (_render_target->GetWidth() == width && _render_target->GetHeight() == height)
+            return true;
+
+        // The screen was resized.
+        gl::RenderTarget* render_target = _render_target;
+        VideoManager->RunGLCommand([render_target, width, height]() { render_target->Resize(width, height); });
+        _dirty = true;
+        return true;
+    }
+
+    // The render target is needed right away, so wait for the render thread to create it.
+    gl::RenderTarget* render_target = nullptr;
+    VideoManager->RunGLCommand([&render_target, width, height]() {
+        try {
+            render_target = new gl::RenderTarget(width, height);
+        } catch(const char* error) {
+            PRINT_WARNING << "Couldn't create the GUI render cache: " << error << std::endl;
+            render_target = nullptr;
+        }
+    });
+
+    _render_target = render_target;
+    _dirty = true;
+    return (_render_target != nullptr);
+}
+
+} // namespace vt_gui
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    render_cache.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the cached GUI renders
+***
+*** Menu screens mostly change on input, yet they were drawn entirely each frame.
+*** A game mode drawing its menus through a render cache only draws them when
+*** their content changed, into an offscreen render target. The other frames
+*** only draw the render target onto the screen:
+***
+*** \code
+*** void ExampleMode::Draw()
+*** {
+***     if (_render_cache.BeginDraw()) {
+***         // Draw the menus as usual.
+***     }
+***     _render_cache.EndDraw();
+*** }
+*** \endcode
+***
+*** The content is considered changed when a GUI control reported a change,
+*** \see GUISystem::MarkContentChanged(), when the player pressed, released
+*** or held a key, or when MarkDirty() was called. The content is then drawn
+*** for a short time, to let the changes triggered by it settle.
+*** ***************************************************************************/
+
+#ifndef __RENDER_CACHE_HEADER__
+#define __RENDER_CACHE_HEADER__
+
+#include <cstdint>
+
+namespace vt_video
+{
+namespace gl
+{
+class RenderTarget;
+}
+}
+
+namespace vt_gui
+{
+
+//! \brief The time the content is drawn anyway after it changed, in milliseconds.
+const uint32_t GUI_RENDER_CACHE_SETTLE_TIME = 250;
+
+/** ****************************************************************************
+*** \brief Draws the menus of a game mode only when their content changed.
+***
+*** The cached content must cover the whole screen, as the cached frame
+*** replaces the screen content when drawn again.
+*** ***************************************************************************/
+class GUIRenderCache
+{
+public:
+    GUIRenderCache();
+
+    ~GUIRenderCache();
+
+    /** \brief Tells whether the content must be drawn this frame.
+    *** \return True when the content must be drawn. It is then drawn into the cache
+    *** until EndDraw() is called. False when the cached frame can be drawn instead.
+    **/
+    bool BeginDraw();
+
+    //! \brief Draws the cached frame onto the screen. Must be called after each BeginDraw() call.
+    void EndDraw();
+
+    //! \brief Forces the content to be drawn again, typically when a game mode is reset.
+    void MarkDirty() {
+        _dirty = true;
+    }
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    GUIRenderCache(const GUIRenderCache& cache);
+    GUIRenderCache& operator=(const GUIRenderCache& cache);
+
+    //! \brief Creates the render target, or resizes it to the screen size. \return false on failure.
+    bool _UpdateRenderTarget();
+
+    //! \brief The offscreen render target holding the last frame drawn, or nullptr.
+    vt_video::gl::RenderTarget* _render_target;
+
+    //! \brief The GUI content version when the cached frame was drawn.
+    uint32_t _content_version;
+
+    //! \brief The SDL ticks when the content last changed, in milliseconds.
+    uint32_t _change_time;
+
+    //! \brief Whether the content must be drawn again.
+    bool _dirty;
+
+    //! \brief Whether the content is being drawn into the render target.
+    bool _drawing;
+
+    //! \brief Set to false when the render target couldn't be created. The content is then always drawn.
+    bool _enabled;
+};
+
+} // namespace vt_gui
+
+#endif // __RENDER_CACHE_HEADER__
@@ -73,6 +73,7 @@ TextBox::TextBox(float x, float y, float width, float height, const TEXT_DISPLAY
 
 void TextBox::ClearText()
 {
+    GUIManager->MarkContentChanged();
     _finished = true;
     _text.clear();
     _num_chars = 0;
@@ -85,6 +86,8 @@ void TextBox::Update(uint32_t time)
     if (_finished)
         return;
 
+    // The text is being displayed gradually.
+    GUIManager->MarkContentChanged();
     _current_time += time;
 
     if(_text.empty() == false && _current_time > _end_time)
@@ -228,6 +231,8 @@ void TextBox::SetDisplayText(const ustring &text)
 
 void TextBox::_ReformatText()
 {
+    GUIManager->MarkContentChanged();
+
     // Go through the text ustring and determine where the newline characters can be found,
     // examining one line at a time and adding it to the _text vector.
     _text.clear();
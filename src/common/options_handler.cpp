@@ -1308,6 +1308,10 @@ bool GameOptionsMenuHandler::_SaveSettingsFile(const std::string& filename)
     settings_lua.WriteBool("full_screen", VideoManager->IsFullscreen());
     settings_lua.WriteComment("Get the desired VSync mode. 0: No VSync, 1: VSync, 2: Swap Tearing");
     settings_lua.WriteUInt("vsync_mode", VideoManager->GetVSyncMode());
+    settings_lua.WriteComment("The maximum number of frames rendered per second. 0: Unlocked, only limited by VSync");
+    settings_lua.WriteUInt("frame_rate_limit", VideoManager->GetFrameRateLimit());
+    settings_lua.WriteComment("Run the OpenGL calls on a dedicated render thread, overlapped with the game update (experimental)");
+    settings_lua.WriteBool("render_thread", VideoManager->IsRenderThreadEnabled());
     settings_lua.WriteComment("The UI Theme to load.");
     settings_lua.WriteString("ui_theme", GUIManager->GetDefaultMenuSkinId());
     settings_lua.EndTable(); // video_settings
@@ -1378,6 +1382,8 @@ bool GameOptionsMenuHandler::_SaveSettingsFile(const std::string& filename)
     settings_lua.WriteInt("message_speed", SystemManager->GetMessageSpeed());
     settings_lua.WriteComment("Sets whether each character will remember their previous action in battle. (Default: 'true')");
     settings_lua.WriteBool("battle_target_cursor_memory", SystemManager->GetBattleTargetMemory());
+    settings_lua.WriteComment("Sets whether the save games are written in the binary format, faster to load than Lua. (Default: 'false')");
+    settings_lua.WriteBool("binary_save_games", SystemManager->GetBinarySaveGames());
     settings_lua.EndTable(); // game_options
 
     settings_lua.EndTable(); // settings
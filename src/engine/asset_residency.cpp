@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    asset_residency.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the game mode assets residency manager
+*** ***************************************************************************/
+
+#include "engine/asset_residency.h"
+
+#include "engine/audio/audio.h"
+#include "engine/video/texture_controller.h"
+
+#include "utils/utils_common.h"
+
+#include <vector>
+
+using namespace vt_audio;
+using namespace vt_video;
+
+namespace vt_mode_manager
+{
+
+AssetResidencyManager::AssetResidencyManager():
+    _recording_mode(nullptr),
+    _resident_bytes(0),
+    _memory_budget(DEFAULT_ASSET_RESIDENCY_BUDGET)
+{
+}
+
+AssetResidencyManager::~AssetResidencyManager()
+{
+    _RecordIn(nullptr);
+    ReleaseAll();
+}
+
+void AssetResidencyManager::DeclareModeManifest(GameMode* mode, const std::string& manifest_name)
+{
+    if (mode == nullptr || manifest_name.empty())
+        return;
+
+    if (_mode_manifests.find(mode) != _mode_manifests.end()) {
+        PRINT_WARNING << "The game mode already declared a manifest, ignoring: " << manifest_name << std::endl;
+        return;
+    }
+
+    _mode_manifests[mode] = manifest_name;
+    AssetManifest& manifest = _manifests[manifest_name];
+
+    // Decode the image files that aren't loaded anymore ahead of time.
+    if (TextureManager != nullptr) {
+        std::vector<std::string> files_to_preload;
+        for (std::set<std::string>::const_iterator it = manifest.image_files.begin();
+                it != manifest.image_files.end(); ++it) {
+            if (!TextureManager->IsImageFileLoaded(*it))
+                files_to_preload.push_back(*it);
+        }
+        if (!files_to_preload.empty())
+            TextureManager->PreloadImages(files_to_preload);
+    }
+
+    _recording_mode = mode;
+    _RecordIn(&manifest);
+}
+
+void AssetResidencyManager::SetActiveMode(GameMode* mode)
+{
+    std::map<GameMode*, std::string>::const_iterator it = _mode_manifests.find(mode);
+    if (it == _mode_manifests.end()) {
+        _recording_mode = nullptr;
+        _RecordIn(nullptr);
+        return;
+    }
+
+    _recording_mode = mode;
+    _RecordIn(&_manifests[it->second]);
+}
+
+void AssetResidencyManager::RetainModeAssets(GameMode* mode)
+{
+    std::map<GameMode*, std::string>::const_iterator it = _mode_manifests.find(mode);
+    if (it == _mode_manifests.end())
+        return;
+
+    const std::string& manifest_name = it->second;
+    AssetManifest& manifest = _manifests[manifest_name];
+
+    // Retain the files not already resident, while the mode still uses them.
+    for (std::set<std::string>::const_iterator file = manifest.image_files.begin();
+            file != manifest.image_files.end(); ++file) {
+        if (manifest.retained_image_files.find(*file) != manifest.retained_image_files.end())
+            continue;
+
+        uint32_t new_bytes = 0;
+        if (!TextureManager->RetainImageFile(*file, new_bytes))
+            continue;
+        manifest.retained_image_files.insert(*file);
+        _resident_bytes += new_bytes;
+    }
+
+    for (std::set<std::string>::const_iterator file = manifest.audio_files.begin();
+            file != manifest.audio_files.end(); ++file) {
+        if (manifest.retained_audio_files.find(*file) != manifest.retained_audio_files.end())
+            continue;
+
+        if (AudioManager->RetainAudio(*file))
+            manifest.retained_audio_files.insert(*file);
+    }
+
+    // The manifest is now the most recently used one.
+    _resident_manifests.remove(manifest_name);
+    _resident_manifests.push_back(manifest_name);
+
+    _EnforceBudget();
+}
+
+void AssetResidencyManager::RemoveMode(GameMode* mode)
+{
+    _mode_manifests.erase(mode);
+
+    if (_recording_mode == mode) {
+        _recording_mode = nullptr;
+        _RecordIn(nullptr);
+    }
+}
+
+void AssetResidencyManager::SetMemoryBudget(uint32_t bytes)
+{
+    _memory_budget = bytes;
+    _EnforceBudget();
+}
+
+void AssetResidencyManager::ReleaseAll()
+{
+    while (!_resident_manifests.empty()) {
+        // Copied, as releasing removes it from the list.
+        std::string manifest_name = _resident_manifests.front();
+        _Release(manifest_name);
+    }
+}
+
+void AssetResidencyManager::_RecordIn(AssetManifest* manifest)
+{
+    if (TextureManager != nullptr)
+        TextureManager->SetImageFileRecorder(manifest ? &manifest->image_files : nullptr);
+    if (AudioManager != nullptr)
+        AudioManager->SetAudioFileRecorder(manifest ? &manifest->audio_files : nullptr);
+}
+
+void AssetResidencyManager::_Release(const std::string& manifest_name)
+{
+    _resident_manifests.remove(manifest_name);
+
+    AssetManifest& manifest = _manifests[manifest_name];
+    for (std::set<std::string>::const_iterator file = manifest.retained_image_files.begin();
+            file != manifest.retained_image_files.end(); ++file) {
+        _resident_bytes -= TextureManager->ReleaseImageFile(*file);
+    }
+    for (std::set<std::string>::const_iterator file = manifest.retained_audio_files.begin();
+            file != manifest.retained_audio_files.end(); ++file) {
+        AudioManager->ReleaseAudio(*file);
+    }
+
+    manifest.retained_image_files.clear();
+    manifest.retained_audio_files.clear();
+}
+
+void AssetResidencyManager::_EnforceBudget()
+{
+    while (_resident_bytes > _memory_budget && !_resident_manifests.empty()) {
+        std::string manifest_name = _resident_manifests.front();
+        _Release(manifest_name);
+    }
+}
+
+} // namespace vt_mode_manager
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    asset_residency.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the game mode assets residency manager
+***
+*** Game modes load their images and sounds as they are created, and free them
+*** once deleted. Entering the same kind of mode again, a battle on the same map
+*** for instance, used to load the same files from disk again.
+***
+*** Each game mode can declare an asset manifest, named after what it shows.
+*** The image and audio files loaded while the mode is created or active are
+*** recorded in it. When the mode is deleted, its assets are kept resident
+*** within a texture memory budget, the least recently used manifests being
+*** released first. When a mode declaring a known manifest is created, the image
+*** files not resident anymore are decoded on a worker thread ahead of its loading.
+*** ***************************************************************************/
+
+#ifndef __ASSET_RESIDENCY_HEADER__
+#define __ASSET_RESIDENCY_HEADER__
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+
+namespace vt_mode_manager
+{
+
+class GameMode;
+
+//! \brief The default texture memory the resident assets can use, in bytes.
+const uint32_t DEFAULT_ASSET_RESIDENCY_BUDGET = 64 * 1024 * 1024;
+
+//! \brief The assets used by a kind of game mode.
+struct AssetManifest {
+    //! \brief The image and audio files recorded for the manifest.
+    std::set<std::string> image_files;
+    std::set<std::string> audio_files;
+
+    //! \brief The files currently kept resident.
+    std::set<std::string> retained_image_files;
+    std::set<std::string> retained_audio_files;
+};
+
+/** ****************************************************************************
+*** \brief Keeps the assets of the last game modes resident, and prefetches them.
+***
+*** The manager is owned by the mode engine. \see ModeEngine::GetAssetResidency()
+*** ***************************************************************************/
+class AssetResidencyManager
+{
+public:
+    AssetResidencyManager();
+
+    //! \brief Releases all the resident assets.
+    ~AssetResidencyManager();
+
+    /** \brief Declares the manifest of a game mode, and prefetches the image files it recorded.
+    *** It must be called before the mode loads its assets, typically from its constructor.
+    *** The assets loaded from then on, and while the mode is active, are recorded in the manifest.
+    *** \param mode The game mode.
+    *** \param manifest_name The manifest name, shared by the modes using the same assets.
+    **/
+    void DeclareModeManifest(GameMode* mode, const std::string& manifest_name);
+
+    //! \brief Records the assets loaded from now on in the manifest of the given active mode, if any.
+    void SetActiveMode(GameMode* mode);
+
+    //! \brief Keeps the assets of a game mode about to be deleted resident, within the memory budget.
+    void RetainModeAssets(GameMode* mode);
+
+    //! \brief Forgets a deleted game mode.
+    void RemoveMode(GameMode* mode);
+
+    //! \brief Sets the texture memory the resident assets can use, releasing the oldest ones if needed.
+    void SetMemoryBudget(uint32_t bytes);
+
+    uint32_t GetMemoryBudget() const {
+        return _memory_budget;
+    }
+
+    //! \brief Returns the texture memory used by the resident assets, in bytes.
+    uint32_t GetResidentBytes() const {
+        return _resident_bytes;
+    }
+
+    //! \brief Releases all the resident assets. The existing modes keep their own ones.
+    void ReleaseAll();
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    AssetResidencyManager(const AssetResidencyManager& manager);
+    AssetResidencyManager& operator=(const AssetResidencyManager& manager);
+
+    //! \brief Records the loaded assets in the given manifest, or stops recording with nullptr.
+    void _RecordIn(AssetManifest* manifest);
+
+    //! \brief Releases the resident assets of a manifest.
+    void _Release(const std::string& manifest_name);
+
+    //! \brief Releases the least recently used manifests until the resident assets fit in the budget.
+    void _EnforceBudget();
+
+    //! \brief The known manifests, by name.
+    std::map<std::string, AssetManifest> _manifests;
+
+    //! \brief The manifest names of the existing game modes that declared one.
+    std::map<GameMode*, std::string> _mode_manifests;
+
+    //! \brief The names of the manifests with resident assets, the least recently used first.
+    std::list<std::string> _resident_manifests;
+
+    //! \brief The game mode whose assets are being recorded, or nullptr.
+    GameMode* _recording_mode;
+
+    //! \brief The texture memory used by the resident assets, in bytes. Files shared by several manifests are counted once.
+    uint32_t _resident_bytes;
+
+    //! \brief The texture memory the resident assets can use, in bytes.
+    uint32_t _memory_budget;
+};
+
+} // namespace vt_mode_manager
+
+#endif // __ASSET_RESIDENCY_HEADER__
@@ -46,7 +46,8 @@ AudioEngine::AudioEngine() :
     _device(0),
     _context(0),
     _max_sources(MAX_DEFAULT_AUDIO_SOURCES),
-    _active_music(nullptr)
+    _active_music(nullptr),
+    _audio_file_recorder(nullptr)
 {}
 
 bool AudioEngine::SingletonInitialize()
@@ -209,6 +210,8 @@ void AudioEngine::Update()
     if(!AUDIO_ENABLE)
         return;
 
+    vt_system::ProfilerZone zone("AudioEngine::Update");
+
     for(std::vector<AudioSource *>::iterator i = _audio_sources.begin(); i != _audio_sources.end(); ++i) {
         if((*i)->owner) {
             (*i)->owner->_Update();
@@ -502,8 +505,11 @@ void AudioEngine::RemoveGameModeOwner(vt_mode_manager::GameMode* gm)
     // Tells all audio descriptor the owner can be removed.
     std::map<std::string, AudioCacheElement>::iterator it = _audio_cache.begin();
     for(; it != _audio_cache.end();) {
+        // Retained audio stays loaded until released.
+        bool retained = _retained_audio.find(it->first) != _retained_audio.end();
+
         // If the audio buffers are erased, we can remove the descriptor from the cache.
-        if(it->second.audio->RemoveGameModeOwner(gm)) {
+        if(it->second.audio->RemoveGameModeOwner(gm, !retained)) {
             delete it->second.audio;
             // Make sure the iterator doesn't get flawed after erase.
             _audio_cache.erase(it++);
@@ -513,6 +519,45 @@ void AudioEngine::RemoveGameModeOwner(vt_mode_manager::GameMode* gm)
     }
 }
 
+bool AudioEngine::RetainAudio(const std::string& filename)
+{
+    std::map<std::string, AudioCacheElement>::const_iterator it = _audio_cache.find(filename);
+    if(it == _audio_cache.end())
+        return false;
+
+    std::map<std::string, uint32_t>::iterator retained = _retained_audio.find(filename);
+    if(retained != _retained_audio.end()) {
+        ++retained->second;
+        return true;
+    }
+
+    // The audio never owned by a game mode is never freed anyway.
+    if(it->second.audio->GetGameModeOwners()->empty())
+        return false;
+
+    _retained_audio[filename] = 1;
+    return true;
+}
+
+void AudioEngine::ReleaseAudio(const std::string& filename)
+{
+    std::map<std::string, uint32_t>::iterator retained = _retained_audio.find(filename);
+    if(retained == _retained_audio.end())
+        return;
+
+    if(--retained->second > 0)
+        return;
+    _retained_audio.erase(retained);
+
+    std::map<std::string, AudioCacheElement>::iterator it = _audio_cache.find(filename);
+    if(it == _audio_cache.end() || !it->second.audio->GetGameModeOwners()->empty())
+        return;
+
+    it->second.audio->FreeAudio();
+    delete it->second.audio;
+    _audio_cache.erase(it);
+}
+
 const std::string AudioEngine::CreateALErrorString()
 {
     switch(_al_error_code) {
@@ -612,6 +657,9 @@ bool AudioEngine::_LoadAudio(const std::string &filename, bool is_music, vt_mode
     if(!DoesFileExist(filename))
         return false;
 
+    if(gm && _audio_file_recorder)
+        _audio_file_recorder->insert(filename);
+
     std::map<std::string, private_audio::AudioCacheElement>::iterator it = _audio_cache.find(filename);
     if(it != _audio_cache.end()) {
 
@@ -31,6 +31,7 @@
 #include "audio_effects.h"
 
 #include <map>
+#include <set>
 
 //! \brief All related audio engine code is wrapped within this namespace
 namespace vt_audio
@@ -288,6 +289,24 @@ public:
     **/
     void RemoveGameModeOwner(vt_mode_manager::GameMode *gm);
 
+    /** \brief Keeps a cached audio file loaded once the game modes owning it end, until released.
+    *** Only the audio owned by game modes is retained, as the other cached audio is never freed.
+    *** Each successful call must be matched by a ReleaseAudio() call.
+    *** \return Whether the audio file was retained.
+    *** \see vt_mode_manager::AssetResidencyManager
+    **/
+    bool RetainAudio(const std::string& filename);
+
+    //! \brief Releases a retained audio file, freeing it if no game mode owns it anymore.
+    void ReleaseAudio(const std::string& filename);
+
+    /** \brief Records the audio files loaded for a game mode in the given set.
+    *** \param recorder The set to add the filenames to, or nullptr to stop recording.
+    **/
+    void SetAudioFileRecorder(std::set<std::string>* recorder) {
+        _audio_file_recorder = recorder;
+    }
+
     /** \name Error Detection and Processing methods
     *** Code external to the audio engine should not need to make use of the following methods,
     *** as error detection is routinely done by the engine itself.
@@ -391,6 +410,12 @@ private:
     **/
     std::map<std::string, private_audio::AudioCacheElement> _audio_cache;
 
+    //! \brief The cached audio files kept loaded after their owners end, and their retain count. \see RetainAudio()
+    std::map<std::string, uint32_t> _retained_audio;
+
+    //! \brief The set recording the audio files loaded for game modes, or nullptr.
+    std::set<std::string>* _audio_file_recorder;
+
     /** \brief Acquires an available audio source that may be used
     *** \return A pointer to the available source, or nullptr if no available source could be found
     **/
@@ -589,7 +589,7 @@ void AudioDescriptor::AddGameModeOwners(std::vector<vt_mode_manager::GameMode *>
     }
 }
 
-bool AudioDescriptor::RemoveGameModeOwner(vt_mode_manager::GameMode* gm)
+bool AudioDescriptor::RemoveGameModeOwner(vt_mode_manager::GameMode* gm, bool free_audio)
 {
     if(!gm)
         return false;
@@ -609,7 +609,7 @@ bool AudioDescriptor::RemoveGameModeOwner(vt_mode_manager::GameMode* gm)
         // Remove the owner and check whether the sound can be freed
         it = _game_mode_owners.erase(it);
 
-        if(_game_mode_owners.empty()) {
+        if(_game_mode_owners.empty() && free_audio) {
             FreeAudio();
             return true;
         }
@@ -348,9 +348,10 @@ public:
     /**
     *** Remove a game mode reference from the audio descriptor owners,
     *** and checks whether the file data can be freed.
+    *** \param free_audio Whether the file data is freed when no owner is left.
     *** \returns whether the descriptor should be removed from the cache.
     **/
-    bool RemoveGameModeOwner(vt_mode_manager::GameMode *gm);
+    bool RemoveGameModeOwner(vt_mode_manager::GameMode *gm, bool free_audio = true);
 
     /**
     *** Get the list of game mode claiming ownership over the audio descriptor.
@@ -404,7 +404,7 @@ void IndicatorSupervisor::Draw()
 void IndicatorSupervisor::AddDamageIndicator(float x_position, float y_position,
                                              uint32_t amount, const TextStyle& style, bool use_parallax)
 {
-    if (amount == 0)
+    if (amount == 0 || !_enabled)
         return;
 
     std::string text = vt_utils::NumberToString(amount);
@@ -420,7 +420,7 @@ void IndicatorSupervisor::AddDamageIndicator(float x_position, float y_position,
 void IndicatorSupervisor::AddHealingIndicator(float x_position, float y_position,
                                               uint32_t amount, const TextStyle& style, bool use_parallax)
 {
-    if(amount == 0)
+    if(amount == 0 || !_enabled)
         return;
 
     std::string text = vt_utils::NumberToString(amount);
@@ -433,6 +433,9 @@ void IndicatorSupervisor::AddHealingIndicator(float x_position, float y_position
 
 void IndicatorSupervisor::AddMissIndicator(float x_position, float y_position)
 {
+    if (!_enabled)
+        return;
+
     std::string text = vt_system::Translate("Miss");
     TextStyle style("text24", Color::white);
     _wait_queue.push_back(new IndicatorText(x_position, y_position, text, style, TEXT_INDICATOR));
@@ -442,6 +445,9 @@ void IndicatorSupervisor::AddStatusIndicator(float x_position, float y_position,
                                              vt_global::GLOBAL_STATUS status, vt_global::GLOBAL_INTENSITY old_intensity,
                                              vt_global::GLOBAL_INTENSITY new_intensity)
 {
+    if (!_enabled)
+        return;
+
     // If the status and intensity has not changed, only a single status icon needs to be used
     if(old_intensity == new_intensity) {
         StillImage *image = vt_global::GlobalManager->Media().GetStatusIcon(status, new_intensity);
@@ -459,6 +465,9 @@ void IndicatorSupervisor::AddStatusIndicator(float x_position, float y_position,
 
 void IndicatorSupervisor::AddItemIndicator(float x_position, float y_position, const vt_global::GlobalItem& item)
 {
+    if (!_enabled)
+        return;
+
     _wait_queue.push_back(new IndicatorImage(x_position, y_position,
                                              item.GetIconImage(),
                                              ITEM_INDICATOR));
@@ -480,6 +489,9 @@ void IndicatorSupervisor::AddShortNotice(const vt_utils::ustring& message,
                                          const std::string& icon_image_filename,
                                          uint32_t display_time)
 {
+    if (!_enabled)
+        return;
+
     vt_common::ShortNoticeWindow* msg_win = nullptr;
     msg_win = new vt_common::ShortNoticeWindow(message, icon_image_filename, display_time);
     _short_notices.push_back(msg_win);
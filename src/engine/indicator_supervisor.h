@@ -344,7 +344,8 @@ protected:
 class IndicatorSupervisor
 {
 public:
-    IndicatorSupervisor()
+    IndicatorSupervisor():
+        _enabled(true)
     {}
 
     ~IndicatorSupervisor();
@@ -355,6 +356,11 @@ public:
     //! \brief Draws all elements present in the active queue
     void Draw();
 
+    //! \brief Sets whether new indicators are created. The disabled supervisor ignores them.
+    void SetEnabled(bool enabled) {
+        _enabled = enabled;
+    }
+
     /** \brief Creates indicator text representing a numeric amount of damage dealt
     *** \param amount The amount of damage to display, in hit points. Should be non-zero.
     *** \param style The text style the damage should be shown with (font + color + shadow)
@@ -425,6 +431,9 @@ private:
     //! \param element the Indicator Element which is about to be added.
     //! \return whether there were overlapping elements whose positions were fixed.
     bool _FixPotentialIndicatorOverlapping(IndicatorElement* element);
+
+    //! \brief Whether new indicators are created.
+    bool _enabled;
 }; // class IndicatorSupervisor
 
 } // namespace vt_mode_manager
@@ -21,6 +21,7 @@
 #include "script/script_read.h"
 #include "engine/mode_manager.h"
 #include "engine/system.h"
+#include "engine/script_profiler.h"
 
 #include "modes/mode_help_window.h"
 
@@ -41,6 +42,24 @@ namespace vt_input
 InputEngine *InputManager = nullptr;
 bool INPUT_DEBUG = false;
 
+// The order must be kept to read the existing input recordings. New members are added at the end.
+bool InputEngine::* const InputEngine::_RECORDED_INPUT_MEMBERS[] = {
+    &InputEngine::_up_state, &InputEngine::_down_state, &InputEngine::_left_state, &InputEngine::_right_state,
+    &InputEngine::_confirm_state, &InputEngine::_cancel_state, &InputEngine::_menu_state,
+
+    &InputEngine::_up_press, &InputEngine::_down_press, &InputEngine::_left_press, &InputEngine::_right_press,
+    &InputEngine::_confirm_press, &InputEngine::_cancel_press, &InputEngine::_menu_press,
+    &InputEngine::_minimap_press, &InputEngine::_pause_press, &InputEngine::_quit_press, &InputEngine::_help_press,
+
+    &InputEngine::_up_release, &InputEngine::_down_release, &InputEngine::_left_release, &InputEngine::_right_release,
+    &InputEngine::_confirm_release, &InputEngine::_cancel_release, &InputEngine::_menu_release,
+    &InputEngine::_minimap_release, &InputEngine::_pause_release, &InputEngine::_quit_release, &InputEngine::_help_release,
+
+    &InputEngine::_hat_up_state, &InputEngine::_hat_down_state, &InputEngine::_hat_left_state, &InputEngine::_hat_right_state,
+
+    &InputEngine::_any_keyboard_key_press, &InputEngine::_any_joystick_key_press
+};
+
 // Initializes class members
 InputEngine::InputEngine()
 {
@@ -223,10 +242,65 @@ bool InputEngine::RestoreDefaultJoyButtons()
 }
 
 // Handles all of the event processing for the game.
-void InputEngine::EventHandler()
+void InputEngine::PollEvents()
 {
     SDL_Event event; // Holds the game event
 
+    if(_replay.GetMode() == INPUT_REPLAY_REPLAYING) {
+        // Only closing the window is handled, and stops the replay.
+        while(SDL_PollEvent(&event)) {
+            if(event.type == SDL_QUIT)
+                SystemManager->ExitGame();
+        }
+        return;
+    }
+
+    // Loops until there are no remaining events to process
+    while(SDL_PollEvent(&event)) {
+        if(event.type == SDL_QUIT) {
+            _key_event = event;
+            _quit_press = true;
+            break;
+        } else if(event.type == SDL_KEYUP || event.type == SDL_KEYDOWN) {
+            _key_event = event;
+            _KeyEventHandler(event.key);
+        } else {
+            _joystick_event = event;
+            _JoystickEventHandler(event);
+        }
+    }
+
+    if (_joysticks_enabled) {
+        static bool joystick_unplugged = false;
+        if (!joystick_unplugged && SDL_NumJoysticks() == 0) {
+            joystick_unplugged = true;
+        }
+        else if (joystick_unplugged && SDL_NumJoysticks() > 0) {
+            joystick_unplugged = false;
+            InitializeJoysticks();
+        }
+    }
+
+    _UpdateRegisteredKeys();
+} // void InputEngine::PollEvents()
+
+void InputEngine::EventHandler()
+{
+    // Takes the events received since the last frame into account.
+    PollEvents();
+
+    if(_replay.GetMode() == INPUT_REPLAY_REPLAYING) {
+        _SetRecordedInputState(_replay.ReplayTick());
+        _UpdateRegisteredKeys();
+        return;
+    }
+
+    if(_replay.GetMode() == INPUT_REPLAY_RECORDING)
+        _replay.RecordTick(_GetRecordedInputState());
+} // void InputEngine::EventHandler()
+
+void InputEngine::ClearPressEvents()
+{
     // Reset all of the press and release flags so that they don't get detected twice.
     _registered_key_press   = false;
     _registered_key_release = false;
@@ -259,33 +333,10 @@ void InputEngine::EventHandler()
     _help_release         = false;
 
     // NOTE: We don't reinit the D-Pad/hat values on purpose here.
+}
 
-    // Loops until there are no remaining events to process
-    while(SDL_PollEvent(&event)) {
-        if(event.type == SDL_QUIT) {
-            _key_event = event;
-            _quit_press = true;
-            break;
-        } else if(event.type == SDL_KEYUP || event.type == SDL_KEYDOWN) {
-            _key_event = event;
-            _KeyEventHandler(event.key);
-        } else {
-            _joystick_event = event;
-            _JoystickEventHandler(event);
-        }
-    }
-
-    if (_joysticks_enabled) {
-        static bool joystick_unplugged = false;
-        if (!joystick_unplugged && SDL_NumJoysticks() == 0) {
-            joystick_unplugged = true;
-        }
-        else if (joystick_unplugged && SDL_NumJoysticks() > 0) {
-            joystick_unplugged = false;
-            InitializeJoysticks();
-        }
-    }
-
+void InputEngine::_UpdateRegisteredKeys()
+{
     _registered_key_press = _up_press || _down_press || _left_press || _right_press || _quit_press ||
             _confirm_press || _cancel_press || _minimap_press || _menu_press || _pause_press ||
             _help_press;
@@ -293,7 +344,27 @@ void InputEngine::EventHandler()
     _registered_key_release = _up_release || _down_release || _left_release || _right_release || _quit_release ||
             _confirm_release || _cancel_release || _minimap_release || _menu_release || _pause_release ||
             _help_release;
-} // void InputEngine::EventHandler()
+}
+
+uint64_t InputEngine::_GetRecordedInputState() const
+{
+    const uint32_t member_count = sizeof(_RECORDED_INPUT_MEMBERS) / sizeof(_RECORDED_INPUT_MEMBERS[0]);
+
+    uint64_t input_state = 0;
+    for(uint32_t i = 0; i < member_count; ++i) {
+        if(this->*_RECORDED_INPUT_MEMBERS[i])
+            input_state |= (static_cast<uint64_t>(1) << i);
+    }
+    return input_state;
+}
+
+void InputEngine::_SetRecordedInputState(uint64_t input_state)
+{
+    const uint32_t member_count = sizeof(_RECORDED_INPUT_MEMBERS) / sizeof(_RECORDED_INPUT_MEMBERS[0]);
+
+    for(uint32_t i = 0; i < member_count; ++i)
+        this->*_RECORDED_INPUT_MEMBERS[i] = ((input_state >> i) & 1) != 0;
+}
 
 
 
@@ -323,6 +394,28 @@ void InputEngine::_KeyEventHandler(SDL_KeyboardEvent &key_event)
                 }
                 VideoManager->MakeScreenshot(path);
                 return;
+            } else if(key_event.keysym.sym == SDLK_p) {
+                // Toggle the frame profiler overlay, recording the time spent in each engine part
+                VideoManager->ToggleProfiler();
+                return;
+            } else if(key_event.keysym.sym == SDLK_e) {
+                // Export the profiled frames to a Chrome trace file (chrome://tracing)
+                static uint32_t i = 1;
+                std::string path = "";
+                while(true) {
+                    path = GetUserDataPath() + "profile_" + NumberToString<uint32_t>(i) + ".json";
+                    if(!DoesFileExist(path))
+                        break;
+                    i++;
+                }
+                if(SystemManager->GetProfiler().ExportChromeTrace(path))
+                    std::cout << "Profiled frames exported to: " << path << std::endl;
+
+                // And the Lua calls statistics next to it
+                path = GetUserDataPath() + "profile_" + NumberToString<uint32_t>(i) + "_lua.txt";
+                if(SystemManager->GetScriptProfiler().ExportStatistics(path))
+                    std::cout << "Profiled Lua calls exported to: " << path << std::endl;
+                return;
             }
 #ifdef DEBUG_FEATURES
             // Insert developers options here.
@@ -18,6 +18,8 @@
 #ifndef __INPUT_HEADER__
 #define __INPUT_HEADER__
 
+#include "engine/input_replay.h"
+
 #include "utils/utils_strings.h"
 #include "utils/singleton.h"
 
@@ -115,7 +117,7 @@ public:
 *** \brief Processes and manages all user input events.
 ***
 *** The way this class operates is by first retaining the user-defined keyboard
-*** and joystick settings. The EventHandler() function is called once every
+*** and joystick settings. The PollEvents() function is called once every
 *** iteration of the main game loop to process all events that have accumulated
 *** in the SDL input queue. Three boolean varaiables for each type of input event
 *** are maintained to represent the state of each input:
@@ -258,6 +260,21 @@ private:
      **/
 	SDL_Event _key_event;
 
+    //! \brief Records or replays the logical input state of each update.
+    InputReplay _replay;
+
+    //! \brief The logical input members stored in the input recordings, in bit order.
+    static bool InputEngine::* const _RECORDED_INPUT_MEMBERS[];
+
+    //! \brief Packs the logical input members into a bit field, to be recorded.
+    uint64_t _GetRecordedInputState() const;
+
+    //! \brief Sets the logical input members from a recorded bit field.
+    void _SetRecordedInputState(uint64_t input_state);
+
+    //! \brief Computes whether any registered key was pressed or released, from the other members.
+    void _UpdateRegisteredKeys();
+
     /** \brief Processes all keyboard input events
     *** \param key_event The event to process
     **/
@@ -345,10 +362,30 @@ public:
     *** to quit the game). Any keyboard or joystick events that occur are passed to the KeyEventHandler()
     *** and JoystickEventHandler() functions.
     ***
+    *** It is called at the start of each fixed logic update. The press and release events
+    *** received since the last update, including the ones already polled by PollEvents(),
+    *** are kept until ClearPressEvents() is called at the end of the update.
+    ***
     *** \note EventHandler() should only be called in the main game loop. Do \b not call it anywhere else.
+    *** \note While an input recording is replayed, the keyboard and joystick events are ignored
+    *** and the recorded input state is used instead.
     **/
     void EventHandler();
 
+    /** \brief Empties the SDL queue once per rendered frame, even when no logic update is run.
+    *** The key states are updated right away, and the press and release events are kept
+    *** for the next logic update, so that none is lost on high refresh rate displays.
+    **/
+    void PollEvents();
+
+    //! \brief Resets the press and release events, once a logic update has handled them.
+    void ClearPressEvents();
+
+    //! \brief Returns the input recording or replay. \see InputReplay
+    InputReplay& GetReplay() {
+        return _replay;
+    }
+
     /** \name   Input state member access functions
     *** \return True if the input event key/button is being held down
     **/
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    input_replay.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the input recordings and replays
+*** ***************************************************************************/
+
+#include "engine/input_replay.h"
+
+#include "utils/utils_common.h"
+
+#include <cstdlib>
+
+namespace vt_input
+{
+
+//! \brief The first word of the input recording files.
+const std::string INPUT_RECORDING_HEADER = "vtinput";
+
+//! \brief The first word of the input recordings last line.
+const std::string INPUT_RECORDING_END = "end";
+
+InputReplay::InputReplay():
+    _mode(INPUT_REPLAY_NONE),
+    _random_seed(0),
+    _tick(0),
+    _number_of_ticks(0),
+    _next_replay_tick(0)
+{
+}
+
+InputReplay::~InputReplay()
+{
+    Stop();
+}
+
+bool InputReplay::StartRecording(const std::string& filename, uint32_t random_seed)
+{
+    Stop();
+
+    _record_file.open(filename.c_str(), std::ios::out | std::ios::trunc);
+    if (!_record_file.is_open()) {
+        PRINT_WARNING << "Couldn't open the input recording file: " << filename << std::endl;
+        return false;
+    }
+
+    _record_file << INPUT_RECORDING_HEADER << " " << INPUT_RECORDING_VERSION << " "
+                 << random_seed << std::endl;
+
+    _mode = INPUT_REPLAY_RECORDING;
+    _random_seed = random_seed;
+    _tick = 0;
+    return true;
+}
+
+bool InputReplay::StartReplay(const std::string& filename)
+{
+    Stop();
+
+    std::ifstream file(filename.c_str());
+    if (!file.is_open()) {
+        PRINT_WARNING << "Couldn't open the input recording file: " << filename << std::endl;
+        return false;
+    }
+
+    std::string header;
+    uint32_t version = 0;
+    uint32_t random_seed = 0;
+    file >> header >> version >> random_seed;
+    if (!file || header != INPUT_RECORDING_HEADER || version != INPUT_RECORDING_VERSION) {
+        PRINT_WARNING << "Invalid input recording file: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<RecordedTick> replay_ticks;
+    std::string word;
+    while (file >> word) {
+        if (word == INPUT_RECORDING_END) {
+            uint32_t number_of_ticks = 0;
+            if (!(file >> number_of_ticks))
+                break;
+
+            _mode = INPUT_REPLAY_REPLAYING;
+            _random_seed = random_seed;
+            _tick = 0;
+            _number_of_ticks = number_of_ticks;
+            _replay_ticks.swap(replay_ticks);
+            _next_replay_tick = 0;
+            return true;
+        }
+
+        RecordedTick recorded_tick;
+        recorded_tick.tick = static_cast<uint32_t>(strtoul(word.c_str(), nullptr, 10));
+        if (!(file >> std::hex >> recorded_tick.input_state >> std::dec))
+            break;
+        replay_ticks.push_back(recorded_tick);
+    }
+
+    PRINT_WARNING << "The input recording file is truncated: " << filename << std::endl;
+    return false;
+}
+
+void InputReplay::Stop()
+{
+    if (_mode == INPUT_REPLAY_RECORDING) {
+        _record_file << INPUT_RECORDING_END << " " << _tick << std::endl;
+        _record_file.close();
+    }
+
+    _mode = INPUT_REPLAY_NONE;
+    _replay_ticks.clear();
+    _next_replay_tick = 0;
+    _number_of_ticks = 0;
+}
+
+void InputReplay::RecordTick(uint64_t input_state)
+{
+    if (_mode != INPUT_REPLAY_RECORDING)
+        return;
+
+    // Most ticks have no input at all, and aren't written.
+    if (input_state != 0)
+        _record_file << _tick << " " << std::hex << input_state << std::dec << "\n";
+    ++_tick;
+}
+
+uint64_t InputReplay::ReplayTick()
+{
+    if (_mode != INPUT_REPLAY_REPLAYING || _tick >= _number_of_ticks)
+        return 0;
+
+    // Skip the ticks given out of order, if any.
+    while (_next_replay_tick < _replay_ticks.size() && _replay_ticks[_next_replay_tick].tick < _tick)
+        ++_next_replay_tick;
+
+    uint64_t input_state = 0;
+    if (_next_replay_tick < _replay_ticks.size() && _replay_ticks[_next_replay_tick].tick == _tick) {
+        input_state = _replay_ticks[_next_replay_tick].input_state;
+        ++_next_replay_tick;
+    }
+    ++_tick;
+    return input_state;
+}
+
+} // namespace vt_input
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    input_replay.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the input recordings and replays
+***
+*** An input recording stores the logical input state (up press, confirm state, ...)
+*** of each game logic update, along with the random seed the game was started with.
+*** Replaying it with one fixed logic update per frame plays the same game again,
+*** unattended, which permits to compare the frame times between two builds:
+***
+*** \code
+*** valyriatear --record-input walk.vtinput
+*** valyriatear --replay-input walk.vtinput --max-frame-time 16
+*** \endcode
+***
+*** The replays must be started with the same game data and settings as the recording.
+*** The engine shortcuts (Ctrl+F, Ctrl+S, ...) and the help window aren't part of the
+*** game logic, and aren't replayed.
+*** ***************************************************************************/
+
+#ifndef __INPUT_REPLAY_HEADER__
+#define __INPUT_REPLAY_HEADER__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace vt_input
+{
+
+//! \brief The input recordings file format version.
+const uint32_t INPUT_RECORDING_VERSION = 1;
+
+//! \brief Whether the input is being recorded, replayed, or neither.
+enum INPUT_REPLAY_MODE {
+    INPUT_REPLAY_NONE = 0,
+    INPUT_REPLAY_RECORDING = 1,
+    INPUT_REPLAY_REPLAYING = 2
+};
+
+/** ****************************************************************************
+*** \brief Records the logical input state of each game logic update to a file, or replays it.
+***
+*** The input replay is owned by the input engine. \see InputEngine::GetReplay()
+*** The file is a text file made of a header line, one line per update tick with
+*** a non-empty input state, and an end line giving the number of recorded ticks.
+*** ***************************************************************************/
+class InputReplay
+{
+public:
+    InputReplay();
+
+    //! \brief Ends the recording properly, if any.
+    ~InputReplay();
+
+    /** \brief Starts recording the input state of each update in the given file.
+    *** \param filename The file to write.
+    *** \param random_seed The random seed the game was initialized with, stored for the replays.
+    *** \return false if the file couldn't be opened.
+    **/
+    bool StartRecording(const std::string& filename, uint32_t random_seed);
+
+    /** \brief Loads a recording and starts replaying it.
+    *** \return false if the file couldn't be read.
+    **/
+    bool StartReplay(const std::string& filename);
+
+    //! \brief Stops the recording or replay, writing the end of the recording file.
+    void Stop();
+
+    INPUT_REPLAY_MODE GetMode() const {
+        return _mode;
+    }
+
+    //! \brief Returns the random seed of the recording.
+    uint32_t GetRandomSeed() const {
+        return _random_seed;
+    }
+
+    //! \brief Returns the number of update ticks recorded or replayed so far.
+    uint32_t GetTick() const {
+        return _tick;
+    }
+
+    //! \brief Tells whether all the recorded ticks have been replayed.
+    bool IsReplayFinished() const {
+        return _mode == INPUT_REPLAY_REPLAYING && _tick >= _number_of_ticks;
+    }
+
+    //! \brief Records the input state of the current update tick, and goes to the next one.
+    void RecordTick(uint64_t input_state);
+
+    //! \brief Returns the recorded input state of the current update tick, and goes to the next one.
+    uint64_t ReplayTick();
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    InputReplay(const InputReplay& replay);
+    InputReplay& operator=(const InputReplay& replay);
+
+    //! \brief A recorded update tick with a non-empty input state.
+    struct RecordedTick {
+        uint32_t tick;
+        uint64_t input_state;
+    };
+
+    INPUT_REPLAY_MODE _mode;
+
+    //! \brief The random seed of the recording.
+    uint32_t _random_seed;
+
+    //! \brief The current update tick.
+    uint32_t _tick;
+
+    //! \brief The number of ticks in the replayed recording.
+    uint32_t _number_of_ticks;
+
+    //! \brief The file being recorded.
+    std::ofstream _record_file;
+
+    //! \brief The ticks of the replayed recording, and the index of the next one to replay.
+    std::vector<RecordedTick> _replay_ticks;
+    uint32_t _next_replay_tick;
+};
+
+} // namespace vt_input
+
+#endif // __INPUT_REPLAY_HEADER__
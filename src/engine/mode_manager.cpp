@@ -67,6 +67,9 @@ GameMode::~GameMode()
     // Tells the audio manager that the mode is ending
     // to permit freeing self-managed audio files.
     AudioManager->RemoveGameModeOwner(this);
+
+    if(ModeManager)
+        ModeManager->GetAssetResidency().RemoveMode(this);
 }
 
 
@@ -269,6 +272,8 @@ GameMode *ModeEngine::Get(uint32_t index)
 // Checks if any game modes need to be pushed or popped off the stack, then updates the top stack mode.
 void ModeEngine::Update()
 {
+    vt_system::ProfilerZone zone("ModeEngine::Update");
+
     // Check whether the fade out is done.
     if(_fade_out && VideoManager->IsLastFadeTransitional() &&
             !VideoManager->IsFading()) {
@@ -285,6 +290,8 @@ void ModeEngine::Update()
                 _pop_count = 0;
                 break; // Exit the loop
             }
+            // Keep the mode assets resident, in case it is entered again.
+            _asset_residency.RetainModeAssets(_game_stack.back());
             delete _game_stack.back();
             _game_stack.pop_back();
             _pop_count--;
@@ -307,6 +314,9 @@ void ModeEngine::Update()
             SystemManager->ExitGame();
         }
 
+        // Record the assets the newly active game mode loads
+        _asset_residency.SetActiveMode(_game_stack.back());
+
         // Call the newly active game mode's Reset() function
         // to re-initialize the game mode
         _game_stack.back()->Reset();
@@ -336,6 +346,8 @@ void ModeEngine::Update()
 
 void ModeEngine::Draw()
 {
+    vt_system::ProfilerZone zone("ModeEngine::Draw");
+
     if(_game_stack.empty())
         return;
 
@@ -344,6 +356,8 @@ void ModeEngine::Draw()
 
 void ModeEngine::DrawEffects()
 {
+    vt_system::ProfilerZone zone("ModeEngine::DrawEffects");
+
     if(_game_stack.empty())
         return;
 
@@ -352,6 +366,8 @@ void ModeEngine::DrawEffects()
 
 void ModeEngine::DrawPostEffects()
 {
+    vt_system::ProfilerZone zone("ModeEngine::DrawPostEffects");
+
     if(_game_stack.empty())
         return;
 
@@ -19,6 +19,7 @@
 #define __MODE_MANAGER_HEADER__
 
 #include "effect_supervisor.h"
+#include "engine/asset_residency.h"
 #include "engine/video/particle_manager.h"
 #include "engine/script_supervisor.h"
 #include "engine/indicator_supervisor.h"
@@ -211,6 +212,9 @@ private:
     //! \brief A window showing help according to the current game mode.
     HelpWindow *_help_window;
 
+    //! \brief Keeps the assets of the deleted game modes resident. \see AssetResidencyManager
+    AssetResidencyManager _asset_residency;
+
 public:
     ~ModeEngine();
 
@@ -276,6 +280,11 @@ public:
         return _help_window;
     }
 
+    //! \brief Returns the game mode assets residency manager.
+    AssetResidencyManager& GetAssetResidency() {
+        return _asset_residency;
+    }
+
     //! \brief Prints the contents of the game_stack member to standard output.
     void DEBUG_PrintStack();
 }; // class ModeEngine : public vt_utils::Singleton<ModeEngine>
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    profiler.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the frame profiler
+*** ***************************************************************************/
+
+#include "engine/profiler.h"
+
+#include "engine/system.h"
+
+#include "utils/utils_common.h"
+
+#include <SDL2/SDL_timer.h>
+
+#include <cassert>
+#include <fstream>
+
+namespace vt_system
+{
+
+//! \brief The number of zones reserved per frame, so that recording usually doesn't allocate.
+const uint32_t PROFILER_ZONES_RESERVED_PER_FRAME = 64;
+
+FrameProfiler::FrameProfiler():
+    _current_frame(0),
+    _number_of_frames(0),
+    _current_depth(0),
+    _counter_frequency(SDL_GetPerformanceFrequency()),
+    _enabled(false),
+    _in_frame(false)
+{
+    // The frequency can't be 0 on supported platforms, but avoid dividing by it anyway.
+    if (_counter_frequency == 0)
+        _counter_frequency = 1000;
+}
+
+void FrameProfiler::SetEnabled(bool enabled)
+{
+    if (_enabled == enabled)
+        return;
+
+    _enabled = enabled;
+    _in_frame = false;
+    _current_depth = 0;
+    _current_frame = 0;
+    _number_of_frames = 0;
+
+    if (!_enabled) {
+        // Free the history memory.
+        _frames.clear();
+        return;
+    }
+
+    _frames.resize(PROFILER_FRAME_HISTORY);
+    for (uint32_t i = 0; i < _frames.size(); ++i)
+        _frames[i].zones.reserve(PROFILER_ZONES_RESERVED_PER_FRAME);
+}
+
+void FrameProfiler::BeginFrame()
+{
+    if (!_enabled)
+        return;
+
+    ProfilerFrame& frame = _frames[_current_frame];
+    frame.start_counter = SDL_GetPerformanceCounter();
+    frame.end_counter = frame.start_counter;
+    frame.zones.clear();
+
+    _current_depth = 0;
+    _in_frame = true;
+}
+
+void FrameProfiler::EndFrame()
+{
+    if (!_enabled || !_in_frame)
+        return;
+
+    _frames[_current_frame].end_counter = SDL_GetPerformanceCounter();
+
+    _in_frame = false;
+    _current_frame = (_current_frame + 1) % PROFILER_FRAME_HISTORY;
+    if (_number_of_frames < PROFILER_FRAME_HISTORY)
+        ++_number_of_frames;
+}
+
+int32_t FrameProfiler::BeginZone(const char* name)
+{
+    if (!_enabled || !_in_frame)
+        return -1;
+
+    ProfilerFrame& frame = _frames[_current_frame];
+
+    ProfilerZoneRecord zone;
+    zone.name = name;
+    zone.start = SDL_GetPerformanceCounter() - frame.start_counter;
+    zone.end = zone.start;
+    zone.depth = _current_depth++;
+    frame.zones.push_back(zone);
+
+    return static_cast<int32_t>(frame.zones.size()) - 1;
+}
+
+void FrameProfiler::EndZone(int32_t zone_index)
+{
+    if (zone_index < 0 || !_enabled || !_in_frame)
+        return;
+
+    ProfilerFrame& frame = _frames[_current_frame];
+    // The frame may have been restarted in between.
+    if (static_cast<uint32_t>(zone_index) >= frame.zones.size())
+        return;
+
+    frame.zones[zone_index].end = SDL_GetPerformanceCounter() - frame.start_counter;
+    if (_current_depth > 0)
+        --_current_depth;
+}
+
+const ProfilerFrame& FrameProfiler::GetFrame(uint32_t frames_ago) const
+{
+    assert(frames_ago < _number_of_frames);
+    uint32_t index = (_current_frame + PROFILER_FRAME_HISTORY - 1 - frames_ago) % PROFILER_FRAME_HISTORY;
+    return _frames[index];
+}
+
+bool FrameProfiler::ExportChromeTrace(const std::string& filename) const
+{
+    if (_number_of_frames == 0) {
+        PRINT_WARNING << "No profiled frames to export. Enable the profiler first." << std::endl;
+        return false;
+    }
+
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) {
+        PRINT_WARNING << "Couldn't open the profiler trace file for writing: " << filename << std::endl;
+        return false;
+    }
+
+    // Timestamps are given in microseconds, relative to the oldest frame.
+    const uint64_t time_origin = GetFrame(_number_of_frames - 1).start_counter;
+    const double counter_to_us = 1000000.0 / static_cast<double>(_counter_frequency);
+
+    file << "{\"traceEvents\":[" << std::endl;
+    bool first_event = true;
+
+    for (uint32_t i = _number_of_frames; i > 0; --i) {
+        const ProfilerFrame& frame = GetFrame(i - 1);
+        const uint64_t frame_start = frame.start_counter - time_origin;
+
+        if (!first_event)
+            file << "," << std::endl;
+        first_event = false;
+
+        file << "{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0"
+             << ",\"ts\":" << static_cast<double>(frame_start) * counter_to_us
+             << ",\"dur\":" << static_cast<double>(frame.end_counter - frame.start_counter) * counter_to_us
+             << "}";
+
+        for (uint32_t j = 0; j < frame.zones.size(); ++j) {
+            const ProfilerZoneRecord& zone = frame.zones[j];
+            file << "," << std::endl
+                 << "{\"name\":\"" << zone.name << "\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":0,\"tid\":0"
+                 << ",\"ts\":" << static_cast<double>(frame_start + zone.start) * counter_to_us
+                 << ",\"dur\":" << static_cast<double>(zone.end - zone.start) * counter_to_us
+                 << "}";
+        }
+    }
+
+    file << std::endl << "]}" << std::endl;
+    file.close();
+
+    if (file.fail()) {
+        PRINT_WARNING << "Failed to write the profiler trace file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+ProfilerZone::ProfilerZone(const char* name):
+    _zone_index(-1)
+{
+    if (SystemManager && SystemManager->GetProfiler().IsEnabled())
+        _zone_index = SystemManager->GetProfiler().BeginZone(name);
+}
+
+ProfilerZone::~ProfilerZone()
+{
+    if (_zone_index >= 0 && SystemManager)
+        SystemManager->GetProfiler().EndZone(_zone_index);
+}
+
+} // namespace vt_system
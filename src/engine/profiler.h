@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    profiler.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the frame profiler
+***
+*** The frame profiler records the time spent in named zones of code, nested
+*** within each frame, and keeps the last frames in a ring buffer.
+*** A zone is recorded by declaring a ProfilerZone object on the stack:
+***
+*** \code
+*** void MapMode::Update()
+*** {
+***     vt_system::ProfilerZone zone("MapMode::Update");
+***     ...
+*** }
+*** \endcode
+***
+*** When the profiler is disabled, declaring a zone only costs a boolean check.
+*** The recorded frames can be drawn by the video engine debug overlay,
+*** and exported in the Chrome trace event format (chrome://tracing).
+*** ***************************************************************************/
+
+#ifndef __PROFILER_HEADER__
+#define __PROFILER_HEADER__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vt_system
+{
+
+//! \brief The number of frames kept in the profiler history.
+const uint32_t PROFILER_FRAME_HISTORY = 120;
+
+//! \brief A zone recorded within a frame.
+struct ProfilerZoneRecord {
+    //! \brief The zone name. It must be a string literal, as only the pointer is kept.
+    const char* name;
+
+    //! \brief The zone start and end, in high resolution counter units since the frame start.
+    uint64_t start;
+    uint64_t end;
+
+    //! \brief The zone nesting depth, 0 being a zone directly within the frame.
+    uint32_t depth;
+};
+
+//! \brief A frame recorded by the profiler.
+struct ProfilerFrame {
+    //! \brief The frame start and end high resolution counter values.
+    uint64_t start_counter;
+    uint64_t end_counter;
+
+    //! \brief The zones recorded during the frame, sorted by start time.
+    std::vector<ProfilerZoneRecord> zones;
+};
+
+/** ****************************************************************************
+*** \brief Records the time spent in nested code zones over the last frames.
+***
+*** The profiler is owned by the system engine. \see SystemEngine::GetProfiler().
+*** Zones are only recorded when the profiler is enabled and a frame is being recorded.
+*** ***************************************************************************/
+class FrameProfiler
+{
+public:
+    FrameProfiler();
+
+    ~FrameProfiler()
+    {}
+
+    //! \brief Enables or disables the recording. Disabling it clears the history.
+    void SetEnabled(bool enabled);
+
+    bool IsEnabled() const {
+        return _enabled;
+    }
+
+    //! \brief Starts recording a new frame, overwriting the oldest one when the history is full.
+    void BeginFrame();
+
+    //! \brief Ends the frame being recorded.
+    void EndFrame();
+
+    /** \brief Starts recording a zone in the current frame.
+    *** \param name The zone name. It must be a string literal, as only the pointer is kept.
+    *** \return The zone index to give to EndZone(), or -1 if the zone isn't recorded.
+    **/
+    int32_t BeginZone(const char* name);
+
+    //! \brief Ends recording the given zone.
+    void EndZone(int32_t zone_index);
+
+    //! \brief Returns the number of complete frames currently in the history.
+    uint32_t GetNumberOfFrames() const {
+        return _number_of_frames;
+    }
+
+    /** \brief Returns a complete frame from the history.
+    *** \param frames_ago 0 for the last complete frame, up to GetNumberOfFrames() - 1 for the oldest one.
+    **/
+    const ProfilerFrame& GetFrame(uint32_t frames_ago) const;
+
+    //! \brief Converts a duration in high resolution counter units into milliseconds.
+    float CounterToMilliseconds(uint64_t counter) const {
+        return static_cast<float>(counter) * 1000.0f / static_cast<float>(_counter_frequency);
+    }
+
+    /** \brief Writes the frame history in the Chrome trace event JSON format.
+    *** \param filename The file to write to.
+    *** \return Whether the file was written.
+    **/
+    bool ExportChromeTrace(const std::string& filename) const;
+
+private:
+    //! \brief The ring buffer of frames, allocated once so that recording doesn't allocate.
+    std::vector<ProfilerFrame> _frames;
+
+    //! \brief The ring buffer index of the frame being recorded.
+    uint32_t _current_frame;
+
+    //! \brief The number of complete frames in the ring buffer.
+    uint32_t _number_of_frames;
+
+    //! \brief The current zone nesting depth.
+    uint32_t _current_depth;
+
+    //! \brief The high resolution counter frequency, in counter units per second.
+    uint64_t _counter_frequency;
+
+    //! \brief Whether the zones are recorded.
+    bool _enabled;
+
+    //! \brief Whether a frame is being recorded.
+    bool _in_frame;
+};
+
+/** ****************************************************************************
+*** \brief Records a zone in the system engine profiler for the lifetime of the object.
+*** ***************************************************************************/
+class ProfilerZone
+{
+public:
+    //! \param name The zone name. It must be a string literal, as only the pointer is kept.
+    explicit ProfilerZone(const char* name);
+
+    ~ProfilerZone();
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    ProfilerZone(const ProfilerZone& zone);
+    ProfilerZone& operator=(const ProfilerZone& zone);
+
+    //! \brief The recorded zone index, or -1 if the zone isn't recorded.
+    int32_t _zone_index;
+};
+
+} // namespace vt_system
+
+#endif // __PROFILER_HEADER__
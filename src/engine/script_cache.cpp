@@ -0,0 +1,311 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_cache.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the compiled Lua scripts cache.
+*** ***************************************************************************/
+
+#include "engine/script_cache.h"
+
+#include "common/app_settings.h"
+#include "script/script_read.h"
+
+#include "utils/utils_common.h"
+#include "utils/utils_files.h"
+#include "utils/utils_strings.h"
+
+#include <luabind/lua_include.hpp>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <dirent.h>
+#   include <sys/types.h>
+#endif
+
+#include <sys/stat.h>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+namespace vt_script
+{
+
+//! \brief The cache folder name, within the user data folder.
+const std::string SCRIPT_CACHE_FOLDER = "script_cache";
+
+//! \brief The first line of the compiled files starts with it. Lua skips such a line when loading a file.
+const std::string SCRIPT_CACHE_HEADER_START = "#";
+
+//! \brief The maximum length of the compiled files header line.
+const size_t SCRIPT_CACHE_HEADER_MAX_LENGTH = 256;
+
+/** \brief Returns the header line of the file compiled from the given source file, without the line end.
+*** It changes whenever the source file or the Lua build does.
+*** \return An empty string if the source file doesn't exist.
+**/
+static std::string _GetCacheHeader(const std::string& filename)
+{
+    struct stat file_status;
+    if (stat(filename.c_str(), &file_status) != 0)
+        return std::string();
+
+    // An updated install can bring older source files, so the modification time is compared for equality.
+    return SCRIPT_CACHE_HEADER_START + " " + LUA_RELEASE + " "
+        + vt_utils::NumberToString<uint32_t>(sizeof(void*) * 8) + "-bit "
+        + vt_utils::NumberToString<int64_t>(static_cast<int64_t>(file_status.st_mtime)) + " "
+        + vt_utils::NumberToString<int64_t>(static_cast<int64_t>(file_status.st_size));
+}
+
+//! \brief Reads the header line of a compiled file, without the line end.
+//! \return An empty string if the file doesn't exist or has no header.
+static std::string _ReadCacheHeader(const std::string& compiled_filename)
+{
+    FILE* file = fopen(compiled_filename.c_str(), "rb");
+    if (file == nullptr)
+        return std::string();
+
+    char line[SCRIPT_CACHE_HEADER_MAX_LENGTH];
+    std::string header;
+    if (fgets(line, sizeof(line), file) != nullptr)
+        header = line;
+    fclose(file);
+
+    if (header.empty() || header[header.size() - 1] != '\n'
+            || header.compare(0, SCRIPT_CACHE_HEADER_START.size(), SCRIPT_CACHE_HEADER_START) != 0) {
+        return std::string();
+    }
+    header.erase(header.size() - 1);
+    return header;
+}
+
+//! \brief Tells whether the given path is a folder.
+static bool _IsDirectory(const std::string& path)
+{
+    struct stat file_status;
+    if (stat(path.c_str(), &file_status) != 0)
+        return false;
+
+    return (file_status.st_mode & S_IFDIR) != 0;
+}
+
+//! \brief Lists the entries of a folder, without the '.' and '..' ones.
+static std::vector<std::string> _ListDirectory(const std::string& directory)
+{
+    std::vector<std::string> entries;
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA find_data;
+    HANDLE find_handle = FindFirstFileA((directory + "/*").c_str(), &find_data);
+    if (find_handle == INVALID_HANDLE_VALUE)
+        return entries;
+
+    do {
+        std::string entry = find_data.cFileName;
+        if (entry != "." && entry != "..")
+            entries.push_back(entry);
+    } while (FindNextFileA(find_handle, &find_data));
+    FindClose(find_handle);
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr)
+        return entries;
+
+    while (dirent* dir_entry = readdir(dir)) {
+        std::string entry = dir_entry->d_name;
+        if (entry != "." && entry != "..")
+            entries.push_back(entry);
+    }
+    closedir(dir);
+#endif
+
+    return entries;
+}
+
+//! \brief Returns the cache folder of the Lua version and architecture the game is built with, ending with a slash.
+static const std::string& _GetCacheDirectory()
+{
+    // Bytecode isn't compatible between Lua versions or architectures.
+    // The compiled files header also checks the exact Lua release.
+    static const std::string cache_directory = vt_common::GetUserDataPath() + SCRIPT_CACHE_FOLDER
+        + "/lua" + vt_utils::NumberToString<int32_t>(LUA_VERSION_NUM)
+        + "_" + vt_utils::NumberToString<uint32_t>(sizeof(void*) * 8) + "/";
+    return cache_directory;
+}
+
+//! \brief Creates every missing folder of the given file path.
+static bool _MakeParentDirectories(const std::string& filename)
+{
+    // Avoids checking the same folders for every script.
+    static std::set<std::string> created_directories;
+
+    // The user data folder itself already exists.
+    size_t separator = filename.find('/', vt_common::GetUserDataPath().size());
+    while (separator != std::string::npos) {
+        std::string directory = filename.substr(0, separator);
+        if (created_directories.find(directory) == created_directories.end()) {
+            if (!vt_utils::DoesFileExist(directory) && !vt_utils::MakeDirectory(directory))
+                return false;
+            created_directories.insert(directory);
+        }
+        separator = filename.find('/', separator + 1);
+    }
+    return true;
+}
+
+//! \brief The lua_dump() writer, appending the bytecode chunks to a file.
+static int _WriteChunk(lua_State* /*lua_state*/, const void* data, size_t size, void* file)
+{
+    return (fwrite(data, 1, size, static_cast<FILE*>(file)) == size) ? 0 : 1;
+}
+
+/** \brief Compiles a Lua script into the given file.
+*** \return false if the script couldn't be compiled or the file written.
+**/
+static bool _CompileScript(const std::string& filename, const std::string& compiled_filename,
+                           const std::string& header)
+{
+    if (!_MakeParentDirectories(compiled_filename))
+        return false;
+
+    // A private state is used, so that nothing is run.
+    lua_State* lua_state = luaL_newstate();
+    if (lua_state == nullptr)
+        return false;
+
+    if (luaL_loadfile(lua_state, filename.c_str()) != 0) {
+        PRINT_WARNING << "Couldn't compile the script: " << filename << ": "
+                      << lua_tostring(lua_state, -1) << std::endl;
+        lua_close(lua_state);
+        return false;
+    }
+
+    // Write into a temporary file first, so that a failure never leaves a truncated chunk behind.
+    const std::string temp_filename = compiled_filename + ".tmp";
+    FILE* file = fopen(temp_filename.c_str(), "wb");
+    if (file == nullptr) {
+        lua_close(lua_state);
+        return false;
+    }
+
+    bool written = (fputs((header + "\n").c_str(), file) >= 0);
+
+    // The debug information is kept, so that errors still give the source lines.
+#if LUA_VERSION_NUM >= 503
+    written = written && (lua_dump(lua_state, _WriteChunk, file, 0) == 0);
+#else
+    written = written && (lua_dump(lua_state, _WriteChunk, file) == 0);
+#endif
+    written = (fclose(file) == 0) && written;
+    lua_close(lua_state);
+
+    if (!written) {
+        remove(temp_filename.c_str());
+        return false;
+    }
+
+    // rename() doesn't overwrite existing files on every platform.
+    remove(compiled_filename.c_str());
+    if (rename(temp_filename.c_str(), compiled_filename.c_str()) != 0) {
+        remove(temp_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+/** \brief Compiles the script into the cache when needed.
+*** \param filename The Lua script source file.
+*** \param compiled_filename Set to the compiled file path.
+*** \param compiled Set to true when the script was compiled by this call.
+*** \return Whether the compiled file is up to date.
+**/
+static bool _UpdateCachedScript(const std::string& filename, std::string& compiled_filename, bool& compiled)
+{
+    compiled = false;
+
+    // Only the game files are cached, as they are keyed by their relative path.
+    if (filename.empty() || filename[0] == '/' || filename[0] == '\\'
+            || filename.find(':') != std::string::npos || filename.find("..") != std::string::npos) {
+        return false;
+    }
+
+    const std::string header = _GetCacheHeader(filename);
+    if (header.empty())
+        return false;
+
+    compiled_filename = _GetCacheDirectory() + filename;
+    for (size_t i = 0; i < compiled_filename.size(); ++i) {
+        if (compiled_filename[i] == '\\')
+            compiled_filename[i] = '/';
+    }
+
+    if (_ReadCacheHeader(compiled_filename) == header)
+        return true;
+
+    compiled = _CompileScript(filename, compiled_filename, header);
+    return compiled;
+}
+
+std::string GetCachedScriptFilename(const std::string& filename)
+{
+    std::string compiled_filename;
+    bool compiled = false;
+    if (!_UpdateCachedScript(filename, compiled_filename, compiled))
+        return filename;
+    return compiled_filename;
+}
+
+bool OpenCachedScript(ReadScriptDescriptor& script, const std::string& filename)
+{
+    const std::string compiled_filename = GetCachedScriptFilename(filename);
+    if (script.OpenFile(compiled_filename))
+        return true;
+
+    if (compiled_filename == filename)
+        return false;
+
+    // The compiled file may not be loadable by this Lua build: it is compiled again next time.
+    PRINT_WARNING << "Couldn't open the compiled script: " << compiled_filename
+                  << ", opening its source file instead." << std::endl;
+    remove(compiled_filename.c_str());
+    return script.OpenFile(filename);
+}
+
+uint32_t BuildScriptCache(const std::string& directory)
+{
+    uint32_t number_compiled = 0;
+
+    std::vector<std::string> entries = _ListDirectory(directory);
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        const std::string path = directory + "/" + entries[i];
+
+        if (_IsDirectory(path)) {
+            number_compiled += BuildScriptCache(path);
+            continue;
+        }
+
+        const std::string extension = ".lua";
+        if (path.size() <= extension.size()
+                || path.compare(path.size() - extension.size(), extension.size(), extension) != 0) {
+            continue;
+        }
+
+        std::string compiled_filename;
+        bool compiled = false;
+        _UpdateCachedScript(path, compiled_filename, compiled);
+        if (compiled)
+            ++number_compiled;
+    }
+
+    return number_compiled;
+}
+
+} // namespace vt_script
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_cache.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the compiled Lua scripts cache.
+***
+*** Opening a Lua data file compiles its whole source text, which is most of
+*** the time spent reading the big data tables (map data, tilesets, items...).
+*** The script cache compiles such files once into Lua bytecode, stored in the
+*** user data folder, and gives the compiled file to open instead as long as
+*** the source file doesn't change:
+***
+*** \code
+*** vt_script::ReadScriptDescriptor map_file;
+*** vt_script::OpenCachedScript(map_file, map_data_filename);
+*** \endcode
+***
+*** The compiled files start with a header line giving the Lua release, and the
+*** modification time and size of their source file. They are compiled again as
+*** soon as it differs.
+***
+*** \note Only use it for files read through fixed table names: the compiled file
+*** path differs from the source one, and so would a tablespace computed from it.
+*** ***************************************************************************/
+
+#ifndef __SCRIPT_CACHE_HEADER__
+#define __SCRIPT_CACHE_HEADER__
+
+#include <cstdint>
+#include <string>
+
+namespace vt_script
+{
+
+class ReadScriptDescriptor;
+
+/** \brief Returns the file to open for the given Lua script.
+*** The script is compiled into the cache first, when not done yet or when it changed since.
+*** \param filename The Lua script source file, relative to the game folder.
+*** \return The compiled file, or the source filename when it can't be compiled.
+**/
+std::string GetCachedScriptFilename(const std::string& filename);
+
+/** \brief Opens the compiled file of the given Lua script.
+*** The source file is opened instead when the compiled one can't be.
+*** \param script The script descriptor to open the file with.
+*** \param filename The Lua script source file, relative to the game folder.
+*** \return Whether a file was opened.
+**/
+bool OpenCachedScript(ReadScriptDescriptor& script, const std::string& filename);
+
+/** \brief Compiles all the Lua scripts of a folder and its subfolders into the cache.
+*** \param directory The folder to search, relative to the game folder.
+*** \return The number of scripts compiled, not counting the ones already up to date.
+**/
+uint32_t BuildScriptCache(const std::string& directory);
+
+} // namespace vt_script
+
+#endif // __SCRIPT_CACHE_HEADER__
@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_profiler.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the Lua call profiler
+*** ***************************************************************************/
+
+#include "engine/script_profiler.h"
+
+#include "engine/system.h"
+
+#include "script/script.h"
+
+#include "utils/utils_common.h"
+#include "utils/utils_strings.h"
+
+#include <SDL2/SDL_timer.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace vt_system
+{
+
+ScriptProfiler::ScriptProfiler():
+    _allocated_bytes(0),
+    _lua_state(nullptr),
+    _original_allocator(nullptr),
+    _original_allocator_data(nullptr),
+    _enabled(false)
+{
+}
+
+ScriptProfiler::~ScriptProfiler()
+{
+    // The Lua state must never keep calling the counting allocator once the profiler is gone.
+    _RestoreAllocator();
+}
+
+void ScriptProfiler::SetEnabled(bool enabled)
+{
+    if (_enabled == enabled)
+        return;
+
+    _enabled = enabled;
+    Reset();
+
+    if (_enabled)
+        _InstallAllocator();
+    else
+        _RestoreAllocator();
+}
+
+void ScriptProfiler::Reset()
+{
+    _statistics.clear();
+    _function_indices.clear();
+    _name_indices.clear();
+    _allocated_bytes = 0;
+}
+
+int32_t ScriptProfiler::BeginCall(const luabind::object& function)
+{
+    if (!_enabled || !function.is_valid())
+        return -1;
+
+    lua_State* lua_state = function.interpreter();
+    lua_Debug debug_info;
+    // The '>' option pops the function pushed.
+    function.push(lua_state);
+    if (lua_getinfo(lua_state, ">S", &debug_info) == 0)
+        return -1;
+
+    uint32_t index = 0;
+    std::pair<const char*, int> key(debug_info.source, debug_info.linedefined);
+    std::map<std::pair<const char*, int>, FunctionIndex>::const_iterator it = _function_indices.find(key);
+    if (it != _function_indices.end() && it->second.source == debug_info.source) {
+        index = it->second.index;
+    }
+    else {
+        std::string name = std::string(debug_info.short_src) + ":"
+                           + vt_utils::NumberToString(debug_info.linedefined);
+        std::map<std::string, uint32_t>::const_iterator name_it = _name_indices.find(name);
+        if (name_it != _name_indices.end()) {
+            index = name_it->second;
+        }
+        else {
+            index = static_cast<uint32_t>(_statistics.size());
+            _statistics.push_back(ScriptCallStatistics());
+            _statistics.back().name = name;
+            _name_indices[name] = index;
+        }
+        FunctionIndex& function_index = _function_indices[key];
+        function_index.source = debug_info.source;
+        function_index.index = index;
+    }
+
+    ScriptCallStatistics& statistics = _statistics[index];
+    ++statistics.calls;
+    ++statistics.active_calls;
+    return static_cast<int32_t>(index);
+}
+
+void ScriptProfiler::EndCall(int32_t index, uint64_t start_counter, uint64_t start_allocated_bytes)
+{
+    // The statistics may have been reset in between.
+    if (index < 0 || !_enabled || static_cast<uint32_t>(index) >= _statistics.size())
+        return;
+
+    ScriptCallStatistics& statistics = _statistics[index];
+    if (statistics.active_calls > 0)
+        --statistics.active_calls;
+
+    // Recursive calls are already included in the outermost one.
+    if (statistics.active_calls > 0)
+        return;
+
+    statistics.total_counter += SDL_GetPerformanceCounter() - start_counter;
+    if (_allocated_bytes > start_allocated_bytes)
+        statistics.allocated_bytes += _allocated_bytes - start_allocated_bytes;
+}
+
+//! \brief Sorts the statistics indices by decreasing total time.
+struct ScriptCallTimeComparator {
+    explicit ScriptCallTimeComparator(const std::vector<ScriptCallStatistics>& statistics):
+        _statistics(statistics)
+    {}
+
+    bool operator()(uint32_t first, uint32_t second) const {
+        return _statistics[first].total_counter > _statistics[second].total_counter;
+    }
+
+    const std::vector<ScriptCallStatistics>& _statistics;
+};
+
+std::vector<uint32_t> ScriptProfiler::GetSlowestCalls(uint32_t max_count) const
+{
+    std::vector<uint32_t> indices(_statistics.size());
+    for (uint32_t i = 0; i < indices.size(); ++i)
+        indices[i] = i;
+
+    std::sort(indices.begin(), indices.end(), ScriptCallTimeComparator(_statistics));
+    if (max_count > 0 && indices.size() > max_count)
+        indices.resize(max_count);
+    return indices;
+}
+
+bool ScriptProfiler::ExportStatistics(const std::string& filename) const
+{
+    if (_statistics.empty()) {
+        PRINT_WARNING << "No profiled Lua calls to export. Enable the profiler first." << std::endl;
+        return false;
+    }
+
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) {
+        PRINT_WARNING << "Couldn't open the Lua profiler file for writing: " << filename << std::endl;
+        return false;
+    }
+
+    const FrameProfiler& profiler = SystemManager->GetProfiler();
+
+    file << std::fixed << std::setprecision(3);
+    file << "Lua calls: " << _statistics.size() << " functions, "
+         << static_cast<double>(_allocated_bytes) / 1024.0 << " KB allocated" << std::endl << std::endl;
+    file << std::setw(10) << "calls" << std::setw(14) << "total ms" << std::setw(12) << "average ms"
+         << std::setw(14) << "allocated KB" << "  function" << std::endl;
+
+    std::vector<uint32_t> indices = GetSlowestCalls(0);
+    for (uint32_t i = 0; i < indices.size(); ++i) {
+        const ScriptCallStatistics& statistics = _statistics[indices[i]];
+        float total_ms = profiler.CounterToMilliseconds(statistics.total_counter);
+        file << std::setw(10) << statistics.calls
+             << std::setw(14) << total_ms
+             << std::setw(12) << (statistics.calls > 0 ? total_ms / statistics.calls : 0.0f)
+             << std::setw(14) << static_cast<double>(statistics.allocated_bytes) / 1024.0
+             << "  " << statistics.name << std::endl;
+    }
+    file.close();
+
+    if (file.fail()) {
+        PRINT_WARNING << "Failed to write the Lua profiler file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void* ScriptProfiler::_CountingAllocator(void* user_data, void* ptr, size_t old_size, size_t new_size)
+{
+    ScriptProfiler* profiler = static_cast<ScriptProfiler*>(user_data);
+
+    // When ptr is null, old_size isn't a block size but the type of the object allocated.
+    size_t previous_size = (ptr != nullptr) ? old_size : 0;
+    if (new_size > previous_size)
+        profiler->_allocated_bytes += new_size - previous_size;
+
+    return profiler->_original_allocator(profiler->_original_allocator_data, ptr, old_size, new_size);
+}
+
+void ScriptProfiler::_InstallAllocator()
+{
+    if (_lua_state != nullptr || vt_script::ScriptManager == nullptr)
+        return;
+
+    _lua_state = vt_script::ScriptManager->GetGlobalState();
+    if (_lua_state == nullptr)
+        return;
+
+    _original_allocator = lua_getallocf(_lua_state, &_original_allocator_data);
+    lua_setallocf(_lua_state, _CountingAllocator, this);
+}
+
+void ScriptProfiler::_RestoreAllocator()
+{
+    if (_lua_state == nullptr)
+        return;
+
+    lua_setallocf(_lua_state, _original_allocator, _original_allocator_data);
+    _lua_state = nullptr;
+    _original_allocator = nullptr;
+    _original_allocator_data = nullptr;
+}
+
+ScriptProfilerCall::ScriptProfilerCall(const luabind::object& function):
+    _index(-1),
+    _start_counter(0),
+    _start_allocated_bytes(0)
+{
+    if (!SystemManager || !SystemManager->GetScriptProfiler().IsEnabled())
+        return;
+
+    ScriptProfiler& profiler = SystemManager->GetScriptProfiler();
+    _index = profiler.BeginCall(function);
+    _start_allocated_bytes = profiler.GetAllocatedBytes();
+    _start_counter = SDL_GetPerformanceCounter();
+}
+
+ScriptProfilerCall::~ScriptProfilerCall()
+{
+    if (_index >= 0 && SystemManager)
+        SystemManager->GetScriptProfiler().EndCall(_index, _start_counter, _start_allocated_bytes);
+}
+
+} // namespace vt_system
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_profiler.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the Lua call profiler
+***
+*** The script profiler records, for each Lua function called from the engine,
+*** the number of calls, the time spent in it and the Lua memory it allocated.
+*** A call is recorded by declaring a ScriptProfilerCall object on the stack
+*** right before calling the function:
+***
+*** \code
+*** try {
+***     vt_system::ScriptProfilerCall profiler_call(_update_function);
+***     luabind::call_function<void>(_update_function);
+*** } catch(const luabind::error& e) {
+***     ...
+*** }
+*** \endcode
+***
+*** The functions are named after their script file and definition line.
+*** When the profiler is disabled, declaring a call only costs a boolean check.
+*** ***************************************************************************/
+
+#ifndef __SCRIPT_PROFILER_HEADER__
+#define __SCRIPT_PROFILER_HEADER__
+
+#include <luabind/lua_include.hpp>
+#include <luabind/object.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vt_system
+{
+
+//! \brief The statistics of a Lua function called from the engine.
+struct ScriptCallStatistics {
+    ScriptCallStatistics():
+        calls(0),
+        total_counter(0),
+        allocated_bytes(0),
+        active_calls(0)
+    {}
+
+    //! \brief The function name: its script file and definition line.
+    std::string name;
+
+    //! \brief The number of calls since the profiler was enabled.
+    uint32_t calls;
+
+    //! \brief The time spent in the function, including the functions it called, in high resolution counter units.
+    uint64_t total_counter;
+
+    //! \brief The bytes requested from the Lua allocator during the calls.
+    uint64_t allocated_bytes;
+
+    //! \brief The calls currently running, so that recursive calls aren't counted twice.
+    uint32_t active_calls;
+};
+
+/** ****************************************************************************
+*** \brief Records the Lua function calls made by the engine.
+***
+*** The profiler is owned by the system engine. \see SystemEngine::GetScriptProfiler().
+*** While enabled, it replaces the Lua allocator of the global state to count
+*** the allocated memory, and restores it once disabled.
+*** ***************************************************************************/
+class ScriptProfiler
+{
+public:
+    ScriptProfiler();
+
+    ~ScriptProfiler();
+
+    //! \brief Enables or disables the recording. Enabling it clears the statistics.
+    void SetEnabled(bool enabled);
+
+    bool IsEnabled() const {
+        return _enabled;
+    }
+
+    //! \brief Clears the statistics.
+    void Reset();
+
+    /** \brief Starts recording a call to the given Lua function.
+    *** \return The statistics index to give to EndCall(), or -1 if the call isn't recorded.
+    **/
+    int32_t BeginCall(const luabind::object& function);
+
+    /** \brief Ends recording a call.
+    *** \param start_counter The high resolution counter value when the call started.
+    *** \param start_allocated_bytes The allocated bytes count when the call started.
+    **/
+    void EndCall(int32_t index, uint64_t start_counter, uint64_t start_allocated_bytes);
+
+    //! \brief Returns the bytes requested from the Lua allocator since the profiler was enabled.
+    uint64_t GetAllocatedBytes() const {
+        return _allocated_bytes;
+    }
+
+    const std::vector<ScriptCallStatistics>& GetStatistics() const {
+        return _statistics;
+    }
+
+    /** \brief Returns the statistics indices sorted by decreasing total time.
+    *** \param max_count The maximum number of indices returned, or 0 for all of them.
+    **/
+    std::vector<uint32_t> GetSlowestCalls(uint32_t max_count) const;
+
+    /** \brief Writes the statistics in a text file, sorted by decreasing total time.
+    *** \param filename The file to write to.
+    *** \return Whether the file was written.
+    **/
+    bool ExportStatistics(const std::string& filename) const;
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    ScriptProfiler(const ScriptProfiler& profiler);
+    ScriptProfiler& operator=(const ScriptProfiler& profiler);
+
+    //! \brief The Lua allocator counting the allocated bytes, then calling the original one.
+    static void* _CountingAllocator(void* user_data, void* ptr, size_t old_size, size_t new_size);
+
+    //! \brief Installs or restores the original Lua allocator.
+    void _InstallAllocator();
+    void _RestoreAllocator();
+
+    //! \brief The recorded statistics.
+    std::vector<ScriptCallStatistics> _statistics;
+
+    //! \brief A statistics index, with the function source it was recorded for.
+    struct FunctionIndex {
+        std::string source;
+        uint32_t index;
+    };
+
+    //! \brief The statistics indices, by function source pointer and definition line.
+    //! This avoids building the name at each call. Once a script is collected, its source pointer
+    //! can be reused by another one, so the source is compared on each hit.
+    std::map<std::pair<const char*, int>, FunctionIndex> _function_indices;
+
+    //! \brief The statistics indices, by function name, merging the functions of reloaded scripts.
+    std::map<std::string, uint32_t> _name_indices;
+
+    //! \brief The bytes requested from the Lua allocator since the profiler was enabled.
+    uint64_t _allocated_bytes;
+
+    //! \brief The Lua state whose allocator was replaced, or nullptr.
+    lua_State* _lua_state;
+
+    //! \brief The original Lua allocator and its user data.
+    lua_Alloc _original_allocator;
+    void* _original_allocator_data;
+
+    //! \brief Whether the calls are recorded.
+    bool _enabled;
+};
+
+/** ****************************************************************************
+*** \brief Records a call in the system engine script profiler for the lifetime of the object.
+*** ***************************************************************************/
+class ScriptProfilerCall
+{
+public:
+    //! \param function The Lua function about to be called.
+    explicit ScriptProfilerCall(const luabind::object& function);
+
+    ~ScriptProfilerCall();
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    ScriptProfilerCall(const ScriptProfilerCall& call);
+    ScriptProfilerCall& operator=(const ScriptProfilerCall& call);
+
+    //! \brief The recorded statistics index, or -1 if the call isn't recorded.
+    int32_t _index;
+
+    //! \brief The high resolution counter value and allocated bytes when the call started.
+    uint64_t _start_counter;
+    uint64_t _start_allocated_bytes;
+};
+
+} // namespace vt_system
+
+#endif // __SCRIPT_PROFILER_HEADER__
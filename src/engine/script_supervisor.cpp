@@ -16,6 +16,8 @@
 #include "engine/script_supervisor.h"
 
 #include "engine/mode_manager.h"
+#include "engine/profiler.h"
+#include "engine/script_profiler.h"
 
 using namespace vt_video;
 using namespace vt_script;
@@ -80,8 +82,10 @@ void ScriptSupervisor::Initialize(vt_mode_manager::GameMode *gm)
 
         // Trigger the Initialize functions in the loading order.
         luabind::object init_function = scene_script->ReadFunctionPointer("Initialize");
-        if(init_function.is_valid() && gm)
+        if(init_function.is_valid() && gm) {
+            vt_system::ScriptProfilerCall profiler_call(init_function);
             luabind::call_function<void>(init_function, gm);
+        }
         else
             PRINT_ERROR << "Couldn't initialize the scene component" << std::endl; // Should never happen
     }
@@ -95,41 +99,61 @@ void ScriptSupervisor::SetDrawFlag(vt_video::VIDEO_DRAW_FLAGS draw_flag)
 void ScriptSupervisor::Reset()
 {
     // Updates custom scripts
-    for(uint32_t i = 0; i < _reset_functions.size(); ++i)
+    for(uint32_t i = 0; i < _reset_functions.size(); ++i) {
+        vt_system::ScriptProfilerCall profiler_call(_reset_functions[i]);
         ReadScriptDescriptor::RunScriptObject(_reset_functions[i]);
+    }
 }
 
 void ScriptSupervisor::Restart()
 {
     // Updates custom scripts
-    for(uint32_t i = 0; i < _restart_functions.size(); ++i)
+    for(uint32_t i = 0; i < _restart_functions.size(); ++i) {
+        vt_system::ScriptProfilerCall profiler_call(_restart_functions[i]);
         ReadScriptDescriptor::RunScriptObject(_restart_functions[i]);
+    }
 }
 
 void ScriptSupervisor::Update()
 {
+    vt_system::ProfilerZone zone("ScriptSupervisor::Update");
+
     // Updates custom scripts
-    for(uint32_t i = 0; i < _update_functions.size(); ++i)
+    for(uint32_t i = 0; i < _update_functions.size(); ++i) {
+        vt_system::ScriptProfilerCall profiler_call(_update_functions[i]);
         ReadScriptDescriptor::RunScriptObject(_update_functions[i]);
+    }
 }
 
 void ScriptSupervisor::DrawBackground()
 {
+    vt_system::ProfilerZone zone("ScriptSupervisor::DrawBackground");
+
     // Handles custom scripted draw before sprites
-    for(uint32_t i = 0; i < _draw_background_functions.size(); ++i)
+    for(uint32_t i = 0; i < _draw_background_functions.size(); ++i) {
+        vt_system::ScriptProfilerCall profiler_call(_draw_background_functions[i]);
         ReadScriptDescriptor::RunScriptObject(_draw_background_functions[i]);
+    }
 }
 
 void ScriptSupervisor::DrawForeground()
 {
-    for(uint32_t i = 0; i < _draw_foreground_functions.size(); ++i)
+    vt_system::ProfilerZone zone("ScriptSupervisor::DrawForeground");
+
+    for(uint32_t i = 0; i < _draw_foreground_functions.size(); ++i) {
+        vt_system::ScriptProfilerCall profiler_call(_draw_foreground_functions[i]);
         ReadScriptDescriptor::RunScriptObject(_draw_foreground_functions[i]);
+    }
 }
 
 void ScriptSupervisor::DrawPostEffects()
 {
-    for(uint32_t i = 0; i < _draw_post_effects_functions.size(); ++i)
+    vt_system::ProfilerZone zone("ScriptSupervisor::DrawPostEffects");
+
+    for(uint32_t i = 0; i < _draw_post_effects_functions.size(); ++i) {
+        vt_system::ScriptProfilerCall profiler_call(_draw_post_effects_functions[i]);
         ReadScriptDescriptor::RunScriptObject(_draw_post_effects_functions[i]);
+    }
 }
 
 // Images loading
@@ -104,6 +104,12 @@ public:
         return CreateText(vt_utils::MakeUnicodeString(text), style);
     }
 
+    //! \brief Tells whether the scripts update or draw anything each frame.
+    bool IsAnimated() const {
+        return !_update_functions.empty() || !_draw_background_functions.empty()
+               || !_draw_foreground_functions.empty() || !_draw_post_effects_functions.empty();
+    }
+
     //! \brief Used to permit changing a draw flag at boot time. Use with caution.
     void SetDrawFlag(vt_video::VIDEO_DRAW_FLAGS draw_flag);
 
@@ -18,6 +18,8 @@
 
 #include "engine/system.h"
 
+#include "engine/script_profiler.h"
+
 #include "script/script.h"
 
 #include "utils/utils_strings.h"
@@ -196,7 +198,8 @@ SystemTimer::SystemTimer() :
     _number_loops(0),
     _mode_owner(nullptr),
     _time_expired(0),
-    _times_completed(0)
+    _times_completed(0),
+    _auto_update_index(-1)
 {}
 
 SystemTimer::SystemTimer(uint32_t duration, int32_t loops) :
@@ -206,9 +209,49 @@ SystemTimer::SystemTimer(uint32_t duration, int32_t loops) :
     _number_loops(loops),
     _mode_owner(nullptr),
     _time_expired(0),
-    _times_completed(0)
+    _times_completed(0),
+    _auto_update_index(-1)
 {}
 
+SystemTimer::SystemTimer(const SystemTimer& timer) :
+    _state(timer._state),
+    _auto_update(timer._auto_update),
+    _duration(timer._duration),
+    _number_loops(timer._number_loops),
+    _mode_owner(timer._mode_owner),
+    _time_expired(timer._time_expired),
+    _times_completed(timer._times_completed),
+    _auto_update_index(-1)
+{
+    if(_auto_update) {
+        SystemManager->AddAutoTimer(this);
+    }
+}
+
+SystemTimer& SystemTimer::operator=(const SystemTimer& timer)
+{
+    if(this == &timer)
+        return *this;
+
+    // The auto system timers index belongs to this timer, and is never copied.
+    if(_auto_update) {
+        SystemManager->RemoveAutoTimer(this);
+    }
+
+    _state = timer._state;
+    _auto_update = timer._auto_update;
+    _duration = timer._duration;
+    _number_loops = timer._number_loops;
+    _mode_owner = timer._mode_owner;
+    _time_expired = timer._time_expired;
+    _times_completed = timer._times_completed;
+
+    if(_auto_update) {
+        SystemManager->AddAutoTimer(this);
+    }
+    return *this;
+}
+
 SystemTimer::~SystemTimer()
 {
     if(_auto_update) {
@@ -320,19 +363,6 @@ void SystemTimer::SetModeOwner(vt_mode_manager::GameMode *owner)
     _mode_owner = owner;
 }
 
-void SystemTimer::_AutoUpdate()
-{
-    if(_auto_update == false) {
-        IF_PRINT_WARNING(SYSTEM_DEBUG) << "tried to automatically update a timer that does not have auto updates enabled" << std::endl;
-        return;
-    }
-    if(IsRunning() == false) {
-        return;
-    }
-
-    _UpdateTimer(SystemManager->GetUpdateTime());
-}
-
 void SystemTimer::_UpdateTimer(uint32_t time)
 {
     _time_expired += time;
@@ -363,6 +393,13 @@ void SystemTimer::_UpdateTimer(uint32_t time)
 SystemEngine::SystemEngine():
     _last_update(0),
     _update_time(1), // Set to 1 to avoid hanging the system.
+    _update_count(0),
+    _last_frame_counter(0),
+    _frame_time_accumulator(0),
+    _render_interpolation(0.0f),
+    _frame_time(0.0f),
+    _fixed_frame_step(false),
+    _script_profiler(new ScriptProfiler()),
     _hours_played(0),
     _minutes_played(0),
     _seconds_played(0),
@@ -371,7 +408,8 @@ SystemEngine::SystemEngine():
     _message_speed(vt_gui::DEFAULT_MESSAGE_SPEED),
     _battle_target_cursor_memory(true),
     _game_difficulty(2), // Normal
-    _game_save_slots(10) // Default slot number to handle
+    _game_save_slots(10), // Default slot number to handle
+    _binary_save_games(false)
 {
     IF_PRINT_DEBUG(SYSTEM_DEBUG) << "constructor invoked" << std::endl;
 
@@ -383,6 +421,9 @@ SystemEngine::SystemEngine():
 SystemEngine::~SystemEngine()
 {
     IF_PRINT_DEBUG(SYSTEM_DEBUG) << "destructor invoked" << std::endl;
+
+    // Restores the Lua allocator, the script engine being destroyed afterwards.
+    delete _script_profiler;
 }
 
 bool SystemEngine::LoadLanguages()
@@ -566,17 +607,61 @@ void SystemEngine::InitializeTimers()
 {
     _last_update = SDL_GetTicks();
     _update_time = 1; // Set to non-zero, otherwise bad things may happen...
+    _update_count = 0;
+    _last_frame_counter = SDL_GetPerformanceCounter();
+    _frame_time_accumulator = 0;
+    _render_interpolation = 0.0f;
+    _frame_time = 0.0f;
     _hours_played = 0;
     _minutes_played = 0;
     _seconds_played = 0;
     _milliseconds_played = 0;
+
+    for(uint32_t i = 0; i < _auto_system_timers.size(); ++i)
+        _auto_system_timers[i]->_auto_update_index = -1;
     _auto_system_timers.clear();
 }
 
 void SystemEngine::InitializeUpdateTimer()
 {
-    _last_update = SDL_GetTicks();
     _update_time = 1;
+
+    // Don't catch up with the time spent loading the new mode.
+    _last_frame_counter = SDL_GetPerformanceCounter();
+    _frame_time_accumulator = 0;
+}
+
+uint32_t SystemEngine::AccumulateFrameTime()
+{
+    const uint64_t counter_frequency = SDL_GetPerformanceFrequency();
+    const uint64_t update_step = counter_frequency / SYSTEM_UPDATES_PER_SECOND;
+
+    uint64_t current_counter = SDL_GetPerformanceCounter();
+    uint64_t elapsed = current_counter - _last_frame_counter;
+    _frame_time = static_cast<float>(elapsed * 1000.0 / counter_frequency);
+    _frame_time_accumulator += elapsed;
+    _last_frame_counter = current_counter;
+
+    if (_fixed_frame_step) {
+        // Each frame draws the state of its own update.
+        _frame_time_accumulator = 0;
+        _render_interpolation = 1.0f;
+        return 1;
+    }
+
+    uint32_t updates = static_cast<uint32_t>(_frame_time_accumulator / update_step);
+    if (updates > SYSTEM_MAX_UPDATES_PER_FRAME) {
+        // Drop the time we can't catch up with.
+        updates = SYSTEM_MAX_UPDATES_PER_FRAME;
+        _frame_time_accumulator = update_step * SYSTEM_MAX_UPDATES_PER_FRAME
+                                  + _frame_time_accumulator % update_step;
+    }
+
+    _frame_time_accumulator -= update_step * updates;
+    _render_interpolation = static_cast<float>(_frame_time_accumulator)
+                            / static_cast<float>(update_step);
+
+    return updates;
 }
 
 void SystemEngine::AddAutoTimer(SystemTimer *timer)
@@ -590,9 +675,13 @@ void SystemEngine::AddAutoTimer(SystemTimer *timer)
         return;
     }
 
-    if(_auto_system_timers.insert(timer).second == false) {
+    if(timer->_auto_update_index >= 0) {
         IF_PRINT_WARNING(SYSTEM_DEBUG) << "timer already existed in auto system timer container" << std::endl;
+        return;
     }
+
+    timer->_auto_update_index = static_cast<int32_t>(_auto_system_timers.size());
+    _auto_system_timers.push_back(timer);
 }
 
 void SystemEngine::RemoveAutoTimer(SystemTimer *timer)
@@ -605,17 +694,30 @@ void SystemEngine::RemoveAutoTimer(SystemTimer *timer)
         IF_PRINT_WARNING(SYSTEM_DEBUG) << "timer did not have auto update feature enabled" << std::endl;
     }
 
-    if(_auto_system_timers.erase(timer) == 0) {
+    int32_t index = timer->_auto_update_index;
+    if(index < 0 || index >= static_cast<int32_t>(_auto_system_timers.size())
+            || _auto_system_timers[index] != timer) {
         IF_PRINT_WARNING(SYSTEM_DEBUG) << "timer was not found in auto system timer container" << std::endl;
+        return;
     }
+
+    // Move the last timer in place of the removed one.
+    SystemTimer* last_timer = _auto_system_timers.back();
+    _auto_system_timers[index] = last_timer;
+    last_timer->_auto_update_index = index;
+    _auto_system_timers.pop_back();
+    timer->_auto_update_index = -1;
 }
 
-void SystemEngine::UpdateTimers(uint32_t update_tick)
+void SystemEngine::UpdateTimers()
 {
-    // Update the update game timer
-    uint32_t tmp = _last_update;
-    _last_update = update_tick;
-    _update_time = _last_update - tmp;
+    // Update the update game timer using a fixed step.
+    // The step is computed from the update count, so that 60 updates always last 1000 ms.
+    uint32_t step_index = _update_count % SYSTEM_UPDATES_PER_SECOND;
+    _update_time = (step_index + 1) * 1000 / SYSTEM_UPDATES_PER_SECOND
+                   - step_index * 1000 / SYSTEM_UPDATES_PER_SECOND;
+    _last_update += _update_time;
+    ++_update_count;
 
     // Update the game play timer
     _milliseconds_played += _update_time;
@@ -632,24 +734,28 @@ void SystemEngine::UpdateTimers(uint32_t update_tick)
         }
     }
 
-    // Update all SystemTimer objects
-    for(std::set<SystemTimer *>::iterator i = _auto_system_timers.begin(); i != _auto_system_timers.end(); ++i)
-        (*i)->_AutoUpdate();
+    // Update all the running SystemTimer objects
+    for(uint32_t i = 0; i < _auto_system_timers.size(); ++i) {
+        SystemTimer* timer = _auto_system_timers[i];
+        if(timer->IsRunning())
+            timer->_UpdateTimer(_update_time);
+    }
 }
 
 void SystemEngine::ExamineSystemTimers()
 {
     GameMode* active_mode = ModeManager->GetTop();
 
-    for(std::set<SystemTimer *>::iterator i = _auto_system_timers.begin(); i != _auto_system_timers.end(); ++i) {
-        GameMode* timer_mode = (*i)->GetModeOwner();
+    for(uint32_t i = 0; i < _auto_system_timers.size(); ++i) {
+        SystemTimer* timer = _auto_system_timers[i];
+        GameMode* timer_mode = timer->GetModeOwner();
         if(timer_mode == nullptr)
             continue;
 
         if(timer_mode == active_mode)
-            (*i)->Run();
+            timer->Run();
         else
-            (*i)->Pause();
+            timer->Pause();
     }
 }
 
@@ -25,11 +25,13 @@
 #ifndef __SYSTEM_HEADER__
 #define __SYSTEM_HEADER__
 
+#include "engine/profiler.h"
+
 #include "utils/ustring.h"
 #include "utils/singleton.h"
 
-#include <set>
 #include <map>
+#include <vector>
 
 namespace vt_mode_manager {
 class GameMode;
@@ -40,6 +42,7 @@ namespace vt_system
 {
 
 class SystemEngine;
+class ScriptProfiler;
 
 //! The engine default language used, in case no language config file can be read.
 const std::string DEFAULT_LOCALE = "en_GB";
@@ -57,6 +60,15 @@ extern bool SYSTEM_DEBUG;
 **/
 const uint32_t SYSTEM_INFINITE_TIME = 0xFFFFFFFF;
 
+//! \brief The fixed number of game logic updates done per second, independently from the frame rate.
+const uint32_t SYSTEM_UPDATES_PER_SECOND = 60;
+
+/** \brief The maximum number of game logic updates done before rendering a frame.
+*** When the machine can't keep up, the remaining time is dropped and the game slows down
+*** instead of spending all its time catching up.
+**/
+const uint32_t SYSTEM_MAX_UPDATES_PER_FRAME = 5;
+
 /** \brief A constant to pass to any "loops" function argument in the TimerSystem class
 *** Passing this constant to a TimerSystem object will instruct the timer to run indefinitely
 *** and never finish.
@@ -220,7 +232,7 @@ private:
 *** ***************************************************************************/
 class SystemTimer
 {
-    friend class SystemEngine; // For allowing SystemEngine to call the _AutoUpdate() method
+    friend class SystemEngine; // For allowing SystemEngine to update the auto update timers
 
 public:
     /** The no-arg constructor leaves the timer in the SYSTEM_TIMER_INVALID state.
@@ -234,6 +246,12 @@ public:
     **/
     SystemTimer(uint32_t duration, int32_t loops = 0);
 
+    /** \brief Copies the timer state. An auto updated copy is added to the auto system timers
+    *** of the SystemEngine class on its own, rather than taking the copied timer place there.
+    **/
+    SystemTimer(const SystemTimer& timer);
+    SystemTimer& operator=(const SystemTimer& timer);
+
     virtual ~SystemTimer();
 
     /** \brief Initializes the critical members of the system timer class
@@ -394,10 +412,10 @@ protected:
     //! \brief Incremented by one each time the timer reaches the finished state
     uint32_t _times_completed;
 
-    /** \brief Updates the timer if it is running and has auto updating enabled
-    *** This method can only be invoked by the SystemEngine class.
+    /** \brief The timer index in the auto system timers of the SystemEngine class, or -1 when it isn't in it.
+    *** It lets the timer be removed from there without searching for it.
     **/
-    virtual void _AutoUpdate();
+    int32_t _auto_update_index;
 
     /** \brief Performs the actual update of the class members
     *** \param amount The amount of time to update the timer by
@@ -405,7 +423,7 @@ protected:
     *** The function contains the core logic of performing the update for the _time_expired and
     *** _times_completed members as well as setting the _state member to SYSTEM_TIMER_FINISHED
     *** when the timer has completed all of its loops. This is a helper function to the Update()
-    *** and _AutoUpdate() methods, who should perform all appropriate checking of timer state
+    *** method and to SystemEngine::UpdateTimers(), who should perform all appropriate checking of timer state
     *** before calling this method. The method intentionally does not do any state or error-checking
     *** by itself; It simply updates the timer without complaint.
     **/
@@ -438,10 +456,31 @@ public:
 
     /** \brief Initializes the game update timer
     *** This function should typically only be called when the active game mode is changed. This ensures that
-    *** the active game mode's execution begins with only 1 millisecond of time expired instead of several.
+    *** the active game mode's execution begins with only 1 millisecond of time expired instead of several,
+    *** and that the time spent loading the mode isn't caught up with fixed updates.
     **/
     void InitializeUpdateTimer();
 
+    /** \brief Accumulates the real time elapsed since the last call using the high resolution counter.
+    *** This function should only be called <b>once</b> per frame, in the main loop.
+    *** \return The number of fixed game logic updates to run before rendering the frame,
+    *** capped at SYSTEM_MAX_UPDATES_PER_FRAME.
+    *** \note Also computes the render interpolation factor. \see GetRenderInterpolation().
+    **/
+    uint32_t AccumulateFrameTime();
+
+    /** \brief Makes each frame run exactly one fixed logic update, however long it took.
+    *** This makes the game logic independent of the machine speed, as needed by the input replays.
+    *** \see vt_input::InputReplay
+    **/
+    void SetFixedFrameStep(bool fixed) {
+        _fixed_frame_step = fixed;
+    }
+
+    bool IsFixedFrameStep() const {
+        return _fixed_frame_step;
+    }
+
     /** \brief Adds a timer to the set system timers for auto updating
     *** \param timer A pointer to the timer to add
     ***
@@ -458,12 +497,13 @@ public:
     **/
     void RemoveAutoTimer(SystemTimer *timer);
 
-    /** \brief Updates the game timer variables.
-    *** This function should only be called <b>once</b> for each cycle through the main game loop. Since
-    *** it is called inside the loop in main.cpp, you should have no reason to call this function anywhere
-    *** else.
+    /** \brief Updates the game timer variables by one fixed logic step.
+    *** This function should only be called <b>once</b> for each game logic update of the main game loop.
+    *** Since it is called inside the loop in main.cpp, you should have no reason to call this function
+    *** anywhere else.
+    *** \note The fixed step alternates between 16 and 17 milliseconds to match SYSTEM_UPDATES_PER_SECOND.
     **/
-    void UpdateTimers(uint32_t update_tick);
+    void UpdateTimers();
 
     /** \brief Checks all system timers for whether they should be paused or resumed
     *** This function is typically called whenever the ModeEngine class has changed the active game mode.
@@ -484,6 +524,33 @@ public:
         return _update_time;
     }
 
+    /** \brief Gives how far the rendered frame is between the last logic update and the next one.
+    *** \return A factor between 0.0f and 1.0f, used by the map and battle modes to draw the positions
+    *** between the ones of the last two logic updates. It is 1.0f with a fixed frame step.
+    **/
+    float GetRenderInterpolation() const {
+        return _render_interpolation;
+    }
+
+    /** \brief Gets the real time spent on the last rendered frame.
+    *** \return The number of milliseconds elapsed between the last two calls of AccumulateFrameTime(),
+    *** with the high resolution counter precision.
+    *** \note Unlike GetUpdateTime(), this isn't a fixed step and reflects the actual frame rate.
+    **/
+    float GetFrameTime() const {
+        return _frame_time;
+    }
+
+    //! \brief Returns the frame profiler. \see ProfilerZone.
+    FrameProfiler& GetProfiler() {
+        return _profiler;
+    }
+
+    //! \brief Returns the Lua call profiler. \see ScriptProfilerCall.
+    ScriptProfiler& GetScriptProfiler() {
+        return *_script_profiler;
+    }
+
     /** \brief Sets the play time of a game instance
     *** \param h The amount of hours to set.
     *** \param m The amount of minutes to set.
@@ -607,6 +674,15 @@ public:
             _game_save_slots = 10;
     }
 
+    //! \brief Tells whether the save games are written in the binary format, rather than in Lua.
+    bool GetBinarySaveGames() const {
+        return _binary_save_games;
+    }
+
+    void SetBinarySaveGames(bool binary_save_games) {
+        _binary_save_games = binary_save_games;
+    }
+
 private:
     SystemEngine();
 
@@ -616,6 +692,30 @@ private:
     //! \brief The number of milliseconds that have transpired on the last timer update.
     uint32_t _update_time;
 
+    //! \brief The number of fixed logic updates done, used to compute the next fixed step duration.
+    uint32_t _update_count;
+
+    //! \brief The high resolution counter value at the last call of AccumulateFrameTime().
+    uint64_t _last_frame_counter;
+
+    //! \brief The real time not yet consumed by fixed logic updates, in high resolution counter units.
+    uint64_t _frame_time_accumulator;
+
+    //! \brief The current render interpolation factor. \see GetRenderInterpolation().
+    float _render_interpolation;
+
+    //! \brief The real duration of the last frame in milliseconds. \see GetFrameTime().
+    float _frame_time;
+
+    //! \brief Whether each frame runs exactly one fixed logic update. \see SetFixedFrameStep().
+    bool _fixed_frame_step;
+
+    //! \brief The frame profiler, recording the time spent in each engine subsystem.
+    FrameProfiler _profiler;
+
+    //! \brief The Lua call profiler, kept as a pointer so that this header doesn't depend on Lua.
+    ScriptProfiler* _script_profiler;
+
     /** \name Play time members
     *** \brief Timers that retain the total amount of time that the user has been playing
     *** When the player starts a new game or loads an existing game, these timers are reset.
@@ -654,10 +754,16 @@ private:
     //! \brief Sets the number of game slots that will be available to the player.
     uint32_t _game_save_slots;
 
-    /** \brief A set container for all SystemTimer objects that have automatic updating enabled
+    //! \brief Tells whether the save games are written in the binary format.
+    //! Both formats are always read.
+    bool _binary_save_games;
+
+    /** \brief A container for all SystemTimer objects that have automatic updating enabled
     *** The timers in this container are updated on each call to UpdateTimers().
+    *** Each timer knows its index in it, so that it is added and removed in constant time
+    *** without any allocation once the container has grown.
     **/
-    std::set<SystemTimer *> _auto_system_timers;
+    std::vector<SystemTimer *> _auto_system_timers;
 }; // class SystemEngine : public vt_utils::Singleton<SystemEngine>
 
 } // namepsace vt_system
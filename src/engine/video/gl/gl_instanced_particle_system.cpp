@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_instanced_particle_system.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for instanced buffers for a particle system.
+*** ***************************************************************************/
+
+#include "gl_instanced_particle_system.h"
+
+#include "utils/exception.h"
+#include "utils/utils_strings.h"
+#include "utils/utils_common.h"
+
+#include <cassert>
+
+namespace vt_video
+{
+namespace gl
+{
+
+//! \brief constants.
+const unsigned VERTICES_PER_PARTICLE = 4;
+
+//! \brief The unit quad corners, in triangle fan order:
+//! upper-left, upper-right, lower-right, lower-left.
+const float CORNERS[] = {
+    -1.0f, -1.0f,
+     1.0f, -1.0f,
+     1.0f,  1.0f,
+    -1.0f,  1.0f
+};
+
+//! \brief The attribute slots, matching the order given to the shader program.
+const GLuint CORNER_ATTRIBUTE = 0;
+const GLuint INSTANCE_ATTRIBUTE = 1;
+const GLuint ROTATION_ATTRIBUTE = 2;
+const GLuint COLOR_ATTRIBUTE = 3;
+
+#ifndef __APPLE__
+//! \brief Sets the attribute divisor, using the core entry point when available.
+static void _VertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    if (GLEW_VERSION_3_3)
+        glVertexAttribDivisor(index, divisor);
+    else
+        glVertexAttribDivisorARB(index, divisor);
+}
+
+//! \brief Draws the instances, using the core entry point when available.
+static void _DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instance_count)
+{
+    if (GLEW_VERSION_3_3)
+        glDrawArraysInstanced(mode, first, count, instance_count);
+    else
+        glDrawArraysInstancedARB(mode, first, count, instance_count);
+}
+#endif
+
+InstancedParticleSystem::InstancedParticleSystem() :
+    _number_of_instances(0),
+    _instance_buffer_capacity(0),
+    _vao(0),
+    _corner_buffer(0),
+    _instance_buffer(0)
+{
+#ifndef __APPLE__
+    bool errors = false;
+
+    // Create the vertex array object.
+    if (!errors) {
+        GLuint arrays[1] = { 0 };
+        glGenVertexArrays(1, arrays);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            errors = true;
+            PRINT_ERROR << "Failed to create the vertex array object." << std::endl;
+            assert(error == GL_NO_ERROR);
+        } else {
+            _vao = arrays[0];
+        }
+    }
+
+    if (!errors) {
+        glBindVertexArray(_vao);
+    }
+
+    // Create the corner and instance buffers.
+    if (!errors) {
+        GLuint buffers[2] = { 0 };
+        glGenBuffers(2, buffers);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            errors = true;
+            PRINT_ERROR << "Failed to create the vertex array object's corner and instance buffers. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+        } else {
+            _corner_buffer = buffers[0];
+            _instance_buffer = buffers[1];
+        }
+    }
+
+    // Store the static quad corners into slot 0.
+    if (!errors) {
+        glBindBuffer(GL_ARRAY_BUFFER, _corner_buffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(CORNERS), CORNERS, GL_STATIC_DRAW);
+        glVertexAttribPointer(CORNER_ATTRIBUTE, 2, GL_FLOAT, false, 0, nullptr);
+        glEnableVertexAttribArray(CORNER_ATTRIBUTE);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            errors = true;
+            PRINT_ERROR << "Failed to store the corner data. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                           vt_utils::NumberToString(_corner_buffer) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+        }
+    }
+
+    // Set up the per-instance attributes into slots 1 to 3.
+    if (!errors) {
+        const GLsizei stride = sizeof(ParticleInstance);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _instance_buffer);
+        glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+
+        glVertexAttribPointer(INSTANCE_ATTRIBUTE, 4, GL_FLOAT, false, stride,
+                              reinterpret_cast<const GLvoid*>(offsetof(ParticleInstance, x)));
+        glVertexAttribPointer(ROTATION_ATTRIBUTE, 1, GL_FLOAT, false, stride,
+                              reinterpret_cast<const GLvoid*>(offsetof(ParticleInstance, rotation)));
+        glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_FLOAT, false, stride,
+                              reinterpret_cast<const GLvoid*>(offsetof(ParticleInstance, color)));
+
+        glEnableVertexAttribArray(INSTANCE_ATTRIBUTE);
+        glEnableVertexAttribArray(ROTATION_ATTRIBUTE);
+        glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+
+        // Advance those attributes once per particle instead of once per vertex.
+        _VertexAttribDivisor(INSTANCE_ATTRIBUTE, 1);
+        _VertexAttribDivisor(ROTATION_ATTRIBUTE, 1);
+        _VertexAttribDivisor(COLOR_ATTRIBUTE, 1);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            PRINT_ERROR << "Failed to set the instance data attribute pointers. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                           vt_utils::NumberToString(_instance_buffer) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+        }
+    }
+
+    // Unbind the vertex array object from the pipeline.
+    glBindVertexArray(0);
+
+    // Unbind the active buffers from the pipeline.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+}
+
+InstancedParticleSystem::~InstancedParticleSystem()
+{
+#ifndef __APPLE__
+    if (_vao != 0) {
+        const GLuint arrays[] = { _vao };
+        glDeleteVertexArrays(1, arrays);
+        _vao = 0;
+    }
+
+    if (_corner_buffer != 0) {
+        const GLuint buffers[] = { _corner_buffer };
+        glDeleteBuffers(1, buffers);
+        _corner_buffer = 0;
+    }
+
+    if (_instance_buffer != 0) {
+        const GLuint buffers[] = { _instance_buffer };
+        glDeleteBuffers(1, buffers);
+        _instance_buffer = 0;
+    }
+#endif
+}
+
+bool InstancedParticleSystem::IsSupported()
+{
+#ifdef __APPLE__
+    // The legacy OSX context doesn't go through GLEW. Use the default path there.
+    return false;
+#else
+    // The core entry points are used from OpenGL 3.3, and the ARB ones otherwise.
+    return (GLEW_VERSION_3_3 || (GLEW_ARB_instanced_arrays && GLEW_ARB_draw_instanced))
+        && (GLEW_VERSION_3_0 || GLEW_ARB_vertex_array_object);
+#endif
+}
+
+void InstancedParticleSystem::Draw(const ParticleInstance* instances,
+                                   unsigned number_of_particles)
+{
+#ifndef __APPLE__
+    if (number_of_particles == 0)
+        return;
+
+    // Upload the instances when given.
+    if (instances != nullptr) {
+        glBindBuffer(GL_ARRAY_BUFFER, _instance_buffer);
+
+        // Only reallocate the buffer storage when it grows,
+        // otherwise orphan it and stream the new data in.
+        if (number_of_particles > _instance_buffer_capacity) {
+            glBufferData(GL_ARRAY_BUFFER,
+                         number_of_particles * sizeof(ParticleInstance),
+                         instances,
+                         GL_STREAM_DRAW);
+            _instance_buffer_capacity = number_of_particles;
+        } else {
+            glBufferData(GL_ARRAY_BUFFER,
+                         _instance_buffer_capacity * sizeof(ParticleInstance),
+                         nullptr,
+                         GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER,
+                            0,
+                            number_of_particles * sizeof(ParticleInstance),
+                            instances);
+        }
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            PRINT_ERROR << "Failed to update the instance data. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                           vt_utils::NumberToString(_instance_buffer) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        _number_of_instances = number_of_particles;
+    }
+
+    assert(number_of_particles <= _number_of_instances);
+
+    // Draw one quad per instance.
+    glBindVertexArray(_vao);
+    _DrawArraysInstanced(GL_TRIANGLE_FAN, 0, VERTICES_PER_PARTICLE, number_of_particles);
+    glBindVertexArray(0);
+#else
+    (void)instances;
+    (void)number_of_particles;
+#endif
+}
+
+InstancedParticleSystem::InstancedParticleSystem(const InstancedParticleSystem&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+InstancedParticleSystem& InstancedParticleSystem::operator=(const InstancedParticleSystem&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace gl
+} // namespace vt_video
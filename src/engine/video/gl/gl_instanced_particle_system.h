@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_instanced_particle_system.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for instanced buffers for a particle system.
+***
+*** Each particle is uploaded as a single instance record, and the particle
+*** quads are expanded in the vertex shader.
+*** ***************************************************************************/
+
+#ifndef __GL_INSTANCED_PARTICLE_SYSTEM_HEADER__
+#define __GL_INSTANCED_PARTICLE_SYSTEM_HEADER__
+
+#include "utils/gl_include.h"
+
+#include <cstddef>
+
+namespace vt_video
+{
+namespace gl
+{
+
+//! \brief The per-particle data uploaded when drawing an instanced particle system.
+struct ParticleInstance {
+    //! The particle center position.
+    float x;
+    float y;
+
+    //! Half the particle quad width and height, scale included.
+    float half_width;
+    float half_height;
+
+    //! The particle rotation angle in radians.
+    float rotation;
+
+    //! The particle color.
+    float color[4];
+};
+
+//! \brief A class for drawing a particle system using one instance per particle.
+class InstancedParticleSystem
+{
+public:
+    InstancedParticleSystem();
+    ~InstancedParticleSystem();
+
+    //! \brief Tells whether the current OpenGL context supports instanced drawing.
+    static bool IsSupported();
+
+    //! \brief Draws all particles in a particle system.
+    //! The instances are uploaded only when needed. The texture rectangle and color scale
+    //! are shader uniforms, so the same instances can be drawn several times.
+    //! \param instances The particle instances, or nullptr to redraw the last uploaded ones.
+    void Draw(const ParticleInstance* instances,
+              unsigned number_of_particles);
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design
+    //! to cause compilation errors when attempting to copy or assign this class.
+    InstancedParticleSystem(const InstancedParticleSystem& particle_system);
+    InstancedParticleSystem& operator=(const InstancedParticleSystem& particle_system);
+
+    //! The number of instances uploaded in the instance buffer.
+    unsigned _number_of_instances;
+
+    //! The number of instances the instance buffer can currently hold.
+    unsigned _instance_buffer_capacity;
+
+    GLuint _vao;
+    GLuint _corner_buffer;
+    GLuint _instance_buffer;
+};
+
+} // namespace gl
+} // namespace vt_video
+
+#endif // __GL_INSTANCED_PARTICLE_SYSTEM_HEADER__
@@ -45,6 +45,37 @@ namespace shader_definitions
         "    gl_TexCoord[0].xy = in_TexCoords.xy;\n"
         "}\n";
 
+    const char PARTICLE_INSTANCED_VERTEX[] =
+        "#version 110\n"
+        "\n"
+        "//\n"
+        "// Expands one particle instance into a quad corner.\n"
+        "//\n"
+        "\n"
+        "uniform mat4 u_Model;\n"
+        "uniform mat4 u_View;\n"
+        "uniform mat4 u_Projection;\n"
+        "uniform vec4 u_TexRect;\n"
+        "uniform float u_ColorScale;\n"
+        "\n"
+        "attribute vec2 in_Corner;\n"
+        "attribute vec4 in_Instance;\n"
+        "attribute float in_Rotation;\n"
+        "attribute vec4 in_Color;\n"
+        "\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 offset = in_Corner * in_Instance.zw;\n"
+        "    float c = cos(in_Rotation);\n"
+        "    float s = sin(in_Rotation);\n"
+        "    offset = vec2(offset.x * c - offset.y * s, offset.x * s + offset.y * c);\n"
+        "\n"
+        "    vec4 position     = vec4(in_Instance.xy + offset, 0.0, 1.0);\n"
+        "    gl_Position       = u_Projection * (u_View * (u_Model * position));\n"
+        "    gl_FrontColor     = in_Color * u_ColorScale;\n"
+        "    gl_TexCoord[0].xy = mix(u_TexRect.xy, u_TexRect.zw, in_Corner * 0.5 + 0.5);\n"
+        "}\n";
+
     const char SOLID_FRAGMENT[] =
         "#version 110\n"
         "\n"
@@ -29,6 +29,7 @@ enum ShaderPrograms
     SolidGrayscale,
     Sprite,
     SpriteGrayscale,
+    ParticleInstanced,
     Count
 };
 
@@ -209,6 +209,13 @@ bool ImageDescriptor::GetImageInfo(const std::string& filename,
     cols = 0;
     bpp = 0;
 
+    // Don't decode the file a second time when it has been decoded ahead of time.
+    // The preloaded pixels are always converted to 32 bits.
+    if (TextureManager != nullptr && TextureManager->_GetPreloadedImageSize(filename, cols, rows)) {
+        bpp = 32 * 8;
+        return true;
+    }
+
     SDL_Surface* surf = IMG_Load(filename.c_str());
 
     if (!surf) {
@@ -563,13 +570,13 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const
     if (VideoManager->_current_context.blend) {
         VideoManager->EnableBlending();
         if (VideoManager->_current_context.blend == 1) {
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
+            VideoManager->SubmitGLCommand([]() { glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); }); // Normal blending
         } else {
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE); // Additive blending
+            VideoManager->SubmitGLCommand([]() { glBlendFunc(GL_SRC_ALPHA, GL_ONE); }); // Additive blending
         }
     } else if (_blend) {
         VideoManager->EnableBlending();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
+        VideoManager->SubmitGLCommand([]() { glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); }); // Normal blending
     } else {
         VideoManager->DisableBlending();
     }
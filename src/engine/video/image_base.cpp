@@ -73,9 +73,22 @@ bool ImageMemory::LoadImage(const std::string& filename)
         IF_PRINT_WARNING(VIDEO_DEBUG) << "_pixels member was not empty upon function invocation" << std::endl;
     }
 
+    if (TextureManager != nullptr)
+        TextureManager->_RecordImageFile(filename);
+
+    // The file may have been decoded ahead of time.
+    if (TextureManager != nullptr && TextureManager->_TakePreloadedImage(filename, *this))
+        return true;
+
+    return _LoadImageFile(filename, true);
+}
+
+bool ImageMemory::_LoadImageFile(const std::string& filename, bool report_errors)
+{
     SDL_Surface* temp_surf = IMG_Load(filename.c_str());
     if (temp_surf == nullptr) {
-        PRINT_ERROR << "Couldn't load image file: " << filename << std::endl;
+        if (report_errors)
+            PRINT_ERROR << "Couldn't load image file: " << filename << std::endl;
         return false;
     }
 
@@ -377,7 +390,9 @@ void ImageMemory::CopyFromTexture(TexSheet *texture)
     }
 
     TextureManager->_BindTexture(texture->tex_id);
-    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
+    VideoManager->RunGLCommand([this]() {
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
+    });
 }
 
 void ImageMemory::CopyFromImage(BaseTexture *img)
@@ -453,20 +468,37 @@ void ImageMemory::CopyFrom(const ImageMemory& src, uint32_t src_offset)
 
 void ImageMemory::GlGetTexImage()
 {
-    glGetTexImage(GL_TEXTURE_2D, 0,
-                  _rgb_format ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
+    VideoManager->RunGLCommand([this]() {
+        glGetTexImage(GL_TEXTURE_2D, 0,
+                      _rgb_format ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
+    });
 }
 
 void ImageMemory::GlTexSubImage(int32_t x, int32_t y)
 {
-    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, _width, _height,
-                    _rgb_format ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
+    if (!VideoManager->IsRenderThreadRunning()) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, _width, _height,
+                        _rgb_format ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
+        return;
+    }
+
+    // The image memory is usually released right after, so the command keeps its own copy.
+    const GLsizei width = _width;
+    const GLsizei height = _height;
+    const GLenum format = _rgb_format ? GL_RGB : GL_RGBA;
+    std::vector<uint8_t> pixels(_pixels);
+    VideoManager->SubmitGLCommand([=]() {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height,
+                        format, GL_UNSIGNED_BYTE, &pixels[0]);
+    });
 }
 
 void ImageMemory::GlReadPixels(int32_t x, int32_t y)
 {
-    glReadPixels(x, y, _width, _height,
-                 _rgb_format ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
+    VideoManager->RunGLCommand([=]() {
+        glReadPixels(x, y, _width, _height,
+                     _rgb_format ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, &_pixels[0]);
+    });
 }
 
 void ImageMemory::VerticalFlip()
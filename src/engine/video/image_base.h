@@ -68,6 +68,8 @@ namespace private_video
 *** ***************************************************************************/
 class ImageMemory
 {
+    friend class ImagePreloader;
+
 public:
     ImageMemory();
     explicit ImageMemory(const SDL_Surface* surface);
@@ -158,6 +160,14 @@ public:
     void VerticalFlip();
 
 private:
+    /** \brief Decodes an image file into the class members.
+    *** This doesn't use any engine state, so that it can be run by the image preloader thread.
+    *** \param filename The name of the image file to load.
+    *** \param report_errors Whether to print the errors.
+    *** \return True if the image was loaded successfully, false if it was not
+    **/
+    bool _LoadImageFile(const std::string& filename, bool report_errors);
+
     //! \brief The width of the image data (in pixels)
     size_t _width;
 
@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    image_preloader.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the background image file decoder.
+*** ***************************************************************************/
+
+#include "image_preloader.h"
+
+#include "utils/utils_common.h"
+
+#include <algorithm>
+
+namespace vt_video
+{
+
+namespace private_video
+{
+
+ImagePreloader::ImagePreloader() :
+    _quit(false),
+    _thread(nullptr),
+    _mutex(nullptr),
+    _condition(nullptr)
+{
+}
+
+ImagePreloader::~ImagePreloader()
+{
+    _Stop();
+}
+
+void ImagePreloader::Preload(const std::vector<std::string>& filenames)
+{
+    if (!_Start())
+        return;
+
+    SDL_LockMutex(_mutex);
+
+    // Drop the previous requests that aren't needed anymore.
+    _queue.clear();
+    std::map<std::string, ImageMemory>::iterator it = _decoded_images.begin();
+    while (it != _decoded_images.end()) {
+        if (std::find(filenames.begin(), filenames.end(), it->first) == filenames.end())
+            _decoded_images.erase(it++);
+        else
+            ++it;
+    }
+
+    for (uint32_t i = 0; i < filenames.size(); ++i) {
+        const std::string& filename = filenames[i];
+        if (filename.empty() || filename == _decoding_filename
+                || _decoded_images.find(filename) != _decoded_images.end()
+                || std::find(_queue.begin(), _queue.end(), filename) != _queue.end()) {
+            continue;
+        }
+        _queue.push_back(filename);
+    }
+
+    SDL_CondBroadcast(_condition);
+    SDL_UnlockMutex(_mutex);
+}
+
+void ImagePreloader::Cancel()
+{
+    if (_thread == nullptr)
+        return;
+
+    SDL_LockMutex(_mutex);
+    _queue.clear();
+    _decoded_images.clear();
+    SDL_UnlockMutex(_mutex);
+}
+
+bool ImagePreloader::IsDecoded(const std::string& filename)
+{
+    if (_thread == nullptr)
+        return false;
+
+    SDL_LockMutex(_mutex);
+    bool decoded = (_decoded_images.find(filename) != _decoded_images.end());
+    SDL_UnlockMutex(_mutex);
+    return decoded;
+}
+
+bool ImagePreloader::IsPending(const std::string& filename)
+{
+    if (_thread == nullptr)
+        return false;
+
+    SDL_LockMutex(_mutex);
+    bool pending = (filename == _decoding_filename
+                    || std::find(_queue.begin(), _queue.end(), filename) != _queue.end());
+    SDL_UnlockMutex(_mutex);
+    return pending;
+}
+
+bool ImagePreloader::GetImageSize(const std::string& filename, uint32_t& width, uint32_t& height)
+{
+    if (_thread == nullptr)
+        return false;
+
+    SDL_LockMutex(_mutex);
+
+    while (_decoding_filename == filename)
+        SDL_CondWait(_condition, _mutex);
+
+    std::map<std::string, ImageMemory>::const_iterator it = _decoded_images.find(filename);
+    bool decoded = (it != _decoded_images.end());
+    if (decoded) {
+        width = it->second.GetWidth();
+        height = it->second.GetHeight();
+    }
+
+    SDL_UnlockMutex(_mutex);
+    return decoded;
+}
+
+bool ImagePreloader::TakeImage(const std::string& filename, ImageMemory& image)
+{
+    if (_thread == nullptr)
+        return false;
+
+    SDL_LockMutex(_mutex);
+
+    // Decoding it here wouldn't be faster.
+    while (_decoding_filename == filename)
+        SDL_CondWait(_condition, _mutex);
+
+    std::map<std::string, ImageMemory>::iterator it = _decoded_images.find(filename);
+    if (it == _decoded_images.end()) {
+        // The caller loads it now, so don't decode it a second time.
+        std::deque<std::string>::iterator queued = std::find(_queue.begin(), _queue.end(), filename);
+        if (queued != _queue.end())
+            _queue.erase(queued);
+
+        SDL_UnlockMutex(_mutex);
+        return false;
+    }
+
+    // Move the pixels without copying them.
+    ImageMemory& decoded_image = it->second;
+    image._width = decoded_image._width;
+    image._height = decoded_image._height;
+    image._rgb_format = decoded_image._rgb_format;
+    image._pixels.swap(decoded_image._pixels);
+    _decoded_images.erase(it);
+
+    SDL_UnlockMutex(_mutex);
+    return true;
+}
+
+bool ImagePreloader::_Start()
+{
+    if (_thread != nullptr)
+        return true;
+
+    _mutex = SDL_CreateMutex();
+    _condition = SDL_CreateCond();
+    if (_mutex == nullptr || _condition == nullptr) {
+        PRINT_WARNING << "Couldn't create the image preloader synchronization objects: "
+                      << SDL_GetError() << std::endl;
+        _Stop();
+        return false;
+    }
+
+    _quit = false;
+    _thread = SDL_CreateThread(_ThreadFunction, "ImagePreloader", this);
+    if (_thread == nullptr) {
+        PRINT_WARNING << "Couldn't create the image preloader thread: " << SDL_GetError() << std::endl;
+        _Stop();
+        return false;
+    }
+
+    return true;
+}
+
+void ImagePreloader::_Stop()
+{
+    if (_thread != nullptr) {
+        SDL_LockMutex(_mutex);
+        _queue.clear();
+        _quit = true;
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+
+        SDL_WaitThread(_thread, nullptr);
+        _thread = nullptr;
+    }
+
+    if (_condition != nullptr) {
+        SDL_DestroyCond(_condition);
+        _condition = nullptr;
+    }
+
+    if (_mutex != nullptr) {
+        SDL_DestroyMutex(_mutex);
+        _mutex = nullptr;
+    }
+
+    _decoded_images.clear();
+}
+
+int ImagePreloader::_ThreadFunction(void* data)
+{
+    ImagePreloader* preloader = static_cast<ImagePreloader*>(data);
+    preloader->_Run();
+    return 0;
+}
+
+void ImagePreloader::_Run()
+{
+    SDL_LockMutex(_mutex);
+
+    while (true) {
+        while (_queue.empty() && !_quit)
+            SDL_CondWait(_condition, _mutex);
+
+        if (_quit)
+            break;
+
+        std::string filename = _queue.front();
+        _queue.pop_front();
+        _decoding_filename = filename;
+        SDL_UnlockMutex(_mutex);
+
+        // The decoding is done without holding the lock.
+        // Failures are silently dropped: the game thread will report them when loading the file.
+        ImageMemory image;
+        bool decoded = image._LoadImageFile(filename, false);
+
+        SDL_LockMutex(_mutex);
+        if (decoded) {
+            ImageMemory& decoded_image = _decoded_images[filename];
+            decoded_image._width = image._width;
+            decoded_image._height = image._height;
+            decoded_image._rgb_format = image._rgb_format;
+            decoded_image._pixels.swap(image._pixels);
+        }
+        _decoding_filename.clear();
+        SDL_CondBroadcast(_condition);
+    }
+
+    SDL_UnlockMutex(_mutex);
+}
+
+} // namespace private_video
+
+} // namespace vt_video
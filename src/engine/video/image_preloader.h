@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    image_preloader.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the background image file decoder.
+***
+*** Decoding image files is the slowest part of loading a map or a battle.
+*** The image preloader decodes the image files it is given on a worker thread,
+*** ahead of time. When an image file is then loaded, its decoded pixels are
+*** taken from the preloader instead of the disk. Only the texture upload is
+*** left to the game thread, as it is bound to the OpenGL context.
+*** ***************************************************************************/
+
+#ifndef __IMAGE_PRELOADER_HEADER__
+#define __IMAGE_PRELOADER_HEADER__
+
+#include "image_base.h"
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vt_video
+{
+
+namespace private_video
+{
+
+/** ****************************************************************************
+*** \brief Decodes image files on a worker thread.
+***
+*** The preloader is owned by the texture controller.
+*** \see TextureController::PreloadImages()
+*** ***************************************************************************/
+class ImagePreloader
+{
+public:
+    ImagePreloader();
+
+    //! \brief Stops the worker thread and frees the decoded images.
+    ~ImagePreloader();
+
+    /** \brief Queues image files to decode, starting the worker thread if needed.
+    *** The previous requests not part of the given files are dropped.
+    **/
+    void Preload(const std::vector<std::string>& filenames);
+
+    //! \brief Drops the queued files and the decoded images not taken yet.
+    void Cancel();
+
+    //! \brief Tells whether the decoded pixels of an image file are waiting to be taken.
+    bool IsDecoded(const std::string& filename);
+
+    //! \brief Tells whether an image file is queued or being decoded.
+    bool IsPending(const std::string& filename);
+
+    /** \brief Gets the dimensions of a decoded image file, without taking its pixels.
+    *** If the file is being decoded, this waits for it.
+    *** \return false if the file hasn't been decoded.
+    **/
+    bool GetImageSize(const std::string& filename, uint32_t& width, uint32_t& height);
+
+    /** \brief Takes the decoded pixels of an image file.
+    *** If the file is being decoded, this waits for it. If it is only queued, it is dropped
+    *** from the queue, as the caller will load it anyway.
+    *** \param filename The image filename.
+    *** \param image The image memory to move the pixels into.
+    *** \return Whether the pixels were taken. If not, the file has to be loaded from disk.
+    **/
+    bool TakeImage(const std::string& filename, ImageMemory& image);
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    ImagePreloader(const ImagePreloader& preloader);
+    ImagePreloader& operator=(const ImagePreloader& preloader);
+
+    //! \brief Starts the worker thread, if not done yet.
+    bool _Start();
+
+    //! \brief Stops the worker thread, once the file being decoded is done.
+    void _Stop();
+
+    //! \brief The thread entry point.
+    static int _ThreadFunction(void* data);
+
+    //! \brief The worker thread loop.
+    void _Run();
+
+    //! \brief The files waiting to be decoded.
+    std::deque<std::string> _queue;
+
+    //! \brief The decoded images, waiting to be taken, sorted by filename.
+    std::map<std::string, ImageMemory> _decoded_images;
+
+    //! \brief The file currently decoded by the worker thread, or an empty string.
+    std::string _decoding_filename;
+
+    //! \brief Whether the worker thread should exit.
+    bool _quit;
+
+    SDL_Thread* _thread;
+    SDL_mutex* _mutex;
+    SDL_cond* _condition;
+};
+
+} // namespace private_video
+
+} // namespace vt_video
+
+#endif // __IMAGE_PRELOADER_HEADER__
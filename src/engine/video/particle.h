@@ -180,8 +180,8 @@ public:
     vt_video::Color next_color_variation;
 
     //! keep track of current and next keyframes
-    ParticleKeyframe *current_keyframe;
-    ParticleKeyframe *next_keyframe;
+    const ParticleKeyframe *current_keyframe;
+    const ParticleKeyframe *next_keyframe;
 };
 
 } // vt_mode_manager
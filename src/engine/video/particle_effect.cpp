@@ -21,27 +21,30 @@
 #include "engine/video/video.h"
 
 #include "script/script_read.h"
+#include "engine/script_cache.h"
 #include "engine/system.h"
 
 #include "utils/utils_files.h"
 
+#include <map>
+#include <memory>
+
 using namespace vt_script;
 using namespace vt_video;
 
 namespace vt_mode_manager
 {
 
-bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
+bool ParticleEffectDef::Load(const std::string &particle_file)
 {
-    _effect_def.Clear();
-    _loaded = false;
+    Clear();
 
     // Make sure the corresponding tables are empty
     ScriptManager->DropGlobalTable("systems");
     ScriptManager->DropGlobalTable("map_effect_collision");
 
     vt_script::ReadScriptDescriptor particle_script;
-    if(!particle_script.OpenFile(particle_file)) {
+    if(!OpenCachedScript(particle_script, particle_file)) {
         PRINT_WARNING << "No script file: '"
                       << particle_file << "' The corresponding particle effect won't work."
                       << std::endl;
@@ -50,10 +53,10 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
 
     // Read the particle image rectangle when existing
     if (particle_script.OpenTable("map_effect_collision")) {
-        _effect_def.effect_collision_width = particle_script.ReadFloat("effect_collision_width");
-        _effect_def.effect_collision_height = particle_script.ReadFloat("effect_collision_height");
-        _effect_def.effect_width = particle_script.ReadFloat("effect_width");
-        _effect_def.effect_height = particle_script.ReadFloat("effect_height");
+        effect_collision_width = particle_script.ReadFloat("effect_collision_width");
+        effect_collision_height = particle_script.ReadFloat("effect_collision_height");
+        effect_width = particle_script.ReadFloat("effect_width");
+        effect_height = particle_script.ReadFloat("effect_height");
         particle_script.CloseTable(); // map_effect_collision
     }
 
@@ -61,8 +64,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
         PRINT_WARNING << "Could not find the 'systems' array in particle effect "
                       << particle_file << std::endl;
         particle_script.CloseFile();
-        _effect_def.Clear();
-        _loaded = false;
+        Clear();
         return false;
     }
 
@@ -73,8 +75,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
                       << particle_file << std::endl;
         particle_script.CloseTable();
         particle_script.CloseFile();
-        _effect_def.Clear();
-        _loaded = false;
+        Clear();
         return false;
     }
 
@@ -85,8 +86,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
                           << " in particle effect " << particle_file << std::endl;
             particle_script.CloseAllTables();
             particle_script.CloseFile();
-            _effect_def.Clear();
-            _loaded = false;
+            Clear();
             return false;
         }
         particle_script.OpenTable(sys);
@@ -97,8 +97,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
                           << sys << " in particle effect " << particle_file << std::endl;
             particle_script.CloseAllTables();
             particle_script.CloseFile();
-            _effect_def.Clear();
-            _loaded = false;
+            Clear();
             return false;
         }
         particle_script.OpenTable("emitter");
@@ -164,8 +163,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
                           << sys << " in particle effect " << particle_file << std::endl;
             particle_script.CloseAllTables();
             particle_script.CloseFile();
-            _effect_def.Clear();
-            _loaded = false;
+            Clear();
             return false;
         }
         particle_script.OpenTable("keyframes");
@@ -203,8 +201,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
                           << particle_file << std::endl;
             particle_script.CloseAllTables();
             particle_script.CloseFile();
-            _effect_def.Clear();
-            _loaded = false;
+            Clear();
             return false;
         }
 
@@ -220,8 +217,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
                               << particle_file << std::endl;
                 particle_script.CloseAllTables();
                 particle_script.CloseFile();
-                _effect_def.Clear();
-                _loaded = false;
+                Clear();
                 return false;
             }
         }
@@ -231,8 +227,7 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
                           << particle_file << std::endl;
             particle_script.CloseAllTables();
             particle_script.CloseFile();
-            _effect_def.Clear();
-            _loaded = false;
+            Clear();
             return false;
         }
 
@@ -331,16 +326,15 @@ bool ParticleEffect::_LoadEffectDef(const std::string &particle_file)
         // pop the system table
         particle_script.CloseTable();
 
-        _effect_def._systems.push_back(sys_def);
+        _systems.push_back(sys_def);
     }
 
-    _loaded = true;
     return true;
 }
 
 // A helper function reading a lua subtable of 4 float values.
-Color ParticleEffect::_ReadColor(vt_script::ReadScriptDescriptor &particle_script,
-                                 const std::string &param_name)
+Color ParticleEffectDef::_ReadColor(vt_script::ReadScriptDescriptor &particle_script,
+                                    const std::string &param_name)
 {
     std::vector<float> float_vec;
     particle_script.ReadFloatVector(param_name, float_vec);
@@ -354,19 +348,68 @@ Color ParticleEffect::_ReadColor(vt_script::ReadScriptDescriptor &particle_scrip
     return new_color;
 }
 
+// The shared particle effect definitions, indexed by filename.
+// Failed loads are stored as nullptr so that broken files are only parsed once.
+static std::map<std::string, std::unique_ptr<ParticleEffectDef> > _particle_effect_defs;
+
+const ParticleEffectDef* GetParticleEffectDef(const std::string &particle_file)
+{
+    auto it = _particle_effect_defs.find(particle_file);
+    if(it != _particle_effect_defs.end())
+        return it->second.get();
+
+    std::unique_ptr<ParticleEffectDef> effect_def(new ParticleEffectDef());
+    if(!effect_def->Load(particle_file))
+        effect_def.reset();
+
+    const ParticleEffectDef* def = effect_def.get();
+    _particle_effect_defs[particle_file] = std::move(effect_def);
+    return def;
+}
+
+bool ParticleEffect::_LoadEffectDef(const std::string &filename)
+{
+    _effect_def = GetParticleEffectDef(filename);
+    _loaded = (_effect_def != nullptr);
+    if(_loaded)
+        _effect_filename = filename;
+    else
+        _effect_filename.clear();
+    return _loaded;
+}
+
 bool ParticleEffect::_CreateEffect()
 {
     // The effect isn't loaded, so we can't create the effect.
     if(!IsLoaded())
         return false;
 
+    // When the systems were already created from this definition,
+    // simply restart them so that their particle buffers are reused.
+    if(!_systems.empty()) {
+        std::vector<ParticleSystem>::iterator iSystem = _systems.begin();
+        for(; iSystem != _systems.end(); ++iSystem)
+            (*iSystem).Restart();
+
+        // The pooled effects behave as freshly created ones:
+        // the previous spawn orientation and attractor point are dropped.
+        _attractor.x = 0.0f;
+        _attractor.y = 0.0f;
+        _orientation = 0.0f;
+        _num_particles = 0;
+
+        _alive = true;
+        _age = 0.0f;
+        return true;
+    }
+
     // Initialize systems
-    _systems.clear();
-    std::vector<ParticleSystemDef>::iterator it = _effect_def._systems.begin();
-    for(; it != _effect_def._systems.end(); ++it) {
+    _systems.reserve(_effect_def->_systems.size());
+    std::vector<ParticleSystemDef>::const_iterator it = _effect_def->_systems.begin();
+    for(; it != _effect_def->_systems.end(); ++it) {
         if((*it).enabled) {
-            ParticleSystem sys(&(*it));
-            if(!sys.IsAlive()) {
+            _systems.emplace_back(&(*it));
+            if(!_systems.back().IsAlive()) {
                 // If a system could not be created then we bail out
                 _systems.clear();
 
@@ -375,7 +418,6 @@ bool ParticleEffect::_CreateEffect()
                 return false;
 
             }
-            _systems.push_back(sys);
         }
     }
 
@@ -386,6 +428,13 @@ bool ParticleEffect::_CreateEffect()
 
 bool ParticleEffect::LoadEffect(const std::string &filename)
 {
+    // Reloading the same effect only restarts it.
+    if(_loaded && filename == _effect_filename)
+        return _CreateEffect();
+
+    _systems.clear();
+    _alive = false;
+
     if(!_LoadEffectDef(filename)) {
         PRINT_WARNING << "Failed to load particle definition file: "
                       << filename << std::endl;
@@ -436,21 +485,22 @@ void ParticleEffect::Update(float frame_time)
     effect_parameters.attractor.x = _attractor.x - _pos.x;
     effect_parameters.attractor.y = _attractor.y - _pos.y;
 
+    // Dead systems are kept so that their buffers can be reused when the effect restarts.
+    bool systems_alive = false;
     std::vector<ParticleSystem>::iterator iSystem = _systems.begin();
 
-    while(iSystem != _systems.end()) {
-        if(!(*iSystem).IsAlive()) {
-            iSystem = _systems.erase(iSystem);
+    for(; iSystem != _systems.end(); ++iSystem) {
+        if(!(*iSystem).IsAlive())
+            continue;
 
-            if(_systems.empty())
-                _alive = false;
-        } else {
-            (*iSystem).Update(frame_time, effect_parameters);
+        (*iSystem).Update(frame_time, effect_parameters);
 
-            _num_particles += (*iSystem).GetNumParticles();
-            ++iSystem;
-        }
+        _num_particles += (*iSystem).GetNumParticles();
+        systems_alive = true;
     }
+
+    if(!systems_alive)
+        _alive = false;
 }
 
 
@@ -464,8 +514,12 @@ void ParticleEffect::_Destroy()
     _age = 0.0f;
     _orientation = 0.0f;
 
+    _num_particles = 0;
+
     _systems.clear();
 
+    _effect_def = nullptr;
+    _effect_filename.clear();
     _loaded = false;
 }
 
@@ -492,7 +546,11 @@ void ParticleEffect::Stop(bool kill_immediate)
 {
     if(kill_immediate) {
         _alive = false;
-        _systems.clear();
+        _num_particles = 0;
+
+        std::vector<ParticleSystem>::iterator iSystem = _systems.begin();
+        for(; iSystem != _systems.end(); ++iSystem)
+            (*iSystem).Kill();
     } else {
         // if we're not killing immediately, then calling Stop() just means to stop emitting NEW
         // particles, so go through each system and turn off its emitter
@@ -89,10 +89,29 @@ public:
     float effect_collision_width;
     float effect_collision_height;
 
+    /** \brief Loads the effect definition from a particle file.
+    *** \param particle_file The particle Lua file to parse.
+    *** \return Whether the effect definition is valid.
+    **/
+    bool Load(const std::string &particle_file);
+
     //! list of system definitions
     std::vector<ParticleSystemDef> _systems;
+
+private:
+    //! \brief Helper function used to read a color subtable.
+    static vt_video::Color _ReadColor(vt_script::ReadScriptDescriptor &particle_script,
+                                      const std::string &param_name);
 };
 
+/** \brief Returns the shared definition of the given particle effect file.
+*** The file is only parsed the first time the definition is requested, and the definition
+*** is then kept for the whole game session. Particle effect instances only point to it.
+*** \param particle_file The particle Lua file to get the definition from.
+*** \return The effect definition, or nullptr if the file couldn't be loaded.
+**/
+const ParticleEffectDef* GetParticleEffectDef(const std::string &particle_file);
+
 
 /*!***************************************************************************
  *  \brief particle effect, basically one coherent "effect" like an explosion,
@@ -107,11 +126,15 @@ public:
     /*!
      *  \brief Constructor
      */
-    ParticleEffect() {
+    ParticleEffect():
+        _effect_def(nullptr)
+    {
         _Destroy();
     }
 
-    ParticleEffect(const std::string &effect_filename) {
+    ParticleEffect(const std::string &effect_filename):
+        _effect_def(nullptr)
+    {
         _Destroy();
         LoadEffect(effect_filename);
     }
@@ -121,6 +144,7 @@ public:
     *** as one can control the drawing order.
     *** \param filename The particle effect filename to load
     *** \return whether the effect is valid.
+    *** \note Loading the effect already loaded simply restarts it, reusing its particle buffers.
     **/
     bool LoadEffect(const std::string &effect_filename);
 
@@ -216,18 +240,18 @@ public:
 
     //! \brief Get the overall effect collision width/height in pixels.
     float GetEffectCollisionWidth() const {
-        return _effect_def.effect_collision_width;
+        return _effect_def ? _effect_def->effect_collision_width : 0.0f;
     }
     float GetEffectCollisionHeight() const {
-        return _effect_def.effect_collision_height;
+        return _effect_def ? _effect_def->effect_collision_height : 0.0f;
     }
 
     //! \brief Get the overall effect image width/height in pixels.
     float GetEffectWidth() const {
-        return _effect_def.effect_width;
+        return _effect_def ? _effect_def->effect_width : 0.0f;
     }
     float GetEffectHeight() const {
-        return _effect_def.effect_height;
+        return _effect_def ? _effect_def->effect_height : 0.0f;
     }
 
 
@@ -235,6 +259,11 @@ public:
         return _loaded;
     }
 
+    //! \brief Returns the particle file the effect was loaded from.
+    const std::string& GetEffectFilename() const {
+        return _effect_filename;
+    }
+
     //! \brief draws the effect.
     void Draw();
 
@@ -252,7 +281,7 @@ private:
     void _Destroy();
 
     /*!
-     * \brief loads an effect definition from a particle file
+     * \brief fetches the shared effect definition of a particle file
      * \param filename file to load the effect from
      * \return Whether the effect def is valid
      */
@@ -260,15 +289,15 @@ private:
 
     /** Creates the effect based on the particle effect definition.
     *** _LoadEffectDef() must be called before this one.
+    *** If the systems already exist, they are restarted instead of being reallocated.
     **/
     bool _CreateEffect();
 
-    //! \brief Helper function used to read a color subtable.
-    vt_video::Color _ReadColor(vt_script::ReadScriptDescriptor &particle_script,
-                                const std::string &param_name);
+    //! The shared effect definition. Not owned by the effect.
+    const ParticleEffectDef* _effect_def;
 
-    //! The effect definition
-    ParticleEffectDef _effect_def;
+    //! The particle file the definition was loaded from.
+    std::string _effect_filename;
 
     //! list of subsystems that make up the effect. (for example, a fire effect might consist
     //! of a flame + smoke + embers)
@@ -30,22 +30,62 @@ namespace vt_mode_manager
 
 bool ParticleManager::AddParticleEffect(const std::string &effect_filename, float x, float y)
 {
-
-    ParticleEffect *effect = new ParticleEffect(effect_filename);
-    if(!effect->IsLoaded()) {
-        PRINT_WARNING << "Failed to add effect to particle manager" <<
-                      " for file: " << effect_filename << std::endl;
-        delete effect;
-        return false;
+    ParticleEffect *effect = nullptr;
+
+    // Reuse a finished effect when possible.
+    std::map<std::string, std::vector<ParticleEffect *> >::iterator it = _idle_effects.find(effect_filename);
+    if(it != _idle_effects.end() && !it->second.empty()) {
+        effect = it->second.back();
+        it->second.pop_back();
+
+        if(!effect->Start()) {
+            PRINT_WARNING << "Failed to restart effect in particle manager"
+                          << " for file: " << effect_filename << std::endl;
+            it->second.push_back(effect);
+            return false;
+        }
+    }
+    else {
+        effect = new ParticleEffect(effect_filename);
+        if(!effect->IsLoaded()) {
+            PRINT_WARNING << "Failed to add effect to particle manager" <<
+                          " for file: " << effect_filename << std::endl;
+            delete effect;
+            return false;
+        }
+        _all_effects.push_back(effect);
     }
 
     effect->Move(x, y);
-    _all_effects.push_back(effect);
     _active_effects.push_back(effect);
 
     return true;
 }
 
+bool ParticleManager::PreloadParticleEffect(const std::string &effect_filename, uint32_t count)
+{
+    std::vector<ParticleEffect *>& idle_effects = _idle_effects[effect_filename];
+
+    while(idle_effects.size() < count) {
+        ParticleEffect *effect = new ParticleEffect(effect_filename);
+        if(!effect->IsLoaded()) {
+            PRINT_WARNING << "Failed to preload effect in particle manager" <<
+                          " for file: " << effect_filename << std::endl;
+            delete effect;
+            return false;
+        }
+
+        // Keep it idle until it is actually added.
+        effect->Stop(true);
+        _all_effects.push_back(effect);
+        idle_effects.push_back(effect);
+    }
+
+    // Reserve room so that adding the effects later doesn't grow the active list.
+    _active_effects.reserve(_active_effects.size() + count);
+    return true;
+}
+
 void ParticleManager::_DEBUG_ShowParticleStats()
 {
     char text[50];
@@ -63,8 +103,10 @@ void ParticleManager::Draw() const
 
     std::vector<ParticleEffect *>::const_iterator it = _active_effects.begin();
 
-    glClearStencil(0);
-    glClear(GL_STENCIL_BUFFER_BIT);
+    VideoManager->SubmitGLCommand([]() {
+        glClearStencil(0);
+        glClear(GL_STENCIL_BUFFER_BIT);
+    });
 
     while(it != _active_effects.end()) {
         (*it)->Draw();
@@ -84,6 +126,8 @@ void ParticleManager::Update(int32_t frame_time)
 
     while(it != _active_effects.end()) {
         if(!(*it)->IsAlive()) {
+            // Keep the finished effect around for later reuse.
+            _idle_effects[(*it)->GetEffectFilename()].push_back(*it);
             it = _active_effects.erase(it);
         } else {
             (*it)->Update(frame_time_seconds);
@@ -111,8 +155,9 @@ void ParticleManager::_Destroy()
         delete(*it);
     }
     _all_effects.clear();
-    // Clear the active effect pointer references
+    // Clear the active and idle effect pointer references
     _active_effects.clear();
+    _idle_effects.clear();
 }
 
 }  // namespace vt_mode_manager
@@ -15,8 +15,9 @@
 *** \brief   Header file for particle manager
 ***
 *** The particle manager is very simple. Every time you want to draw an effect,
-*** you call AddEffect() with a pointer to the effect definition structure.
+*** you call AddParticleEffect() with the particle effect filename.
 *** Then every frame, call Update() and Draw() to draw all the effects.
+*** Finished effects are kept and restarted the next time the same file is added.
 *** **************************************************************************/
 
 #ifndef __PARTICLE_MANAGER_HEADER__
@@ -24,6 +25,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <cstdint>
 
 namespace vt_mode_manager
@@ -43,7 +45,9 @@ public:
     /*!
      *  \brief Constructor
      */
-    ParticleManager() {}
+    ParticleManager():
+        _num_particles(0)
+    {}
 
     ~ParticleManager() {
         _Destroy();
@@ -60,6 +64,16 @@ public:
      */
     bool AddParticleEffect(const std::string &effect_filename, float x, float y);
 
+    /** \brief Loads the effect definition and prepares idle effect instances.
+    *** Once preloaded, adding the effect doesn't open any file nor allocate
+    *** particle buffers, as long as no more than the given number of instances
+    *** are alive at the same time.
+    *** \param effect_filename The particle effect file to preload.
+    *** \param count The number of effect instances to prepare.
+    *** \return whether the effect could be loaded.
+    **/
+    bool PreloadParticleEffect(const std::string &effect_filename, uint32_t count = 1);
+
     //! \brief draws all active effects
     void Draw() const;
 
@@ -103,6 +117,10 @@ private:
 
     std::vector<ParticleEffect *> _active_effects;
 
+    //! Finished effects, kept per particle filename so they can be restarted
+    //! instead of being reloaded when the same effect is added again.
+    std::map<std::string, std::vector<ParticleEffect *> > _idle_effects;
+
     //! Total number of particles among all the active effects. This is updated
     //! during each call to Update(), so that when GetNumParticles() is called,
     //! we can just return this value instead of having to calculate it
@@ -31,7 +31,7 @@ using namespace vt_common;
 namespace vt_mode_manager
 {
 
-bool ParticleSystem::_Create(ParticleSystemDef *sys_def)
+bool ParticleSystem::_Create(const ParticleSystemDef *sys_def)
 {
     // Make sure the system def is valid before initializing.
     if(!sys_def) {
@@ -44,9 +44,16 @@ bool ParticleSystem::_Create(ParticleSystemDef *sys_def)
     _num_particles = 0;
 
     _particles.resize(_system_def->max_particles);
-    _particle_vertices.resize(_system_def->max_particles * 4);
-    _particle_texcoords.resize(_system_def->max_particles * 4);
-    _particle_colors.resize(_system_def->max_particles * 4);
+
+    // Only allocate the arrays of the drawing path used.
+    if (VideoManager->IsParticleInstancingAvailable()) {
+        _particle_instances.resize(_system_def->max_particles);
+    }
+    else {
+        _particle_vertices.resize(_system_def->max_particles * 4);
+        _particle_texcoords.resize(_system_def->max_particles * 4);
+        _particle_colors.resize(_system_def->max_particles * 4);
+    }
 
     _alive = true;
     _stopped = false;
@@ -69,6 +76,20 @@ bool ParticleSystem::_Create(ParticleSystemDef *sys_def)
     return true;
 }
 
+void ParticleSystem::Restart()
+{
+    if(!_system_def)
+        return;
+
+    _num_particles = 0;
+    _alive = true;
+    _stopped = false;
+    _age = 0.0f;
+    _last_update_time = 0.0f;
+
+    _animation.ResetAnimation();
+}
+
 void ParticleSystem::Draw()
 {
     if (!_alive || !_system_def->enabled || _age < _system_def->emitter._start_time || _num_particles <= 0)
@@ -80,37 +101,44 @@ void ParticleSystem::Draw()
     } else {
         VideoManager->EnableBlending();
 
-        if (_system_def->blend_mode == VIDEO_BLEND)
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        else
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE); // Additive.
+        const GLenum destination_factor = (_system_def->blend_mode == VIDEO_BLEND) ?
+                                          GL_ONE_MINUS_SRC_ALPHA : GL_ONE; // Otherwise additive.
+        VideoManager->SubmitGLCommand([destination_factor]() {
+            glBlendFunc(GL_SRC_ALPHA, destination_factor);
+        });
     }
 
     if (_system_def->use_stencil) {
         VideoManager->EnableStencilTest();
-        glStencilFunc(GL_EQUAL, 1, 0xFFFFFFFF);
-        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        VideoManager->SubmitGLCommand([]() {
+            glStencilFunc(GL_EQUAL, 1, 0xFFFFFFFF);
+            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        });
     } else if (_system_def->modify_stencil) {
         VideoManager->EnableStencilTest();
 
+        GLenum stencil_fail_op = GL_REPLACE;
         if (_system_def->stencil_op == VIDEO_STENCIL_OP_INCREASE)
-            glStencilOp(GL_INCR, GL_KEEP, GL_KEEP);
+            stencil_fail_op = GL_INCR;
         else if (_system_def->stencil_op == VIDEO_STENCIL_OP_DECREASE)
-            glStencilOp(GL_DECR, GL_KEEP, GL_KEEP);
+            stencil_fail_op = GL_DECR;
         else if (_system_def->stencil_op == VIDEO_STENCIL_OP_ZERO)
-            glStencilOp(GL_ZERO, GL_KEEP, GL_KEEP);
-        else
-            glStencilOp(GL_REPLACE, GL_KEEP, GL_KEEP);
+            stencil_fail_op = GL_ZERO;
 
-        glStencilFunc(GL_NEVER, 1, 0xFFFFFFFF);
+        VideoManager->SubmitGLCommand([stencil_fail_op]() {
+            glStencilOp(stencil_fail_op, GL_KEEP, GL_KEEP);
+            glStencilFunc(GL_NEVER, 1, 0xFFFFFFFF);
+        });
     } else {
         VideoManager->DisableStencilTest();
     }
 
     VideoManager->EnableTexture2D();
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    VideoManager->SubmitGLCommand([]() {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    });
 
     StillImage* id = _animation.GetFrame(_animation.GetCurrentFrameIndex());
     private_video::ImageTexture* img = id->_image_texture;
@@ -118,6 +146,12 @@ void ParticleSystem::Draw()
 
     float frame_progress = _animation.GetPercentProgress();
 
+    // Let the vertex shader expand the particle quads when possible.
+    if (VideoManager->IsParticleInstancingAvailable()) {
+        _DrawInstanced(img, frame_progress);
+        return;
+    }
+
     float u1 = img->u1;
     float u2 = img->u2;
     float v1 = img->v1;
@@ -339,6 +373,89 @@ void ParticleSystem::Draw()
     VideoManager->UnloadShaderProgram();
 }
 
+void ParticleSystem::_DrawInstanced(private_video::ImageTexture* img, float frame_progress)
+{
+    float img_width_half  = static_cast<float>(img->width) * 0.5f;
+    float img_height_half = static_cast<float>(img->height) * 0.5f;
+
+    // Fill one instance record per particle.
+    for (int32_t j = 0; j < _num_particles; ++j) {
+        gl::ParticleInstance& instance = _particle_instances[j];
+
+        instance.x = _particles[j].pos.x;
+        instance.y = _particles[j].pos.y;
+        instance.half_width  = img_width_half * _particles[j].size.x;
+        instance.half_height = img_height_half * _particles[j].size.y;
+        instance.rotation = 0.0f;
+
+        if (_system_def->rotation_used) {
+            instance.rotation = _particles[j].rotation_angle;
+
+            if(_system_def->rotate_to_velocity) {
+                // Calculate the angle based on the velocity.
+                instance.rotation += UTILS_HALF_PI + atan2f(_particles[j].combined_velocity.y,
+                                                            _particles[j].combined_velocity.x);
+
+                // Calculate the scaling due to speed.
+                if(_system_def->speed_scale_used) {
+                    float speed = sqrtf(_particles[j].combined_velocity.x * _particles[j].combined_velocity.x
+                                        + _particles[j].combined_velocity.y * _particles[j].combined_velocity.y);
+                    float scale_factor = _system_def->speed_scale * speed;
+
+                    if (scale_factor < _system_def->min_speed_scale)
+                        scale_factor = _system_def->min_speed_scale;
+                    if (scale_factor > _system_def->max_speed_scale)
+                        scale_factor = _system_def->max_speed_scale;
+
+                    instance.half_height *= scale_factor;
+                }
+            }
+        }
+
+        const Color& color = _particles[j].color;
+        instance.color[0] = color[0];
+        instance.color[1] = color[1];
+        instance.color[2] = color[2];
+        instance.color[3] = color[3];
+    }
+
+    gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::ParticleInstanced);
+    assert(shader_program != nullptr);
+
+    // With smooth animation, the current frame fades out while the next one fades in.
+    float texture_rectangle[4] = { img->u1, img->v1, img->u2, img->v2 };
+    float color_scale = _system_def->smooth_animation ? 1.0f - frame_progress : 1.0f;
+
+    VideoManager->DrawInstancedParticleSystem(shader_program,
+                                              &_particle_instances[0],
+                                              _num_particles,
+                                              texture_rectangle,
+                                              color_scale);
+
+    if (_system_def->smooth_animation) {
+        uint32_t findex = _animation.GetCurrentFrameIndex();
+        findex = (findex + 1) % _animation.GetNumFrames();
+
+        StillImage *id2 = _animation.GetFrame(findex);
+        private_video::ImageTexture *img2 = id2->_image_texture;
+        TextureManager->_BindTexture(img2->texture_sheet->tex_id);
+
+        texture_rectangle[0] = img2->u1;
+        texture_rectangle[1] = img2->v1;
+        texture_rectangle[2] = img2->u2;
+        texture_rectangle[3] = img2->v2;
+
+        // The instances are already uploaded: only the frame data changes.
+        VideoManager->DrawInstancedParticleSystem(shader_program,
+                                                  nullptr,
+                                                  _num_particles,
+                                                  texture_rectangle,
+                                                  frame_progress);
+    }
+
+    VideoManager->UnloadShaderProgram();
+}
+
 //-----------------------------------------------------------------------------
 // Update: updates particle positions and properties, and emits/kills particles
 //-----------------------------------------------------------------------------
@@ -417,6 +534,9 @@ void ParticleSystem::_Destroy()
 
     _particles.clear();
     _particle_vertices.clear();
+    _particle_texcoords.clear();
+    _particle_colors.clear();
+    _particle_instances.clear();
     // Don't delete it, since it's handled by the ParticleEffectDef
     _system_def = 0;
 }
@@ -430,7 +550,7 @@ void ParticleSystem::_UpdateParticles(float t, const EffectParameters &params)
 
         // figure out which keyframe we're on
         if(_particles[j].next_keyframe) {
-            ParticleKeyframe *old_next = _particles[j].next_keyframe;
+            const ParticleKeyframe *old_next = _particles[j].next_keyframe;
 
             // check if we need to advance the keyframe
             if(scaled_time >= _particles[j].next_keyframe->time) {
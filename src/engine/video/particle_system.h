@@ -34,6 +34,7 @@
 #include "particle_emitter.h"
 
 #include "engine/video/image.h"
+#include "engine/video/gl/gl_instanced_particle_system.h"
 
 namespace vt_mode_manager
 {
@@ -276,7 +277,7 @@ public:
     /*!
      * \brief Constructor
      */
-    explicit ParticleSystem(ParticleSystemDef* sys_def) {
+    explicit ParticleSystem(const ParticleSystemDef* sys_def) {
         _Destroy();
         _Create(sys_def);
     }
@@ -318,6 +319,22 @@ public:
         _stopped = true;
     }
 
+    /*!
+     *  \brief kills the system immediately, dropping all of its particles.
+     *         The particle buffers are kept so the system can be restarted.
+     */
+    void Kill() {
+        _num_particles = 0;
+        _alive = false;
+        _stopped = true;
+    }
+
+    /*!
+     *  \brief restarts the system from scratch, reusing the already allocated
+     *         particle buffers and animation frames.
+     */
+    void Restart();
+
     /*!
      *  \brief returns how many particles are alive in this system
      * \return the number of particles in this system
@@ -341,7 +358,7 @@ private:
      * \param sys_def particle definition to base the system off of
      * \return success/failure
      */
-    bool _Create(ParticleSystemDef *sys_def);
+    bool _Create(const ParticleSystemDef *sys_def);
 
     /*!
      *  \brief destroys the system
@@ -393,11 +410,18 @@ private:
      */
     void _RespawnParticle(int32_t i, const EffectParameters &params);
 
+    /*!
+     *  \brief draws the system using one instance per particle
+     * \param img the current animation frame texture
+     * \param frame_progress the current animation frame progress, used for smooth animation
+     */
+    void _DrawInstanced(vt_video::private_video::ImageTexture* img, float frame_progress);
+
     //! The system definition, contains information like the emitter properties, lifetime of
     //! particles, particle keyframes, etc. Basically everything which isn't instance-specific
     //! Note that this pointer shouldn't be deleted by the particle system, since it's handled by
     //! the corresponding ParticleEffectDef instance.
-    ParticleSystemDef *_system_def;
+    const ParticleSystemDef *_system_def;
 
     //! Animation for each particle. If it's non-animated, it just has 1 frame
     vt_video::AnimatedImage _animation;
@@ -407,11 +431,14 @@ private:
     int32_t _num_particles;
 
     //! The array of particle vertices. Note that this array contains FOUR vertices per particle.
-    //! This is used for rendering the particles with OpenGL
+    //! This is used for rendering the particles with OpenGL, when instancing isn't available.
     std::vector<ParticleVertex> _particle_vertices;
     std::vector<vt_video::Color> _particle_colors;
     std::vector<ParticleTexCoord> _particle_texcoords;
 
+    //! The array of particle instances, one per particle, used when instanced rendering is available.
+    std::vector<vt_video::gl::ParticleInstance> _particle_instances;
+
     //! This array holds everything except positions and colors. The reason we keep positions and
     //! colors separate is so that they can be efficiently fed to OpenGL for rendering.
     std::vector<Particle> _particles;
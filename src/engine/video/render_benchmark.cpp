@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    render_benchmark.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the render benchmarks
+*** ***************************************************************************/
+
+#include "engine/video/render_benchmark.h"
+
+#include "engine/video/video.h"
+#include "engine/script_profiler.h"
+
+#include "utils/utils_common.h"
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace vt_script;
+
+namespace vt_video
+{
+
+RenderBenchmark::RenderBenchmark():
+    _running(false),
+    _frame(0),
+    _number_of_frames(0),
+    _draw_calls(0),
+    _texture_binds(0),
+    _gpu_timing(false),
+    _checksum(0)
+{
+    for (uint32_t i = 0; i < RENDER_BENCHMARK_GPU_QUERIES; ++i)
+        _gpu_queries[i] = 0;
+}
+
+bool RenderBenchmark::Start(const std::string& script_filename, uint32_t number_of_frames)
+{
+    Stop();
+
+    // Clears out old script data
+    ScriptManager->DropGlobalTable(ScriptEngine::GetTableSpace(script_filename));
+
+    if (!_script.OpenFile(script_filename))
+        return false;
+
+    if (_script.OpenTablespace().empty()) {
+        PRINT_ERROR << "The render benchmark script: " << script_filename
+                    << " has not set a correct namespace" << std::endl;
+        _script.CloseFile();
+        return false;
+    }
+
+    luabind::object init_function = _script.ReadFunctionPointer("Initialize");
+    if (!init_function.is_valid()) {
+        PRINT_ERROR << "No Initialize() function in the render benchmark script: " << script_filename << std::endl;
+        _script.CloseFile();
+        return false;
+    }
+    _update_function = _script.ReadFunctionPointer("Update");
+
+    _script_filename = script_filename;
+    _running = true;
+    _frame = 0;
+    _number_of_frames = number_of_frames;
+    _cpu_frame_times.clear();
+    _draw_calls = 0;
+    _texture_binds = 0;
+    _checksum = 0;
+
+    // The GPU times are only written by the thread owning the OpenGL context, so wait for it.
+    VideoManager->RunGLCommand([this]() {
+        _gpu_frame_times.clear();
+#ifdef __APPLE__
+        // The legacy OSX context doesn't go through GLEW.
+        _gpu_timing = false;
+#else
+        _gpu_timing = (GLEW_VERSION_3_3 || GLEW_ARB_timer_query);
+#endif
+        if (_gpu_timing)
+            glGenQueries(RENDER_BENCHMARK_GPU_QUERIES, _gpu_queries);
+    });
+
+    vt_system::ScriptProfilerCall profiler_call(init_function);
+    ReadScriptDescriptor::RunScriptObject(init_function);
+    return true;
+}
+
+void RenderBenchmark::Stop()
+{
+    if (!_running)
+        return;
+
+    // Read the GPU times still pending, and free the queries.
+    VideoManager->RunGLCommand([this]() {
+        if (!_gpu_timing)
+            return;
+        for (uint32_t frame = static_cast<uint32_t>(_gpu_frame_times.size()); frame < _frame; ++frame)
+            _ReadGPUQuery(frame);
+        glDeleteQueries(RENDER_BENCHMARK_GPU_QUERIES, _gpu_queries);
+    });
+
+    for (uint32_t i = 0; i < RENDER_BENCHMARK_GPU_QUERIES; ++i)
+        _gpu_queries[i] = 0;
+
+    _update_function = luabind::object();
+    _script.CloseFile();
+    _running = false;
+}
+
+void RenderBenchmark::UpdateFrame()
+{
+    if (!_running || !_update_function.is_valid())
+        return;
+
+    try {
+        vt_system::ScriptProfilerCall profiler_call(_update_function);
+        luabind::call_function<void>(_update_function, _frame);
+    } catch(const luabind::error& e) {
+        PRINT_ERROR << "Error while running the render benchmark Update() function." << std::endl;
+        ScriptManager->HandleLuaError(e);
+    } catch(const luabind::cast_failed& e) {
+        PRINT_ERROR << "Error while running the render benchmark Update() function." << std::endl;
+        ScriptManager->HandleCastError(e);
+    }
+}
+
+void RenderBenchmark::BeginFrame()
+{
+    if (!_running || !_gpu_timing || _frame >= _number_of_frames)
+        return;
+
+    GLuint query = _gpu_queries[_frame % RENDER_BENCHMARK_GPU_QUERIES];
+    VideoManager->SubmitGLCommand([query]() { glBeginQuery(GL_TIME_ELAPSED, query); });
+}
+
+void RenderBenchmark::EndFrame()
+{
+    if (!_running || _frame >= _number_of_frames)
+        return;
+
+    if (_gpu_timing) {
+        // The oldest query in flight is read once its slot is about to be reused.
+        uint32_t frame = _frame;
+        VideoManager->SubmitGLCommand([this, frame]() {
+            glEndQuery(GL_TIME_ELAPSED);
+            if (frame + 1 >= RENDER_BENCHMARK_GPU_QUERIES)
+                _ReadGPUQuery(frame + 1 - RENDER_BENCHMARK_GPU_QUERIES);
+        });
+    }
+
+    const VideoFrameStatistics& statistics = VideoManager->GetFrameStatistics();
+    _draw_calls += statistics.draw_calls;
+    _texture_binds += statistics.texture_binds;
+
+    ++_frame;
+    if (_frame == _number_of_frames)
+        _checksum = VideoManager->ComputeFrameChecksum();
+}
+
+void RenderBenchmark::AddFrameTime(float milliseconds)
+{
+    if (_running)
+        _cpu_frame_times.push_back(milliseconds);
+}
+
+void RenderBenchmark::_ReadGPUQuery(uint32_t frame)
+{
+    GLuint64 elapsed_time = 0;
+    glGetQueryObjectui64v(_gpu_queries[frame % RENDER_BENCHMARK_GPU_QUERIES], GL_QUERY_RESULT, &elapsed_time);
+    _gpu_frame_times.push_back(static_cast<float>(elapsed_time / 1000000.0));
+}
+
+//! \brief Prints the average, median, 95th percentile and maximum of the given times.
+static void _PrintFrameTimes(const std::string& name, const std::vector<float>& times)
+{
+    if (times.empty()) {
+        std::cout << "  " << name << ": unavailable" << std::endl;
+        return;
+    }
+
+    std::vector<float> sorted_times = times;
+    std::sort(sorted_times.begin(), sorted_times.end());
+
+    float total_time = 0.0f;
+    for (uint32_t i = 0; i < sorted_times.size(); ++i)
+        total_time += sorted_times[i];
+
+    std::cout << "  " << name << ": average " << (total_time / sorted_times.size())
+              << " ms, median " << sorted_times[sorted_times.size() / 2]
+              << " ms, 95th percentile " << sorted_times[(sorted_times.size() * 95) / 100]
+              << " ms, maximum " << sorted_times.back() << " ms" << std::endl;
+}
+
+void RenderBenchmark::PrintResults() const
+{
+    if (_frame == 0) {
+        std::cout << "Render benchmark: " << _script_filename << ": no frame rendered." << std::endl;
+        return;
+    }
+
+    std::cout << "Render benchmark: " << _script_filename << std::endl
+              << "  Frames: " << _frame << std::endl
+              << "  Draw calls per frame: " << (static_cast<double>(_draw_calls) / _frame) << std::endl
+              << "  Texture binds per frame: " << (static_cast<double>(_texture_binds) / _frame) << std::endl;
+    _PrintFrameTimes("CPU frame time", _cpu_frame_times);
+    _PrintFrameTimes("GPU frame time", _gpu_frame_times);
+    std::cout << "  Last frame checksum: " << std::hex << std::setw(8) << std::setfill('0')
+              << _checksum << std::dec << std::setfill(' ') << std::endl;
+}
+
+} // namespace vt_video
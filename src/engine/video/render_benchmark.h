@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    render_benchmark.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the render benchmarks
+***
+*** A render benchmark loads a game mode through a script, renders a fixed
+*** number of frames with one fixed logic update each, and prints the draw calls,
+*** texture binds, CPU and GPU frame times, and a checksum of the last frame.
+*** Used with the offscreen rendering, it runs on machines without a display:
+***
+*** \code
+*** valyriatear --offscreen --disable-audio --benchmark-render data/debug/render_benchmark_forest.lua 600
+*** \endcode
+***
+*** The benchmark script uses its own tablespace, like the scene scripts.
+*** Its Initialize() function pushes the game mode to render, and its optional
+*** Update(frame) function is called before each frame is updated, to move
+*** the camera along a scripted path for instance.
+*** ***************************************************************************/
+
+#ifndef __RENDER_BENCHMARK_HEADER__
+#define __RENDER_BENCHMARK_HEADER__
+
+#include "script/script_read.h"
+
+#include "utils/gl_include.h"
+
+#include <vector>
+
+namespace vt_video
+{
+
+//! \brief The number of GPU timer queries in flight, so that reading them doesn't stall the GPU.
+const uint32_t RENDER_BENCHMARK_GPU_QUERIES = 4;
+
+/** ****************************************************************************
+*** \brief Renders a scripted scene for a fixed number of frames, and measures it.
+***
+*** The render benchmark is owned by the video engine. \see VideoEngine::GetRenderBenchmark()
+*** The game loop calls BeginFrame() and EndFrame() around the drawing of each frame.
+*** ***************************************************************************/
+class RenderBenchmark
+{
+public:
+    RenderBenchmark();
+
+    /** \brief Loads the benchmark script and runs its Initialize() function.
+    *** \param script_filename The benchmark script.
+    *** \param number_of_frames The number of frames to render.
+    *** \return false if the script couldn't be loaded.
+    **/
+    bool Start(const std::string& script_filename, uint32_t number_of_frames);
+
+    //! \brief Stops the benchmark, and reads back the pending GPU times.
+    void Stop();
+
+    bool IsRunning() const {
+        return _running;
+    }
+
+    //! \brief Tells whether all the frames have been rendered.
+    bool IsFinished() const {
+        return _running && _frame >= _number_of_frames;
+    }
+
+    //! \brief Calls the script Update() function. Called once per frame, before updating the game.
+    void UpdateFrame();
+
+    //! \brief Starts measuring the GPU time of the frame. Called before drawing it.
+    void BeginFrame();
+
+    /** \brief Records the frame statistics, and the last frame checksum.
+    *** Called once the frame is drawn, before swapping the buffers.
+    **/
+    void EndFrame();
+
+    //! \brief Adds the CPU time of the frame, swap included, in milliseconds.
+    void AddFrameTime(float milliseconds);
+
+    //! \brief Prints the benchmark results.
+    void PrintResults() const;
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    RenderBenchmark(const RenderBenchmark& benchmark);
+    RenderBenchmark& operator=(const RenderBenchmark& benchmark);
+
+    //! \brief Reads the GPU time of the given frame. Must be run on the thread owning the OpenGL context.
+    void _ReadGPUQuery(uint32_t frame);
+
+    //! \brief The benchmark script and its update function.
+    vt_script::ReadScriptDescriptor _script;
+    luabind::object _update_function;
+
+    std::string _script_filename;
+
+    bool _running;
+
+    //! \brief The current frame, and the number of frames to render.
+    uint32_t _frame;
+    uint32_t _number_of_frames;
+
+    //! \brief The CPU time of each frame, in milliseconds.
+    std::vector<float> _cpu_frame_times;
+
+    //! \brief The draw calls and texture binds done during the benchmark.
+    uint64_t _draw_calls;
+    uint64_t _texture_binds;
+
+    //! \brief Whether the GPU timer queries are supported.
+    bool _gpu_timing;
+
+    //! \brief The GPU timer queries, used in turn.
+    GLuint _gpu_queries[RENDER_BENCHMARK_GPU_QUERIES];
+
+    //! \brief The GPU time of each frame, in milliseconds. Only accessed by the thread owning the OpenGL context.
+    std::vector<float> _gpu_frame_times;
+
+    //! \brief The checksum of the last frame.
+    uint32_t _checksum;
+};
+
+} // namespace vt_video
+
+#endif // __RENDER_BENCHMARK_HEADER__
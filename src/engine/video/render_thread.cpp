@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    render_thread.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the render thread and its draw command lists.
+*** ***************************************************************************/
+
+#include "engine/video/render_thread.h"
+
+#include "utils/utils_common.h"
+
+namespace vt_video
+{
+
+RenderThread::RenderThread(SDL_Window* window, SDL_GLContext context) :
+    _window(window),
+    _context(context),
+    _recording_list(0),
+    _present(false),
+    _busy(false),
+    _quit(false),
+    _thread(nullptr),
+    _mutex(nullptr),
+    _condition(nullptr)
+{
+}
+
+RenderThread::~RenderThread()
+{
+    Stop();
+}
+
+bool RenderThread::Start()
+{
+    if (_thread != nullptr)
+        return true;
+
+    _mutex = SDL_CreateMutex();
+    _condition = SDL_CreateCond();
+    if (_mutex == nullptr || _condition == nullptr) {
+        PRINT_WARNING << "Couldn't create the render thread synchronization objects: "
+                      << SDL_GetError() << std::endl;
+        Stop();
+        return false;
+    }
+
+    // Release the context, so that the render thread can make it current.
+    SDL_GL_MakeCurrent(_window, nullptr);
+
+    _quit = false;
+    _busy = false;
+    _thread = SDL_CreateThread(_ThreadFunction, "RenderThread", this);
+    if (_thread == nullptr) {
+        PRINT_WARNING << "Couldn't create the render thread: " << SDL_GetError() << std::endl;
+        SDL_GL_MakeCurrent(_window, _context);
+        Stop();
+        return false;
+    }
+
+    return true;
+}
+
+void RenderThread::Stop()
+{
+    if (_thread != nullptr) {
+        // Run what was recorded so far, so that no resource is left behind.
+        Finish();
+
+        SDL_LockMutex(_mutex);
+        _quit = true;
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+
+        SDL_WaitThread(_thread, nullptr);
+        _thread = nullptr;
+
+        // Get the context back.
+        SDL_GL_MakeCurrent(_window, _context);
+    }
+
+    if (_condition != nullptr) {
+        SDL_DestroyCond(_condition);
+        _condition = nullptr;
+    }
+
+    if (_mutex != nullptr) {
+        SDL_DestroyMutex(_mutex);
+        _mutex = nullptr;
+    }
+
+    _command_lists[0].clear();
+    _command_lists[1].clear();
+}
+
+void RenderThread::SubmitFrame()
+{
+    _Submit(true);
+}
+
+void RenderThread::Finish()
+{
+    _Submit(false);
+    _WaitForIdle();
+}
+
+int RenderThread::_ThreadFunction(void* data)
+{
+    RenderThread* render_thread = static_cast<RenderThread*>(data);
+    render_thread->_Run();
+    return 0;
+}
+
+void RenderThread::_Run()
+{
+    if (SDL_GL_MakeCurrent(_window, _context) != 0) {
+        PRINT_ERROR << "Couldn't make the OpenGL context current on the render thread: "
+                    << SDL_GetError() << std::endl;
+    }
+
+    while (true) {
+        SDL_LockMutex(_mutex);
+        while (!_busy && !_quit)
+            SDL_CondWait(_condition, _mutex);
+
+        if (!_busy && _quit) {
+            SDL_UnlockMutex(_mutex);
+            break;
+        }
+
+        // The game thread records into the other list meanwhile.
+        std::vector<RenderCommand>& command_list = _command_lists[1 - _recording_list];
+        bool present = _present;
+        SDL_UnlockMutex(_mutex);
+
+        for (size_t i = 0; i < command_list.size(); ++i)
+            command_list[i]();
+        command_list.clear();
+
+        if (present)
+            SDL_GL_SwapWindow(_window);
+
+        SDL_LockMutex(_mutex);
+        _busy = false;
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+    }
+
+    // Release the context, so that the game thread can get it back.
+    SDL_GL_MakeCurrent(_window, nullptr);
+}
+
+void RenderThread::_Submit(bool present)
+{
+    if (_thread == nullptr) {
+        _command_lists[_recording_list].clear();
+        return;
+    }
+
+    // Wait for the previous list to be run, so that its buffer can be recorded into.
+    _WaitForIdle();
+
+    SDL_LockMutex(_mutex);
+    _recording_list = 1 - _recording_list;
+    _present = present;
+    _busy = true;
+    SDL_CondBroadcast(_condition);
+    SDL_UnlockMutex(_mutex);
+}
+
+void RenderThread::_WaitForIdle()
+{
+    if (_thread == nullptr)
+        return;
+
+    SDL_LockMutex(_mutex);
+    while (_busy)
+        SDL_CondWait(_condition, _mutex);
+    SDL_UnlockMutex(_mutex);
+}
+
+} // namespace vt_video
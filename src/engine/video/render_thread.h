@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    render_thread.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the render thread and its draw command lists.
+***
+*** When the render thread is running, it owns the OpenGL context. The video
+*** engine then records every OpenGL call made by the game thread as a command
+*** in the current command list, instead of running it immediately.
+***
+*** The command lists are double-buffered: once a frame is recorded, its list is
+*** handed to the render thread, which runs it and swaps the window buffers
+*** while the game thread updates and records the next frame.
+*** ***************************************************************************/
+
+#ifndef __RENDER_THREAD_HEADER__
+#define __RENDER_THREAD_HEADER__
+
+#include <SDL2/SDL_video.h>
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+
+#include <functional>
+#include <vector>
+
+namespace vt_video
+{
+
+//! \brief A recorded OpenGL command. It must own copies of the data it uses.
+typedef std::function<void()> RenderCommand;
+
+/** ****************************************************************************
+*** \brief Runs the recorded draw command lists on a dedicated thread.
+***
+*** Only the game thread may record and submit commands.
+*** ***************************************************************************/
+class RenderThread
+{
+public:
+    RenderThread(SDL_Window* window, SDL_GLContext context);
+
+    //! \brief Stops the thread when it is still running.
+    ~RenderThread();
+
+    /** \brief Hands the OpenGL context over to a new render thread.
+    *** \return Whether the thread was started. If not, the context is still current on the calling thread.
+    **/
+    bool Start();
+
+    /** \brief Runs the remaining commands, stops the thread,
+    *** and makes the OpenGL context current on the calling thread again.
+    **/
+    void Stop();
+
+    //! \brief Records a command into the current command list.
+    void Record(RenderCommand&& command) {
+        _command_lists[_recording_list].push_back(std::move(command));
+    }
+
+    /** \brief Hands the recorded frame over to the render thread,
+    *** which runs it and then swaps the window buffers.
+    *** This waits for the previously submitted frame to be done, but not for this one.
+    **/
+    void SubmitFrame();
+
+    /** \brief Runs all the commands recorded so far, and waits for them to be done.
+    *** This is the fence to use before reading data back from OpenGL.
+    **/
+    void Finish();
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    RenderThread(const RenderThread& render_thread);
+    RenderThread& operator=(const RenderThread& render_thread);
+
+    //! \brief The thread entry point.
+    static int _ThreadFunction(void* data);
+
+    //! \brief The render thread loop.
+    void _Run();
+
+    //! \brief Hands the current command list over to the render thread.
+    //! \param present Whether to swap the window buffers once the list is run.
+    void _Submit(bool present);
+
+    //! \brief Waits for the render thread to be done with the submitted command list.
+    void _WaitForIdle();
+
+    //! \brief The window to present frames to and the OpenGL context to use.
+    SDL_Window* _window;
+    SDL_GLContext _context;
+
+    //! \brief The two command lists: one recorded by the game thread while the other one is run.
+    std::vector<RenderCommand> _command_lists[2];
+
+    //! \brief The index of the command list recorded by the game thread.
+    uint32_t _recording_list;
+
+    //! \brief Whether the submitted command list ends a frame.
+    bool _present;
+
+    //! \brief Whether the render thread has a command list to run.
+    bool _busy;
+
+    //! \brief Whether the render thread should exit.
+    bool _quit;
+
+    SDL_Thread* _thread;
+    SDL_mutex* _mutex;
+    SDL_cond* _condition;
+};
+
+} // namespace vt_video
+
+#endif // __RENDER_THREAD_HEADER__
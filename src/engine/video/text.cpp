@@ -559,7 +559,10 @@ TextSupervisor::TextSupervisor() :
     _text_texture_width(0),
     _text_texture_height(0)
 {
-    glGenTextures(1, &_text_texture);
+    // The texture name is needed right away, so wait for the render thread to create it.
+    GLuint text_texture = 0;
+    VideoManager->RunGLCommand([&text_texture]() { glGenTextures(1, &text_texture); });
+    _text_texture = text_texture;
     if (_text_texture == 0) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "call to glGenTextures() failed" << std::endl;
         assert(_text_texture != 0);
@@ -570,8 +573,11 @@ TextSupervisor::~TextSupervisor()
 {
     // Clean up the text texture.
     if (_text_texture != 0) {
-        GLuint textures[] = { _text_texture };
-        glDeleteTextures(1, textures);
+        const GLuint text_texture = _text_texture;
+        VideoManager->SubmitGLCommand([text_texture]() {
+            GLuint textures[] = { text_texture };
+            glDeleteTextures(1, textures);
+        });
         _text_texture = 0;
     }
 
@@ -1062,41 +1068,21 @@ void TextSupervisor::_RenderText(const uint16_t* text, FontProperties* font_prop
     // Enable texturing.
     VideoManager->EnableTexture2D();
 
-    // Bind the OpenGL texture.
-    TextureManager->_BindTexture(_text_texture);
-
-    // Lock the SDL surface.
-    SDL_LockSurface(surface);
+    {
+        vt_system::ProfilerZone zone("TextSupervisor::_RenderText upload");
 
-    //
-    // Send the surface pixel data to OpenGL.
-    //
+        // Bind the OpenGL texture.
+        TextureManager->_BindTexture(_text_texture);
 
-    if (_text_texture_width == static_cast<GLuint>(surface->w) &&
-        _text_texture_height == static_cast<GLuint>(surface->h)) {
-        // The size of the old texture is the same.  Just update the pixel data.
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _text_texture_width, _text_texture_height, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
-    } else {
-        // The size of the old texture is different.  Update the storage definition as well as the pixel data.
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, surface->w, surface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
+        // Send the surface pixel data to OpenGL.
+        _UploadTextTexture(surface);
     }
 
-    // Update the texture's width and height.
-    _text_texture_width = surface->w;
-    _text_texture_height = surface->h;
-
-    // Unlock the SDL surface.
-    SDL_UnlockSurface(surface);
-
-    // Update some of the OpenGL texture parameters.
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
     // Enable blending.
     VideoManager->EnableBlending();
 
     // Update the blending function.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    VideoManager->SubmitGLCommand([]() { glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); });
 
     // Push the matrix stack.
     VideoManager->PushMatrix();
@@ -1192,41 +1178,21 @@ void TextSupervisor::_RenderText(const uint16_t* text, FontProperties* font_prop
     // Enable texturing.
     VideoManager->EnableTexture2D();
 
-    // Bind the OpenGL texture.
-    TextureManager->_BindTexture(_text_texture);
-
-    // Lock the SDL surface.
-    SDL_LockSurface(surface);
+    {
+        vt_system::ProfilerZone zone("TextSupervisor::_RenderText upload");
 
-    //
-    // Send the surface pixel data to OpenGL.
-    //
+        // Bind the OpenGL texture.
+        TextureManager->_BindTexture(_text_texture);
 
-    if (_text_texture_width == static_cast<GLuint>(surface->w) &&
-        _text_texture_height == static_cast<GLuint>(surface->h)) {
-        // The size of the old texture is the same.  Just update the pixel data.
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _text_texture_width, _text_texture_height, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
-    } else {
-        // The size of the old texture is different.  Update the storage definition as well as the pixel data.
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, surface->w, surface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
+        // Send the surface pixel data to OpenGL.
+        _UploadTextTexture(surface);
     }
 
-    // Update the texture's width and height.
-    _text_texture_width = surface->w;
-    _text_texture_height = surface->h;
-
-    // Unlock the SDL surface.
-    SDL_UnlockSurface(surface);
-
-    // Update some of the OpenGL texture parameters.
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
     // Enable blending.
     VideoManager->EnableBlending();
 
     // Update the blending function.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    VideoManager->SubmitGLCommand([]() { glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); });
 
     //
     // Draw the shadow first.
@@ -1309,6 +1275,41 @@ void TextSupervisor::_RenderText(const uint16_t* text, FontProperties* font_prop
     }
 }
 
+void TextSupervisor::_UploadTextTexture(SDL_Surface* surface)
+{
+    // Lock the SDL surface.
+    SDL_LockSurface(surface);
+
+    // Copy the pixel data, as the surface is freed before the render thread gets to it.
+    const uint8_t* surface_pixels = static_cast<const uint8_t*>(surface->pixels);
+    std::vector<uint8_t> pixels(surface_pixels, surface_pixels + surface->h * surface->pitch);
+
+    // Unlock the SDL surface.
+    SDL_UnlockSurface(surface);
+
+    // When the size of the old texture is the same, just update the pixel data.
+    // Otherwise, update the storage definition as well as the pixel data.
+    const bool same_size = (_text_texture_width == static_cast<GLuint>(surface->w) &&
+                            _text_texture_height == static_cast<GLuint>(surface->h));
+    const GLsizei width = surface->w;
+    const GLsizei height = surface->h;
+
+    VideoManager->SubmitGLCommand([=]() {
+        if (same_size)
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+        else
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+
+        // Update some of the OpenGL texture parameters.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    });
+
+    // Update the texture's width and height.
+    _text_texture_width = surface->w;
+    _text_texture_height = surface->h;
+}
+
 bool TextSupervisor::_RenderText(const vt_utils::ustring& text, TextStyle& style, ImageMemory& buffer)
 {
     FontProperties* font_properties = style.GetFontProperties();
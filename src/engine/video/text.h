@@ -654,6 +654,12 @@ private:
     **/
     bool _RenderText(const vt_utils::ustring& text, TextStyle& style, private_video::ImageMemory& buffer);
 
+    /** \brief Sends the rendered text surface pixels to the bound text texture.
+    *** The pixels are copied, so that the surface can be freed before the upload is run
+    *** by the render thread.
+    **/
+    void _UploadTextTexture(SDL_Surface* surface);
+
     /** \brief Returns true if a font of a certain reference name exists
     *** \param font_name The reference name of the font to check
     *** \return True if font name is valid, false if it is not.
@@ -19,6 +19,8 @@
 
 #include "video.h"
 
+#include "engine/profiler.h"
+
 #include "utils/utils_common.h"
 
 #include <cassert>
@@ -101,6 +103,8 @@ bool TexSheet::Reload()
 
 bool TexSheet::CopyRect(int32_t x, int32_t y, ImageMemory& data)
 {
+    vt_system::ProfilerZone zone("TexSheet::CopyRect");
+
     TextureManager->_BindTexture(tex_id);
 
     data.GlTexSubImage(x, y);
@@ -117,16 +121,19 @@ bool TexSheet::CopyScreenRect(int32_t x, int32_t y, const ScreenRect &screen_rec
 {
     TextureManager->_BindTexture(tex_id);
 
-    glCopyTexSubImage2D(
-        GL_TEXTURE_2D, // target
-        0, // level
-        x, // x offset within tex sheet
-        y, // y offset within tex sheet
-        screen_rect.left, // left starting pixel of the screen to copy
-        screen_rect.top, // top starting pixel of the screen to copy
-        screen_rect.width, // width in pixels of image
-        screen_rect.height // height in pixels of image
-    );
+    const ScreenRect rect = screen_rect;
+    VideoManager->SubmitGLCommand([x, y, rect]() {
+        glCopyTexSubImage2D(
+            GL_TEXTURE_2D, // target
+            0, // level
+            x, // x offset within tex sheet
+            y, // y offset within tex sheet
+            rect.left, // left starting pixel of the screen to copy
+            rect.top, // top starting pixel of the screen to copy
+            rect.width, // width in pixels of image
+            rect.height // height in pixels of image
+        );
+    });
 
     if(VideoManager->CheckGLError()) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occured: " << VideoManager->CreateGLErrorString() << std::endl;
@@ -144,8 +151,10 @@ void TexSheet::Smooth(bool flag)
         GLenum filtering_type = smoothed ? GL_LINEAR : GL_NEAREST;
 
         TextureManager->_BindTexture(tex_id);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering_type);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering_type);
+        VideoManager->SubmitGLCommand([filtering_type]() {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering_type);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering_type);
+        });
     }
 }
 
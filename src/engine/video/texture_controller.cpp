@@ -30,7 +30,8 @@ namespace vt_video
 TextureController* TextureManager = nullptr;
 
 TextureController::TextureController() :
-    _debug_current_sheet(-1)
+    _debug_current_sheet(-1),
+    _image_file_recorder(nullptr)
 {
 }
 
@@ -38,6 +39,9 @@ TextureController::~TextureController()
 {
     IF_PRINT_DEBUG(VIDEO_DEBUG) << "Deleting all remaining ImageTextures, a total of: " << _images.size() << std::endl;
 
+    // The retained textures are deleted with the other ones.
+    _retained_images.clear();
+
     // Invoking the ImageTexture destructor will erase the entry in the _images map that corresponds to that object
     // Thus the map will decrement in size by one on every iteration through this loop
     while(_images.empty() == false) {
@@ -172,10 +176,81 @@ void TextureController::DEBUG_ShowTexSheet()
     VideoManager->PopState();
 }
 
+bool TextureController::IsImageFileLoaded(const std::string& filename) const
+{
+    // The images are registered by filename + tags, so the ones of a file follow each other.
+    std::map<std::string, ImageTexture *>::const_iterator it = _images.lower_bound(filename);
+    for(; it != _images.end() && it->first.compare(0, filename.size(), filename) == 0; ++it) {
+        if(it->second->filename == filename)
+            return true;
+    }
+    return false;
+}
+
+bool TextureController::RetainImageFile(const std::string& filename, uint32_t& new_bytes)
+{
+    new_bytes = 0;
+
+    // The memory of a file already retained is only counted once.
+    std::map<std::string, RetainedImageFile>::iterator retained = _retained_images.find(filename);
+    if(retained != _retained_images.end()) {
+        ++retained->second.retain_count;
+        return true;
+    }
+
+    RetainedImageFile retained_file;
+    std::map<std::string, ImageTexture *>::const_iterator it = _images.lower_bound(filename);
+    for(; it != _images.end() && it->first.compare(0, filename.size(), filename) == 0; ++it) {
+        ImageTexture* img = it->second;
+        if(img->filename != filename)
+            continue;
+
+        img->AddReference();
+        retained_file.textures.push_back(img);
+        retained_file.bytes += static_cast<uint32_t>(img->width * img->height * 4);
+    }
+
+    if(retained_file.textures.empty())
+        return false;
+
+    retained_file.retain_count = 1;
+    _retained_images[filename] = retained_file;
+    new_bytes = retained_file.bytes;
+    return true;
+}
+
+uint32_t TextureController::ReleaseImageFile(const std::string& filename)
+{
+    std::map<std::string, RetainedImageFile>::iterator it = _retained_images.find(filename);
+    if(it == _retained_images.end())
+        return 0;
+
+    if(--it->second.retain_count > 0)
+        return 0;
+
+    uint32_t bytes = it->second.bytes;
+
+    std::vector<ImageTexture *>& textures = it->second.textures;
+    for(uint32_t i = 0; i < textures.size(); ++i) {
+        ImageTexture* img = textures[i];
+        if(!img->RemoveReference())
+            continue;
+
+        // Same as when the last image using the texture is removed.
+        img->texture_sheet->RemoveTexture(img);
+        if(img->width > 512 || img->height > 512)
+            _RemoveSheet(img->texture_sheet);
+        delete img;
+    }
+    _retained_images.erase(it);
+    return bytes;
+}
+
 GLuint TextureController::_CreateBlankGLTexture(int32_t width, int32_t height)
 {
-    GLuint tex_id;
-    glGenTextures(1, &tex_id);
+    // The texture name is needed right away, so wait for the render thread to create it.
+    GLuint tex_id = 0;
+    VideoManager->RunGLCommand([&tex_id]() { glGenTextures(1, &tex_id); });
 
     if(VideoManager->CheckGLError()) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error was detected: " << VideoManager->CreateGLErrorString() << std::endl;
@@ -187,7 +262,9 @@ GLuint TextureController::_CreateBlankGLTexture(int32_t width, int32_t height)
 
     // If the binding was successful, initialize the texture with glTexImage2D()
     if(VideoManager->GetGLError() == GL_NO_ERROR) {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        VideoManager->SubmitGLCommand([width, height]() {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        });
     }
 
     if(VideoManager->CheckGLError()) {
@@ -196,24 +273,29 @@ GLuint TextureController::_CreateBlankGLTexture(int32_t width, int32_t height)
         return INVALID_TEXTURE_ID;
     }
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    VideoManager->SubmitGLCommand([]() {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    });
 
     return tex_id;
 }
 
 void TextureController::_BindTexture(GLuint tex_id)
 {
-    glBindTexture(GL_TEXTURE_2D, tex_id);
+    ++VideoManager->_frame_statistics.texture_binds;
+    VideoManager->SubmitGLCommand([tex_id]() { glBindTexture(GL_TEXTURE_2D, tex_id); });
 }
 
 void TextureController::_DeleteTexture(GLuint tex_id)
 {
     if (tex_id != 0) {
-        GLuint textures[] = { tex_id };
-        glDeleteTextures(1, textures);
+        VideoManager->SubmitGLCommand([tex_id]() {
+            GLuint textures[] = { tex_id };
+            glDeleteTextures(1, textures);
+        });
     }
 }
 
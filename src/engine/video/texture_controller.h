@@ -26,8 +26,10 @@
 
 #include "texture.h"
 #include "image_base.h"
+#include "image_preloader.h"
 
 #include <map>
+#include <set>
 
 namespace vt_mode_manager {
 class ParticleSystem;
@@ -73,6 +75,55 @@ public:
     **/
     void DEBUG_ShowTexSheet();
 
+    /** \brief Decodes the given image files on a worker thread, ahead of their loading.
+    *** The previous preload requests not part of the given files are dropped.
+    *** \param filenames The image files that are about to be loaded.
+    **/
+    void PreloadImages(const std::vector<std::string>& filenames) {
+        _image_preloader.Preload(filenames);
+    }
+
+    //! \brief Tells whether an image file has been decoded ahead of time, so that loading it only uploads it.
+    bool IsImagePreloaded(const std::string& filename) {
+        return _image_preloader.IsDecoded(filename);
+    }
+
+    //! \brief Tells whether an image file is still waiting to be decoded ahead of time.
+    bool IsImagePreloadPending(const std::string& filename) {
+        return _image_preloader.IsPending(filename);
+    }
+
+    //! \brief Drops the image files decoded ahead of time but not loaded, freeing their memory.
+    void CancelImagePreloads() {
+        _image_preloader.Cancel();
+    }
+
+    //! \brief Tells whether textures of the given image file are currently loaded.
+    bool IsImageFileLoaded(const std::string& filename) const;
+
+    /** \brief Keeps the textures of an image file loaded, even once no image uses them anymore.
+    *** Only the textures loaded when first calling this are retained. Each call must be matched
+    *** by a ReleaseImageFile() call.
+    *** \param new_bytes Set to the newly retained texture memory, in bytes.
+    *** It is 0 when the file was already retained.
+    *** \return false if the file isn't loaded.
+    *** \see vt_mode_manager::AssetResidencyManager
+    **/
+    bool RetainImageFile(const std::string& filename, uint32_t& new_bytes);
+
+    /** \brief Releases the textures of a retained image file, freeing the ones no image uses anymore.
+    *** \return The texture memory no longer retained, in bytes.
+    *** It is 0 while the file is still retained by other calls.
+    **/
+    uint32_t ReleaseImageFile(const std::string& filename);
+
+    /** \brief Records the image files loaded from now on in the given set.
+    *** \param recorder The set to add the filenames to, or nullptr to stop recording.
+    **/
+    void SetImageFileRecorder(std::set<std::string>* recorder) {
+        _image_file_recorder = recorder;
+    }
+
 private:
     virtual ~TextureController() override;
 
@@ -88,6 +139,22 @@ private:
     //! \brief An index to _tex_sheets of the current texture sheet being shown in debug mode. -1 indicates no sheet
     int32_t _debug_current_sheet;
 
+    //! \brief Decodes the image files requested through PreloadImages() on a worker thread.
+    private_video::ImagePreloader _image_preloader;
+
+    //! \brief The textures kept loaded by RetainImageFile(), by image filename.
+    struct RetainedImageFile {
+        RetainedImageFile(): retain_count(0), bytes(0) {}
+
+        std::vector<private_video::ImageTexture *> textures;
+        uint32_t retain_count;
+        uint32_t bytes;
+    };
+    std::map<std::string, RetainedImageFile> _retained_images;
+
+    //! \brief The set recording the loaded image files, or nullptr.
+    std::set<std::string>* _image_file_recorder;
+
     // ---------- Private methods
 
     //! \name Texture Operations
@@ -148,6 +215,27 @@ private:
 
     //! \name Image Texture Operations
     //@{
+    /** \brief Takes the pixels of an image file decoded ahead of time.
+    *** \param filename The image filename.
+    *** \param image The image memory to move the pixels into.
+    *** \return True if the pixels were taken, false if the file has to be loaded from disk.
+    **/
+    bool _TakePreloadedImage(const std::string& filename, private_video::ImageMemory& image) {
+        return _image_preloader.TakeImage(filename, image);
+    }
+
+    //! \brief Gets the dimensions of an image file decoded ahead of time, leaving its pixels to be taken.
+    //! \return False if the file hasn't been decoded ahead of time.
+    bool _GetPreloadedImageSize(const std::string& filename, uint32_t& width, uint32_t& height) {
+        return _image_preloader.GetImageSize(filename, width, height);
+    }
+
+    //! \brief Adds an image file being loaded to the recorder set, if any.
+    void _RecordImageFile(const std::string& filename) {
+        if(_image_file_recorder)
+            _image_file_recorder->insert(filename);
+    }
+
     /** \brief Adds an image texture to the map registery
     *** \param img A pointer to the ImageTexture to add with its filename and tags members correctly set
     **/
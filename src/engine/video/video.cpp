@@ -18,8 +18,10 @@
 #include "engine/video/video.h"
 
 #include "engine/mode_manager.h"
+#include "engine/script_profiler.h"
 #include "script/script_read.h"
 #include "engine/system.h"
+#include "engine/video/gl/gl_instanced_particle_system.h"
 #include "engine/video/gl/gl_particle_system.h"
 #include "engine/video/gl/gl_render_target.h"
 #include "engine/video/gl/gl_shader.h"
@@ -32,6 +34,12 @@
 
 #include "utils/utils_strings.h"
 
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
 using namespace vt_utils;
 using namespace vt_video::private_video;
 
@@ -40,6 +48,7 @@ namespace vt_video
 
 VideoEngine *VideoManager = nullptr;
 bool VIDEO_DEBUG = false;
+bool VIDEO_OFFSCREEN = false;
 
 //-----------------------------------------------------------------------------
 // Static variable for the Color class
@@ -78,12 +87,17 @@ void RotatePoint(float &x, float &y, float angle)
 
 VideoEngine::VideoEngine():
     _sdl_window(nullptr),
+    _render_thread(nullptr),
+    _render_thread_enabled(false),
     _secondary_render_target(nullptr),
     _fps_display(false),
     _fps_sum(0),
     _current_sample(0),
     _number_samples(0),
     _FPS_textimage(nullptr),
+    _profiler_display(false),
+    _profiler_textimage(nullptr),
+    _profiler_text_frames(0),
     _gl_error_code(GL_NO_ERROR),
     _gl_blend_is_active(false),
     _gl_texture_2d_is_active(false),
@@ -104,9 +118,11 @@ VideoEngine::VideoEngine():
     _temp_width(0),
     _temp_height(0),
     _vsync_mode(0),
+    _frame_rate_limit(VIDEO_DEFAULT_FRAME_RATE_LIMIT),
     _game_update_mode(false),
     _sprite(nullptr),
     _particle_system(nullptr),
+    _instanced_particle_system(nullptr),
     _initialized(false)
 {
     _current_context.blend = 0;
@@ -132,6 +148,9 @@ VideoEngine::VideoEngine():
 
 VideoEngine::~VideoEngine()
 {
+    // Get the OpenGL context back before freeing the resources.
+    StopRenderThread();
+
     // Clean up the sprite.
     if (_sprite != nullptr) {
         delete _sprite;
@@ -144,6 +163,11 @@ VideoEngine::~VideoEngine()
         _particle_system = nullptr;
     }
 
+    if (_instanced_particle_system != nullptr) {
+        delete _instanced_particle_system;
+        _instanced_particle_system = nullptr;
+    }
+
     // Clean up the shaders and shader programs.
     glUseProgram(0);
 
@@ -178,6 +202,11 @@ VideoEngine::~VideoEngine()
         _FPS_textimage = nullptr;
     }
 
+    if (_profiler_textimage != nullptr) {
+        delete _profiler_textimage;
+        _profiler_textimage = nullptr;
+    }
+
     TextureManager->SingletonDestroy();
 }
 
@@ -202,6 +231,11 @@ bool VideoEngine::FinalizeInitialization()
     // Create the particle system.
     _particle_system = new gl::ParticleSystem();
 
+    // Create the instanced particle system when supported.
+    // The per-vertex particle system is used otherwise.
+    if (gl::InstancedParticleSystem::IsSupported())
+        _instanced_particle_system = new gl::InstancedParticleSystem();
+
     //
     // Create the programmable pipeline.
     //
@@ -222,6 +256,12 @@ bool VideoEngine::FinalizeInitialization()
     gl::Shader* sprite_grayscale_fragment =
         new gl::Shader(GL_FRAGMENT_SHADER,
                        gl::shader_definitions::SPRITE_GRAYSCALE_FRAGMENT);
+    gl::Shader* particle_instanced_vertex = nullptr;
+    if (_instanced_particle_system != nullptr) {
+        particle_instanced_vertex =
+            new gl::Shader(GL_VERTEX_SHADER,
+                           gl::shader_definitions::PARTICLE_INSTANCED_VERTEX);
+    }
 
     // Store the shaders.
     _shaders[gl::shaders::VertexDefault] = default_vertex;
@@ -229,6 +269,8 @@ bool VideoEngine::FinalizeInitialization()
     _shaders[gl::shaders::FragmentSolidGrayscale] = solid_color_grayscale_fragment;
     _shaders[gl::shaders::FragmentSprite] = sprite_fragment;
     _shaders[gl::shaders::FragmentSpriteGrayscale] = sprite_grayscale_fragment;
+    if (particle_instanced_vertex != nullptr)
+        _shaders[gl::shaders::VertexParticleInstanced] = particle_instanced_vertex;
 
     //
     // Create the shader programs.
@@ -268,6 +310,19 @@ bool VideoEngine::FinalizeInitialization()
     _programs[gl::shader_programs::Sprite] = sprite_program;
     _programs[gl::shader_programs::SpriteGrayscale] = sprite_grayscale_program;
 
+    if (particle_instanced_vertex != nullptr) {
+        std::vector<std::string> instanced_attributes;
+        instanced_attributes.push_back("in_Corner");
+        instanced_attributes.push_back("in_Instance");
+        instanced_attributes.push_back("in_Rotation");
+        instanced_attributes.push_back("in_Color");
+
+        _programs[gl::shader_programs::ParticleInstanced] =
+            new gl::ShaderProgram(_shaders[gl::shaders::VertexParticleInstanced],
+                                  _shaders[gl::shaders::FragmentSprite],
+                                  instanced_attributes);
+    }
+
     // Create instances of the various sub-systems
     TextureManager = TextureController::SingletonCreate();
     TextManager = TextSupervisor::SingletonCreate();
@@ -368,9 +423,58 @@ void VideoEngine::SetDrawFlags(int32_t first_flag, ...)
 
 void VideoEngine::Clear()
 {
-    glClear(GL_COLOR_BUFFER_BIT |
-            GL_DEPTH_BUFFER_BIT |
-            GL_STENCIL_BUFFER_BIT);
+    SubmitGLCommand([]() {
+        glClear(GL_COLOR_BUFFER_BIT |
+                GL_DEPTH_BUFFER_BIT |
+                GL_STENCIL_BUFFER_BIT);
+    });
+}
+
+bool VideoEngine::StartRenderThread(SDL_GLContext context)
+{
+    if (_render_thread != nullptr)
+        return true;
+
+    if (!_render_thread_enabled || _sdl_window == nullptr)
+        return false;
+
+#ifdef __APPLE__
+    // The window buffers must be swapped on the main thread there.
+    PRINT_WARNING << "The render thread isn't supported on this platform. "
+                  << "Rendering on the game thread instead." << std::endl;
+    return false;
+#endif
+
+    _render_thread = new RenderThread(_sdl_window, context);
+    if (!_render_thread->Start()) {
+        PRINT_WARNING << "The render thread couldn't be started. "
+                      << "Rendering on the game thread instead." << std::endl;
+        delete _render_thread;
+        _render_thread = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void VideoEngine::StopRenderThread()
+{
+    if (_render_thread == nullptr)
+        return;
+
+    _render_thread->Stop();
+    delete _render_thread;
+    _render_thread = nullptr;
+}
+
+void VideoEngine::SwapBuffers()
+{
+    _frame_statistics = VideoFrameStatistics();
+
+    if (_render_thread)
+        _render_thread->SubmitFrame();
+    else
+        SDL_GL_SwapWindow(_sdl_window);
 }
 
 void VideoEngine::Update()
@@ -378,9 +482,6 @@ void VideoEngine::Update()
     uint32_t frame_time = vt_system::SystemManager->GetUpdateTime();
 
     _screen_fader.Update(frame_time);
-
-    if (_fps_display)
-        _UpdateFPS();
 }
 
 void VideoEngine::DrawDebugInfo()
@@ -388,15 +489,31 @@ void VideoEngine::DrawDebugInfo()
     if (TextureManager->_debug_current_sheet >= 0)
         TextureManager->DEBUG_ShowTexSheet();
 
-    if (_fps_display)
+    if (_fps_display) {
+        _UpdateFPS();
         _DrawFPS();
+    }
+
+    if (_profiler_display)
+        _DrawProfiler();
+}
+
+void VideoEngine::ToggleProfiler()
+{
+    _profiler_display = !_profiler_display;
+    _profiler_text_frames = 0;
+
+    vt_system::SystemManager->GetProfiler().SetEnabled(_profiler_display);
+    vt_system::SystemManager->GetScriptProfiler().SetEnabled(_profiler_display);
 }
 
 bool VideoEngine::CheckGLError() {
     if(!VIDEO_DEBUG)
         return false;
 
-    _gl_error_code = glGetError();
+    RunGLCommand([this]() {
+        _gl_error_code = glGetError();
+    });
     return (_gl_error_code != GL_NO_ERROR);
 }
 
@@ -432,6 +549,9 @@ bool VideoEngine::ApplySettings()
         return false;
     }
 
+    // Don't change the window while the render thread is drawing into it.
+    RunGLCommand([]() {});
+
     if (_temp_fullscreen && !_fullscreen) {
         // We want to go in fullscreen mode
         // Get desktop resolution and adapt the current resolution
@@ -482,31 +602,34 @@ bool VideoEngine::ApplySettings()
 
     _UpdateViewportMetrics();
 
-    // Resize the secondary render target.
-    assert(_secondary_render_target != nullptr);
-    _secondary_render_target->Resize(_screen_width, _screen_height);
+    // The swap interval applies to the current context, so it is set from the thread owning it.
+    RunGLCommand([this]() {
+        // Resize the secondary render target.
+        assert(_secondary_render_target != nullptr);
+        _secondary_render_target->Resize(_screen_width, _screen_height);
 
-    // Try to apply the VSync mode
-    if (_vsync_mode > 2) {
-        _vsync_mode = 0;
-    }
+        // Try to apply the VSync mode
+        if (_vsync_mode > 2) {
+            _vsync_mode = 0;
+        }
 
-    // Try Swap tearing
-    if (_vsync_mode == 2 && SDL_GL_SetSwapInterval(-1) != 0) {
-        // Swap tearing failed, attempt VSync.
-        _vsync_mode = 1;
-    }
+        // Try Swap tearing
+        if (_vsync_mode == 2 && SDL_GL_SetSwapInterval(-1) != 0) {
+            // Swap tearing failed, attempt VSync.
+            _vsync_mode = 1;
+        }
 
-    // Try VSync
-    if (_vsync_mode == 1 && SDL_GL_SetSwapInterval(1) != 0) {
-        // VSync failed, fall-back to none.
-        _vsync_mode = 0;
-    }
+        // Try VSync
+        if (_vsync_mode == 1 && SDL_GL_SetSwapInterval(1) != 0) {
+            // VSync failed, fall-back to none.
+            _vsync_mode = 0;
+        }
 
-    // No VSync
-    if (_vsync_mode == 0) {
-        SDL_GL_SetSwapInterval(0);
-    }
+        // No VSync
+        if (_vsync_mode == 0) {
+            SDL_GL_SetSwapInterval(0);
+        }
+    });
 
     return true;
 }
@@ -545,13 +668,12 @@ void VideoEngine::SetCoordSys(const CoordSys &coordinate_system)
 void VideoEngine::GetCurrentViewport(float &x, float &y,
                                      float &width, float &height)
 {
-    GLint viewport_dimensions[4] = { 0, 0, 0, 0 };
-    glGetIntegerv(GL_VIEWPORT, viewport_dimensions);
-
-    x = (float) viewport_dimensions[0];
-    y = (float) viewport_dimensions[1];
-    width = (float) viewport_dimensions[2];
-    height = (float) viewport_dimensions[3];
+    // The viewport is only changed through SetViewport(), so there is no need
+    // to read it back from OpenGL and wait for the render thread.
+    x = static_cast<float>(_viewport_x_offset);
+    y = static_cast<float>(_viewport_y_offset);
+    width = static_cast<float>(_viewport_width);
+    height = static_cast<float>(_viewport_height);
 }
 
 void VideoEngine::SetViewport(float x, float y, float width, float height)
@@ -569,14 +691,19 @@ void VideoEngine::SetViewport(float x, float y, float width, float height)
     _viewport_width = width;
     _viewport_height = height;
 
-    glViewport(_viewport_x_offset, _viewport_y_offset,
-               _viewport_width, _viewport_height);
+    GLint viewport_x = _viewport_x_offset;
+    GLint viewport_y = _viewport_y_offset;
+    GLsizei viewport_width = _viewport_width;
+    GLsizei viewport_height = _viewport_height;
+    SubmitGLCommand([=]() {
+        glViewport(viewport_x, viewport_y, viewport_width, viewport_height);
+    });
 }
 
 void VideoEngine::EnableBlending()
 {
     if(!_gl_blend_is_active) {
-        glEnable(GL_BLEND);
+        SubmitGLCommand([]() { glEnable(GL_BLEND); });
         _gl_blend_is_active = true;
     }
 }
@@ -584,7 +711,7 @@ void VideoEngine::EnableBlending()
 void VideoEngine::DisableBlending()
 {
     if(_gl_blend_is_active) {
-        glDisable(GL_BLEND);
+        SubmitGLCommand([]() { glDisable(GL_BLEND); });
         _gl_blend_is_active = false;
     }
 }
@@ -592,7 +719,7 @@ void VideoEngine::DisableBlending()
 void VideoEngine::EnableStencilTest()
 {
     if(!_gl_stencil_test_is_active) {
-        glEnable(GL_STENCIL_TEST);
+        SubmitGLCommand([]() { glEnable(GL_STENCIL_TEST); });
         _gl_stencil_test_is_active = true;
     }
 }
@@ -600,7 +727,7 @@ void VideoEngine::EnableStencilTest()
 void VideoEngine::DisableStencilTest()
 {
     if(_gl_stencil_test_is_active) {
-        glDisable(GL_STENCIL_TEST);
+        SubmitGLCommand([]() { glDisable(GL_STENCIL_TEST); });
         _gl_stencil_test_is_active = false;
     }
 }
@@ -608,7 +735,7 @@ void VideoEngine::DisableStencilTest()
 void VideoEngine::EnableTexture2D()
 {
     if(!_gl_texture_2d_is_active) {
-        glEnable(GL_TEXTURE_2D);
+        SubmitGLCommand([]() { glEnable(GL_TEXTURE_2D); });
         _gl_texture_2d_is_active = true;
     }
 }
@@ -616,7 +743,7 @@ void VideoEngine::EnableTexture2D()
 void VideoEngine::DisableTexture2D()
 {
     if(_gl_texture_2d_is_active) {
-        glDisable(GL_TEXTURE_2D);
+        SubmitGLCommand([]() { glDisable(GL_TEXTURE_2D); });
         _gl_texture_2d_is_active = false;
     }
 }
@@ -624,21 +751,51 @@ void VideoEngine::DisableTexture2D()
 void VideoEngine::EnableSecondaryRenderTarget()
 {
     assert(_secondary_render_target != nullptr);
-    _secondary_render_target->Bind();
+    gl::RenderTarget* render_target = _secondary_render_target;
+    SubmitGLCommand([render_target]() { render_target->Bind(); });
 }
 
 void VideoEngine::DisableSecondaryRenderTarget()
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    SubmitGLCommand([]() { glBindFramebuffer(GL_FRAMEBUFFER, 0); });
 }
 
 void VideoEngine::DrawSecondaryRenderTarget()
 {
-    assert(_sprite != nullptr);
     assert(_secondary_render_target != nullptr);
 
-    float width_render_target = static_cast<float>(_secondary_render_target->GetWidth());
-    float height_render_target = static_cast<float>(_secondary_render_target->GetHeight());
+    // Disable the secondary render target.
+    DisableSecondaryRenderTarget();
+
+    _DrawFullscreenRenderTarget(_secondary_render_target, true);
+}
+
+void VideoEngine::BindRenderTarget(gl::RenderTarget* render_target)
+{
+    if (render_target == nullptr) {
+        SubmitGLCommand([]() { glBindFramebuffer(GL_FRAMEBUFFER, 0); });
+        return;
+    }
+
+    SubmitGLCommand([render_target]() { render_target->Bind(); });
+}
+
+void VideoEngine::DrawRenderTarget(gl::RenderTarget* render_target)
+{
+    assert(render_target != nullptr);
+
+    // The render target holds a whole frame, so it replaces the screen content.
+    _DrawFullscreenRenderTarget(render_target, false);
+}
+
+void VideoEngine::_DrawFullscreenRenderTarget(gl::RenderTarget* render_target, bool blend)
+{
+    assert(_sprite != nullptr);
+    assert(render_target != nullptr);
+
+    float width_render_target = static_cast<float>(render_target->GetWidth());
+    float height_render_target = static_cast<float>(render_target->GetHeight());
+    bool blending_was_active = _gl_blend_is_active;
 
     // Set up the video manager state.
     vt_video::VideoManager->PushState();
@@ -647,33 +804,18 @@ void VideoEngine::DrawSecondaryRenderTarget()
     vt_video::VideoManager->SetCoordSys(0.0f, width_render_target, height_render_target, 0.0f);
     vt_video::VideoManager->SetDrawFlags(vt_video::VIDEO_X_LEFT, vt_video::VIDEO_Y_TOP, vt_video::VIDEO_BLEND, 0);
 
-    VideoManager->EnableBlending();
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (blend) {
+        VideoManager->EnableBlending();
+        SubmitGLCommand([]() { glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); });
+    }
+    else {
+        VideoManager->DisableBlending();
+    }
 
     // Load the shader program.
     gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
     assert(shader_program != nullptr);
 
-    // Load the shader uniforms.
-    float buffer[16] = { 0 };
-    gl::Transform identity;
-    identity.Apply(buffer);
-    shader_program->UpdateUniform("u_Model", buffer, 16);
-
-    identity.Apply(buffer);
-    shader_program->UpdateUniform("u_View", buffer, 16);
-
-    identity.Apply(buffer);
-    shader_program->UpdateUniform("u_Projection", buffer, 16);
-
-    shader_program->UpdateUniform("u_Color", ::vt_video::Color::white.GetColors(), 4);
-
-    // Disable the secondary render target.
-    DisableSecondaryRenderTarget();
-
-    // Bind the secondary render target's texture.
-    _secondary_render_target->BindTexture();
-
     //
     // Draw a fullscreen quad.
     //
@@ -705,15 +847,37 @@ void VideoEngine::DrawSecondaryRenderTarget()
         1.0f, 1.0f, 1.0f, 1.0f  // Vertex Four.
     };
 
-    _sprite->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors);
+    // The render target's texture bind and its draw.
+    ++_frame_statistics.texture_binds;
+    ++_frame_statistics.draw_calls;
+
+    gl::Sprite* sprite = _sprite;
+    SubmitGLCommand([=]() mutable {
+        // Load the shader uniforms.
+        float buffer[16] = { 0 };
+        gl::Transform identity;
+        identity.Apply(buffer);
+        shader_program->UpdateUniform("u_Model", buffer, 16);
+        shader_program->UpdateUniform("u_View", buffer, 16);
+        shader_program->UpdateUniform("u_Projection", buffer, 16);
+
+        shader_program->UpdateUniform("u_Color", ::vt_video::Color::white.GetColors(), 4);
 
-    // Unbind the secondary render target's texture.
-    glBindTexture(GL_TEXTURE_2D, 0);
+        // Bind the render target's texture.
+        render_target->BindTexture();
+
+        sprite->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors);
+
+        // Unbind the render target's texture.
+        glBindTexture(GL_TEXTURE_2D, 0);
+    });
 
     // Unload the shader program.
     VideoManager->UnloadShaderProgram();
 
     // Restore the state.
+    if (blending_was_active)
+        VideoManager->EnableBlending();
     vt_video::VideoManager->PopState();
 }
 
@@ -724,7 +888,7 @@ gl::ShaderProgram* VideoEngine::LoadShaderProgram(const gl::shader_programs::Sha
     assert(_programs.find(shader_program) != _programs.end());
     if (_programs.find(shader_program) != _programs.end()) {
         result = _programs.at(shader_program);
-        result->Load();
+        SubmitGLCommand([result]() { result->Load(); });
     }
 
     return result;
@@ -732,7 +896,7 @@ gl::ShaderProgram* VideoEngine::LoadShaderProgram(const gl::shader_programs::Sha
 
 void VideoEngine::UnloadShaderProgram()
 {
-    glUseProgram(0);
+    SubmitGLCommand([]() { glUseProgram(0); });
 }
 
 void VideoEngine::DrawParticleSystem(gl::ShaderProgram* shader_program,
@@ -748,22 +912,107 @@ void VideoEngine::DrawParticleSystem(gl::ShaderProgram* shader_program,
     assert(vertex_colors != nullptr);
     assert(number_of_vertices % 4 == 0);
 
+    // The matrices are computed now, as the transform stack will have changed when the command is run.
+    float model[16] = { 0 };
+    _transform_stack.top().Apply(model);
+    float projection[16] = { 0 };
+    _projection.Apply(projection);
+
+    ++_frame_statistics.draw_calls;
+
+    gl::ParticleSystem* particle_system = _particle_system;
+    if (_render_thread == nullptr) {
+        _DrawParticleSystem(particle_system, shader_program, model, projection,
+                            vertex_positions, vertex_texture_coordinates, vertex_colors,
+                            number_of_vertices);
+        return;
+    }
+
+    // The vertex arrays are reused by the particle system, so the command needs its own copy.
+    std::vector<float> positions(vertex_positions, vertex_positions + number_of_vertices * 3);
+    std::vector<float> texture_coordinates(vertex_texture_coordinates,
+                                           vertex_texture_coordinates + number_of_vertices * 2);
+    std::vector<float> colors(vertex_colors, vertex_colors + number_of_vertices * 4);
+    _render_thread->Record([=]() mutable {
+        _DrawParticleSystem(particle_system, shader_program, model, projection,
+                            positions.data(), texture_coordinates.data(), colors.data(),
+                            number_of_vertices);
+    });
+}
+
+void VideoEngine::_DrawParticleSystem(gl::ParticleSystem* particle_system,
+                                      gl::ShaderProgram* shader_program,
+                                      const float* model,
+                                      const float* projection,
+                                      float* vertex_positions,
+                                      float* vertex_texture_coordinates,
+                                      float* vertex_colors,
+                                      unsigned number_of_vertices)
+{
     // Load the shader uniforms common to all programs.
-    float buffer[16] = { 0 };
-    _transform_stack.top().Apply(buffer);
-    shader_program->UpdateUniform("u_Model", buffer, 16);
+    shader_program->UpdateUniform("u_Model", model, 16);
 
+    float buffer[16] = { 0 };
     gl::Transform identity;
     identity.Apply(buffer);
     shader_program->UpdateUniform("u_View", buffer, 16);
 
-    _projection.Apply(buffer);
-    shader_program->UpdateUniform("u_Projection", buffer, 16);
+    shader_program->UpdateUniform("u_Projection", projection, 16);
 
     shader_program->UpdateUniform("u_Color", reinterpret_cast<const float*>(&::vt_video::Color::white), 4);
 
     // Draw the particle system.
-    _particle_system->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors, number_of_vertices);
+    particle_system->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors, number_of_vertices);
+}
+
+void VideoEngine::DrawInstancedParticleSystem(gl::ShaderProgram* shader_program,
+                                              const gl::ParticleInstance* instances,
+                                              unsigned number_of_particles,
+                                              const float* texture_rectangle,
+                                              float color_scale)
+{
+    assert(_instanced_particle_system != nullptr);
+    assert(shader_program != nullptr);
+    assert(texture_rectangle != nullptr);
+
+    float model[16] = { 0 };
+    _transform_stack.top().Apply(model);
+    float projection[16] = { 0 };
+    _projection.Apply(projection);
+    float tex_rect[4] = { texture_rectangle[0], texture_rectangle[1],
+                          texture_rectangle[2], texture_rectangle[3] };
+
+    // A null instance array means reusing the previously uploaded instances, so there is nothing to copy then.
+    std::vector<gl::ParticleInstance> instance_copy;
+    if (instances != nullptr && _render_thread != nullptr)
+        instance_copy.assign(instances, instances + number_of_particles);
+
+    ++_frame_statistics.draw_calls;
+
+    gl::InstancedParticleSystem* particle_system = _instanced_particle_system;
+    SubmitGLCommand([=]() {
+        // Load the shader uniforms common to all programs.
+        shader_program->UpdateUniform("u_Model", model, 16);
+
+        float buffer[16] = { 0 };
+        gl::Transform identity;
+        identity.Apply(buffer);
+        shader_program->UpdateUniform("u_View", buffer, 16);
+
+        shader_program->UpdateUniform("u_Projection", projection, 16);
+
+        shader_program->UpdateUniform("u_Color", reinterpret_cast<const float*>(&::vt_video::Color::white), 4);
+
+        // Load the per-draw frame data.
+        shader_program->UpdateUniform("u_TexRect", tex_rect, 4);
+        shader_program->UpdateUniform("u_ColorScale", color_scale);
+
+        // Draw the particle system.
+        if (instances == nullptr || instance_copy.empty())
+            particle_system->Draw(instances, number_of_particles);
+        else
+            particle_system->Draw(&instance_copy[0], number_of_particles);
+    });
 }
 
 void VideoEngine::DrawSprite(gl::ShaderProgram* shader_program,
@@ -778,29 +1027,48 @@ void VideoEngine::DrawSprite(gl::ShaderProgram* shader_program,
     assert(vertex_texture_coordinates != nullptr);
     assert(vertex_colors != nullptr);
 
-    // Load the shader uniforms common to all programs.
-    float buffer[16] = { 0 };
-    _transform_stack.top().Apply(buffer);
-    shader_program->UpdateUniform("u_Model", buffer, 16);
-
-    gl::Transform identity;
-    identity.Apply(buffer);
-    shader_program->UpdateUniform("u_View", buffer, 16);
-
-    _projection.Apply(buffer);
-    shader_program->UpdateUniform("u_Projection", buffer, 16);
-
-    shader_program->UpdateUniform("u_Color", color.GetColors(), 4);
-
-    // Draw the sprite.
-    _sprite->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors);
+    // A sprite is a quad: 4 vertices of 3 position, 2 texture coordinates and 4 color components.
+    // The arrays usually live on the caller's stack, so the command keeps its own copy.
+    std::array<float, 12> positions;
+    std::array<float, 8> texture_coordinates;
+    std::array<float, 16> colors;
+    std::copy(vertex_positions, vertex_positions + positions.size(), positions.begin());
+    std::copy(vertex_texture_coordinates, vertex_texture_coordinates + texture_coordinates.size(),
+              texture_coordinates.begin());
+    std::copy(vertex_colors, vertex_colors + colors.size(), colors.begin());
+
+    float model[16] = { 0 };
+    _transform_stack.top().Apply(model);
+    float projection[16] = { 0 };
+    _projection.Apply(projection);
+
+    ++_frame_statistics.draw_calls;
+
+    gl::Sprite* sprite = _sprite;
+    Color sprite_color = color;
+    SubmitGLCommand([=]() mutable {
+        // Load the shader uniforms common to all programs.
+        shader_program->UpdateUniform("u_Model", model, 16);
+
+        float buffer[16] = { 0 };
+        gl::Transform identity;
+        identity.Apply(buffer);
+        shader_program->UpdateUniform("u_View", buffer, 16);
+
+        shader_program->UpdateUniform("u_Projection", projection, 16);
+
+        shader_program->UpdateUniform("u_Color", sprite_color.GetColors(), 4);
+
+        // Draw the sprite.
+        sprite->Draw(positions.data(), texture_coordinates.data(), colors.data());
+    });
 }
 
 void VideoEngine::EnableScissoring()
 {
     _current_context.scissoring_enabled = true;
     if (!_gl_scissor_test_is_active) {
-        glEnable(GL_SCISSOR_TEST);
+        SubmitGLCommand([]() { glEnable(GL_SCISSOR_TEST); });
         _gl_scissor_test_is_active = true;
     }
 }
@@ -809,7 +1077,7 @@ void VideoEngine::DisableScissoring()
 {
     _current_context.scissoring_enabled = false;
     if (_gl_scissor_test_is_active) {
-        glDisable(GL_SCISSOR_TEST);
+        SubmitGLCommand([]() { glDisable(GL_SCISSOR_TEST); });
         _gl_scissor_test_is_active = false;
     }
 }
@@ -824,10 +1092,11 @@ void VideoEngine::SetScissorRect(const ScreenRect& screen_rectangle)
 {
     _current_context.scissor_rectangle = screen_rectangle;
 
-    glScissor(static_cast<GLint>(_current_context.scissor_rectangle.left),
-              static_cast<GLint>(_current_context.scissor_rectangle.top),
-              static_cast<GLsizei>(_current_context.scissor_rectangle.width),
-              static_cast<GLsizei>(_current_context.scissor_rectangle.height));
+    GLint left = static_cast<GLint>(screen_rectangle.left);
+    GLint top = static_cast<GLint>(screen_rectangle.top);
+    GLsizei width = static_cast<GLsizei>(screen_rectangle.width);
+    GLsizei height = static_cast<GLsizei>(screen_rectangle.height);
+    SubmitGLCommand([=]() { glScissor(left, top, width, height); });
 }
 
 void VideoEngine::PushScissoredRect(float x, float y, float width, float height)
@@ -1154,14 +1423,17 @@ void VideoEngine::MakeScreenshot(const std::string &filename)
     private_video::ImageMemory buffer;
 
     // Retrieve the width and height of the viewport.
-    GLint viewport_dimensions[4]; // viewport_dimensions[2] is the width, [3] is the height
-    glGetIntegerv(GL_VIEWPORT, viewport_dimensions);
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+    GetCurrentViewport(x, y, width, height);
 
     // Buffer to store the image before it is flipped
-    buffer.Resize(viewport_dimensions[2], viewport_dimensions[3], true);
+    buffer.Resize(static_cast<uint32_t>(width), static_cast<uint32_t>(height), true);
 
     // Read the viewport pixel data
-    buffer.GlReadPixels(viewport_dimensions[0], viewport_dimensions[1]);
+    buffer.GlReadPixels(static_cast<int32_t>(x), static_cast<int32_t>(y));
 
     if(CheckGLError()) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "An OpenGL error occured: "
@@ -1174,6 +1446,34 @@ void VideoEngine::MakeScreenshot(const std::string &filename)
     buffer.SaveImage(filename);
 }
 
+uint32_t VideoEngine::ComputeFrameChecksum()
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+    GetCurrentViewport(x, y, width, height);
+
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    if (pixels.empty())
+        return 0;
+
+    RunGLCommand([&pixels, x, y, width, height]() {
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(static_cast<GLint>(x), static_cast<GLint>(y),
+                     static_cast<GLsizei>(width), static_cast<GLsizei>(height),
+                     GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+    });
+
+    // FNV-1a hash of the pixels.
+    uint32_t checksum = 2166136261u;
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        checksum ^= pixels[i];
+        checksum *= 16777619u;
+    }
+    return checksum;
+}
+
 void VideoEngine::DrawLine(float x1, float y1, unsigned width1,
                            float x2, float y2, unsigned width2, const Color &color)
 {
@@ -1220,7 +1520,7 @@ void VideoEngine::DrawLine(float x1, float y1, unsigned width1,
     DisableTexture2D();
 
     // Normal blending.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    SubmitGLCommand([]() { glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); });
 
     // Load the solid shader program.
     gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Solid);
@@ -1377,12 +1677,13 @@ void VideoEngine::_UpdateFPS()
     //! \brief The number of samples to take if we need to play catchup with the current FPS
     const uint32_t FPS_CATCHUP = 20;
 
-    uint32_t frame_time = vt_system::SystemManager->GetUpdateTime();
+    // Use the real frame time, as the update time is a fixed step.
+    float frame_time = vt_system::SystemManager->GetFrameTime();
 
     // Calculate the FPS for the current frame
     uint32_t current_fps = 1000;
-    if (frame_time)
-        current_fps /= frame_time;
+    if (frame_time > 0.0f)
+        current_fps = static_cast<uint32_t>(1000.0f / frame_time);
 
     // The number of times to insert the current FPS sample into the fps_samples array
     uint32_t number_insertions;
@@ -1439,4 +1740,172 @@ void VideoEngine::_DrawFPS()
     PopState();
 }
 
+//! \brief The number of frames between two profiler text updates.
+const uint32_t PROFILER_TEXT_UPDATE_FRAMES = 30;
+
+//! \brief The number of Lua functions shown in the profiler text, the slowest ones.
+const uint32_t PROFILER_SCRIPT_FUNCTIONS_SHOWN = 5;
+
+void VideoEngine::_UpdateProfilerText()
+{
+    const vt_system::FrameProfiler& profiler = vt_system::SystemManager->GetProfiler();
+    uint32_t number_of_frames = profiler.GetNumberOfFrames();
+
+    // The zone statistics, by zone name, over the whole history.
+    struct ZoneStatistics {
+        ZoneStatistics(): total_ms(0.0f), max_ms(0.0f), depth(0) {}
+        float total_ms;
+        float max_ms;
+        uint32_t depth;
+    };
+    std::vector<std::string> zone_names;
+    std::map<std::string, ZoneStatistics> zone_statistics;
+    float total_frame_ms = 0.0f;
+    float max_frame_ms = 0.0f;
+
+    for (uint32_t i = 0; i < number_of_frames; ++i) {
+        const vt_system::ProfilerFrame& frame = profiler.GetFrame(i);
+        float frame_ms = profiler.CounterToMilliseconds(frame.end_counter - frame.start_counter);
+        total_frame_ms += frame_ms;
+        max_frame_ms = std::max(max_frame_ms, frame_ms);
+
+        // Zones called several times in a frame are summed up.
+        std::map<std::string, float> frame_zones_ms;
+        for (uint32_t j = 0; j < frame.zones.size(); ++j) {
+            const vt_system::ProfilerZoneRecord& zone = frame.zones[j];
+            // Only show the first levels to keep the text readable.
+            if (zone.depth > 1)
+                continue;
+
+            std::string name = zone.name;
+            if (zone_statistics.find(name) == zone_statistics.end()) {
+                zone_names.push_back(name);
+                zone_statistics[name].depth = zone.depth;
+            }
+            frame_zones_ms[name] += profiler.CounterToMilliseconds(zone.end - zone.start);
+        }
+
+        for (std::map<std::string, float>::const_iterator it = frame_zones_ms.begin();
+                it != frame_zones_ms.end(); ++it) {
+            ZoneStatistics& statistics = zone_statistics[it->first];
+            statistics.total_ms += it->second;
+            statistics.max_ms = std::max(statistics.max_ms, it->second);
+        }
+    }
+
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2);
+    text << "Frame: " << total_frame_ms / number_of_frames << " ms (max: " << max_frame_ms << " ms)";
+    for (uint32_t i = 0; i < zone_names.size(); ++i) {
+        const ZoneStatistics& statistics = zone_statistics[zone_names[i]];
+        text << std::endl << (statistics.depth == 0 ? "  " : "      ") << zone_names[i] << ": "
+             << statistics.total_ms / number_of_frames << " ms (max: " << statistics.max_ms << " ms)";
+    }
+
+    // The Lua functions statistics are summed up since the profiler was enabled.
+    const vt_system::ScriptProfiler& script_profiler = vt_system::SystemManager->GetScriptProfiler();
+    std::vector<uint32_t> slowest_calls = script_profiler.GetSlowestCalls(PROFILER_SCRIPT_FUNCTIONS_SHOWN);
+    if (!slowest_calls.empty()) {
+        text << std::endl << "Lua: " << script_profiler.GetAllocatedBytes() / 1024 << " KB allocated";
+        for (uint32_t i = 0; i < slowest_calls.size(); ++i) {
+            const vt_system::ScriptCallStatistics& statistics = script_profiler.GetStatistics()[slowest_calls[i]];
+            text << std::endl << "  " << statistics.name << ": " << statistics.calls << " calls, "
+                 << profiler.CounterToMilliseconds(statistics.total_counter) << " ms, "
+                 << statistics.allocated_bytes / 1024 << " KB";
+        }
+    }
+
+    // We only create the text image when needed, to permit getting the text style correctly.
+    if (!_profiler_textimage)
+        _profiler_textimage = new TextImage(text.str(), TextStyle("text14", Color::white));
+    else
+        _profiler_textimage->SetText(text.str());
+}
+
+void VideoEngine::_DrawProfiler()
+{
+    const vt_system::FrameProfiler& profiler = vt_system::SystemManager->GetProfiler();
+    uint32_t number_of_frames = profiler.GetNumberOfFrames();
+    if (number_of_frames == 0)
+        return;
+
+    if (_profiler_text_frames == 0 || !_profiler_textimage)
+        _UpdateProfilerText();
+    _profiler_text_frames = (_profiler_text_frames + 1) % PROFILER_TEXT_UPDATE_FRAMES;
+
+    // The frame budget of one fixed game logic update, in milliseconds.
+    const float FRAME_BUDGET_MS = 1000.0f / vt_system::SYSTEM_UPDATES_PER_SECOND;
+
+    const float PANEL_LEFT = 8.0f;
+    const float PANEL_TOP = 8.0f;
+    const float PANEL_WIDTH = 4.0f * vt_system::PROFILER_FRAME_HISTORY + 16.0f;
+    const float GRAPH_HEIGHT = 90.0f;
+    const float GRAPH_PIXELS_PER_MS = GRAPH_HEIGHT / (3.0f * FRAME_BUDGET_MS);
+    const float ZONE_HEIGHT = 10.0f;
+    const float ZONE_PIXELS_PER_MS = (PANEL_WIDTH - 16.0f) / (2.0f * FRAME_BUDGET_MS);
+
+    // Zone colors, by depth.
+    const Color ZONE_COLORS[] = { Color::aqua, Color::green, Color::yellow, Color::orange, Color::violet };
+    const uint32_t NUMBER_OF_ZONE_COLORS = sizeof(ZONE_COLORS) / sizeof(ZONE_COLORS[0]);
+
+    const vt_system::ProfilerFrame& last_frame = profiler.GetFrame(0);
+    uint32_t max_depth = 0;
+    for (uint32_t i = 0; i < last_frame.zones.size(); ++i)
+        max_depth = std::max(max_depth, last_frame.zones[i].depth);
+
+    const float graph_bottom = PANEL_TOP + 8.0f + GRAPH_HEIGHT;
+    const float zones_top = graph_bottom + 8.0f;
+    const float text_top = zones_top + (max_depth + 1) * (ZONE_HEIGHT + 2.0f) + 8.0f;
+    const float panel_height = text_top + _profiler_textimage->GetHeight() + 8.0f - PANEL_TOP;
+
+    PushState();
+    SetStandardCoordSys();
+    SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_BOTTOM, VIDEO_X_NOFLIP, VIDEO_Y_NOFLIP,
+                 VIDEO_BLEND, 0);
+
+    // Background panel
+    Move(PANEL_LEFT, PANEL_TOP + panel_height);
+    DrawRectangle(PANEL_WIDTH, panel_height, Color(0.0f, 0.0f, 0.0f, 0.7f));
+
+    // Frame times graph, the oldest frame on the left.
+    for (uint32_t i = 0; i < number_of_frames; ++i) {
+        const vt_system::ProfilerFrame& frame = profiler.GetFrame(i);
+        float frame_ms = profiler.CounterToMilliseconds(frame.end_counter - frame.start_counter);
+        float bar_height = std::min(GRAPH_HEIGHT, std::max(1.0f, frame_ms * GRAPH_PIXELS_PER_MS));
+
+        Color bar_color = Color::green;
+        if (frame_ms > 2.0f * FRAME_BUDGET_MS)
+            bar_color = Color::red;
+        else if (frame_ms > FRAME_BUDGET_MS)
+            bar_color = Color::orange;
+
+        Move(PANEL_LEFT + 8.0f + (vt_system::PROFILER_FRAME_HISTORY - 1 - i) * 4.0f, graph_bottom);
+        DrawRectangle(3.0f, bar_height, bar_color);
+    }
+
+    // Frame budget line
+    float budget_y = graph_bottom - FRAME_BUDGET_MS * GRAPH_PIXELS_PER_MS;
+    DrawLine(PANEL_LEFT + 8.0f, budget_y, 1, PANEL_LEFT + PANEL_WIDTH - 8.0f, budget_y, 1, Color::white);
+
+    // Last frame zones, as a flame graph.
+    for (uint32_t i = 0; i < last_frame.zones.size(); ++i) {
+        const vt_system::ProfilerZoneRecord& zone = last_frame.zones[i];
+        float zone_x = profiler.CounterToMilliseconds(zone.start) * ZONE_PIXELS_PER_MS;
+        if (zone_x >= PANEL_WIDTH - 16.0f)
+            continue;
+
+        float zone_width = std::max(1.0f, profiler.CounterToMilliseconds(zone.end - zone.start) * ZONE_PIXELS_PER_MS);
+        zone_width = std::min(zone_width, PANEL_WIDTH - 16.0f - zone_x);
+
+        Move(PANEL_LEFT + 8.0f + zone_x, zones_top + zone.depth * (ZONE_HEIGHT + 2.0f) + ZONE_HEIGHT);
+        DrawRectangle(zone_width, ZONE_HEIGHT, ZONE_COLORS[zone.depth % NUMBER_OF_ZONE_COLORS]);
+    }
+
+    // Zone statistics
+    Move(PANEL_LEFT + 8.0f, text_top + _profiler_textimage->GetHeight());
+    _profiler_textimage->Draw();
+
+    PopState();
+}
+
 }  // namespace vt_video
@@ -40,6 +40,8 @@
 #include "engine/video/gl/gl_shaders.h"
 #include "engine/video/gl/gl_transform.h"
 #include "engine/video/image.h"
+#include "engine/video/render_benchmark.h"
+#include "engine/video/render_thread.h"
 #include "engine/video/screen_rect.h"
 #include "engine/video/text.h"
 #include "engine/video/texture_controller.h"
@@ -70,7 +72,9 @@ class ModeEngine;
 namespace vt_video {
 
 namespace gl {
+class InstancedParticleSystem;
 class ParticleSystem;
+struct ParticleInstance;
 class RenderTarget;
 class Shader;
 class ShaderProgram;
@@ -85,6 +89,25 @@ extern VideoEngine *VideoManager;
 //! \brief Determines whether the code in the vt_video namespace should print
 extern bool VIDEO_DEBUG;
 
+/** \brief Whether the game is rendered offscreen, with a hidden window.
+*** It uses the SDL offscreen video driver, unless another one is requested,
+*** so that the game runs on machines without a display.
+**/
+extern bool VIDEO_OFFSCREEN;
+
+//! \brief The rendering statistics of a frame.
+struct VideoFrameStatistics {
+    VideoFrameStatistics():
+        draw_calls(0),
+        texture_binds(0)
+    {}
+
+    //! \brief The sprites and particle systems drawn.
+    uint32_t draw_calls;
+
+    uint32_t texture_binds;
+};
+
 /** \brief Rotates a point (x,y) around the origin (0,0), by angle radians
 *** \param x x coordinate of point to rotate
 *** \param y y coordinate of point to rotate
@@ -245,6 +268,17 @@ public:
         return _vsync_mode;
     }
 
+    //! \brief Sets the maximum number of frames rendered per second.
+    //! \param frame_rate_limit 0: Unlocked, the frame rate is then only limited by VSync.
+    void SetFrameRateLimit(uint32_t frame_rate_limit) {
+        _frame_rate_limit = frame_rate_limit;
+    }
+
+    //! \brief Gets the maximum number of frames rendered per second, 0 if unlocked.
+    inline uint32_t GetFrameRateLimit() const {
+        return _frame_rate_limit;
+    }
+
     //! \brief Returns a reference to the current coordinate system
     const CoordSys& GetCoordSys() const {
         return _current_context.coordinate_system;
@@ -323,6 +357,16 @@ public:
     **/
     void DrawSecondaryRenderTarget();
 
+    /** \brief Binds a render target, the next draws being rendered into it.
+    *** \param render_target The render target, or nullptr to draw on screen again.
+    **/
+    void BindRenderTarget(gl::RenderTarget* render_target);
+
+    /** \brief Draws a screen sized render target onto the whole screen, replacing its content.
+    *** Used to draw again a frame rendered earlier, such as cached GUI renders.
+    **/
+    void DrawRenderTarget(gl::RenderTarget* render_target);
+
     //! \brief Loads a shader program.
     gl::ShaderProgram* LoadShaderProgram(const gl::shader_programs::ShaderPrograms& shader_program);
 
@@ -336,6 +380,24 @@ public:
                             float* vertex_colors,
                             unsigned number_of_vertices);
 
+    //! \brief Tells whether particle systems can be drawn using instancing.
+    bool IsParticleInstancingAvailable() const {
+        return _instanced_particle_system != nullptr;
+    }
+
+    /** \brief Draws a particle system using one instance per particle.
+    *** \param instances The particle instances, or nullptr to redraw the previously uploaded ones.
+    *** \param number_of_particles The number of particles to draw.
+    *** \param texture_rectangle The u1, v1, u2, v2 texture coordinates of the current frame.
+    *** \param color_scale A factor applied to every particle color.
+    *** \note Only valid when IsParticleInstancingAvailable() returns true.
+    **/
+    void DrawInstancedParticleSystem(gl::ShaderProgram* shader_program,
+                                     const gl::ParticleInstance* instances,
+                                     unsigned number_of_particles,
+                                     const float* texture_rectangle,
+                                     float color_scale);
+
     //! \brief Draws a sprite.
     void DrawSprite(gl::ShaderProgram* shader_program,
                     float* vertex_positions,
@@ -591,6 +653,21 @@ public:
     **/
     void MakeScreenshot(const std::string &filename = "screenshot.png");
 
+    /** \brief Computes a checksum of the pixels of the frame drawn, to compare frames between runs.
+    *** It must be called before SwapBuffers(), and waits for the render thread.
+    **/
+    uint32_t ComputeFrameChecksum();
+
+    //! \brief Returns the rendering statistics of the frame being drawn. They are reset by SwapBuffers().
+    const VideoFrameStatistics& GetFrameStatistics() const {
+        return _frame_statistics;
+    }
+
+    //! \brief Returns the render benchmark. \see RenderBenchmark
+    RenderBenchmark& GetRenderBenchmark() {
+        return _render_benchmark;
+    }
+
     /** \brief toggles debug information display.
     *** currently used for debugging game modes, and more especially the map mode.
      */
@@ -614,12 +691,79 @@ public:
         _fps_display = !_fps_display;
     }
 
+    /** \brief toggles the frame profiler overlay.
+    *** The frame profiler only records frames while its overlay is displayed.
+    **/
+    void ToggleProfiler();
+
     void SetWindowHandle(SDL_Window* window)
     { _sdl_window = window; }
 
     SDL_Window* GetWindowHandle()
     { return _sdl_window; }
 
+    //! \name Render thread methods
+    //@{
+    /** \brief Sets whether the render thread should be used. Only applied when starting it.
+    *** It is disabled by default, and enabled through the "render_thread" video setting.
+    **/
+    void SetRenderThreadEnabled(bool enabled) {
+        _render_thread_enabled = enabled;
+    }
+
+    bool IsRenderThreadEnabled() const {
+        return _render_thread_enabled;
+    }
+
+    /** \brief Starts the render thread, when enabled, handing the OpenGL context over to it.
+    *** \param context The OpenGL context of the window handle.
+    *** \return Whether the render thread is running.
+    *** \note The window handle must be set and the video settings applied before.
+    **/
+    bool StartRenderThread(SDL_GLContext context);
+
+    //! \brief Stops the render thread, giving the OpenGL context back to the calling thread.
+    void StopRenderThread();
+
+    //! \brief Tells whether the OpenGL commands are currently run by the render thread.
+    bool IsRenderThreadRunning() const {
+        return _render_thread != nullptr;
+    }
+
+    /** \brief Runs an OpenGL command on the thread owning the OpenGL context.
+    *** When the render thread is running, the command is recorded in the current command list
+    *** and run later on. It must thus capture the data it uses by value.
+    *** Otherwise, the command is run immediately.
+    **/
+    template <typename Command>
+    void SubmitGLCommand(Command command) {
+        if (_render_thread)
+            _render_thread->Record(RenderCommand(std::move(command)));
+        else
+            command();
+    }
+
+    /** \brief Runs an OpenGL command on the thread owning the OpenGL context, and waits for it.
+    *** This is a fence: every command recorded before is run first. Use it to read data back
+    *** from OpenGL. The command can then capture its data by reference.
+    **/
+    template <typename Command>
+    void RunGLCommand(Command command) {
+        if (_render_thread) {
+            _render_thread->Record(RenderCommand(std::move(command)));
+            _render_thread->Finish();
+        } else {
+            command();
+        }
+    }
+
+    /** \brief Presents the frame drawn.
+    *** When the render thread is running, the recorded frame is handed over to it,
+    *** and this only waits for the previous frame to be done.
+    **/
+    void SwapBuffers();
+    //@}
+
 private:
     VideoEngine();
 
@@ -640,9 +784,21 @@ private:
     //! The SDL2 Window handle
     SDL_Window* _sdl_window;
 
+    //! The render thread, or nullptr when the OpenGL commands are run by the game thread.
+    RenderThread* _render_thread;
+
+    //! Whether the render thread should be used.
+    bool _render_thread_enabled;
+
     //! The secondary render target.
     gl::RenderTarget* _secondary_render_target;
 
+    //! The rendering statistics of the frame being drawn.
+    VideoFrameStatistics _frame_statistics;
+
+    //! The render benchmark, running a scripted scene.
+    RenderBenchmark _render_benchmark;
+
     //! The FPS display flag.  If true, FPS is displayed.
     bool _fps_display;
 
@@ -667,6 +823,15 @@ private:
     //! The FPS text
     TextImage* _FPS_textimage;
 
+    //! The frame profiler overlay display flag.
+    bool _profiler_display;
+
+    //! The frame profiler zone statistics text.
+    TextImage* _profiler_textimage;
+
+    //! The number of frames drawn since the profiler text was last updated.
+    uint32_t _profiler_text_frames;
+
     //! \brief Holds the most recently fetched OpenGL error code
     GLenum _gl_error_code;
 
@@ -734,6 +899,9 @@ private:
     //! \brief Stores the current vsync mode.
     uint32_t _vsync_mode;
 
+    //! \brief Stores the maximum number of frames rendered per second, 0 if unlocked.
+    uint32_t _frame_rate_limit;
+
     //! \brief The game main loop update mode.
     //! \note update_mode true for performance, false for the CPU-gentle loop.
     //! It is always on performance when VSync is enabled.
@@ -757,6 +925,10 @@ private:
     //! The OpenGL buffers and objects to draw a particle system.
     gl::ParticleSystem* _particle_system;
 
+    //! The OpenGL buffers and objects to draw an instanced particle system.
+    //! nullptr when instancing isn't supported by the OpenGL context.
+    gl::InstancedParticleSystem* _instanced_particle_system;
+
     //! The OpenGL shaders.
     std::map<gl::shaders::Shaders, gl::Shader*> _shaders;
 
@@ -784,12 +956,31 @@ private:
     //! \note it also centers the viewport when the resolution isn't a 4:3 one.
     void _UpdateViewportMetrics();
 
+    //! \brief Draws a render target onto the whole screen, blended or not.
+    void _DrawFullscreenRenderTarget(gl::RenderTarget* render_target, bool blend);
+
+    //! \brief Draws a particle system with the given matrices. Must be run on the thread owning the OpenGL context.
+    void _DrawParticleSystem(gl::ParticleSystem* particle_system,
+                             gl::ShaderProgram* shader_program,
+                             const float* model,
+                             const float* projection,
+                             float* vertex_positions,
+                             float* vertex_texture_coordinates,
+                             float* vertex_colors,
+                             unsigned number_of_vertices);
+
     // Debug info
     //! \brief Updates the FPS counter.
     void _UpdateFPS();
 
     //! \brief Draws the current average FPS to the screen.
     void _DrawFPS();
+
+    //! \brief Updates the frame profiler zone statistics text.
+    void _UpdateProfilerText();
+
+    //! \brief Draws the frame times graph, the last frame zones and their statistics.
+    void _DrawProfiler();
 };
 
 } // namespace vt_video
@@ -38,6 +38,10 @@ const float VIDEO_VIEWPORT_HEIGHT = 600.0f;
 //! \brief The number of FPS samples to retain across frames
 const uint32_t FPS_SAMPLES = 250;
 
+//! \brief The default maximum number of frames rendered per second.
+//! 10 is a smoothness safety margin above the 60 game logic updates per second.
+const uint32_t VIDEO_DEFAULT_FRAME_RATE_LIMIT = 60 + 10;
+
 //! \brief Draw flags to control x and y alignment, flipping, and texture blending.
 enum VIDEO_DRAW_FLAGS {
     VIDEO_DRAW_FLAGS_INVALID = -1,
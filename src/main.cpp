@@ -16,15 +16,17 @@
 ***
 *** The code in this file is the first to execute when the game is started and
 *** the last to execute before the game exits. The core engine
-*** uses time-based updating, which means that the state of the game is
-*** updated based on how much time has expired since the last update.
+*** uses fixed-step updating, which means that the state of the game is
+*** always updated by the same amount of time, as many times as needed to
+*** keep up with the real time, independently from the frame rate.
 ***
 *** The main game loop consists of the following steps.
 ***
+*** -# Accumulate the real time expired since the last frame.
+*** -# For each fixed step accumulated, update the timers, collect information
+***    on new user input events and update the game status.
 *** -# Render the newly drawn frame to the screen.
-*** -# Collect information on new user input events.
-*** -# Update the main loop timer.
-*** -# Update the game status based on how much time expired from the last update.
+*** -# Wait for the next frame when a frame rate limit is set.
 *** ***************************************************************************/
 
 #include "engine/audio/audio.h"
@@ -163,6 +165,10 @@ static bool LoadSettings()
     VideoManager->SetFullscreen(settings.ReadBool("full_screen"));
     if (settings.DoesUIntExist("vsync_mode"))
         VideoManager->SetVSyncMode(settings.ReadUInt("vsync_mode"));
+    if (settings.DoesUIntExist("frame_rate_limit"))
+        VideoManager->SetFrameRateLimit(settings.ReadUInt("frame_rate_limit"));
+    if (settings.DoesBoolExist("render_thread"))
+        VideoManager->SetRenderThreadEnabled(settings.ReadBool("render_thread"));
     GUIManager->SetUserMenuSkin(settings.ReadString("ui_theme"));
     settings.CloseTable(); // video_settings
 
@@ -198,6 +204,9 @@ static bool LoadSettings()
         if (settings.DoesBoolExist("battle_target_cursor_memory"))
             SystemManager->SetBattleTargetMemory(settings.ReadBool("battle_target_cursor_memory"));
 
+        if (settings.DoesBoolExist("binary_save_games"))
+            SystemManager->SetBinarySaveGames(settings.ReadBool("binary_save_games"));
+
         settings.CloseTable(); // game_options
     }
 
@@ -455,40 +464,48 @@ void RenderFrame()
     VideoManager->DrawDebugInfo();
 }
 
-//! \brief Update the engine logic with the provided new absolute tick time.
-void UpdateEngine(uint32_t update_tick)
+//! \brief Update the engine logic by one fixed logic step.
+void UpdateEngine()
 {
-    //uint32_t update_begin_tick = update_tick;
-
     // Update timers for correct time-based movement operation
-    SystemManager->UpdateTimers(update_tick);
-
-    //std::cout << "Update timers delay: " << SDL_GetTicks() - update_tick << "ms" << std::endl;
-    //update_tick = SDL_GetTicks();
+    SystemManager->UpdateTimers();
 
     // Process all new events
     InputManager->EventHandler();
 
-    //std::cout << "Update events delay: " << SDL_GetTicks() - update_tick << "ms" << std::endl;
-    //update_tick = SDL_GetTicks();
-
     // Update video
     VideoManager->Update();
 
-    //std::cout << "Update video delay: " << SDL_GetTicks() - update_tick << "ms" << std::endl;
-    //update_tick = SDL_GetTicks();
-
     // Update any streaming audio sources
     AudioManager->Update();
 
-    //std::cout << "Update audio delay: " << SDL_GetTicks() - update_tick << "ms" << std::endl;
-    //update_tick = SDL_GetTicks();
-
     // Update the game status
     ModeManager->Update();
 
-    //std::cout << "Update events delay: " << SDL_GetTicks() - update_tick << "ms" << std::endl;
-    //std::cout << "Update total delay: " << SDL_GetTicks() - update_begin_tick << "ms" << std::endl;
+    // The press events have been handled by this update.
+    InputManager->ClearPressEvents();
+}
+
+/** \brief Waits until the given high resolution counter value is reached.
+*** Sleeps while there is enough time left to not oversleep,
+*** and yields the remaining time to reach the target precisely.
+**/
+void WaitUntilCounter(uint64_t target_counter)
+{
+    const uint64_t counter_frequency = SDL_GetPerformanceFrequency();
+    // SDL_Delay() can oversleep by up to the OS scheduler granularity.
+    const uint64_t sleep_margin = counter_frequency * 2 / 1000;
+
+    uint64_t current_counter = SDL_GetPerformanceCounter();
+    while (current_counter < target_counter) {
+        uint64_t remaining = target_counter - current_counter;
+        if (remaining > sleep_margin)
+            SDL_Delay(static_cast<uint32_t>((remaining - sleep_margin) * 1000 / counter_frequency));
+        else
+            SDL_Delay(0);
+
+        current_counter = SDL_GetPerformanceCounter();
+    }
 }
 
 // Every great game begins with a single function :)
@@ -506,6 +523,23 @@ int main(int argc, char* argv[])
     // When the program exits, call 'SDL_Quit'.
     atexit(SDL_Quit);
 
+    // The offscreen rendering must be known before initializing the video,
+    // while the other options are parsed once in the game data directory.
+    for(int i = 1; i < argc; ++i) {
+        if(std::string(argv[i]) == "--offscreen")
+            vt_video::VIDEO_OFFSCREEN = true;
+    }
+
+    // Render without any display, unless another video driver is requested.
+    if(vt_video::VIDEO_OFFSCREEN) {
+#ifndef _WIN32
+        setenv("SDL_VIDEODRIVER", "offscreen", 0);
+#else
+        if(GetEnvironmentVariable("SDL_VIDEODRIVER", nullptr, 0) == 0)
+            SetEnvironmentVariable("SDL_VIDEODRIVER", "offscreen");
+#endif
+    }
+
     if(SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
         PRINT_ERROR << "SDL video initialization failed" << std::endl;
         return EXIT_FAILURE;
@@ -517,7 +551,7 @@ int main(int argc, char* argv[])
                          SDL_WINDOWPOS_CENTERED,
                          vt_video::VIDEO_VIEWPORT_WIDTH,
                          vt_video::VIDEO_VIEWPORT_HEIGHT,
-                         SDL_WINDOW_OPENGL);
+                         vt_video::VIDEO_OFFSCREEN ? SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN : SDL_WINDOW_OPENGL);
     if (!sdl_window) {
         PRINT_ERROR << "SDL window creation failed: "
                     << SDL_GetError() << std::endl;
@@ -582,6 +616,10 @@ int main(int argc, char* argv[])
         // Function call below throws exceptions if any errors occur
         InitializeEngine();
 
+        // Start the input recording or replay, if any, once the input engine exists.
+        if(!vt_main::StartInputReplay())
+            return EXIT_FAILURE;
+
     } catch(const Exception &e) {
 #ifdef WIN32
         MessageBox(nullptr, e.ToString().c_str(), "Unhandled exception",
@@ -596,47 +634,104 @@ int main(int argc, char* argv[])
     VideoManager->SetWindowHandle(sdl_window);
     VideoManager->ApplySettings();
 
+    // Hand the OpenGL context over to the render thread, when enabled.
+    // From now on, the OpenGL calls are recorded and run there.
+    VideoManager->StartRenderThread(glcontext);
+
     // Now the settings are loaded, let's set the windows translated title.
     // tr: The window title only supports UTF-8 characters in SDL2.
     std::string app_fullname = vt_system::Translate("Valyria Tear");
     SDL_SetWindowTitle(sdl_window, app_fullname.c_str());
-    SDL_ShowWindow(sdl_window);
+    if(!vt_video::VIDEO_OFFSCREEN)
+        SDL_ShowWindow(sdl_window);
+
+    // The battle simulation workers play their battles right away, and exit the game.
+    bool benchmark_succeeded = vt_main::RunBattleSimulationWorker();
+    if(SystemManager->NotDone())
+        ModeManager->Push(new BootMode(), false, true);
+
+    // The render benchmark script pushes the game mode to render over the boot menu.
+    if(!vt_main::StartRenderBenchmark()) {
+        benchmark_succeeded = false;
+        SystemManager->ExitGame();
+    }
+
+    // The save benchmark runs right away, and exits the game.
+    if(!vt_main::RunSaveBenchmark())
+        benchmark_succeeded = false;
 
-    ModeManager->Push(new BootMode(), false, true);
+    // The game logic is updated at a fixed rate, while frames are rendered
+    // as fast as the frame rate limit and the VSync allow.
+    SystemManager->InitializeUpdateTimer();
 
-    // Used for a variable game speed,
-    // sleeping when on sufficiently fast hardware, and max FPS.
-    const uint32_t UPDATES_PER_SECOND = 60 + 10; // 10 is a smoothness safety margin (gives a max of 70 FPS)
-    const uint32_t SKIP_RENDER_TICKS = 1000 / UPDATES_PER_SECOND;
-    uint32_t render_tick = SDL_GetTicks();
-    uint32_t next_render_tick = 0;
+    const bool replaying_input = (InputManager->GetReplay().GetMode() == vt_input::INPUT_REPLAY_REPLAYING);
+    vt_video::RenderBenchmark& render_benchmark = VideoManager->GetRenderBenchmark();
+    const bool benchmarking_render = render_benchmark.IsRunning();
 
     try {
         // This is the main loop for the game.
         // The loop iterates once for every frame drawn to the screen.
         while (SystemManager->NotDone()) {
+            uint64_t frame_start_counter = SDL_GetPerformanceCounter();
+            SystemManager->GetProfiler().BeginFrame();
 
-            // Render part
-            render_tick = SDL_GetTicks();
+            // Let the render benchmark script move the scene.
+            if (benchmarking_render)
+                render_benchmark.UpdateFrame();
 
-            // We want to be nice with the CPU % used..
-            // And set fixed rendering updates
-            if (render_tick < next_render_tick) {
-                SDL_Delay(next_render_tick - render_tick);
-                continue;
+            // Poll the input on every frame, even when no logic update is due.
+            InputManager->PollEvents();
+
+            // Update part
+            uint32_t updates = SystemManager->AccumulateFrameTime();
+            for (uint32_t i = 0; i < updates && SystemManager->NotDone(); ++i) {
+                ProfilerZone zone("Update");
+                UpdateEngine();
             }
 
-            UpdateEngine(render_tick);
+            // The game quits once the whole recording was replayed.
+            if (replaying_input && InputManager->GetReplay().IsReplayFinished())
+                SystemManager->ExitGame();
 
-            RenderFrame();
+            // Render part
+            {
+                ProfilerZone zone("Render");
+                render_benchmark.BeginFrame();
+                RenderFrame();
+                render_benchmark.EndFrame();
+            }
 
             // Swap the buffers once the draw operations are done.
-            SDL_GL_SwapWindow(sdl_window);
+            // With the render thread, this hands the recorded frame over to it instead.
+            {
+                ProfilerZone zone("SwapWindow");
+                VideoManager->SwapBuffers();
+            }
 
-            next_render_tick = SDL_GetTicks() + SKIP_RENDER_TICKS;
+            SystemManager->GetProfiler().EndFrame();
+
+            // The replays and render benchmarks are run as fast as possible, and their frame times reported.
+            if (replaying_input) {
+                uint64_t frame_counter = SDL_GetPerformanceCounter() - frame_start_counter;
+                vt_main::AddReplayFrameTime(static_cast<float>(frame_counter * 1000.0 / SDL_GetPerformanceFrequency()));
+                continue;
+            }
+            if (benchmarking_render) {
+                uint64_t frame_counter = SDL_GetPerformanceCounter() - frame_start_counter;
+                render_benchmark.AddFrameTime(static_cast<float>(frame_counter * 1000.0 / SDL_GetPerformanceFrequency()));
+                if (render_benchmark.IsFinished())
+                    SystemManager->ExitGame();
+                continue;
+            }
+
+            // We want to be nice with the CPU % used..
+            uint32_t frame_rate_limit = VideoManager->GetFrameRateLimit();
+            if (frame_rate_limit > 0)
+                WaitUntilCounter(frame_start_counter + SDL_GetPerformanceFrequency() / frame_rate_limit);
 
         } // while (SystemManager->NotDone())
     } catch(const Exception& e) {
+        VideoManager->StopRenderThread();
 #ifdef WIN32
         MessageBox(nullptr, e.ToString().c_str(), "Unhandled exception",
                    MB_OK | MB_ICONERROR);
@@ -646,6 +741,16 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    // Get the OpenGL context back before freeing the resources.
+    VideoManager->StopRenderThread();
+
+    // Write the end of the input recording, or report the replay frame times.
+    bool replay_succeeded = vt_main::FinishInputReplay();
+
+    // Report the render benchmark results.
+    if(!vt_main::FinishRenderBenchmark())
+        benchmark_succeeded = false;
+
     DeinitializeEngine();
 
     // Once finished with OpenGL functions, the SDL_GLContext can be deleted.
@@ -654,5 +759,5 @@ int main(int argc, char* argv[])
     // Close and destroy the window.
     SDL_DestroyWindow(sdl_window);
 
-    return EXIT_SUCCESS;
+    return (replay_succeeded && benchmark_succeeded) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
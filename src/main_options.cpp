@@ -18,6 +18,7 @@
 #include "main_options.h"
 
 #include "engine/audio/audio.h"
+#include "engine/script_cache.h"
 #include "engine/video/video.h"
 #include "script/script_write.h"
 #include "engine/input.h"
@@ -29,9 +30,21 @@
 #include "common/app_name.h"
 #include "common/app_settings.h"
 #include "common/global/global.h"
+#include "common/global/save/save_game_binary.h"
+#include "common/global/save/save_game_data.h"
+#include "common/global/save/save_game_header.h"
 
+#include "modes/battle/battle_simulator.h"
+
+#include <SDL2/SDL_filesystem.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+
 namespace vt_battle {
 extern bool BATTLE_DEBUG;
 }
@@ -57,6 +70,29 @@ using namespace vt_common;
 namespace vt_main
 {
 
+//! \brief The input recording or replay file given on the command line, if any.
+static std::string _input_record_filename;
+static std::string _input_replay_filename;
+
+//! \brief The 95th percentile frame time the replays must not exceed, in milliseconds. 0 for no limit.
+static float _max_replay_frame_time = 0.0f;
+
+//! \brief The duration of each replayed frame, in milliseconds.
+static std::vector<float> _replay_frame_times;
+
+//! \brief The render benchmark script given on the command line, if any, and its number of frames.
+static std::string _render_benchmark_filename;
+static uint32_t _render_benchmark_frames = 0;
+
+//! \brief The save game to benchmark given on the command line, if any.
+static std::string _save_benchmark_filename;
+
+//! \brief The battle simulation played by this worker process, if any. \see RunBattleSimulationWorker()
+static std::string _simulation_worker_filename;
+static uint32_t _simulation_worker_index = 0;
+static uint32_t _simulation_worker_count = 0;
+static std::string _simulation_worker_results_filename;
+
 bool ParseProgramOptions(int32_t &return_code, int32_t argc, char* argv[])
 {
     // Convert the argument list to a vector of strings for convenience
@@ -78,6 +114,8 @@ bool ParseProgramOptions(int32_t &return_code, int32_t argc, char* argv[])
             i++;
         } else if(options[i] == "--disable-audio") {
             vt_audio::AUDIO_ENABLE = false;
+        } else if(options[i] == "--offscreen") {
+            vt_video::VIDEO_OFFSCREEN = true;
         } else if(options[i] == "-h" || options[i] == "--help") {
             PrintUsage();
             return_code = 0;
@@ -97,6 +135,109 @@ bool ParseProgramOptions(int32_t &return_code, int32_t argc, char* argv[])
             }
             return_code = 0;
             return false;
+        } else if(options[i] == "--build-script-cache") {
+            if(BuildScriptCache()) {
+                return_code = 0;
+            } else {
+                return_code = 1;
+            }
+            return false;
+        } else if(options[i] == "--convert-save") {
+            if((i + 2) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires two arguments." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            if(ConvertSaveGame(options[i + 1], options[i + 2])) {
+                return_code = 0;
+            } else {
+                return_code = 1;
+            }
+            return false;
+        } else if(options[i] == "--benchmark-save") {
+            if((i + 1) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires an argument." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            // The save game is loaded and written once the engine is initialized.
+            _save_benchmark_filename = options[i + 1];
+            i++;
+        } else if(options[i] == "--simulate-battles") {
+            if((i + 1) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires an argument." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            if(SimulateBattles(options[i + 1], options[0])) {
+                return_code = 0;
+            } else {
+                return_code = 1;
+            }
+            return false;
+        } else if(options[i] == "--simulation-worker") {
+            // Internal option, given by --simulate-battles to its worker processes.
+            if((i + 4) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires four arguments." << std::endl;
+                return_code = 1;
+                return false;
+            }
+            // The battles are played once the engine is initialized.
+            _simulation_worker_filename = options[i + 1];
+            _simulation_worker_index = static_cast<uint32_t>(atoi(options[i + 2].c_str()));
+            _simulation_worker_count = static_cast<uint32_t>(atoi(options[i + 3].c_str()));
+            _simulation_worker_results_filename = options[i + 4];
+            if(_simulation_worker_count == 0) {
+                std::cerr << "The battle simulation requires at least one worker." << std::endl;
+                return_code = 1;
+                return false;
+            }
+            i += 4;
+        } else if(options[i] == "--record-input" || options[i] == "--replay-input") {
+            if((i + 1) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires an argument." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            if(options[i] == "--record-input")
+                _input_record_filename = options[i + 1];
+            else
+                _input_replay_filename = options[i + 1];
+
+            if(!_input_record_filename.empty() && !_input_replay_filename.empty()) {
+                std::cerr << "The input can't be recorded and replayed at the same time." << std::endl;
+                return_code = 1;
+                return false;
+            }
+            i++;
+        } else if(options[i] == "--max-frame-time") {
+            if((i + 1) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires an argument." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            _max_replay_frame_time = static_cast<float>(atof(options[i + 1].c_str()));
+            i++;
+        } else if(options[i] == "--benchmark-render") {
+            if((i + 2) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires two arguments." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            _render_benchmark_filename = options[i + 1];
+            _render_benchmark_frames = static_cast<uint32_t>(atoi(options[i + 2].c_str()));
+            if(_render_benchmark_frames == 0) {
+                std::cerr << "The render benchmark requires at least one frame." << std::endl;
+                return_code = 1;
+                return false;
+            }
+            i += 2;
         } else {
             std::cerr << "Unrecognized option: " << options[i] << std::endl;
             PrintUsage();
@@ -145,6 +286,14 @@ void PrintUsage()
 {
     std::cout
             << "usage: " APPSHORTNAME " [options]" << std::endl
+            << "  --benchmark-render <file> <frames> :: renders the given number of frames of" << std::endl
+            << "                       the scene set up by the given script, then prints the" << std::endl
+            << "                       rendering statistics" << std::endl
+            << "  --benchmark-save <file> :: loads the given save game, then compares the Lua" << std::endl
+            << "                       and binary saving and loading times of the game" << std::endl
+            << "  --build-script-cache :: compiles the game data scripts ahead of time" << std::endl
+            << "  --convert-save <input> <output> :: converts a save game from Lua to binary," << std::endl
+            << "                       or from binary to Lua" << std::endl
             << "  --debug/-d <args> :: enables debug statements in specified sections of the" << std::endl
             << "                       program, where <args> can be:" << std::endl
             << "                       all, audio, battle, boot, data, global, input," << std::endl
@@ -153,7 +302,15 @@ void PrintUsage()
             << "  --disable-audio   :: disables loading and playing audio" << std::endl
             << "  --help/-h         :: prints this help menu" << std::endl
             << "  --info/-i         :: prints information about the user's system" << std::endl
-            << "  --reset/-r        :: resets game configuration to use default settings" << std::endl;
+            << "  --max-frame-time <ms> :: makes the replays fail when the 95th percentile" << std::endl
+            << "                       frame time exceeds the given one" << std::endl
+            << "  --offscreen       :: renders the game offscreen, without showing any window" << std::endl
+            << "  --record-input <file> :: records the input of the game played to the given file" << std::endl
+            << "  --replay-input <file> :: replays a recorded input unattended, then prints the" << std::endl
+            << "                       frame times" << std::endl
+            << "  --reset/-r        :: resets game configuration to use default settings" << std::endl
+            << "  --simulate-battles <file> :: plays the battles described in the given file" << std::endl
+            << "                       headlessly, then prints their results" << std::endl;
 }
 
 bool PrintSystemInformation()
@@ -299,6 +456,301 @@ bool ResetSettings()
     return false;
 } // bool ResetSettings()
 
+bool BuildScriptCache()
+{
+    // Makes sure the user data folder exists.
+    if(GetUserDataPath().empty())
+        return false;
+
+    uint32_t number_compiled = vt_script::BuildScriptCache("data");
+    std::cout << "Compiled " << number_compiled << " script file(s) into the script cache." << std::endl;
+
+    return true;
+} // bool BuildScriptCache()
+
+bool ConvertSaveGame(const std::string& input_filename, const std::string& output_filename)
+{
+    std::ifstream input(input_filename.c_str(), std::ios::in | std::ios::binary);
+    if(!input.is_open()) {
+        std::cerr << "Couldn't open the save game: " << input_filename << std::endl;
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+
+    vt_global::SaveGameNode root;
+    std::string converted;
+    if(vt_global::IsBinarySaveGame(data)) {
+        if(!vt_global::ReadBinarySaveGame(data, root)) {
+            std::cerr << "Invalid binary save game: " << input_filename << std::endl;
+            return false;
+        }
+        vt_global::WriteLuaSaveGame(root, converted);
+    } else {
+        if(!vt_global::ReadLuaSaveGame(data, input_filename, root)) {
+            std::cerr << "Invalid Lua save game: " << input_filename << std::endl;
+            return false;
+        }
+        vt_global::WriteBinarySaveGame(root, converted);
+    }
+
+    std::ofstream output(output_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!output.is_open()) {
+        std::cerr << "Couldn't write the save game: " << output_filename << std::endl;
+        return false;
+    }
+    output.write(converted.data(), converted.size());
+    output.close();
+    if(!output) {
+        std::cerr << "Couldn't write the save game: " << output_filename << std::endl;
+        return false;
+    }
+
+    std::cout << "Converted " << input_filename << " (" << data.size() << " bytes) to "
+              << output_filename << " (" << converted.size() << " bytes)." << std::endl;
+    return true;
+} // bool ConvertSaveGame(const std::string& input_filename, const std::string& output_filename)
+
+//! \brief Returns the size of a file in bytes, or 0 if it can't be opened.
+static uint64_t _GetFileSize(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+        return 0;
+    return static_cast<uint64_t>(file.tellg());
+}
+
+//! \brief Saves and loads the current game in one format, and prints the average times.
+static bool _BenchmarkSaveFormat(const std::string& filename, bool binary)
+{
+    const uint32_t iterations = 20;
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    vt_global::GameGlobal* global = vt_global::GlobalManager;
+    vt_system::SystemManager->SetBinarySaveGames(binary);
+
+    // The time spent on the game thread building the save, and the time
+    // until the save file and its header are on the disk.
+    uint64_t game_thread_counter = 0;
+    uint64_t total_counter = 0;
+    for(uint32_t i = 0; i < iterations; ++i) {
+        const uint64_t start = SDL_GetPerformanceCounter();
+        if(!global->SaveGame(filename, 0, global->GetMapData().GetSaveLocationX(),
+                             global->GetMapData().GetSaveLocationY())) {
+            std::cerr << "Couldn't save the game: " << filename << std::endl;
+            return false;
+        }
+        game_thread_counter += SDL_GetPerformanceCounter() - start;
+
+        global->WaitForSaves();
+        total_counter += SDL_GetPerformanceCounter() - start;
+        if(!global->HasLastSaveSucceeded()) {
+            std::cerr << "Couldn't write the save game: " << filename << std::endl;
+            return false;
+        }
+    }
+
+    // The game is loaded back the same way as from the save menu.
+    uint64_t load_counter = 0;
+    for(uint32_t i = 0; i < iterations; ++i) {
+        const uint64_t start = SDL_GetPerformanceCounter();
+        if(!global->LoadGame(filename, 0)) {
+            std::cerr << "Couldn't load the save game: " << filename << std::endl;
+            return false;
+        }
+        load_counter += SDL_GetPerformanceCounter() - start;
+    }
+
+    std::cout << (binary ? "  Binary: " : "  Lua:    ") << _GetFileSize(filename) << " bytes, saved in "
+              << game_thread_counter * 1000.0 / frequency / iterations << " ms on the game thread ("
+              << total_counter * 1000.0 / frequency / iterations << " ms until written), loaded in "
+              << load_counter * 1000.0 / frequency / iterations << " ms" << std::endl;
+    return true;
+}
+
+bool RunSaveBenchmark()
+{
+    if(_save_benchmark_filename.empty())
+        return true;
+
+    vt_global::GameGlobal* global = vt_global::GlobalManager;
+    if(!global->LoadGame(_save_benchmark_filename, 0)) {
+        std::cerr << "Couldn't load the save game: " << _save_benchmark_filename << std::endl;
+        vt_system::SystemManager->ExitGame();
+        return false;
+    }
+
+    // The benchmark saves are written next to the given one, and removed afterwards.
+    const std::string filename = _save_benchmark_filename + ".benchmark";
+    const bool binary_save_games = vt_system::SystemManager->GetBinarySaveGames();
+
+    std::cout << "Save game: " << _save_benchmark_filename << std::endl;
+    bool succeeded = _BenchmarkSaveFormat(filename, false);
+    succeeded = succeeded && _BenchmarkSaveFormat(filename, true);
+
+    vt_system::SystemManager->SetBinarySaveGames(binary_save_games);
+    remove(filename.c_str());
+    remove(vt_global::SaveGameHeader::GetHeaderFilename(filename).c_str());
+
+    vt_system::SystemManager->ExitGame();
+    return succeeded;
+} // bool RunSaveBenchmark()
+
+bool SimulateBattles(const std::string& filename, const std::string& program_name)
+{
+    vt_battle::BattleSimulationSettings settings;
+    if(!vt_battle::BattleSimulator::LoadSettings(filename, settings)) {
+        std::cerr << "Couldn't load the battle simulation: " << filename << std::endl;
+        return false;
+    }
+
+    // The workers are started from the game executable, whatever the current directory.
+    std::string program_filename = program_name;
+    char* base_path = SDL_GetBasePath();
+    if(base_path) {
+        size_t separator = program_name.find_last_of("/\\");
+        program_filename = std::string(base_path) +
+                           (separator == std::string::npos ? program_name : program_name.substr(separator + 1));
+        SDL_free(base_path);
+    }
+
+    vt_battle::BattleSimulator simulator(settings);
+    bool succeeded = simulator.Run(program_filename, filename);
+    simulator.PrintResults();
+    return succeeded;
+}
+
+bool RunBattleSimulationWorker()
+{
+    if(_simulation_worker_filename.empty())
+        return true;
+
+    vt_battle::BattleSimulationSettings settings;
+    bool succeeded = vt_battle::BattleSimulator::LoadSettings(_simulation_worker_filename, settings);
+    if(succeeded) {
+        vt_battle::BattleSimulator simulator(settings);
+        succeeded = simulator.RunWorker(_simulation_worker_index, _simulation_worker_count,
+                                        _simulation_worker_results_filename);
+    }
+
+    vt_system::SystemManager->ExitGame();
+    return succeeded;
+}
+
+bool StartInputReplay()
+{
+    vt_input::InputReplay& replay = vt_input::InputManager->GetReplay();
+
+    if(!_input_record_filename.empty()) {
+        // The replays use the same random numbers as the recorded game.
+        uint32_t random_seed = static_cast<uint32_t>(time(nullptr));
+        if(!replay.StartRecording(_input_record_filename, random_seed))
+            return false;
+        srand(random_seed);
+    } else if(!_input_replay_filename.empty()) {
+        if(!replay.StartReplay(_input_replay_filename))
+            return false;
+        srand(replay.GetRandomSeed());
+
+        // Each frame runs one update, so that the game logic doesn't depend on the frame times measured.
+        vt_system::SystemManager->SetFixedFrameStep(true);
+        vt_system::SystemManager->GetProfiler().SetEnabled(true);
+        _replay_frame_times.clear();
+    }
+    return true;
+}
+
+void AddReplayFrameTime(float milliseconds)
+{
+    _replay_frame_times.push_back(milliseconds);
+}
+
+bool FinishInputReplay()
+{
+    vt_input::InputReplay& replay = vt_input::InputManager->GetReplay();
+    if(replay.GetMode() != vt_input::INPUT_REPLAY_REPLAYING) {
+        replay.Stop();
+        return true;
+    }
+
+    bool replay_finished = replay.IsReplayFinished();
+    replay.Stop();
+
+    if(!replay_finished) {
+        std::cerr << "The input replay was interrupted." << std::endl;
+        return false;
+    }
+    if(_replay_frame_times.empty())
+        return true;
+
+    std::vector<float> frame_times = _replay_frame_times;
+    std::sort(frame_times.begin(), frame_times.end());
+
+    float total_time = 0.0f;
+    for(uint32_t i = 0; i < frame_times.size(); ++i)
+        total_time += frame_times[i];
+
+    const float average_time = total_time / frame_times.size();
+    const float median_time = frame_times[frame_times.size() / 2];
+    const float p95_time = frame_times[(frame_times.size() * 95) / 100];
+    const float max_time = frame_times.back();
+
+    std::cout << "Input replay: " << _input_replay_filename << std::endl
+              << "  Frames:  " << frame_times.size() << std::endl
+              << "  Average: " << average_time << " ms" << std::endl
+              << "  Median:  " << median_time << " ms" << std::endl
+              << "  95th percentile: " << p95_time << " ms" << std::endl
+              << "  Maximum: " << max_time << " ms" << std::endl;
+
+    if(_max_replay_frame_time > 0.0f && p95_time > _max_replay_frame_time) {
+        std::cerr << "The 95th percentile frame time exceeds " << _max_replay_frame_time << " ms." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool StartRenderBenchmark()
+{
+    if(_render_benchmark_filename.empty())
+        return true;
+
+    if(vt_input::InputManager->GetReplay().GetMode() != vt_input::INPUT_REPLAY_NONE) {
+        std::cerr << "The render benchmark can't be run while recording or replaying the input." << std::endl;
+        return false;
+    }
+
+    // Each frame runs one update with the same random numbers, so that the frames rendered
+    // and their checksum only depend on the benchmark script.
+    srand(1);
+    vt_system::SystemManager->SetFixedFrameStep(true);
+
+    // The frames are rendered as fast as possible.
+    vt_video::VideoManager->SetVSyncMode(0);
+    vt_video::VideoManager->ApplySettings();
+
+    if(!vt_video::VideoManager->GetRenderBenchmark().Start(_render_benchmark_filename, _render_benchmark_frames)) {
+        std::cerr << "Couldn't start the render benchmark: " << _render_benchmark_filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool FinishRenderBenchmark()
+{
+    vt_video::RenderBenchmark& benchmark = vt_video::VideoManager->GetRenderBenchmark();
+    if(!benchmark.IsRunning())
+        return true;
+
+    bool benchmark_finished = benchmark.IsFinished();
+    benchmark.Stop();
+    benchmark.PrintResults();
+
+    if(!benchmark_finished) {
+        std::cerr << "The render benchmark was interrupted." << std::endl;
+        return false;
+    }
+    return true;
+}
+
 bool EnableDebugging(const std::string &vars)
 {
     // A vector of all the debug arguments
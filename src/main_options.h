@@ -56,6 +56,66 @@ bool PrintSystemInformation();
 **/
 bool ResetSettings();
 
+/** \brief Compiles the game data scripts into the script cache, so that the first run doesn't have to.
+*** \return False if the script cache could not be created.
+**/
+bool BuildScriptCache();
+
+/** \brief Converts a save game to the other format: Lua saves to binary, and binary saves to Lua.
+*** \return False if the input save game couldn't be read, or the output file written.
+**/
+bool ConvertSaveGame(const std::string& input_filename, const std::string& output_filename);
+
+
+/** \brief Plays the battles described in a simulation file headlessly, and prints their results.
+*** The battles are played by worker processes of the game, started with the --simulation-worker option.
+*** \param filename The simulation file.
+*** \param program_name The game executable name, as given on the command line.
+*** \return False if the simulation file couldn't be read, or a worker failed.
+*** \see vt_battle::BattleSimulator
+**/
+bool SimulateBattles(const std::string& filename, const std::string& program_name);
+
+/** \brief Plays the battles of the simulation worker given on the command line, if any, and exits the game.
+*** It must be called once the engine is initialized, before any game mode is pushed.
+*** \return False if the battles couldn't be set up, or their results written.
+**/
+bool RunBattleSimulationWorker();
+
+/** \brief Starts the input recording or replay given on the command line, if any.
+*** It must be called once the engine is initialized, and seeds the random number generator.
+*** \return False if the recording couldn't be started.
+**/
+bool StartInputReplay();
+
+//! \brief Adds the duration of a replayed frame to the replay statistics, in milliseconds.
+void AddReplayFrameTime(float milliseconds);
+
+/** \brief Ends the input recording or replay, and prints the replayed frame times.
+*** \return False if the replay was interrupted, or its 95th percentile frame time exceeds the --max-frame-time option.
+**/
+bool FinishInputReplay();
+
+/** \brief Starts the render benchmark given on the command line, if any.
+*** It must be called once the engine is initialized, and seeds the random number generator.
+*** \return False if the benchmark script couldn't be loaded.
+*** \see vt_video::RenderBenchmark
+**/
+bool StartRenderBenchmark();
+
+/** \brief Ends the render benchmark, and prints its results.
+*** \return False if the benchmark was interrupted before rendering all its frames.
+**/
+bool FinishRenderBenchmark();
+
+/** \brief Runs the save game benchmark given on the command line, if any, and exits the game.
+*** The save game is loaded, then the game is saved and loaded again through
+*** GameGlobal::SaveGame() and GameGlobal::LoadGame(), in the Lua and binary formats.
+*** It must be called once the engine is initialized.
+*** \return False if the save game couldn't be loaded, saved or loaded again.
+**/
+bool RunSaveBenchmark();
+
 /** \brief Enables debugging print statements in various parts of the game engine.
 *** \param vars The name(s) of the debugging variable(s) to enable.
 *** \return False if a bad function argument was given, or true on success.
@@ -12,6 +12,7 @@
 
 #include "common/global/objects/global_item.h"
 #include "engine/system.h"
+#include "engine/script_profiler.h"
 
 #include "utils/ustring.h"
 
@@ -103,6 +104,7 @@ bool ItemAction::Update()
         return true;
 
     try {
+        vt_system::ScriptProfilerCall profiler_call(_update_function);
         return luabind::call_function<bool>(_update_function);
     } catch(const luabind::error& err) {
         ScriptManager->HandleLuaError(err);
@@ -130,6 +132,7 @@ void ItemAction::Warmup()
     }
 
     try {
+        vt_system::ScriptProfilerCall profiler_call(script_function);
         luabind::call_function<void>(script_function, _actor, _target);
     } catch(const luabind::error &err) {
         ScriptManager->HandleLuaError(err);
@@ -158,6 +161,7 @@ bool ItemAction::Execute()
 
     bool ret = false;
     try {
+        vt_system::ScriptProfilerCall profiler_call(script_function);
         ret = luabind::call_function<bool>(script_function, _actor, _target);
     } catch(const luabind::error &err) {
         ScriptManager->HandleLuaError(err);
@@ -220,6 +224,7 @@ uint32_t ItemAction::GetCoolDownTime() const
 void ItemAction::_InitAnimationScript()
 {
     try {
+        vt_system::ScriptProfilerCall profiler_call(_init_function);
         // N.B: _battle_item is a shared_ptr, but we need the actual pointer for luabind.
         luabind::call_function<void>(_init_function, _actor, _target, _battle_item.get());
     } catch(const luabind::error& err) {
@@ -12,6 +12,8 @@
 
 #include "common/global/global_skills.h"
 
+#include "engine/script_profiler.h"
+
 #include "utils/ustring.h"
 
 using namespace vt_global;
@@ -95,6 +97,7 @@ bool SkillAction::ShouldShowSkillNotice() const
 void SkillAction::_InitAnimationScript()
 {
     try {
+        vt_system::ScriptProfilerCall profiler_call(_init_function);
         luabind::call_function<void>(_init_function, _actor, _target, _skill);
     } catch(const luabind::error &err) {
         ScriptManager->HandleLuaError(err);
@@ -149,6 +152,7 @@ bool SkillAction::Update()
         return true;
 
     try {
+        vt_system::ScriptProfilerCall profiler_call(_update_function);
         return luabind::call_function<bool>(_update_function);
     } catch(const luabind::error &err) {
         ScriptManager->HandleLuaError(err);
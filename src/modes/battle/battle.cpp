@@ -25,6 +25,7 @@
 #include "engine/audio/audio.h"
 #include "engine/input.h"
 #include "engine/mode_manager.h"
+#include "engine/profiler.h"
 #include "script/script.h"
 #include "engine/video/video.h"
 
@@ -34,10 +35,12 @@
 #include "modes/battle/finish/battle_victory.h"
 #include "modes/battle/objects/battle_animation.h"
 #include "modes/battle/objects/battle_character.h"
+#include "modes/battle/objects/battle_effect_pool.h"
 #include "modes/battle/objects/battle_enemy.h"
 #include "modes/battle/objects/battle_particle_effect.h"
 #include "modes/battle/actions/skill_action.h"
 #include "modes/battle/command/command_supervisor.h"
+#include "modes/battle/battle_ai.h"
 #include "modes/battle/battle_sequence.h"
 
 #include "common/global/global.h"
@@ -117,6 +120,8 @@ BattleMode::BattleMode() :
     _command_supervisor(nullptr),
     _dialogue_supervisor(nullptr),
     _battle_finish(nullptr),
+    _effect_pool(nullptr),
+    _ai_supervisor(nullptr),
     _current_number_swaps(0),
     _last_enemy_dying(false),
     _stamina_icon_alpha(1.0f),
@@ -125,10 +130,15 @@ BattleMode::BattleMode() :
     _highest_stamina(0),
     _is_boss_battle(false),
     _hero_init_boost(false),
-    _enemy_init_boost(false)
+    _enemy_init_boost(false),
+    _headless(false)
 {
     _current_instance = this;
 
+    // The battles of a map mostly use the same assets.
+    ModeManager->GetAssetResidency().DeclareModeManifest(this, "battle:"
+        + GlobalManager->GetMapData().GetMapDataFilename());
+
     _auto_battle_text.SetText(vt_system::UTranslate("Auto-Battle"),
                               vt_video::TextStyle("text20",
                               vt_video::Color::white,
@@ -137,6 +147,8 @@ BattleMode::BattleMode() :
     _sequence_supervisor = new SequenceSupervisor(this);
     _command_supervisor = new CommandSupervisor();
     _dialogue_supervisor = new vt_common::DialogueSupervisor();
+    _effect_pool = new BattleEffectPool();
+    _ai_supervisor = new BattleAISupervisor();
 }
 
 BattleMode::~BattleMode()
@@ -146,6 +158,15 @@ BattleMode::~BattleMode()
     delete _dialogue_supervisor;
     delete _battle_finish;
 
+    // Delete all the effects, in use or not
+    for(uint32_t i = 0; i < _battle_particle_effects.size(); ++i)
+        delete _battle_particle_effects[i];
+    _battle_particle_effects.clear();
+    for(uint32_t i = 0; i < _battle_animations.size(); ++i)
+        delete _battle_animations[i];
+    _battle_animations.clear();
+    delete _effect_pool;
+
     // Delete all character and enemy actors
     for(uint32_t i = 0; i < _character_actors.size(); i++) {
         delete _character_actors[i];
@@ -160,6 +181,9 @@ BattleMode::~BattleMode()
     _enemy_party.clear();
 
     _ready_queue.clear();
+
+    // Deleted once no actor uses the AIs anymore
+    delete _ai_supervisor;
 }
 
 void BattleMode::_ResetMusicState()
@@ -209,6 +233,8 @@ void BattleMode::_ResetMusicState()
 
 void BattleMode::Reset()
 {
+    vt_system::ProfilerZone zone("BattleMode::Reset");
+
     _current_instance = this;
 
     VideoManager->SetStandardCoordSys();
@@ -239,6 +265,7 @@ void BattleMode::RestartBattle()
     _enemy_actors.clear();
     _enemy_party.clear();
     _ready_queue.clear();
+    _ai_supervisor->ClearDecisions();
 
     for(uint32_t i = 0; i < _initial_enemy_actors_info.size(); ++i)
         AddEnemy(_initial_enemy_actors_info[i].enemy_id,
@@ -278,6 +305,11 @@ static bool CompareObjectsYCoord(BattleObject *one, BattleObject *other)
 
 void BattleMode::Update()
 {
+    vt_system::ProfilerZone zone("BattleMode::Update");
+
+    // Keep the locations drawn so far, to interpolate the next frames from them.
+    _StorePreviousLocations();
+
     // Update potential battle animations
     GlobalManager->GetBattleMedia().Update();
     GameMode::Update();
@@ -314,16 +346,34 @@ void BattleMode::Update()
         _battle_objects.push_back(_enemy_actors[i]);
     }
 
-    // Add effects (particles and animations)
-    for(std::vector<BattleObject *>::iterator it = _battle_effects.begin();
-            it != _battle_effects.end();) {
-        if((*it)->CanBeRemoved()) {
-            delete (*it);
-            it = _battle_effects.erase(it);
+    // Take the decisions of all the actors that entered the command state
+    _ai_supervisor->Update();
+
+    // Add effects (particles and animations).
+    // The finished ones are given back to the pool, and swapped with the last one
+    // as the effects are sorted afterwards anyway.
+    for(uint32_t i = 0; i < _battle_particle_effects.size();) {
+        BattleParticleEffect* effect = _battle_particle_effects[i];
+        if(effect->CanBeRemoved()) {
+            _effect_pool->ReleaseParticleEffect(effect);
+            _battle_particle_effects[i] = _battle_particle_effects.back();
+            _battle_particle_effects.pop_back();
         } else {
-            (*it)->Update();
-            _battle_objects.push_back(*it);
-            ++it;
+            effect->Update();
+            _battle_objects.push_back(effect);
+            ++i;
+        }
+    }
+    for(uint32_t i = 0; i < _battle_animations.size();) {
+        BattleAnimation* animation = _battle_animations[i];
+        if(animation->CanBeRemoved()) {
+            _effect_pool->ReleaseAnimation(animation);
+            _battle_animations[i] = _battle_animations.back();
+            _battle_animations.pop_back();
+        } else {
+            animation->Update();
+            _battle_objects.push_back(animation);
+            ++i;
         }
     }
 
@@ -473,6 +523,10 @@ void BattleMode::Update()
 
 void BattleMode::Draw()
 {
+    // When drawn under another mode, the battle isn't updated and stays still.
+    if(ModeManager->GetTop() != this)
+        _StorePreviousLocations();
+
     VideoManager->SetStandardCoordSys();
 
     if(_state == BATTLE_STATE_INITIAL || _state == BATTLE_STATE_EXITING) {
@@ -503,6 +557,18 @@ void BattleMode::DrawPostEffects()
 // BattleMode class -- secondary methods
 ////////////////////////////////////////////////////////////////////////////////
 
+void BattleMode::_StorePreviousLocations()
+{
+    for(uint32_t i = 0; i < _character_actors.size(); ++i)
+        _character_actors[i]->StorePreviousLocation();
+    for(uint32_t i = 0; i < _enemy_actors.size(); ++i)
+        _enemy_actors[i]->StorePreviousLocation();
+    for(uint32_t i = 0; i < _battle_particle_effects.size(); ++i)
+        _battle_particle_effects[i]->StorePreviousLocation();
+    for(uint32_t i = 0; i < _battle_animations.size(); ++i)
+        _battle_animations[i]->StorePreviousLocation();
+}
+
 void BattleMode::AddEnemy(uint32_t new_enemy_id, float position_x, float position_y)
 {
     // Check for the enemy data validity
@@ -619,6 +685,10 @@ void BattleMode::ChangeState(BATTLE_STATE new_state)
                 action->Cancel();
         }
 
+        // The headless battles end there, without rewards.
+        if (_headless)
+            break;
+
         // Remove the items used in battle from inventory.
         _command_supervisor->CommitChangesToInventory();
 
@@ -634,6 +704,9 @@ void BattleMode::ChangeState(BATTLE_STATE new_state)
         break;
     }
     case BATTLE_STATE_DEFEAT: {
+        if (_headless)
+            break;
+
         // Attempt to reload the music if it was removed from the cache
         AudioManager->LoadMusic(battle_media.defeat_music_filename);
         if (MusicDescriptor* defeat_music = AudioManager->RetrieveMusic(battle_media.defeat_music_filename)) {
@@ -794,6 +867,9 @@ void BattleMode::_Initialize()
     // Determine the origin position for all characters and enemies
     _DetermineActorLocations();
 
+    // Load the effects of the actors skills now, rather than when they are first used.
+    _PreloadBattleEffects();
+
     // Find the actor with the highest stamina rating
     _highest_stamina = 0;
     for(uint32_t i = 0; i < _character_actors.size(); ++i) {
@@ -855,6 +931,15 @@ void BattleMode::_Initialize()
     ChangeState(BATTLE_STATE_INITIAL);
 }
 
+void BattleMode::SetHeadless(bool headless)
+{
+    _headless = headless;
+
+    // The auto-battle gives the characters commands.
+    _battle_menu.SetAutoBattleActive(headless);
+    GetIndicatorSupervisor().SetEnabled(!headless);
+}
+
 void BattleMode::SetActorIdleStateTime(BattleActor* actor)
 {
     if(!actor || actor->GetStamina() == 0)
@@ -871,27 +956,54 @@ void BattleMode::SetActorIdleStateTime(BattleActor* actor)
 
 void BattleMode::TriggerBattleParticleEffect(const std::string &effect_filename, float x, float y)
 {
-    BattleParticleEffect* effect = new BattleParticleEffect(effect_filename);
+    // The particle effects are only visual.
+    if (_headless)
+        return;
+
+    BattleParticleEffect* effect = _effect_pool->GetParticleEffect(effect_filename);
 
     effect->SetXLocation(x);
     effect->SetYLocation(y);
 
     effect->Start();
+    // The pooled effect doesn't move from its previous location.
+    effect->StorePreviousLocation();
 
-    _battle_effects.push_back(effect);
+    _battle_particle_effects.push_back(effect);
 }
 
 private_battle::BattleAnimation* BattleMode::CreateBattleAnimation(const std::string& animation_filename)
 {
-    BattleAnimation* animation = new BattleAnimation(animation_filename);
+    BattleAnimation* animation = _effect_pool->GetAnimation(animation_filename);
 
     // Set it invisible until an event make it usable
     animation->SetVisible(false);
 
-    _battle_effects.push_back(animation);
+    _battle_animations.push_back(animation);
     return animation;
 }
 
+void BattleMode::_PreloadBattleEffects()
+{
+    std::vector<BattleActor*> actors(_character_actors.begin(), _character_actors.end());
+    actors.insert(actors.end(), _enemy_actors.begin(), _enemy_actors.end());
+
+    for(uint32_t i = 0; i < actors.size(); ++i) {
+        const std::vector<GlobalSkill*>& skills = actors[i]->GetGlobalActor()->GetSkills();
+        for(uint32_t j = 0; j < skills.size(); ++j) {
+            if (!_headless) {
+                const std::vector<std::string>& particle_effects = skills[j]->GetBattleParticleEffects();
+                for(uint32_t k = 0; k < particle_effects.size(); ++k)
+                    _effect_pool->PreloadParticleEffect(particle_effects[k]);
+            }
+
+            const std::vector<std::string>& animations = skills[j]->GetBattleAnimations();
+            for(uint32_t k = 0; k < animations.size(); ++k)
+                _effect_pool->PreloadAnimation(animations[k]);
+        }
+    }
+}
+
 void BattleMode::_DetermineActorLocations()
 {
     float position_x, position_y;
@@ -1070,13 +1182,15 @@ void BattleMode::_DrawSprites()
         if(IsTargetParty(target.GetType())) {
             const std::deque<BattleActor *>& party_target = target.GetPartyTarget();
             for(uint32_t i = 0; i < party_target.size(); i++) {
-                VideoManager->Move(party_target[i]->GetXLocation(),  party_target[i]->GetYLocation());
+                vt_common::Position2D draw_location = party_target[i]->GetDrawLocation();
+                VideoManager->Move(draw_location.x, draw_location.y);
                 VideoManager->MoveRelative(0.0f, 20.0f);
                 battle_media.actor_selection_image.Draw();
             }
         }
         else if(actor_target != nullptr) {
-            VideoManager->Move(actor_target->GetXLocation(), actor_target->GetYLocation());
+            vt_common::Position2D draw_location = actor_target->GetDrawLocation();
+            VideoManager->Move(draw_location.x, draw_location.y);
             VideoManager->MoveRelative(0.0f, 20.0f);
             battle_media.actor_selection_image.Draw();
         }
@@ -1093,7 +1207,8 @@ void BattleMode::_DrawSprites()
         uint32_t point = target.GetAttackPoint();
 
         VideoManager->SetDrawFlags(VIDEO_X_CENTER, VIDEO_Y_CENTER, VIDEO_BLEND, 0);
-        VideoManager->Move(actor_target->GetXLocation(), actor_target->GetYLocation());
+        vt_common::Position2D draw_location = actor_target->GetDrawLocation();
+        VideoManager->Move(draw_location.x, draw_location.y);
         VideoManager->MoveRelative(actor_target->GetAttackPoint(point)->GetXPosition(), -actor_target->GetAttackPoint(point)->GetYPosition());
         battle_media.attack_point_indicator.Draw();
     }
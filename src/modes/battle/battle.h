@@ -48,11 +48,13 @@ namespace private_battle
 {
 
 class BattleActor;
+class BattleAISupervisor;
 class BattleCharacter;
 class BattleEnemy;
 class BattleObject;
 class BattleParticleEffect;
 class BattleAnimation;
+class BattleEffectPool;
 class BattleFinish;
 class CommandSupervisor;
 class SequenceSupervisor;
@@ -253,6 +255,10 @@ public:
         return _command_supervisor;
     }
 
+    private_battle::BattleAISupervisor* GetAISupervisor() {
+        return _ai_supervisor;
+    }
+
     vt_common::DialogueSupervisor* GetDialogueSupervisor() {
         return _dialogue_supervisor;
     }
@@ -277,7 +283,7 @@ public:
     //! and that you must call SetVisible(true) and move it somewhere visible
     //! for it to be shown.
     //! Once you don't need it anymore, you can throw it by calling Remove()
-    //! and the animation will be freed from memory on the next Battle update.
+    //! and the animation will be given back to the effect pool on the next Battle update.
     //!
     //! \param The animation filename is the animation definition file.
     //! \return the animation object for scripted manipulation purpose.
@@ -294,6 +300,18 @@ public:
         return _is_boss_battle;
     }
 
+    /** \brief Makes the battle play without the player nor anything drawn. Used by the battle simulator.
+    *** The characters then use the auto-battle commands, no indicators nor particle effects are created,
+    *** and the battle ends as soon as it is won or lost, without changing the game state.
+    *** It must be called before the battle mode is pushed.
+    *** \see vt_battle::BattleSimulator
+    **/
+    void SetHeadless(bool headless);
+
+    bool IsHeadless() const {
+        return _headless;
+    }
+
     //! \brief Tells the battle mode Heroes will receive an aguility boost at battle start.
     void BoostHeroPartyInitiative() {
         _hero_init_boost = true;
@@ -326,6 +344,12 @@ private:
 
     //! \brief Presents player with information and options after a battle has concluded
     private_battle::BattleFinish* _battle_finish;
+
+    //! \brief Keeps the finished particle effects and animations for reuse
+    private_battle::BattleEffectPool* _effect_pool;
+
+    //! \brief Loads the actors AI files once, and takes their decisions
+    private_battle::BattleAISupervisor* _ai_supervisor;
     //@}
 
     //! \name Battle Actor Containers
@@ -361,11 +385,12 @@ private:
     //! as the number of enemies might have changed.
     std::deque<BattleEnemyInfo> _initial_enemy_actors_info;
 
-    /** \brief The effects container.
-    *** It will permit to draw particle effects and animations in the right order,
-    *** and will get rid of the "dead" useless effects at update time.
+    /** \brief The effects containers.
+    *** They permit to draw particle effects and animations in the right order,
+    *** and give the "dead" useless effects back to the effect pool at update time.
     **/
-    std::vector<private_battle::BattleObject *> _battle_effects;
+    std::vector<private_battle::BattleParticleEffect *> _battle_particle_effects;
+    std::vector<private_battle::BattleAnimation *> _battle_animations;
 
     /** \brief A FIFO queue of all actors that are ready to perform an action
     *** When an actor has completed the wait time for their warm-up state, they enter the ready state and are
@@ -423,6 +448,9 @@ private:
     //! \brief Whether the enemy party should get an initiative boost at battle start.
     bool _enemy_init_boost;
 
+    //! \brief Whether the battle is played without the player nor anything drawn. \see SetHeadless()
+    bool _headless;
+
 
     ////////////////////////////// PRIVATE METHODS ///////////////////////////////
 
@@ -443,6 +471,11 @@ private:
     **/
     void _DetermineActorLocations();
 
+    /** \brief Loads the particle effects and animations used by the skills of all the actors,
+    *** so that the skills used during the battle don't load them.
+    **/
+    void _PreloadBattleEffects();
+
     //! \brief Returns the number of enemies that are still alive in the battle
     uint32_t _NumberEnemiesAlive() const;
 
@@ -472,6 +505,9 @@ private:
     **/
     void _DrawSprites();
 
+    //! \brief Stores the battle objects locations before a logic update, to interpolate the drawn locations.
+    void _StorePreviousLocations();
+
     /** \brief Draws all foreground images and animations
     *** The images and effects drawn by this function will be drawn over sprites,
     *** but not over the post effects and the gui.
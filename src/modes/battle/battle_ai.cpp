@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_ai.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the battle actors AI
+*** ***************************************************************************/
+
+#include "modes/battle/battle_ai.h"
+
+#include "modes/battle/battle.h"
+#include "modes/battle/objects/battle_actor.h"
+
+#include "common/global/global_skills.h"
+#include "engine/profiler.h"
+#include "engine/script_profiler.h"
+#include "script/script.h"
+
+#include "utils/utils_random.h"
+
+using namespace vt_global;
+using namespace vt_script;
+using namespace vt_utils;
+
+namespace vt_battle
+{
+
+namespace private_battle
+{
+
+//! \brief Returns the native decision target filter matching the given name.
+static BATTLE_AI_TARGET _GetTargetFilter(const std::string& name)
+{
+    if (name == "lowest_hp")
+        return BATTLE_AI_TARGET_LOWEST_HP;
+    else if (name == "highest_hp")
+        return BATTLE_AI_TARGET_HIGHEST_HP;
+    else if (name == "most_sp")
+        return BATTLE_AI_TARGET_MOST_SP;
+    else if (name != "random")
+        PRINT_WARNING << "Unknown battle AI target: " << name << ", a random target is used instead." << std::endl;
+
+    return BATTLE_AI_TARGET_RANDOM;
+}
+
+BattleAI::~BattleAI()
+{
+    // Reset the luabind object so its lua counterpart can be freed.
+    _decide_action = luabind::object();
+    _script.CloseFile();
+}
+
+bool BattleAI::Load(const std::string& filename)
+{
+    // Clears out the data of a previous battle.
+    ScriptManager->DropGlobalTable(ScriptEngine::GetTableSpace(filename));
+
+    if(!_script.OpenFile(filename))
+        return false;
+
+    if(_script.OpenTablespace().empty()) {
+        PRINT_ERROR << "The actor battle AI script file: " << filename
+                    << "has got no valid namespace" << std::endl;
+        _script.CloseFile();
+        return false;
+    }
+
+    _decide_action = _script.ReadFunctionPointer("DecideAction");
+    if (_decide_action.is_valid())
+        return true;
+
+    if (_script.OpenTable("decisions")) {
+        for(uint32_t i = 1; i <= _script.GetTableSize(); ++i) {
+            if (!_script.OpenTable(i))
+                continue;
+
+            BattleAIDecision decision;
+            decision.skill_id = _script.ReadUInt("skill_id");
+            if (_script.DoesIntExist("weight"))
+                decision.weight = _script.ReadUInt("weight");
+            if (_script.DoesStringExist("target"))
+                decision.target = _GetTargetFilter(_script.ReadString("target"));
+
+            if (decision.skill_id > 0 && decision.weight > 0)
+                _decisions.push_back(decision);
+            _script.CloseTable();
+        }
+        _script.CloseTable(); // decisions
+    }
+
+    if(_script.IsErrorDetected()) {
+        PRINT_WARNING << "One or more errors occurred while reading the battle AI data - they are listed below"
+                      << std::endl << _script.GetErrorMessages() << std::endl;
+    }
+
+    if (_decisions.empty()) {
+        PRINT_ERROR << "The actor battle AI script file: " << filename
+                    << " has got neither a DecideAction() function nor decisions" << std::endl;
+        _script.CloseFile();
+        return false;
+    }
+
+    // The native decisions don't need the script anymore.
+    _script.CloseFile();
+    return true;
+}
+
+bool BattleAI::DecideAction(BattleActor* actor, const luabind::object& ai_state)
+{
+    if (!_decide_action.is_valid())
+        return _DecideNativeAction(actor);
+
+    try {
+        vt_system::ScriptProfilerCall profiler_call(_decide_action);
+        luabind::call_function<void>(_decide_action, BattleMode::CurrentInstance(), actor, ai_state);
+        return true;
+    } catch(const luabind::error &e) {
+        PRINT_ERROR << "Error while triggering DecideAction() function of actor id: " << actor->GetID() << std::endl;
+        ScriptManager->HandleLuaError(e);
+    } catch(const luabind::cast_failed &e) {
+        PRINT_ERROR << "Error while triggering DecideAction() function of actor id: " << actor->GetID() << std::endl;
+        ScriptManager->HandleCastError(e);
+    }
+    return false;
+}
+
+bool BattleAI::_DecideNativeAction(BattleActor* actor)
+{
+    // Keep the decisions whose skill can be used now.
+    std::vector<const BattleAIDecision*> usable_decisions;
+    std::vector<GlobalSkill*> usable_skills;
+    uint32_t total_weight = 0;
+
+    const std::vector<GlobalSkill *>& actor_skills = actor->GetSkills();
+    for(uint32_t i = 0; i < _decisions.size(); ++i) {
+        for(uint32_t j = 0; j < actor_skills.size(); ++j) {
+            GlobalSkill* skill = actor_skills[j];
+            if (skill->GetID() != _decisions[i].skill_id)
+                continue;
+
+            if (skill->IsExecutableInBattle() && skill->GetSPRequired() <= actor->GetSkillPoints()) {
+                usable_decisions.push_back(&_decisions[i]);
+                usable_skills.push_back(skill);
+                total_weight += _decisions[i].weight;
+            }
+            break;
+        }
+    }
+
+    if (usable_decisions.empty())
+        return false;
+
+    // Select a weighted random decision.
+    int32_t choice = RandomBoundedInteger(0, static_cast<int32_t>(total_weight) - 1);
+    uint32_t index = 0;
+    while (choice >= static_cast<int32_t>(usable_decisions[index]->weight)) {
+        choice -= usable_decisions[index]->weight;
+        ++index;
+    }
+
+    GLOBAL_TARGET target_type = usable_skills[index]->GetTargetType();
+    BattleActor* target = nullptr;
+    if (!IsTargetParty(target_type)) {
+        target = _SelectTarget(actor, target_type, usable_decisions[index]->target);
+        if (target == nullptr)
+            return false;
+    }
+
+    actor->SetAction(usable_decisions[index]->skill_id, target);
+    return true;
+}
+
+BattleActor* BattleAI::_SelectTarget(BattleActor* actor, GLOBAL_TARGET target_type,
+                                     BATTLE_AI_TARGET target_filter)
+{
+    if (IsTargetSelf(target_type))
+        return actor;
+
+    BattleMode* BM = BattleMode::CurrentInstance();
+    // The roles are inversed for enemies.
+    std::deque<BattleActor *>& party = (actor->IsEnemy() == IsTargetFoe(target_type)) ?
+                                       BM->GetCharacterParty() : BM->GetEnemyParty();
+
+    // Keep the valid targets.
+    std::vector<BattleActor*> targets;
+    for(uint32_t i = 0; i < party.size(); ++i) {
+        BattleActor* target = party[i];
+        if (target_type == GLOBAL_TARGET_DEAD_ALLY_ONLY) {
+            if (!target->IsAlive())
+                targets.push_back(target);
+        }
+        else if (target_type == GLOBAL_TARGET_ALLY_EVEN_DEAD || target->IsAlive()) {
+            targets.push_back(target);
+        }
+    }
+
+    if (targets.empty())
+        return nullptr;
+
+    BattleActor* best_target = targets[0];
+    switch(target_filter) {
+    default:
+    case BATTLE_AI_TARGET_RANDOM:
+        if (targets.size() > 1)
+            best_target = targets[RandomBoundedInteger(0, targets.size() - 1)];
+        break;
+    case BATTLE_AI_TARGET_LOWEST_HP:
+        for(uint32_t i = 1; i < targets.size(); ++i) {
+            if (targets[i]->GetHitPoints() < best_target->GetHitPoints())
+                best_target = targets[i];
+        }
+        break;
+    case BATTLE_AI_TARGET_HIGHEST_HP:
+        for(uint32_t i = 1; i < targets.size(); ++i) {
+            if (targets[i]->GetHitPoints() > best_target->GetHitPoints())
+                best_target = targets[i];
+        }
+        break;
+    case BATTLE_AI_TARGET_MOST_SP:
+        for(uint32_t i = 1; i < targets.size(); ++i) {
+            if (targets[i]->GetSkillPoints() > best_target->GetSkillPoints())
+                best_target = targets[i];
+        }
+        break;
+    }
+
+    return best_target;
+}
+
+BattleAISupervisor::~BattleAISupervisor()
+{
+    _pending_actors.clear();
+
+    std::map<std::string, BattleAI*>::iterator it = _ais.begin();
+    for(; it != _ais.end(); ++it)
+        delete it->second;
+    _ais.clear();
+}
+
+BattleAI* BattleAISupervisor::GetAI(const std::string& filename)
+{
+    std::map<std::string, BattleAI*>::iterator it = _ais.find(filename);
+    if (it != _ais.end())
+        return it->second;
+
+    BattleAI* ai = new BattleAI();
+    if (!ai->Load(filename)) {
+        delete ai;
+        ai = nullptr;
+    }
+
+    _ais[filename] = ai;
+    return ai;
+}
+
+void BattleAISupervisor::RequestDecision(BattleActor* actor)
+{
+    if (actor)
+        _pending_actors.push_back(actor);
+}
+
+void BattleAISupervisor::Update()
+{
+    vt_system::ProfilerZone zone("BattleAISupervisor::Update");
+
+    if (_pending_actors.empty())
+        return;
+
+    // The decisions may request new ones, which are then taken on the next update.
+    std::vector<BattleActor*> deciding_actors;
+    deciding_actors.swap(_pending_actors);
+
+    for(uint32_t i = 0; i < deciding_actors.size(); ++i)
+        deciding_actors[i]->DecideAIAction();
+}
+
+} // namespace private_battle
+
+} // namespace vt_battle
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_ai.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the battle actors AI
+***
+*** Each battle AI file is loaded once per battle, and shared by all the actors
+*** using it. The decisions of all the actors waiting for one are then taken
+*** together, once per battle update.
+***
+*** An AI file either provides a DecideAction(battle_instance, battle_actor, ai_state)
+*** function, where ai_state is a table kept for each actor between its decisions,
+*** or a native decisions table choosing a weighted random skill without calling Lua:
+***
+*** \code
+*** decisions = {
+***     { skill_id = 1008, weight = 3, target = "lowest_hp" },
+***     { skill_id = 1009, weight = 1 },
+*** }
+*** \endcode
+***
+*** The target can be "random" (default), "lowest_hp", "highest_hp" or "most_sp".
+*** It is only used for skills targeting a single actor.
+*** ***************************************************************************/
+
+#ifndef __BATTLE_AI_HEADER__
+#define __BATTLE_AI_HEADER__
+
+#include "common/global/global_target.h"
+
+#include "script/script_read.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vt_battle
+{
+
+namespace private_battle
+{
+
+class BattleActor;
+
+//! \brief The target filters of the native AI decisions.
+enum BATTLE_AI_TARGET {
+    BATTLE_AI_TARGET_RANDOM     = 0, //!< A random valid target
+    BATTLE_AI_TARGET_LOWEST_HP  = 1, //!< The valid target with the fewest hit points
+    BATTLE_AI_TARGET_HIGHEST_HP = 2, //!< The valid target with the most hit points
+    BATTLE_AI_TARGET_MOST_SP    = 3, //!< The valid target with the most skill points
+    BATTLE_AI_TARGET_TOTAL      = 4
+};
+
+//! \brief A weighted skill choice of a native AI decisions table.
+struct BattleAIDecision {
+    BattleAIDecision():
+        skill_id(0),
+        weight(1),
+        target(BATTLE_AI_TARGET_RANDOM)
+    {}
+
+    uint32_t skill_id;
+
+    //! \brief The chance of this decision to be taken, relative to the other usable ones.
+    uint32_t weight;
+
+    BATTLE_AI_TARGET target;
+};
+
+/** ****************************************************************************
+*** \brief An AI file, shared by all the actors using it.
+*** ***************************************************************************/
+class BattleAI
+{
+public:
+    BattleAI()
+    {}
+
+    ~BattleAI();
+
+    //! \brief Loads the AI file. Returns false if it provides no valid decision.
+    bool Load(const std::string& filename);
+
+    //! \brief Tells whether the decisions are taken by the Lua DecideAction() function.
+    bool IsScripted() const {
+        return _decide_action.is_valid();
+    }
+
+    /** \brief Makes the actor decide its next action.
+    *** \param actor The actor deciding.
+    *** \param ai_state The actor's own table, given to the DecideAction() function.
+    *** \return false if no decision could be taken, so that the default behaviour is used.
+    **/
+    bool DecideAction(BattleActor* actor, const luabind::object& ai_state);
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    BattleAI(const BattleAI& ai);
+    BattleAI& operator=(const BattleAI& ai);
+
+    //! \brief Takes a decision from the native decisions table.
+    bool _DecideNativeAction(BattleActor* actor);
+
+    //! \brief Returns a target of the given type matching the filter, or nullptr if none is valid.
+    BattleActor* _SelectTarget(BattleActor* actor, vt_global::GLOBAL_TARGET target_type,
+                               BATTLE_AI_TARGET target_filter);
+
+    //! \brief The AI file.
+    vt_script::ReadScriptDescriptor _script;
+
+    //! \brief The "DecideAction" AI function.
+    luabind::object _decide_action;
+
+    //! \brief The native decisions, used when no DecideAction() function is given.
+    std::vector<BattleAIDecision> _decisions;
+};
+
+/** ****************************************************************************
+*** \brief Loads the battle AI files once, and takes the actors decisions once per update.
+***
+*** The supervisor is owned by the battle mode. \see BattleMode::GetAISupervisor()
+*** ***************************************************************************/
+class BattleAISupervisor
+{
+public:
+    BattleAISupervisor()
+    {}
+
+    ~BattleAISupervisor();
+
+    //! \brief Returns the AI of the given file, loaded on first use, or nullptr if it isn't valid.
+    BattleAI* GetAI(const std::string& filename);
+
+    //! \brief Queues the decision of an actor entering the command state. It is taken on the next Update().
+    void RequestDecision(BattleActor* actor);
+
+    //! \brief Forgets the pending decisions. Called when the actors are removed.
+    void ClearDecisions() {
+        _pending_actors.clear();
+    }
+
+    //! \brief Takes the decisions of all the actors waiting for one.
+    void Update();
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    BattleAISupervisor(const BattleAISupervisor& supervisor);
+    BattleAISupervisor& operator=(const BattleAISupervisor& supervisor);
+
+    //! \brief The loaded AIs, by filename. The invalid ones are kept as nullptr, so that they're loaded only once.
+    std::map<std::string, BattleAI*> _ais;
+
+    //! \brief The actors waiting for their decision.
+    std::vector<BattleActor*> _pending_actors;
+};
+
+} // namespace private_battle
+
+} // namespace vt_battle
+
+#endif // __BATTLE_AI_HEADER__
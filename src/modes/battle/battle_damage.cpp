@@ -52,10 +52,10 @@ bool RndEvade(BattleActor* target_actor, float add_eva, float mul_eva, int32_t a
     float evasion = 0.0f;
     if(attack_point > -1) {
         GlobalAttackPoint* atk_point = target_actor->GetAttackPoint(attack_point);
-        evasion = atk_point ? atk_point->GetTotalEvadeRating() : target_actor->GetAverageEvadeRating();
+        evasion = atk_point ? atk_point->GetTotalEvadeRating() : target_actor->GetStatCache().average_evade_rating;
     }
     else {
-        evasion = target_actor->GetAverageEvadeRating();
+        evasion = target_actor->GetStatCache().average_evade_rating;
     }
 
     evasion += add_eva;
@@ -136,10 +136,10 @@ uint32_t RndPhysicalDamage(BattleActor* attacker, BattleActor* target_actor,
 
     if(attack_point > -1) {
         GlobalAttackPoint* atk_point = target_actor->GetAttackPoint(attack_point);
-        total_phys_def = atk_point ? atk_point->GetTotalPhysicalDefense() : target_actor->GetAverageDefense();
+        total_phys_def = atk_point ? atk_point->GetTotalPhysicalDefense() : target_actor->GetStatCache().average_physical_defense;
     }
     else {
-        total_phys_def = target_actor->GetAverageDefense();
+        total_phys_def = target_actor->GetStatCache().average_physical_defense;
     }
 
     // Holds the total damage dealt
@@ -191,15 +191,18 @@ uint32_t RndMagicalDamage(BattleActor* attacker, BattleActor* target_actor, GLOB
     if(total_mag_atk < 0)
         total_mag_atk = 0;
 
+    if(element <= GLOBAL_ELEMENTAL_INVALID || element >= GLOBAL_ELEMENTAL_TOTAL)
+        element = GLOBAL_ELEMENTAL_NEUTRAL;
+
     // Holds the total physical defense of the target
     int32_t total_mag_def = 0;
 
     if(attack_point > -1) {
         GlobalAttackPoint* atk_point = target_actor->GetAttackPoint(attack_point);
-        total_mag_def = atk_point ? atk_point->GetTotalMagicalDefense(element) : target_actor->GetAverageMagicalDefense(element);
+        total_mag_def = atk_point ? atk_point->GetTotalMagicalDefense(element) : target_actor->GetStatCache().average_magical_defense[element];
     }
     else {
-        total_mag_def = target_actor->GetAverageMagicalDefense(element);
+        total_mag_def = target_actor->GetStatCache().average_magical_defense[element];
     }
 
     // Holds the total damage dealt
@@ -214,6 +217,78 @@ uint32_t RndMagicalDamage(BattleActor* attacker, BattleActor* target_actor, GLOB
     return static_cast<uint32_t>(total_dmg);
 }
 
+//! \brief Evaluates an attack on every actor of the target, and registers the damage dealt or the misses.
+static uint32_t _RndAttack(BattleActor* attacker, BattleTarget* target, bool magical, GLOBAL_ELEMENTAL element,
+                           uint32_t add_atk, float mul_atk)
+{
+    if(attacker == nullptr) {
+        PRINT_WARNING << "function received nullptr attacker argument" << std::endl;
+        return 0;
+    }
+    if(target == nullptr) {
+        PRINT_WARNING << "function received nullptr target argument" << std::endl;
+        return 0;
+    }
+
+    target->ClearHitActors();
+
+    GLOBAL_TARGET target_type = target->GetType();
+    int32_t attack_point = IsTargetPoint(target_type) ? static_cast<int32_t>(target->GetAttackPoint()) : -1;
+    bool party_target = IsTargetParty(target_type);
+    uint32_t number_of_actors = party_target ? target->GetPartyTarget().size() : 1;
+
+    for(uint32_t i = 0; i < number_of_actors; ++i) {
+        BattleActor* target_actor = party_target ? target->GetPartyTarget()[i] : target->GetActor();
+        if(target_actor == nullptr)
+            continue;
+
+        if(!target_actor->IsAlive() || RndEvade(target_actor, 0.0f, 1.0f, attack_point)) {
+            target_actor->RegisterMiss(true);
+            continue;
+        }
+
+        uint32_t damage = magical ?
+            RndMagicalDamage(attacker, target_actor, element, add_atk, mul_atk, attack_point) :
+            RndPhysicalDamage(attacker, target_actor, add_atk, mul_atk, attack_point);
+        target_actor->RegisterDamage(damage, target);
+        target->AddHitActor(target_actor);
+    }
+
+    return target->GetHitActors().size();
+}
+
+uint32_t RndPhysicalAttack(BattleActor* attacker, BattleTarget* target)
+{
+    return _RndAttack(attacker, target, false, GLOBAL_ELEMENTAL_NEUTRAL, 0, 1.0f);
+}
+
+uint32_t RndPhysicalAttack(BattleActor* attacker, BattleTarget* target, uint32_t add_atk)
+{
+    return _RndAttack(attacker, target, false, GLOBAL_ELEMENTAL_NEUTRAL, add_atk, 1.0f);
+}
+
+uint32_t RndPhysicalAttack(BattleActor* attacker, BattleTarget* target, uint32_t add_atk, float mul_atk)
+{
+    return _RndAttack(attacker, target, false, GLOBAL_ELEMENTAL_NEUTRAL, add_atk, mul_atk);
+}
+
+uint32_t RndMagicalAttack(BattleActor* attacker, BattleTarget* target, GLOBAL_ELEMENTAL element)
+{
+    return _RndAttack(attacker, target, true, element, 0, 1.0f);
+}
+
+uint32_t RndMagicalAttack(BattleActor* attacker, BattleTarget* target, GLOBAL_ELEMENTAL element,
+                          uint32_t add_atk)
+{
+    return _RndAttack(attacker, target, true, element, add_atk, 1.0f);
+}
+
+uint32_t RndMagicalAttack(BattleActor* attacker, BattleTarget* target, GLOBAL_ELEMENTAL element,
+                          uint32_t add_atk, float mul_atk)
+{
+    return _RndAttack(attacker, target, true, element, add_atk, mul_atk);
+}
+
 } // namespace private_battle
 
 } // namespace vt_battle
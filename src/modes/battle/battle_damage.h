@@ -90,6 +90,37 @@ uint32_t RndMagicalDamage(BattleActor* attacker,
                           BattleActor* target_actor,
                           vt_global::GLOBAL_ELEMENTAL element);
 
+/** \brief Evaluates a physical attack on every actor of a target in one call
+*** \param attacker A pointer to the attacker who is causing the damage
+*** \param target A pointer to the target, which can be an attack point, an actor or a whole party
+*** \param add_atk A modifier value to be added to the standard attack.
+*** \param mul_atk A modifier value to be multiplied to the standard attack.
+*** \return The number of actors hit
+***
+*** Each living actor of the target either evades the attack, or receives its damage.
+*** The hit actors are then available through BattleTarget::GetHitActor(), for the scripts
+*** to apply their own effects on them.
+**/
+uint32_t RndPhysicalAttack(BattleActor* attacker, BattleTarget* target, uint32_t add_atk, float mul_atk);
+
+// Aliases
+//! Useful to make it work with luabind, as it doesn't function with default parameters.
+uint32_t RndPhysicalAttack(BattleActor* attacker, BattleTarget* target, uint32_t add_atk);
+uint32_t RndPhysicalAttack(BattleActor* attacker, BattleTarget* target);
+
+/** \brief Evaluates a magical attack on every actor of a target in one call
+*** \param element The element used when attacking using magic.
+*** \see RndPhysicalAttack()
+**/
+uint32_t RndMagicalAttack(BattleActor* attacker, BattleTarget* target, vt_global::GLOBAL_ELEMENTAL element,
+                          uint32_t add_atk, float mul_atk);
+
+// Aliases
+//! Useful to make it work with luabind, as it doesn't function with default parameters.
+uint32_t RndMagicalAttack(BattleActor* attacker, BattleTarget* target, vt_global::GLOBAL_ELEMENTAL element,
+                          uint32_t add_atk);
+uint32_t RndMagicalAttack(BattleActor* attacker, BattleTarget* target, vt_global::GLOBAL_ELEMENTAL element);
+
 } // namespace private_battle
 
 } // namespace vt_battle
@@ -10,6 +10,8 @@
 
 #include "modes/battle/battle_item.h"
 
+#include "engine/script_profiler.h"
+
 namespace vt_battle
 {
 
@@ -57,6 +59,7 @@ bool BattleItem::ExecuteBattleFunction(BattleActor* battle_actor,
 
     bool return_value = true;
     try {
+        vt_system::ScriptProfilerCall profiler_call(battle_use_function);
         return_value = luabind::call_function<bool>(battle_use_function, battle_actor, target);
     } catch(const luabind::error& err) {
         vt_script::ScriptManager->HandleLuaError(err);
@@ -0,0 +1,490 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_simulator.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the headless battle simulator
+*** ***************************************************************************/
+
+#include "modes/battle/battle_simulator.h"
+
+#include "modes/battle/battle.h"
+
+#include "common/app_settings.h"
+#include "common/global/global.h"
+#include "common/global/actors/global_character.h"
+#include "common/global/save/save_game_data.h"
+
+#include "engine/mode_manager.h"
+#include "engine/script_profiler.h"
+#include "engine/system.h"
+#include "engine/video/video.h"
+
+#include "utils/utils_strings.h"
+
+#include <SDL2/SDL_cpuinfo.h>
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_timer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+using namespace vt_global;
+using namespace vt_mode_manager;
+using namespace vt_system;
+using namespace vt_utils;
+
+namespace vt_battle
+{
+
+//! \brief The number of Lua functions printed with the results.
+const uint32_t SIMULATION_PRINTED_SCRIPT_CALLS = 10;
+
+//! \brief The names of the simulation phases, as written in the results files.
+static const char* _phase_names[SIMULATION_PHASE_TOTAL] = {
+    "setup", "ai", "skills", "status_effects", "other"
+};
+
+BattleSimulationSettings::BattleSimulationSettings():
+    battles(100),
+    workers(0),
+    seed(0),
+    max_battle_time(10 * 60 * 1000)
+{
+}
+
+BattleSimulationResults::BattleSimulationResults():
+    victories(0),
+    defeats(0),
+    timeouts(0),
+    total_battle_time(0),
+    updates(0),
+    wall_time(0.0)
+{
+    for (uint32_t i = 0; i < SIMULATION_PHASE_TOTAL; ++i)
+        phase_times[i] = 0.0;
+}
+
+void BattleSimulationResults::Add(const BattleSimulationResults& results)
+{
+    victories += results.victories;
+    defeats += results.defeats;
+    timeouts += results.timeouts;
+    total_battle_time += results.total_battle_time;
+    updates += results.updates;
+    for (uint32_t i = 0; i < SIMULATION_PHASE_TOTAL; ++i)
+        phase_times[i] += results.phase_times[i];
+
+    for (auto it = results.script_calls.begin(); it != results.script_calls.end(); ++it) {
+        BattleSimulationScriptCall& call = script_calls[it->first];
+        call.calls += it->second.calls;
+        call.time += it->second.time;
+    }
+}
+
+void BattleSimulationResults::Write(SaveGameNode& node) const
+{
+    node.SetTable();
+    node.AddField("victories")->SetInteger(victories);
+    node.AddField("defeats")->SetInteger(defeats);
+    node.AddField("timeouts")->SetInteger(timeouts);
+    node.AddField("total_battle_time")->SetInteger(static_cast<int64_t>(total_battle_time));
+    node.AddField("updates")->SetInteger(static_cast<int64_t>(updates));
+
+    SaveGameNode* phases = node.AddField("phase_times");
+    phases->SetTable();
+    for (uint32_t i = 0; i < SIMULATION_PHASE_TOTAL; ++i)
+        phases->AddField(_phase_names[i])->SetNumber(phase_times[i]);
+
+    SaveGameNode* calls = node.AddField("script_calls");
+    calls->SetTable();
+    for (auto it = script_calls.begin(); it != script_calls.end(); ++it) {
+        SaveGameNode* call = calls->AddField(it->first);
+        call->SetTable();
+        call->AddField("calls")->SetInteger(static_cast<int64_t>(it->second.calls));
+        call->AddField("time")->SetNumber(it->second.time);
+    }
+}
+
+//! \brief Reads a number from a simulation file table, or returns the default value.
+static double _ReadNumber(const SaveGameNode* table, const std::string& key, double default_value)
+{
+    const SaveGameNode* node = table->GetField(key);
+    return (node != nullptr && node->IsNumber()) ? node->GetNumber() : default_value;
+}
+
+bool BattleSimulationResults::Read(const SaveGameNode& node)
+{
+    if (!node.IsTable())
+        return false;
+
+    *this = BattleSimulationResults();
+    victories = static_cast<uint32_t>(_ReadNumber(&node, "victories", 0.0));
+    defeats = static_cast<uint32_t>(_ReadNumber(&node, "defeats", 0.0));
+    timeouts = static_cast<uint32_t>(_ReadNumber(&node, "timeouts", 0.0));
+    total_battle_time = static_cast<uint64_t>(_ReadNumber(&node, "total_battle_time", 0.0));
+    updates = static_cast<uint64_t>(_ReadNumber(&node, "updates", 0.0));
+
+    const SaveGameNode* phases = node.GetField("phase_times");
+    if (phases != nullptr && phases->IsTable()) {
+        for (uint32_t i = 0; i < SIMULATION_PHASE_TOTAL; ++i)
+            phase_times[i] = _ReadNumber(phases, _phase_names[i], 0.0);
+    }
+
+    const SaveGameNode* calls = node.GetField("script_calls");
+    if (calls != nullptr && calls->IsTable()) {
+        const std::map<std::string, std::unique_ptr<SaveGameNode> >& fields = calls->GetFields();
+        for (auto it = fields.begin(); it != fields.end(); ++it) {
+            if (!it->second->IsTable())
+                continue;
+            BattleSimulationScriptCall& call = script_calls[it->first];
+            call.calls = static_cast<uint64_t>(_ReadNumber(it->second.get(), "calls", 0.0));
+            call.time = _ReadNumber(it->second.get(), "time", 0.0);
+        }
+    }
+    return true;
+}
+
+BattleSimulator::BattleSimulator(const BattleSimulationSettings& settings):
+    _settings(settings)
+{
+}
+
+bool BattleSimulator::Run(const std::string& program_filename, const std::string& settings_filename)
+{
+    _results = BattleSimulationResults();
+
+    uint32_t worker_count = _settings.workers;
+    if (worker_count == 0)
+        worker_count = static_cast<uint32_t>(SDL_GetCPUCount());
+    if (worker_count > _settings.battles)
+        worker_count = _settings.battles;
+    if (worker_count == 0)
+        return true;
+
+    std::vector<std::string> results_filenames(worker_count);
+    std::vector<SimulationWorker> workers(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        results_filenames[i] = vt_common::GetUserDataPath() + "battle_simulation_"
+                               + NumberToString<uint32_t>(i) + ".lua";
+        remove(results_filenames[i].c_str());
+
+        // Each worker runs the game engine offscreen, without audio.
+        workers[i].command = "\"" + program_filename + "\" --offscreen --disable-audio --simulation-worker \""
+                             + settings_filename + "\" " + NumberToString<uint32_t>(i) + " "
+                             + NumberToString<uint32_t>(worker_count) + " \"" + results_filenames[i] + "\"";
+#ifdef _WIN32
+        // The command interpreter removes the outer quotes.
+        workers[i].command = "\"" + workers[i].command + "\"";
+#endif
+        workers[i].exit_code = EXIT_FAILURE;
+    }
+
+    uint64_t start = SDL_GetPerformanceCounter();
+
+    // Each thread waits for its worker process.
+    std::vector<SDL_Thread*> threads(worker_count, nullptr);
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        threads[i] = SDL_CreateThread(_ThreadFunction, "BattleSimulator", &workers[i]);
+        if (threads[i] == nullptr) {
+            PRINT_WARNING << "Couldn't create a battle simulator thread: " << SDL_GetError() << std::endl;
+            _ThreadFunction(&workers[i]);
+        }
+    }
+
+    bool succeeded = true;
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        if (threads[i] != nullptr)
+            SDL_WaitThread(threads[i], nullptr);
+
+        SaveGameNode root;
+        const SaveGameNode* results = nullptr;
+        if (workers[i].exit_code == EXIT_SUCCESS && ReadSaveGameFile(results_filenames[i], root))
+            results = root.GetField("results");
+
+        BattleSimulationResults worker_results;
+        if (results == nullptr || !worker_results.Read(*results)) {
+            PRINT_WARNING << "The battle simulation worker " << i << " failed: " << workers[i].command << std::endl;
+            succeeded = false;
+        }
+        else {
+            _results.Add(worker_results);
+        }
+        remove(results_filenames[i].c_str());
+    }
+
+    _results.wall_time = (SDL_GetPerformanceCounter() - start) * 1000.0
+                         / static_cast<double>(SDL_GetPerformanceFrequency());
+    return succeeded;
+}
+
+int BattleSimulator::_ThreadFunction(void* data)
+{
+    SimulationWorker* worker = static_cast<SimulationWorker*>(data);
+    worker->exit_code = std::system(worker->command.c_str());
+    return 0;
+}
+
+bool BattleSimulator::RunWorker(uint32_t worker_index, uint32_t worker_count, const std::string& results_filename)
+{
+    _results = BattleSimulationResults();
+
+    if (!_SetUpParty())
+        return false;
+
+    for (uint32_t i = 0; i < _settings.enemies.size(); ++i) {
+        if (!GlobalManager->DoesEnemyExist(_settings.enemies[i])) {
+            PRINT_WARNING << "Invalid simulated enemy id: " << _settings.enemies[i] << std::endl;
+            return false;
+        }
+    }
+
+    SystemManager->GetProfiler().SetEnabled(true);
+    ScriptProfiler& script_profiler = SystemManager->GetScriptProfiler();
+    script_profiler.SetEnabled(true);
+
+    uint64_t start = SDL_GetPerformanceCounter();
+    for (uint32_t i = worker_index; i < _settings.battles; i += worker_count)
+        _PlayBattle(i);
+    _results.wall_time = (SDL_GetPerformanceCounter() - start) * 1000.0
+                         / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    const std::vector<ScriptCallStatistics>& statistics = script_profiler.GetStatistics();
+    for (uint32_t i = 0; i < statistics.size(); ++i) {
+        BattleSimulationScriptCall& call = _results.script_calls[statistics[i].name];
+        call.calls += statistics[i].calls;
+        call.time += statistics[i].total_counter * 1000.0 / frequency;
+    }
+
+    script_profiler.SetEnabled(false);
+    SystemManager->GetProfiler().SetEnabled(false);
+
+    SaveGameNode root;
+    _results.Write(*root.AddField("results"));
+    std::string text;
+    WriteLuaSaveGame(root, text);
+
+    std::ofstream file(results_filename.c_str(), std::ios::out | std::ios::trunc);
+    file << text;
+    file.close();
+    if (file.fail()) {
+        PRINT_WARNING << "Couldn't write the battle simulation results: " << results_filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool BattleSimulator::_SetUpParty()
+{
+    if (!_settings.save_game.empty()) {
+        if (!GlobalManager->LoadGame(_settings.save_game, 0)) {
+            PRINT_WARNING << "Couldn't load the simulation save game: " << _settings.save_game << std::endl;
+            return false;
+        }
+    }
+    else {
+        // The first characters added form the active party.
+        for (uint32_t i = 0; i < _settings.characters.size(); ++i)
+            GlobalManager->GetCharacterHandler().AddCharacter(_settings.characters[i]);
+    }
+
+    if (GlobalManager->GetCharacterHandler().GetActiveParty().IsPartyEmpty()) {
+        PRINT_WARNING << "The simulated party has no character." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void BattleSimulator::_PlayBattle(uint32_t battle_index)
+{
+    // Each battle has its own random numbers, whatever the worker playing it.
+    // The simulation seed is spread with Knuth's multiplicative hash, not to overlap the battle indices.
+    srand(_settings.seed * 2654435761u + battle_index);
+
+    // Every battle starts from the same party: the characters surviving a battle keep its status effects.
+    const std::vector<GlobalCharacter*>& characters =
+        GlobalManager->GetCharacterHandler().GetActiveParty().GetAllCharacters();
+    for (uint32_t i = 0; i < characters.size(); ++i)
+        characters[i]->ResetActiveStatusEffects();
+
+    uint64_t setup_start = SDL_GetPerformanceCounter();
+    BattleMode* battle = new BattleMode();
+    battle->SetHeadless(true);
+    for (uint32_t i = 0; i < _settings.enemies.size(); ++i)
+        battle->AddEnemy(_settings.enemies[i]);
+    _results.phase_times[SIMULATION_PHASE_SETUP] += (SDL_GetPerformanceCounter() - setup_start) * 1000.0
+                                                    / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    // The previous battle is deleted when the new one is pushed, on the next update.
+    if (ModeManager->GetTop() != nullptr)
+        ModeManager->Pop(false, false);
+    ModeManager->Push(battle, false, false);
+
+    FrameProfiler& profiler = SystemManager->GetProfiler();
+    uint32_t battle_time = 0;
+    while (true) {
+        // Each update is recorded as a profiler frame, to get the time spent in each phase.
+        SystemManager->UpdateTimers();
+        profiler.BeginFrame();
+        vt_video::VideoManager->Update();
+        ModeManager->Update();
+        profiler.EndFrame();
+        ++_results.updates;
+
+        double update_time = 0.0;
+        double nested_time = 0.0;
+        const std::vector<ProfilerZoneRecord>& zones = profiler.GetFrame(0).zones;
+        for (uint32_t i = 0; i < zones.size(); ++i) {
+            const double zone_time = profiler.CounterToMilliseconds(zones[i].end - zones[i].start);
+            SIMULATION_PHASE phase = SIMULATION_PHASE_TOTAL;
+            if (strcmp(zones[i].name, "BattleMode::Update") == 0) {
+                update_time += zone_time;
+                continue;
+            }
+            else if (strcmp(zones[i].name, "BattleMode::Reset") == 0) {
+                phase = SIMULATION_PHASE_SETUP;
+            }
+            else if (strcmp(zones[i].name, "BattleAISupervisor::Update") == 0) {
+                phase = SIMULATION_PHASE_AI;
+            }
+            else if (strcmp(zones[i].name, "GlobalSkill::ExecuteBattleFunction") == 0) {
+                phase = SIMULATION_PHASE_SKILLS;
+            }
+            else if (strcmp(zones[i].name, "BattleStatusEffectsSupervisor::Update") == 0) {
+                phase = SIMULATION_PHASE_STATUS_EFFECTS;
+            }
+            else {
+                continue;
+            }
+
+            _results.phase_times[phase] += zone_time;
+            if (phase != SIMULATION_PHASE_SETUP)
+                nested_time += zone_time;
+        }
+        // The other phases are all run within the battle update.
+        _results.phase_times[SIMULATION_PHASE_OTHER] += std::max(update_time - nested_time, 0.0);
+
+        if (battle->IsBattleFinished()) {
+            if (battle->GetState() == private_battle::BATTLE_STATE_VICTORY)
+                ++_results.victories;
+            else
+                ++_results.defeats;
+            break;
+        }
+
+        battle_time += SystemManager->GetUpdateTime();
+        if (battle_time > _settings.max_battle_time) {
+            ++_results.timeouts;
+            break;
+        }
+    }
+
+    _results.total_battle_time += battle_time;
+}
+
+void BattleSimulator::PrintResults() const
+{
+    const uint32_t battles = _results.victories + _results.defeats + _results.timeouts;
+    if (battles == 0) {
+        std::cout << "No battle was simulated." << std::endl;
+        return;
+    }
+
+    double total_time = 0.0;
+    for (uint32_t i = 0; i < SIMULATION_PHASE_TOTAL; ++i)
+        total_time += _results.phase_times[i];
+    if (total_time <= 0.0)
+        total_time = 1.0;
+
+    const char* phase_names[SIMULATION_PHASE_TOTAL] = { "Setup", "AI", "Skills", "Status effects", "Other" };
+
+    std::cout << "Battle simulation: " << battles << " battles against " << _settings.enemies.size() << " enemies" << std::endl
+              << "  Victories: " << _results.victories << " (" << (100.0 * _results.victories / battles) << " %)" << std::endl
+              << "  Defeats:   " << _results.defeats << " (" << (100.0 * _results.defeats / battles) << " %)" << std::endl
+              << "  Timeouts:  " << _results.timeouts << " (" << (100.0 * _results.timeouts / battles) << " %)" << std::endl
+              << "  Average battle time: " << (_results.total_battle_time / 1000.0 / battles) << " s" << std::endl
+              << "  Average updates:     " << (static_cast<double>(_results.updates) / battles) << std::endl
+              << "  Simulated in " << _results.wall_time << " ms ("
+              << (battles * 1000.0 / (_results.wall_time > 0.0 ? _results.wall_time : 1.0)) << " battles/s)" << std::endl;
+
+    for (uint32_t i = 0; i < SIMULATION_PHASE_TOTAL; ++i) {
+        std::cout << "  " << phase_names[i] << ": " << _results.phase_times[i] << " ms CPU ("
+                  << (100.0 * _results.phase_times[i] / total_time) << " %)" << std::endl;
+    }
+
+    // The Lua functions the battles spent the most time in.
+    std::vector<std::pair<double, std::string> > script_times;
+    for (auto it = _results.script_calls.begin(); it != _results.script_calls.end(); ++it)
+        script_times.push_back(std::make_pair(it->second.time, it->first));
+    std::sort(script_times.rbegin(), script_times.rend());
+    if (script_times.size() > SIMULATION_PRINTED_SCRIPT_CALLS)
+        script_times.resize(SIMULATION_PRINTED_SCRIPT_CALLS);
+
+    if (!script_times.empty())
+        std::cout << "  Slowest Lua functions:" << std::endl;
+    for (uint32_t i = 0; i < script_times.size(); ++i) {
+        const BattleSimulationScriptCall& call = _results.script_calls.find(script_times[i].second)->second;
+        std::cout << "    " << script_times[i].second << ": " << call.time << " ms, "
+                  << call.calls << " calls" << std::endl;
+    }
+}
+
+bool BattleSimulator::_LoadIds(const SaveGameNode* table, std::vector<uint32_t>& ids)
+{
+    if (table == nullptr || !table->IsTable())
+        return false;
+
+    const std::map<int64_t, std::unique_ptr<SaveGameNode> >& items = table->GetItems();
+    for (auto it = items.begin(); it != items.end(); ++it) {
+        if (!it->second->IsNumber() || it->second->GetInteger() <= 0)
+            return false;
+        ids.push_back(static_cast<uint32_t>(it->second->GetInteger()));
+    }
+    return !ids.empty();
+}
+
+bool BattleSimulator::LoadSettings(const std::string& filename, BattleSimulationSettings& settings)
+{
+    SaveGameNode root;
+    if (!ReadSaveGameFile(filename, root)) {
+        PRINT_WARNING << "Couldn't read the battle simulation file: " << filename << std::endl;
+        return false;
+    }
+
+    const SaveGameNode* simulation = root.GetField("simulation");
+    if (simulation == nullptr || !simulation->IsTable()) {
+        PRINT_WARNING << "No 'simulation' table in: " << filename << std::endl;
+        return false;
+    }
+
+    settings = BattleSimulationSettings();
+
+    const SaveGameNode* save_game = simulation->GetField("save_game");
+    if (save_game != nullptr)
+        settings.save_game = save_game->GetString();
+
+    if ((settings.save_game.empty() && !_LoadIds(simulation->GetField("characters"), settings.characters))
+            || !_LoadIds(simulation->GetField("enemies"), settings.enemies)) {
+        PRINT_WARNING << "Invalid 'characters' or 'enemies' ids table in: " << filename << std::endl;
+        return false;
+    }
+
+    settings.battles = static_cast<uint32_t>(_ReadNumber(simulation, "battles", settings.battles));
+    settings.workers = static_cast<uint32_t>(_ReadNumber(simulation, "workers", settings.workers));
+    settings.seed = static_cast<uint32_t>(_ReadNumber(simulation, "seed", settings.seed));
+    settings.max_battle_time = static_cast<uint32_t>(_ReadNumber(simulation, "max_battle_time", settings.max_battle_time));
+    return true;
+}
+
+} // namespace vt_battle
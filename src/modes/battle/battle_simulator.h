@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_simulator.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the headless battle simulator
+***
+*** The battle simulator plays many battles between the party and enemies given
+*** by their ids, without the player nor anything drawn, and as fast as possible.
+*** It permits to balance the game, and to benchmark the combat core:
+***
+*** \code
+*** valyriatear --simulate-battles data/debug/battle_simulation.lua
+*** \endcode
+***
+*** The battles are real battle modes, made headless: the characters and enemies
+*** are the game actors, using their skills, status effects and AI scripts, while
+*** the characters commands are given by the auto-battle.
+***
+*** As the script engine and the game state are shared by the whole game, the
+*** battles are spread over worker processes, each one running the game engine
+*** offscreen and without audio, with its own Lua state. Each battle seeds the
+*** random numbers from the simulation seed and its index, so that the results
+*** don't depend on the number of workers.
+*** ***************************************************************************/
+
+#ifndef __BATTLE_SIMULATOR_HEADER__
+#define __BATTLE_SIMULATOR_HEADER__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vt_global
+{
+class SaveGameNode;
+}
+
+namespace vt_battle
+{
+
+//! \brief The simulation parameters.
+struct BattleSimulationSettings {
+    BattleSimulationSettings();
+
+    //! \brief The ids of the party characters. Unused when a save game is given.
+    std::vector<uint32_t> characters;
+
+    //! \brief The save game whose active party fights, if any.
+    std::string save_game;
+
+    //! \brief The ids of the enemies of each battle.
+    std::vector<uint32_t> enemies;
+
+    //! \brief The number of battles to simulate.
+    uint32_t battles;
+
+    //! \brief The number of worker processes to use. 0 to use one per CPU.
+    uint32_t workers;
+
+    //! \brief The seed of the battles random numbers.
+    uint32_t seed;
+
+    //! \brief The battle time after which a battle is considered lost, in milliseconds.
+    uint32_t max_battle_time;
+};
+
+//! \brief The battle phases whose CPU cost is measured.
+enum SIMULATION_PHASE {
+    //! \brief Creating the battle, its actors, and resetting it.
+    SIMULATION_PHASE_SETUP = 0,
+    //! \brief Taking the enemies AI decisions.
+    SIMULATION_PHASE_AI = 1,
+    //! \brief Executing the skills.
+    SIMULATION_PHASE_SKILLS = 2,
+    //! \brief Updating the status effects.
+    SIMULATION_PHASE_STATUS_EFFECTS = 3,
+    //! \brief The rest of the battle updates: actors states, sequences and animations.
+    SIMULATION_PHASE_OTHER = 4,
+    SIMULATION_PHASE_TOTAL = 5
+};
+
+//! \brief The time spent in a Lua function during the simulation.
+struct BattleSimulationScriptCall {
+    BattleSimulationScriptCall():
+        calls(0),
+        time(0.0)
+    {}
+
+    uint64_t calls;
+
+    //! \brief The total time spent, in milliseconds.
+    double time;
+};
+
+//! \brief The simulation results.
+struct BattleSimulationResults {
+    BattleSimulationResults();
+
+    //! \brief Adds the results of other battles.
+    void Add(const BattleSimulationResults& results);
+
+    //! \brief Writes the results into a save game node, to be given to the simulator.
+    void Write(vt_global::SaveGameNode& node) const;
+
+    //! \brief Reads results written by Write(). \return false if the node is invalid.
+    bool Read(const vt_global::SaveGameNode& node);
+
+    uint32_t victories;
+    uint32_t defeats;
+
+    //! \brief The battles that lasted longer than the maximum battle time.
+    uint32_t timeouts;
+
+    //! \brief The sum of the battles durations, in game milliseconds.
+    uint64_t total_battle_time;
+
+    //! \brief The number of battle updates run.
+    uint64_t updates;
+
+    //! \brief The CPU time spent in each battle phase, in milliseconds.
+    double phase_times[SIMULATION_PHASE_TOTAL];
+
+    //! \brief The time spent in each Lua function called, by function name.
+    std::map<std::string, BattleSimulationScriptCall> script_calls;
+
+    //! \brief The wall clock duration of the simulation, in milliseconds.
+    double wall_time;
+};
+
+/** ****************************************************************************
+*** \brief Plays many headless battles in worker processes, and gathers their results.
+***
+*** The simulator runs the workers before the game engine is initialized.
+*** Each worker then initializes the engine, and calls RunWorker().
+*** ***************************************************************************/
+class BattleSimulator
+{
+public:
+    explicit BattleSimulator(const BattleSimulationSettings& settings);
+
+    /** \brief Starts the workers, and waits until they're all done.
+    *** \param program_filename The game executable, started for each worker.
+    *** \param settings_filename The simulation file, given to the workers.
+    *** \return false if a worker failed.
+    **/
+    bool Run(const std::string& program_filename, const std::string& settings_filename);
+
+    /** \brief Plays the battles of a worker, and writes their results.
+    *** It must be called once the engine is initialized, and before any game mode is pushed.
+    *** \param worker_index The worker index: it plays the battles worker_index, worker_index + worker_count, ...
+    *** \param worker_count The number of workers.
+    *** \param results_filename The file the results are written to.
+    *** \return false if the party or the enemies couldn't be set up.
+    **/
+    bool RunWorker(uint32_t worker_index, uint32_t worker_count, const std::string& results_filename);
+
+    const BattleSimulationResults& GetResults() const {
+        return _results;
+    }
+
+    //! \brief Prints the results of the last run.
+    void PrintResults() const;
+
+    /** \brief Reads the simulation settings from a Lua data file.
+    *** The file defines a 'simulation' table with the 'characters' and 'enemies' ids.
+    *** \see data/debug/battle_simulation.lua
+    *** \return false if the file is invalid.
+    **/
+    static bool LoadSettings(const std::string& filename, BattleSimulationSettings& settings);
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    BattleSimulator(const BattleSimulator& simulator);
+    BattleSimulator& operator=(const BattleSimulator& simulator);
+
+    //! \brief A worker process started by the simulator.
+    struct SimulationWorker {
+        //! \brief The command line starting the worker.
+        std::string command;
+
+        //! \brief The worker exit code.
+        int exit_code;
+    };
+
+    //! \brief The thread function starting a worker process and waiting for it.
+    static int _ThreadFunction(void* data);
+
+    //! \brief Sets up the party fighting the battles. \return false if it is empty.
+    bool _SetUpParty();
+
+    //! \brief Plays a single battle, and adds its outcome to the results.
+    void _PlayBattle(uint32_t battle_index);
+
+    //! \brief Reads an ids table from the simulation file.
+    static bool _LoadIds(const vt_global::SaveGameNode* table, std::vector<uint32_t>& ids);
+
+    BattleSimulationSettings _settings;
+
+    BattleSimulationResults _results;
+};
+
+} // namespace vt_battle
+
+#endif // __BATTLE_SIMULATOR_HEADER__
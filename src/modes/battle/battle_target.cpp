@@ -43,6 +43,8 @@ BattleTarget::BattleTarget(const BattleTarget& copy)
     for (uint32_t i = 0; i < copy._party_target.size(); ++i) {
         _party_target.push_back(copy._party_target[i]);
     }
+
+    _hit_actors = copy._hit_actors;
 }
 
 BattleTarget& BattleTarget::operator=(const BattleTarget& copy)
@@ -59,6 +61,8 @@ BattleTarget& BattleTarget::operator=(const BattleTarget& copy)
         _party_target.push_back(copy._party_target[i]);
     }
 
+    _hit_actors = copy._hit_actors;
+
     return *this;
 }
 
@@ -68,6 +72,7 @@ void BattleTarget::InvalidateTarget()
     _attack_point = 0;
     _actor_target = nullptr;
     _party_target.clear();
+    _hit_actors.clear();
 }
 
 bool BattleTarget::SetTarget(BattleActor* attacker, vt_global::GLOBAL_TARGET type, BattleActor* target, uint32_t attack_point)
@@ -283,6 +288,14 @@ BattleActor* BattleTarget::GetPartyActor(uint32_t index)
     return _party_target.at(index);
 }
 
+BattleActor* BattleTarget::GetHitActor(uint32_t index)
+{
+    if (index >= _hit_actors.size())
+        return nullptr;
+
+    return _hit_actors[index];
+}
+
 ustring BattleTarget::GetName()
 {
     switch(_type) {
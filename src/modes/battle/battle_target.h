@@ -14,6 +14,7 @@
 #include "modes/battle/objects/battle_actor.h"
 
 #include <deque>
+#include <vector>
 
 namespace vt_battle
 {
@@ -118,6 +119,26 @@ public:
     **/
     BattleActor* GetPartyActor(uint32_t index);
 
+    /** \brief Retrieves a pointer to an actor hit by the last attack evaluated on the whole target
+    *** \param index The location in the hit actors container of the actor to retrieve
+    *** \return nullptr if the index is invalid. Otherwise a pointer to the hit actor specified
+    ***
+    *** Once an attack is evaluated on every actor of the target in one call, the Lua code uses this function
+    *** the same way as GetPartyActor() to apply the effects specific to each hit actor.
+    *** \see RndPhysicalAttack(), RndMagicalAttack()
+    **/
+    BattleActor* GetHitActor(uint32_t index);
+
+    //! \brief Adds an actor hit by the attack evaluated on the target.
+    void AddHitActor(BattleActor* actor) {
+        _hit_actors.push_back(actor);
+    }
+
+    //! \brief Forgets the actors hit by the previous attack. Called before evaluating a new one.
+    void ClearHitActors() {
+        _hit_actors.clear();
+    }
+
     /** \brief Returns the name of the target
     ***
     *** Party type targets will return "All Allies" or "All Enemies". Actor type targets return the name of the character or
@@ -143,6 +164,10 @@ public:
     const std::deque<BattleActor *>& GetPartyTarget() const {
         return _party_target;
     }
+
+    const std::vector<BattleActor *>& GetHitActors() const {
+        return _hit_actors;
+    }
     //@}
 
 private:
@@ -157,6 +182,9 @@ private:
 
     //! \brief The current party to target
     std::deque<BattleActor *> _party_target;
+
+    //! \brief The actors hit by the last attack evaluated on the target
+    std::vector<BattleActor *> _hit_actors;
 };
 
 } // namespace private_battle
@@ -11,12 +11,14 @@
 #include "modes/battle/objects/battle_actor.h"
 
 #include "modes/battle/battle.h"
+#include "modes/battle/battle_ai.h"
 #include "modes/battle/status_effects/status_effects_supervisor.h"
 #include "modes/battle/actions/skill_action.h"
 #include "modes/battle/battle_target.h"
 
 #include "common/global/actors/global_attack_point.h"
 #include "common/global/global_skills.h"
+#include "engine/script_profiler.h"
 
 #include "utils/utils_random.h"
 
@@ -57,7 +59,9 @@ BattleActor::BattleActor(GlobalActor *actor) :
     _sprite_alpha(1.0f),
     _animation_timer(0),
     _stamina_location(0.0f, 0.0f),
-    _effects_supervisor(new BattleStatusEffectsSupervisor(this))
+    _previous_stamina_location(0.0f, 0.0f),
+    _effects_supervisor(new BattleStatusEffectsSupervisor(this)),
+    _ai(nullptr)
 {
     if(actor == nullptr) {
         IF_PRINT_WARNING(BATTLE_DEBUG) << "constructor received nullptr argument" << std::endl;
@@ -101,7 +105,7 @@ BattleActor::~BattleActor()
     // Reset the luabind objects so their lua counterparts can be freed
     // when the lua script coroutine is removed from stack,
     // to avoid a potential segfault.
-    _ai_decide_action = luabind::object();
+    _ai_state = luabind::object();
     _death_init = luabind::object();
     _death_update = luabind::object();
     _death_draw_on_sprite = luabind::object();
@@ -154,21 +158,9 @@ void BattleActor::ChangeState(ACTOR_STATE new_state)
     _state_timer.Reset();
     switch(_state) {
     case ACTOR_STATE_COMMAND:
-        // If an AI is used, it will change itself the actor state.
-        if (_ai_decide_action.is_valid()) {
-            try {
-                luabind::call_function<void>(_ai_decide_action, BattleMode::CurrentInstance(), this);
-            } catch(const luabind::error &e) {
-                PRINT_ERROR << "Error while triggering DecideAction() function of actor id: " << _global_actor->GetID() << std::endl;
-                ScriptManager->HandleLuaError(e);
-                // Make the actor keep on anyway.
-                _DecideAction();
-            } catch(const luabind::cast_failed &e) {
-                PRINT_ERROR << "Error while triggering DecideAction() function of actor id: " << _global_actor->GetID() << std::endl;
-                ScriptManager->HandleCastError(e);
-                // Make the actor keep on anyway.
-                _DecideAction();
-            }
+        // If an AI is used, it will change itself the actor state once its decision is taken.
+        if (_ai) {
+            BattleMode::CurrentInstance()->GetAISupervisor()->RequestDecision(this);
         }
         else if (!_global_actor->GetBattleAIScriptFilename().empty()) {
             // Hardcoded fallback behaviour for AI-based actors.
@@ -221,6 +213,7 @@ void BattleActor::ChangeState(ACTOR_STATE new_state)
         // Init the death animation script when valid.
         if (_death_init.is_valid()) {
             try {
+                vt_system::ScriptProfilerCall profiler_call(_death_init);
                 luabind::call_function<void>(_death_init, BattleMode::CurrentInstance(), this);
             } catch(const luabind::error &e) {
                 PRINT_ERROR << "Error while triggering Initialize() function of actor id: " << _global_actor->GetID() << std::endl;
@@ -453,6 +446,31 @@ vt_video::TextStyle BattleActor::_GetHealingTextStyle(uint32_t amount, bool is_h
     return style;
 }
 
+const BattleStatCache& BattleActor::GetStatCache()
+{
+    if(_stat_cache.valid)
+        return _stat_cache;
+
+    _stat_cache.average_physical_defense = GetAverageDefense();
+    for(uint32_t i = 0; i < GLOBAL_ELEMENTAL_TOTAL; ++i)
+        _stat_cache.average_magical_defense[i] = GetAverageMagicalDefense(static_cast<GLOBAL_ELEMENTAL>(i));
+    _stat_cache.average_evade_rating = GetAverageEvadeRating();
+    _stat_cache.valid = true;
+    return _stat_cache;
+}
+
+void BattleActor::_CalculateDefenseRatings()
+{
+    GlobalActor::_CalculateDefenseRatings();
+    _stat_cache.valid = false;
+}
+
+void BattleActor::_CalculateEvadeRatings()
+{
+    GlobalActor::_CalculateEvadeRatings();
+    _stat_cache.valid = false;
+}
+
 void BattleActor::RegisterMiss(bool was_attacked)
 {
     // Set the indicator parameters
@@ -491,6 +509,7 @@ void BattleActor::_UpdateState()
         if (_death_init.is_valid() && _death_update.is_valid()) {
             // Change the state when the animation has finished.
             try {
+                vt_system::ScriptProfilerCall profiler_call(_death_update);
                 if (luabind::call_function<bool>(_death_update))
                     ChangeState(ACTOR_STATE_DEAD);
             } catch(const luabind::error &e) {
@@ -649,12 +668,19 @@ void BattleActor::_UpdateStaminaIconPosition()
     _stamina_location = pos;
 }
 
+void BattleActor::StorePreviousLocation()
+{
+    BattleObject::StorePreviousLocation();
+    _previous_stamina_location = _stamina_location;
+}
+
 void BattleActor::DrawStaminaIcon(const vt_video::Color &color) const
 {
     if(!IsAlive())
         return;
 
-    VideoManager->Move(_stamina_location.x, _stamina_location.y);
+    Position2D draw_location = GetInterpolatedLocation(_previous_stamina_location, _stamina_location);
+    VideoManager->Move(draw_location.x, draw_location.y);
     // Make the stamina icon fade away when dying
     if(_state == ACTOR_STATE_DYING)
         _stamina_icon.Draw(Color(color.GetRed(), color.GetGreen(),
@@ -804,20 +830,21 @@ void BattleActor::_LoadAIScript()
     if (filename.empty())
         return;
 
-    std::string tablespace = ScriptEngine::GetTableSpace(filename);
-    ScriptManager->DropGlobalTable(tablespace);
-
-    if(!_ai_script.OpenFile(filename))
-        return;
+    // The AI files are loaded once per battle, and shared by the actors using them.
+    _ai = BattleMode::CurrentInstance()->GetAISupervisor()->GetAI(filename);
+    if (_ai && _ai->IsScripted())
+        _ai_state = luabind::newtable(ScriptManager->GetGlobalState());
+}
 
-    if(_ai_script.OpenTablespace().empty()) {
-        PRINT_ERROR << "The actor battle AI script file: " << filename
-                    << "has got no valid namespace" << std::endl;
-        _ai_script.CloseFile();
+void BattleActor::DecideAIAction()
+{
+    // The actor may have changed its state since the decision was requested.
+    if (_ai == nullptr || _state != ACTOR_STATE_COMMAND)
         return;
-    }
 
-    _ai_decide_action = _ai_script.ReadFunctionPointer("DecideAction");
+    // Make the actor keep on anyway.
+    if (!_ai->DecideAction(this, _ai_state))
+        _DecideAction();
 }
 
 void BattleActor::_DecideAction()
@@ -25,6 +25,7 @@ namespace private_battle
 {
 
 class BattleAction;
+class BattleAI;
 class BattleStatusEffectsSupervisor;
 
 //! \brief Represents the possible states that a BattleActor may be in
@@ -45,6 +46,25 @@ enum ACTOR_STATE {
     ACTOR_STATE_TOTAL         =  12
 };
 
+//! \brief The averages of the attack points ratings of an actor, used by the damage formulas.
+struct BattleStatCache {
+    BattleStatCache():
+        valid(false),
+        average_physical_defense(0),
+        average_evade_rating(0.0f)
+    {
+        for(uint32_t i = 0; i < vt_global::GLOBAL_ELEMENTAL_TOTAL; ++i)
+            average_magical_defense[i] = 0;
+    }
+
+    //! \brief Whether the values are up to date with the actor stats.
+    bool valid;
+
+    uint32_t average_physical_defense;
+    uint32_t average_magical_defense[vt_global::GLOBAL_ELEMENTAL_TOTAL];
+    float average_evade_rating;
+};
+
 /** \brief An abstract class for representing an actor in the battle
 ***
 *** An "actor" is a term used to represent both characters and enemies in battle.
@@ -241,6 +261,9 @@ public:
     **/
     virtual void Update();
 
+    //! \brief Stores the actor and stamina icon locations before a logic update.
+    virtual void StorePreviousLocation();
+
     //! \brief Draws the stamina icon - default implementation
     virtual void DrawStaminaIcon(const vt_video::Color &color = vt_video::Color::white) const;
 
@@ -329,6 +352,21 @@ public:
         return _global_actor;
     }
 
+    /** \brief Returns the averages of the attack points defense and evade ratings.
+    *** They are only computed again once the actor stats changed, from equipment or status effects.
+    **/
+    const BattleStatCache& GetStatCache();
+
+    //! \brief Tells whether the actor decisions are taken by a battle AI.
+    bool HasAI() const {
+        return _ai != nullptr;
+    }
+
+    /** \brief Makes the battle AI decide the actor next action.
+    *** Called by the battle AI supervisor, once the decision requested when entering the command state is due.
+    **/
+    void DecideAIAction();
+
     const std::string& GetAmmoAnimationFile() const {
         return _ammo_animation_file;
     }
@@ -393,6 +431,12 @@ protected:
     //! \brief The x and y coordinates of the actor's current stamina icon on the stamina bar.
     vt_common::Position2D _stamina_location;
 
+    //! \brief The stamina icon location before the last logic update, to interpolate the drawn location.
+    vt_common::Position2D _previous_stamina_location;
+
+    //! \brief The attack points ratings averages, computed on demand.
+    BattleStatCache _stat_cache;
+
     //! \brief An assistant class to the actor that manages all the actor's status and elemental effects
     BattleStatusEffectsSupervisor* _effects_supervisor;
 
@@ -404,15 +448,19 @@ protected:
     //! This function permits to draw something along with the Battle enemy sprite
     luabind::object _death_draw_on_sprite;
 
-    //! \brief The battle AI script.
-    vt_script::ReadScriptDescriptor _ai_script;
-    //! \brief The "DecideAction" ai script.
-    luabind::object _ai_decide_action;
+    //! \brief The battle AI, shared with the other actors using the same AI file.
+    BattleAI* _ai;
+    //! \brief The actor's own table, kept between the calls to the "DecideAction" AI function.
+    luabind::object _ai_state;
+
+    //! \brief Invalidates the stat cache along with the attack points ratings.
+    void _CalculateDefenseRatings() override;
+    void _CalculateEvadeRatings() override;
 
     //! \brief Loads the potential death animation scripted functions.
     void _LoadDeathAnimationScript();
 
-    //! \brief Loads the potential battle AI scripted function.
+    //! \brief Gets the potential battle AI from the battle AI supervisor.
     void _LoadAIScript();
 
     /** \brief Decides what action that the hero or enemy should execute and the target
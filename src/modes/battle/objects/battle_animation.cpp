@@ -21,14 +21,23 @@ namespace vt_battle
 namespace private_battle
 {
 
-BattleAnimation::BattleAnimation(const std::string& animation_filename):
+BattleAnimation::BattleAnimation(const std::string& animation_filename, const AnimatedImage& animation):
     BattleObject(),
+    _animation_filename(animation_filename),
+    _animation(animation),
     _visible(true),
     _can_be_removed(false)
 {
-    if(!_animation.LoadFromAnimationScript(animation_filename))
-        PRINT_WARNING << "Invalid battle animation file requested: "
-                      << animation_filename << std::endl;
+}
+
+void BattleAnimation::Recycle(const AnimatedImage& animation)
+{
+    // The scripts may have changed the color or the dimensions of the previous use.
+    _animation = animation;
+    _origin = vt_common::Position2D(0.0f, 0.0f);
+    _location = vt_common::Position2D(0.0f, 0.0f);
+    _visible = true;
+    _can_be_removed = false;
 }
 
 void BattleAnimation::DrawSprite()
@@ -36,7 +45,8 @@ void BattleAnimation::DrawSprite()
     if(!IsVisible() || CanBeRemoved())
         return;
 
-    VideoManager->Move(GetXLocation(), GetYLocation());
+    vt_common::Position2D draw_location = GetDrawLocation();
+    VideoManager->Move(draw_location.x, draw_location.y);
     _animation.Draw();
 }
 
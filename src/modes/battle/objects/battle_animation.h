@@ -26,7 +26,14 @@ namespace private_battle
 class BattleAnimation : public BattleObject
 {
 public:
-    BattleAnimation(const std::string& animation_filename);
+    /** \param animation_filename The animation definition file.
+    *** \param animation The animation loaded from this file, copied.
+    *** \see BattleEffectPool::GetAnimation()
+    **/
+    BattleAnimation(const std::string& animation_filename, const vt_video::AnimatedImage& animation);
+
+    //! \brief Makes a removed animation usable again, as if it had just been created.
+    void Recycle(const vt_video::AnimatedImage& animation);
 
     //! Used to be drawn at the right time by the battle mode.
     void DrawSprite();
@@ -63,14 +70,21 @@ public:
         return _animation;
     }
 
+    const std::string& GetAnimationFilename() const {
+        return _animation_filename;
+    }
+
 protected:
+    //! The animation definition file.
+    std::string _animation_filename;
+
     //! The particle effect class used internally
     vt_video::AnimatedImage _animation;
 
     //! Set whether the animation is drawn.
     bool _visible;
 
-    //! Set whether the animation can be removed from memory (now useless).
+    //! Set whether the animation can be given back to the effect pool (now useless).
     bool _can_be_removed;
 };
 
@@ -19,6 +19,7 @@
 #include "common/global/actors/global_character.h"
 #include "common/global/objects/global_weapon.h"
 
+#include "engine/script_profiler.h"
 #include "engine/video/text.h"
 
 #include "utils/utils_random.h"
@@ -210,18 +211,19 @@ void BattleCharacter::Update()
     _current_sprite_animation->Update();
     _current_weapon_animation.Update();
 
+    BattleMode* BM = BattleMode::CurrentInstance();
+
     // Update hit and skill points after drawing to reduce GPU stall.
-    if(_last_rendered_hp != GetHitPoints()) {
+    // The headless battles don't draw them.
+    if(_last_rendered_hp != GetHitPoints() && !BM->IsHeadless()) {
         _last_rendered_hp = GetHitPoints();
         _hit_points_text.SetText(NumberToString(_last_rendered_hp));
     }
-    if(_last_rendered_sp != GetSkillPoints()) {
+    if(_last_rendered_sp != GetSkillPoints() && !BM->IsHeadless()) {
         _last_rendered_sp = GetSkillPoints();
         _skill_points_text.SetText(NumberToString(_last_rendered_sp));
     }
 
-    BattleMode* BM = BattleMode::CurrentInstance();
-
     // Avoid updating the battle logic when finishing.
     // This might break the character's animation.
     switch (BM->GetState()) {
@@ -320,7 +322,8 @@ void BattleCharacter::Update()
 
 void BattleCharacter::DrawSprite()
 {
-    VideoManager->Move(_location.x, _location.y);
+    vt_common::Position2D draw_location = GetDrawLocation();
+    VideoManager->Move(draw_location.x, draw_location.y);
     _current_sprite_animation->Draw(Color(1.0f, 1.0f, 1.0f, _sprite_alpha));
     _current_weapon_animation.Draw(Color(1.0f, 1.0f, 1.0f, _sprite_alpha));
 
@@ -332,6 +335,7 @@ void BattleCharacter::DrawSprite()
 
     if(_state == ACTOR_STATE_DYING) {
         try {
+            vt_system::ScriptProfilerCall profiler_call(_death_draw_on_sprite);
             if (_death_draw_on_sprite.is_valid())
                 luabind::call_function<void>(_death_draw_on_sprite);
         } catch(const luabind::error &e) {
@@ -379,6 +383,9 @@ void BattleCharacter::ChangeSpriteAnimation(const std::string &alias)
 
 void BattleCharacter::ChangeActionText()
 {
+    if (BattleMode::CurrentInstance()->IsHeadless())
+        return;
+
     if(_action) {
         ustring action_text = _action->GetName() + MakeUnicodeString(" -> ") + _action->GetTarget().GetName();
         _action_selection_text.SetText(action_text);
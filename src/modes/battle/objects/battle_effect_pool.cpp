@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_effect_pool.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the battle effects pool
+*** ***************************************************************************/
+
+#include "battle_effect_pool.h"
+
+#include "battle_animation.h"
+#include "battle_particle_effect.h"
+
+#include "utils/utils_common.h"
+
+using namespace vt_video;
+
+namespace vt_battle
+{
+
+namespace private_battle
+{
+
+BattleEffectPool::~BattleEffectPool()
+{
+    std::map<std::string, std::vector<BattleParticleEffect*> >::iterator it = _free_particle_effects.begin();
+    for(; it != _free_particle_effects.end(); ++it) {
+        for(uint32_t i = 0; i < it->second.size(); ++i)
+            delete it->second[i];
+    }
+    _free_particle_effects.clear();
+
+    std::map<std::string, std::vector<BattleAnimation*> >::iterator it2 = _free_animations.begin();
+    for(; it2 != _free_animations.end(); ++it2) {
+        for(uint32_t i = 0; i < it2->second.size(); ++i)
+            delete it2->second[i];
+    }
+    _free_animations.clear();
+}
+
+BattleParticleEffect* BattleEffectPool::GetParticleEffect(const std::string& effect_filename)
+{
+    std::vector<BattleParticleEffect*>& free_effects = _free_particle_effects[effect_filename];
+    if(free_effects.empty())
+        return new BattleParticleEffect(effect_filename);
+
+    BattleParticleEffect* effect = free_effects.back();
+    free_effects.pop_back();
+    return effect;
+}
+
+BattleAnimation* BattleEffectPool::GetAnimation(const std::string& animation_filename)
+{
+    const AnimatedImage& animation_template = _GetAnimationTemplate(animation_filename);
+
+    std::vector<BattleAnimation*>& free_animations = _free_animations[animation_filename];
+    if(free_animations.empty())
+        return new BattleAnimation(animation_filename, animation_template);
+
+    BattleAnimation* animation = free_animations.back();
+    free_animations.pop_back();
+    animation->Recycle(animation_template);
+    return animation;
+}
+
+void BattleEffectPool::ReleaseParticleEffect(BattleParticleEffect* effect)
+{
+    if(effect)
+        _free_particle_effects[effect->GetEffectFilename()].push_back(effect);
+}
+
+void BattleEffectPool::ReleaseAnimation(BattleAnimation* animation)
+{
+    if(animation)
+        _free_animations[animation->GetAnimationFilename()].push_back(animation);
+}
+
+void BattleEffectPool::PreloadParticleEffect(const std::string& effect_filename)
+{
+    std::vector<BattleParticleEffect*>& free_effects = _free_particle_effects[effect_filename];
+    if(free_effects.empty())
+        free_effects.push_back(new BattleParticleEffect(effect_filename));
+}
+
+void BattleEffectPool::PreloadAnimation(const std::string& animation_filename)
+{
+    const AnimatedImage& animation_template = _GetAnimationTemplate(animation_filename);
+
+    std::vector<BattleAnimation*>& free_animations = _free_animations[animation_filename];
+    if(free_animations.empty())
+        free_animations.push_back(new BattleAnimation(animation_filename, animation_template));
+}
+
+const AnimatedImage& BattleEffectPool::_GetAnimationTemplate(const std::string& animation_filename)
+{
+    std::map<std::string, AnimatedImage>::iterator it = _animation_templates.find(animation_filename);
+    if(it != _animation_templates.end())
+        return it->second;
+
+    AnimatedImage& animation = _animation_templates[animation_filename];
+    if(!animation.LoadFromAnimationScript(animation_filename))
+        PRINT_WARNING << "Invalid battle animation file requested: "
+                      << animation_filename << std::endl;
+    return animation;
+}
+
+} // namespace private_battle
+
+} // namespace vt_battle
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_effect_pool.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the battle effects pool
+***
+*** Every hit, heal or spell triggers particle effects and animations.
+*** Instead of loading and freeing them each time, the finished effects are
+*** given back to the pool, and reused by the next effects of the same file.
+*** ***************************************************************************/
+
+#ifndef __BATTLE_EFFECT_POOL_HEADER__
+#define __BATTLE_EFFECT_POOL_HEADER__
+
+#include "engine/video/image.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vt_battle
+{
+
+namespace private_battle
+{
+
+class BattleAnimation;
+class BattleParticleEffect;
+
+/** ****************************************************************************
+*** \brief Keeps the unused battle particle effects and animations, by file, for reuse.
+***
+*** The pool owns the effects given back to it, and frees them when destroyed.
+*** The effects in use are owned by the battle mode.
+*** ***************************************************************************/
+class BattleEffectPool
+{
+public:
+    BattleEffectPool()
+    {}
+
+    ~BattleEffectPool();
+
+    //! \brief Returns a started particle effect, reused when one of the same file is available.
+    BattleParticleEffect* GetParticleEffect(const std::string& effect_filename);
+
+    //! \brief Returns a visible animation, reused when one of the same file is available.
+    BattleAnimation* GetAnimation(const std::string& animation_filename);
+
+    //! \brief Gives back a finished effect to the pool, so that it can be reused.
+    void ReleaseParticleEffect(BattleParticleEffect* effect);
+    void ReleaseAnimation(BattleAnimation* animation);
+
+    /** \brief Loads an effect in advance, so that the first use doesn't load it.
+    *** Nothing is done when an unused effect of the same file is already available.
+    **/
+    void PreloadParticleEffect(const std::string& effect_filename);
+    void PreloadAnimation(const std::string& animation_filename);
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    BattleEffectPool(const BattleEffectPool& pool);
+    BattleEffectPool& operator=(const BattleEffectPool& pool);
+
+    //! \brief Returns the animation as loaded from the given file, loading it the first time.
+    const vt_video::AnimatedImage& _GetAnimationTemplate(const std::string& animation_filename);
+
+    //! \brief The unused particle effects, by effect filename.
+    std::map<std::string, std::vector<BattleParticleEffect*> > _free_particle_effects;
+
+    //! \brief The unused animations, by animation filename.
+    std::map<std::string, std::vector<BattleAnimation*> > _free_animations;
+
+    /** \brief The animations as loaded from their file, by animation filename.
+    *** The animations are copied from them, so that each animation script is only read once,
+    *** and so that the reused animations don't keep the changes done by the scripts.
+    **/
+    std::map<std::string, vt_video::AnimatedImage> _animation_templates;
+};
+
+} // namespace private_battle
+
+} // namespace vt_battle
+
+#endif // __BATTLE_EFFECT_POOL_HEADER__
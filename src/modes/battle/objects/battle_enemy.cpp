@@ -16,6 +16,8 @@
 
 #include "common/global/global.h"
 
+#include "engine/script_profiler.h"
+
 #include "utils/utils_random.h"
 
 using namespace vt_global;
@@ -57,7 +59,8 @@ void BattleEnemy::ChangeState(ACTOR_STATE new_state)
     switch(_state) {
     case ACTOR_STATE_COMMAND:
         // Hardcoded fallback behaviour for enemies if no AI script is provided.
-        _DecideAction();
+        if (!HasAI())
+            _DecideAction();
         break;
     case ACTOR_STATE_SHOWNOTICE:
         if (_action && _action->ShouldShowSkillNotice()) {
@@ -92,6 +95,7 @@ void BattleEnemy::ChangeState(ACTOR_STATE new_state)
         // Trigger the death sequence if it is valid
         if (_death_init.is_valid()) {
             try {
+                vt_system::ScriptProfilerCall profiler_call(_death_init);
                 luabind::call_function<void>(_death_init, BattleMode::CurrentInstance(), this);
             } catch(const luabind::error &e) {
                 PRINT_ERROR << "Error while triggering Initialize() function of enemy id: " << _global_actor->GetID() << std::endl;
@@ -214,12 +218,14 @@ void BattleEnemy::DrawSprite()
 
     float hp_percent = static_cast<float>(GetHitPoints()) / static_cast<float>(GetMaxHitPoints());
 
-    VideoManager->Move(_location.x, _location.y);
+    vt_common::Position2D draw_location = GetDrawLocation();
+    VideoManager->Move(draw_location.x, draw_location.y);
     // Alpha will range from 1.0 to 0.0 in the following calculations
     if(_state == ACTOR_STATE_DYING) {
         _sprite_animations->at(GLOBAL_ENEMY_HURT_HEAVILY).Draw(Color(1.0f, 1.0f, 1.0f, _sprite_alpha));
 
         try {
+            vt_system::ScriptProfilerCall profiler_call(_death_draw_on_sprite);
             if (_death_draw_on_sprite.is_valid())
                 luabind::call_function<void>(_death_draw_on_sprite);
         } catch(const luabind::error &e) {
@@ -253,7 +259,8 @@ void BattleEnemy::DrawStaminaIcon(const vt_video::Color &color) const
     if(!IsAlive())
         return;
 
-    VideoManager->Move(_stamina_location.x, _stamina_location.y);
+    vt_common::Position2D draw_location = GetInterpolatedLocation(_previous_stamina_location, _stamina_location);
+    VideoManager->Move(draw_location.x, draw_location.y);
     // Make the stamina icon fade away when dying, use the enemy sprite alpha
     if(_state == ACTOR_STATE_DYING) {
         _stamina_icon.Draw(Color(color.GetRed(), color.GetGreen(),
@@ -13,12 +13,37 @@
 
 #include "common/position_2d.h"
 
+#include "engine/system.h"
+
+#include <cmath>
+
 namespace vt_battle
 {
 
 namespace private_battle
 {
 
+/** \brief The farthest a battle object can move on each axis in one logic update, in pixels.
+*** Farther moves are teleports, and aren't interpolated when drawing.
+**/
+const float BATTLE_MAX_UPDATE_MOVE_DISTANCE = 32.0f;
+
+/** \brief Returns the location to draw, between the locations of the last two logic updates.
+*** \see vt_system::SystemEngine::GetRenderInterpolation()
+**/
+inline vt_common::Position2D GetInterpolatedLocation(const vt_common::Position2D& previous,
+                                                     const vt_common::Position2D& current)
+{
+    float x_move = current.x - previous.x;
+    float y_move = current.y - previous.y;
+    if (std::fabs(x_move) > BATTLE_MAX_UPDATE_MOVE_DISTANCE || std::fabs(y_move) > BATTLE_MAX_UPDATE_MOVE_DISTANCE)
+        return current;
+
+    float interpolation = vt_system::SystemManager->GetRenderInterpolation();
+    return vt_common::Position2D(previous.x + x_move * interpolation,
+                                 previous.y + y_move * interpolation);
+}
+
 /** \brief An abstract class for representing an object in the battle
 *** Used to properly draw objects based on their Y coordinate.
 **/
@@ -27,7 +52,8 @@ class BattleObject
 public:
     BattleObject():
         _origin(0.0f, 0.0f),
-        _location(0.0f, 0.0f)
+        _location(0.0f, 0.0f),
+        _previous_location(0.0f, 0.0f)
     {}
     virtual ~BattleObject()
     {}
@@ -64,6 +90,16 @@ public:
         _location.y = y_location;
     }
 
+    //! \brief Stores the location before a logic update, to interpolate the drawn location.
+    virtual void StorePreviousLocation() {
+        _previous_location = _location;
+    }
+
+    //! \brief Gets the location to draw the object at, between the last two logic updates.
+    vt_common::Position2D GetDrawLocation() const {
+        return GetInterpolatedLocation(_previous_location, _location);
+    }
+
     virtual void DrawSprite()
     {}
 
@@ -82,6 +118,9 @@ protected:
 
     //! \brief The x and y coordinates of the actor's current location on the battle field
     vt_common::Position2D _location;
+
+    //! \brief The location before the last logic update. \see GetDrawLocation()
+    vt_common::Position2D _previous_location;
 };
 
 } // namespace private_battle
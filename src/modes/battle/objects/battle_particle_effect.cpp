@@ -19,7 +19,8 @@ namespace private_battle
 {
 
 BattleParticleEffect::BattleParticleEffect(const std::string &effect_filename):
-    BattleObject()
+    BattleObject(),
+    _effect_filename(effect_filename)
 {
     if(!_effect.LoadEffect(effect_filename))
         PRINT_WARNING << "Invalid battle particle effect file requested: "
@@ -31,7 +32,8 @@ void BattleParticleEffect::DrawSprite()
     if(!_effect.IsAlive())
         return;
 
-    _effect.Move(GetXLocation(), GetYLocation());
+    vt_common::Position2D draw_location = GetDrawLocation();
+    _effect.Move(draw_location.x, draw_location.y);
     _effect.Draw();
 }
 
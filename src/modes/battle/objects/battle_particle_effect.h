@@ -31,12 +31,16 @@ public:
     //! Used to be drawn at the right time by the battle mode.
     void DrawSprite();
 
-    //! Permits to start the effect.
+    //! Permits to start the effect. A dead effect is restarted, reusing its particles.
     bool Start() {
         return _effect.Start();
     }
 
-    //! Tells whether the effect can be removed from memory.
+    const std::string& GetEffectFilename() const {
+        return _effect_filename;
+    }
+
+    //! Tells whether the effect can be given back to the effect pool.
     bool CanBeRemoved() const {
         return !_effect.IsAlive();
     }
@@ -46,6 +50,9 @@ public:
     }
 
 protected:
+    //! The particle effect definition file.
+    std::string _effect_filename;
+
     //! The particle effect class used internally
     vt_mode_manager::ParticleEffect _effect;
 };
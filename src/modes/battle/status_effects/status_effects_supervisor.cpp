@@ -16,6 +16,7 @@
 #include "common/global/actors/global_character.h"
 
 #include "engine/system.h"
+#include "engine/script_profiler.h"
 #include "engine/video/video.h"
 
 #include "script/script.h"
@@ -86,20 +87,20 @@ void BattleStatusEffectsSupervisor::_UpdatePassive()
     for(uint32_t i = 0; i < _equipment_status_effects.size(); ++i) {
         PassiveBattleStatusEffect& effect = _equipment_status_effects.at(i);
 
-        if (!effect.GetUpdatePassiveFunction().is_valid())
+        // The passive effects state never changes, so only the ones with an update interval
+        // need their update function called.
+        if (!effect.IsUsingUpdateTimer() || !effect.GetUpdatePassiveFunction().is_valid())
             continue;
 
-        // Update the update timer if it is running
+        // Update the update timer
         vt_system::SystemTimer* update_timer = effect.GetUpdateTimer();
-        bool use_update_timer = effect.IsUsingUpdateTimer();
-        if (use_update_timer) {
-            update_timer->Update();
-        }
+        update_timer->Update();
 
-        if (!use_update_timer || update_timer->IsFinished()) {
+        if (effect.IsUpdateDue(false)) {
 
             // Call the update passive function
             try {
+                vt_system::ScriptProfilerCall profiler_call(effect.GetUpdatePassiveFunction());
                 luabind::call_function<void>(effect.GetUpdatePassiveFunction(), _actor, effect.GetIntensity());
             } catch(const luabind::error& e) {
                 PRINT_ERROR << "Error while loading status effect BattleUpdatePassive() function" << std::endl;
@@ -109,17 +110,17 @@ void BattleStatusEffectsSupervisor::_UpdatePassive()
                 ScriptManager->HandleCastError(e);
             }
 
-            // Restart the update timer when needed
-            if (use_update_timer) {
-                update_timer->Reset();
-                update_timer->Run();
-            }
+            // Restart the update timer
+            update_timer->Reset();
+            update_timer->Run();
         }
     }
 }
 
 void BattleStatusEffectsSupervisor::Update()
 {
+    vt_system::ProfilerZone zone("BattleStatusEffectsSupervisor::Update");
+
     // Do not update when states are paused
     BattleMode* BM = BattleMode::CurrentInstance();
     if (BM->IsInSceneMode() || BM->AreActorStatesPaused())
@@ -170,11 +171,13 @@ void BattleStatusEffectsSupervisor::Update()
         // Update the time left text
         effect.UpdateTimeLeftText();
 
-        // Update the effect according to the script function
-        if (!use_update_timer || update_timer->IsFinished()) {
+        // Update the effect according to the script function, at its update interval
+        // or when its intensity changed.
+        if (effect.IsUpdateDue(effect.HasIntensityChanged())) {
             if (effect.GetUpdateFunction().is_valid()) {
 
                 try {
+                    vt_system::ScriptProfilerCall profiler_call(effect.GetUpdateFunction());
                     luabind::call_function<void>(effect.GetUpdateFunction(), _actor, effect);
                 } catch(const luabind::error& e) {
                     PRINT_ERROR << "Error while loading status effect BattleUpdate() function" << std::endl;
@@ -381,6 +384,7 @@ void BattleStatusEffectsSupervisor::_CreateNewStatus(GLOBAL_STATUS status, GLOBA
 
     // Call the apply script function now that this new status is active on the actor
     try {
+        vt_system::ScriptProfilerCall profiler_call(new_effect.GetApplyFunction());
         luabind::call_function<void>(new_effect.GetApplyFunction(), _actor, new_effect);
     } catch(const luabind::error& e) {
         PRINT_ERROR << "Error while loading status effect BattleApply() function" << std::endl;
@@ -400,6 +404,7 @@ void BattleStatusEffectsSupervisor::RemoveActiveStatusEffect(GLOBAL_STATUS statu
 
     if (status_effect.GetRemoveFunction().is_valid()) {
         try {
+            vt_system::ScriptProfilerCall profiler_call(status_effect.GetRemoveFunction());
             luabind::call_function<void>(status_effect.GetRemoveFunction(), _actor, status_effect);
         } catch(const luabind::error& e) {
             PRINT_ERROR << "Error while loading status effect BattleRemove() function" << std::endl;
@@ -30,6 +30,8 @@
 #include "modes/battle/transition_to_battle.h"
 #include "modes/battle/battle_enemy_info.h"
 
+#include "engine/script_profiler.h"
+
 using namespace vt_audio;
 using namespace vt_mode_manager;
 using namespace vt_script;
@@ -196,6 +198,10 @@ void MapTransitionEvent::_Start()
 
     VideoManager->_StartTransitionFadeOut(Color::black, MAP_FADE_OUT_TIME);
     _done = false;
+
+    // Read the new map files and preload its assets while fading out.
+    MapMode::CurrentInstance()->PreloadMap(_transition_map_data_filename,
+                                           _transition_map_script_filename);
 }
 
 bool MapTransitionEvent::_Update()
@@ -207,9 +213,11 @@ bool MapTransitionEvent::_Update()
     // break the fade smoothness and visible duration.
     if(!_done) {
         vt_global::GlobalManager->GetMapData().SetPreviousLocation(_transition_origin);
+        MapMode* current_map = MapMode::CurrentInstance();
         MapMode* MM = new MapMode(_transition_map_data_filename,
                                   _transition_map_script_filename,
-                                  MapMode::CurrentInstance()->GetStamina());
+                                  current_map->GetStamina(), true,
+                                  current_map->GetMapPreloader(_transition_map_data_filename));
         ModeManager->Pop();
         ModeManager->Push(MM, false, true);
         _done = true;
@@ -320,6 +328,7 @@ void IfEvent::_Start()
     try {
         // We had a timer of 100ms her to avoid launching an event within an event
         // for the sake of the engine loop. That time is unnoticeable, anyway.
+        vt_system::ScriptProfilerCall profiler_call(_check_function);
         if (luabind::call_function<bool>(_check_function)
             && !_true_event_id.empty() && !events->IsEventActive(_true_event_id)) {
             events->StartEvent(_true_event_id, 100);
@@ -376,6 +385,7 @@ void ScriptedEvent::_Start()
         return;
 
     try {
+        vt_system::ScriptProfilerCall profiler_call(_start_function);
         luabind::call_function<void>(_start_function);
     } catch(const luabind::error &e) {
         PRINT_ERROR << "Error while loading ScriptedEvent start function"
@@ -394,6 +404,7 @@ bool ScriptedEvent::_Update()
         return true;
 
     try {
+        vt_system::ScriptProfilerCall profiler_call(_update_function);
         return luabind::call_function<bool>(_update_function);
     } catch(const luabind::error &e) {
         PRINT_ERROR << "Error while loading ScriptedEvent update function"
@@ -483,14 +494,17 @@ ScriptedSpriteEvent* ScriptedSpriteEvent::Create(const std::string& event_id,
 void ScriptedSpriteEvent::_Start()
 {
     SpriteEvent::_Start();
-    if(_start_function.is_valid())
+    if(_start_function.is_valid()) {
+        vt_system::ScriptProfilerCall profiler_call(_start_function);
         luabind::call_function<void>(_start_function, _sprite);
+    }
 }
 
 bool ScriptedSpriteEvent::_Update()
 {
     bool finished = false;
     if(_update_function.is_valid()) {
+        vt_system::ScriptProfilerCall profiler_call(_update_function);
         finished = luabind::call_function<bool>(_update_function, _sprite);
     } else {
         finished = true;
@@ -22,6 +22,7 @@
 #include "modes/map/map_event_supervisor.h"
 
 #include "modes/map/map_object_supervisor.h"
+#include "modes/map/map_preloader.h"
 #include "modes/map/map_objects/map_object.h"
 #include "modes/map/map_objects/map_physical_object.h"
 #include "modes/map/map_objects/map_treasure.h"
@@ -41,9 +42,12 @@
 
 #include "engine/audio/audio.h"
 #include "engine/input.h"
+#include "engine/profiler.h"
+#include "engine/script_profiler.h"
 
 #include "common/global/global.h"
 #include "common/global/actors/global_character.h"
+#include "common/global/save/save_game_reader.h"
 
 // DEPRECATED: Used only to check old filenames
 #include "utils/utils_files.h"
@@ -83,11 +87,12 @@ MapMode *MapMode::_current_instance = nullptr;
 // ****************************************************************************
 
 MapMode::MapMode(const std::string& data_filename, const std::string& script_filename,
-                 uint32_t stamina, bool permit_autosave) :
+                 uint32_t stamina, bool permit_autosave, MapPreloader* preloader) :
     GameMode(MODE_MANAGER_MAP_MODE),
     _activated(false),
     _map_data_filename(data_filename),
     _map_script_filename(script_filename),
+    _map_preloader(nullptr),
     _tile_supervisor(nullptr),
     _object_supervisor(nullptr),
     _event_supervisor(nullptr),
@@ -99,6 +104,7 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
     _camera(nullptr),
     _virtual_focus(nullptr),
     _camera_move(0.0f, 0.0f),
+    _previous_camera_position(0.0f, 0.0f),
     _pixel_length(-1.0f, -1.0f),
     _running_enabled(true),
     _unlimited_stamina(false),
@@ -116,6 +122,8 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
 {
     _current_instance = this;
 
+    ModeManager->GetAssetResidency().DeclareModeManifest(this, "map:" + data_filename);
+
     ResetState();
     PushState(STATE_EXPLORE);
 
@@ -141,7 +149,7 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
     _virtual_focus->SetCollisionMask(NO_COLLISION);
     _virtual_focus->SetVisible(false);
 
-    if(!_Load()) {
+    if(!_Load(preloader)) {
         BootMode *BM = new BootMode();
         ModeManager->PopAll();
         ModeManager->Push(BM);
@@ -172,6 +180,9 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
 
     // Unset save temporary data now the map is loaded.
     GlobalManager->GetMapData().UnsetSaveData();
+
+    // Free the preloaded images this map didn't use.
+    TextureManager->CancelImagePreloads();
 }
 
 MapMode::~MapMode()
@@ -183,6 +194,7 @@ MapMode::~MapMode()
     delete(_treasure_supervisor);
     delete(_escape_supervisor);
     if(_minimap) delete _minimap;
+    delete _map_preloader;
 
     // Remove the reference to the luabind object
     // to avoid a potential crash when freeing the lua coroutine
@@ -233,6 +245,7 @@ void MapMode::Reset()
     // Make the map location known globally to other code that may need to know this information
     GlobalManager->GetMapData().SetMap(_map_data_filename, _map_script_filename,
                                        _map_image.GetFilename(), _map_hud_name.GetString());
+    GlobalManager->GetMapData().SetMapName(_map_name);
 
     _ResetMusicState();
 
@@ -335,8 +348,18 @@ void MapMode::_ResetMusicState()
 
 void MapMode::Update()
 {
+    vt_system::ProfilerZone zone("MapMode::Update");
+
     MapDataHandler& map_data = GlobalManager->GetMapData();
 
+    // Spread the preloaded assets loading over the frames preceding the map transition.
+    if (_map_preloader)
+        _map_preloader->Update();
+
+    // Keep the positions drawn so far, to interpolate the next frames from them.
+    _previous_camera_position = _GetCameraPosition();
+    _object_supervisor->StorePreviousPositions();
+
     // Update the map frame coords
     // NOTE: It's done before handling pause so that the frame is updated at
     // least once before setting the pause mode, avoiding a crash.
@@ -360,8 +383,10 @@ void MapMode::Update()
     _dialogue_icon.Update();
 
     // Call the map script's update function
-    if(_update_function.is_valid())
+    if(_update_function.is_valid()) {
+        vt_system::ScriptProfilerCall profiler_call(_update_function);
         luabind::call_function<void>(_update_function);
+    }
 
     // Update all animated tile images
     _tile_supervisor->Update();
@@ -440,6 +465,15 @@ void MapMode::Update()
 
 void MapMode::Draw()
 {
+    // Draw the map between the last two logic updates, so that the scrolling
+    // stays smooth when more frames than updates are rendered.
+    // When drawn under another mode, the map isn't updated and stays still.
+    if(ModeManager->GetTop() != this) {
+        _previous_camera_position = _GetCameraPosition();
+        _object_supervisor->StorePreviousPositions();
+    }
+    _ComputeMapFrame(GetInterpolatedPosition(_previous_camera_position, _GetCameraPosition()));
+
     VideoManager->PushState();
     VideoManager->SetStandardCoordSys();
     VideoManager->SetDrawFlags(VIDEO_BLEND, VIDEO_X_CENTER, VIDEO_Y_BOTTOM, 0);
@@ -650,13 +684,8 @@ void AddEp1ToMapPath(std::string& map_filename)
                          "data/story/ep1");
 }
 
-bool MapMode::_Load()
+bool MapMode::_Load(MapPreloader* preloader)
 {
-    // Map data
-    // Clear out all old map data if existing.
-    ScriptManager->DropGlobalTable("map_data");
-
-
     // DEPRECATED: Remove this after episode II release
     if (!vt_utils::DoesFileExist(_map_data_filename)) {
         AddEp1ToMapPath(_map_data_filename);
@@ -665,38 +694,47 @@ bool MapMode::_Load()
         AddEp1ToMapPath(_map_script_filename);
     }
 
-    // Open map script file and read in the basic map properties and tile definitions
-    if(!_map_script.OpenFile(_map_data_filename)) {
-        PRINT_ERROR << "Couldn't open map data file: "
-                    << _map_data_filename << std::endl;
-        return false;
+    // Map data
+    // The map data file is only made of data tables, read outside of the scripts state.
+    // It may have been read ahead of time.
+    SaveGameReader map_data_file;
+    SaveGameReader* map_file = (preloader != nullptr) ? preloader->GetMapDataFile() : nullptr;
+    if (map_file == nullptr) {
+        if(!OpenMapDataFile(map_data_file, _map_data_filename)) {
+            PRINT_ERROR << "Couldn't open map data file: "
+                        << _map_data_filename << std::endl;
+            return false;
+        }
+        map_file = &map_data_file;
     }
 
-    if(!_map_script.OpenTable("map_data")) {
+    if(!map_file->OpenTable("map_data")) {
         PRINT_ERROR << "Couldn't open table 'map_data' in: "
                     << _map_data_filename << std::endl;
-        _map_script.CloseFile();
         return false;
     }
 
     // Loads the collision grid
-    if(!_object_supervisor->Load(_map_script)) {
+    if(!_object_supervisor->Load(*map_file)) {
         PRINT_ERROR << "Failed to load the collision grid from: "
             << _map_data_filename << std::endl;
-        _map_script.CloseFile();
+        map_file->CloseAllTables();
         return false;
     }
 
     // Instruct the supervisor classes to perform their portion of the load operation
-    if(!_tile_supervisor->Load(_map_script)) {
+    if(!_tile_supervisor->Load(*map_file, preloader)) {
         PRINT_ERROR << "Failed to load the tile data from: "
             << _map_data_filename << std::endl;
-        _map_script.CloseFile();
+        map_file->CloseAllTables();
         return false;
     }
 
-    _map_script.CloseAllTables();
-    _map_script.CloseFile(); // Free the map data file once everyhting is loaded
+    map_file->CloseAllTables();
+    if(map_file->IsErrorDetected()) {
+        PRINT_WARNING << "One or more errors occurred while reading the map data - they are listed below"
+                      << std::endl << map_file->GetErrorMessages() << std::endl;
+    }
 
     // Map script
 
@@ -727,8 +765,8 @@ bool MapMode::_Load()
     // Loads the map image and translated location names.
     // Test for empty strings to never trigger the default gettext msg string
     // which contains translation info.
-    std::string map_hud_name = _map_script.ReadString("map_name");
-    _map_hud_name.SetText(map_hud_name.empty() ? ustring() : UTranslate(map_hud_name),
+    _map_name = _map_script.ReadString("map_name");
+    _map_hud_name.SetText(_map_name.empty() ? ustring() : UTranslate(_map_name),
                           TextStyle("map_title"));
     std::string map_hud_subname = _map_script.ReadString("map_subname");
     _map_hud_subname.SetText(map_hud_subname.empty() ? ustring() : UTranslate(map_hud_subname),
@@ -754,6 +792,7 @@ bool MapMode::_Load()
     bool loading_succeeded = true;
     if(function.is_valid()) {
         try {
+            vt_system::ScriptProfilerCall profiler_call(function);
             luabind::call_function<void>(function, this);
         } catch(const luabind::error &e) {
             ScriptManager->HandleLuaError(e);
@@ -1009,7 +1048,32 @@ void MapMode::StartEnemyEncounter(EnemySprite* enemy,
     ModeManager->Push(TM);
 }
 
-void MapMode::_UpdateMapFrame()
+void MapMode::PreloadMap(const std::string& data_filename, const std::string& script_filename)
+{
+    // Scripts may ask for it every frame while the player stands close to an exit.
+    if (data_filename == _preloaded_map_data_filename)
+        return;
+    _preloaded_map_data_filename = data_filename;
+
+    std::string map_data_filename = data_filename;
+    std::string map_script_filename = script_filename;
+
+    // DEPRECATED: Remove this after episode II release
+    if (!vt_utils::DoesFileExist(map_data_filename))
+        AddEp1ToMapPath(map_data_filename);
+    if (!vt_utils::DoesFileExist(map_script_filename))
+        AddEp1ToMapPath(map_script_filename);
+
+    // The files are read on a worker thread, each one in its own Lua state.
+    delete _map_preloader;
+    _map_preloader = new MapPreloader();
+    if (!_map_preloader->Start(map_data_filename, map_script_filename, this)) {
+        delete _map_preloader;
+        _map_preloader = nullptr;
+    }
+}
+
+Position2D MapMode::_GetCameraPosition() const
 {
     // Determine the center position coordinates for the camera
     // Holds the final X, Y coordinates of the camera
@@ -1020,7 +1084,34 @@ void MapMode::_UpdateMapFrame()
         camera_pos.x += (1.0f - _camera_timer.PercentComplete()) * _camera_move.x;
         camera_pos.y += (1.0f - _camera_timer.PercentComplete()) * _camera_move.y;
     }
+    return camera_pos;
+}
 
+void MapMode::_UpdateMapFrame()
+{
+    _ComputeMapFrame(_GetCameraPosition());
+
+    // Update parallax effects now that map corner members are up to date
+    if(_camera_timer.IsRunning()) {
+        // Inform the effect supervisor about camera movement.
+        float duration = (float)_camera_timer.GetDuration();
+        float time_elapsed = (float)SystemManager->GetUpdateTime();
+        Position2D parallax(!_camera_x_in_map_corner ?
+                                _camera_move.x * time_elapsed / duration
+                                / SCREEN_GRID_X_LENGTH * VIDEO_STANDARD_RES_WIDTH :
+                                0.0f,
+                            !_camera_y_in_map_corner ?
+                                _camera_move.y * time_elapsed / duration
+                                / SCREEN_GRID_Y_LENGTH * VIDEO_STANDARD_RES_HEIGHT :
+                                0.0f);
+
+        GetEffectSupervisor().AddParallax(parallax.x, parallax.y);
+        GetIndicatorSupervisor().AddParallax(parallax.x, parallax.y);
+    }
+}
+
+void MapMode::_ComputeMapFrame(const Position2D& camera_pos)
+{
     // Actual position of the view, either the camera sprite
     // or a point on the camera movement path
     uint16_t current_x = GetFloatInteger(camera_pos.x);
@@ -1113,24 +1204,6 @@ void MapMode::_UpdateMapFrame()
         _camera_y_in_map_corner = true;
     }
 
-    // Update parallax effects now that map corner members are up to date
-    if(_camera_timer.IsRunning()) {
-        // Inform the effect supervisor about camera movement.
-        float duration = (float)_camera_timer.GetDuration();
-        float time_elapsed = (float)SystemManager->GetUpdateTime();
-        Position2D parallax(!_camera_x_in_map_corner ?
-                                _camera_move.x * time_elapsed / duration
-                                / SCREEN_GRID_X_LENGTH * VIDEO_STANDARD_RES_WIDTH :
-                                0.0f,
-                            !_camera_y_in_map_corner ?
-                                _camera_move.y * time_elapsed / duration
-                                / SCREEN_GRID_Y_LENGTH * VIDEO_STANDARD_RES_HEIGHT :
-                                0.0f);
-
-        GetEffectSupervisor().AddParallax(parallax.x, parallax.y);
-        GetIndicatorSupervisor().AddParallax(parallax.x, parallax.y);
-    }
-
     // Comment this out to print out map draw debugging info about once a second.
 //  static int loops = 0;
 //  if (loops == 0) {
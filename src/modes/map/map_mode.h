@@ -61,6 +61,7 @@ class MapDialogueSupervisor;
 class EventSupervisor;
 class Light;
 class MapObject;
+class MapPreloader;
 class MapSprite;
 class EnemySprite;
 class MapZone;
@@ -118,9 +119,11 @@ public:
     //! \param script_filename The name of the Lua file that retains all data about script to load
     //! \param stamina The amount of stamina the map character sprite will start with.
     //! \param permit_autosave Whether an autosave can happen at map load time.
-    //! \note the last parameter is usually set to carry the current stamina value from one map to another.
+    //! \param preloader The preloader which read the map files ahead of time, or nullptr.
+    //! \note the stamina parameter is usually set to carry the current stamina value from one map to another.
     MapMode(const std::string &data_filename, const std::string& script_filename,
-            uint32_t stamina = STAMINA_FULL, bool permit_autosave = true);
+            uint32_t stamina = STAMINA_FULL, bool permit_autosave = true,
+            private_map::MapPreloader* preloader = nullptr);
 
     ~MapMode();
 
@@ -454,6 +457,20 @@ public:
     **/
     void StartEnemyEncounter(vt_map::private_map::EnemySprite* enemy,
                              bool hero_init_boost = false, bool enemy_init_boost = false);
+
+    /** \brief Starts reading the files of another map, and preloading its assets, in the background.
+    *** The assets are then uploaded a few per frame, so that transitioning to the map
+    *** only has to run its script. This is done by map transition events, and can be
+    *** called by map scripts as soon as the player gets close to a map exit.
+    *** \param data_filename The data filename of the map to preload.
+    *** \param script_filename The script filename of the map to preload.
+    **/
+    void PreloadMap(const std::string& data_filename, const std::string& script_filename);
+
+    //! \brief Returns the preloader of the given map, or nullptr if it isn't the one preloaded.
+    private_map::MapPreloader* GetMapPreloader(const std::string& data_filename) const {
+        return (data_filename == _preloaded_map_data_filename) ? _map_preloader : nullptr;
+    }
     //@}
 
 private:
@@ -481,6 +498,12 @@ private:
     //! \brief The name of the Lua file that contains the map script
     std::string _map_script_filename;
 
+    //! \brief The data filename of the last map preloaded from this one.
+    std::string _preloaded_map_data_filename;
+
+    //! \brief Reads the files of the last map preloaded from this one.
+    private_map::MapPreloader* _map_preloader;
+
     //! \brief The map's script unique name as it is used to identify a Lua namespace table
     std::string _map_script_tablespace;
 
@@ -488,6 +511,9 @@ private:
     vt_video::TextImage _map_hud_name;
     vt_video::TextImage _map_hud_subname;
 
+    //! \brief The untranslated map hud name, written in the save games header.
+    std::string _map_name;
+
     /** \brief The interface to the file which contains all the map's stored data and subroutines.
     *** This class generally performs a large amount of communication with this script continuously.
     *** The script remains open for as long as the MapMode object exists.
@@ -550,6 +576,9 @@ private:
     //! \brief The direction the camera will move on next update
     vt_common::Position2D _camera_move;
 
+    //! \brief The camera position before the last logic update, to interpolate the drawn map frame.
+    vt_common::Position2D _previous_camera_position;
+
     //! \brief A time for camera movement
     vt_system::SystemTimer _camera_timer;
 
@@ -657,7 +686,8 @@ private:
     // ----- Methods -----
 
     //! \brief Loads all map data contained in the Lua file that defines the map
-    bool _Load();
+    //! \param preloader The preloader which read the map files ahead of time, or nullptr.
+    bool _Load(private_map::MapPreloader* preloader);
 
     /** Triggers the minimap creation either by trying to load the minimap file given.
     *** Or by creating a minimap procedurally.
@@ -667,9 +697,15 @@ private:
     //! \brief A helper function to Update() that is called only when the map is in the explore state
     void _UpdateExplore();
 
-    //! \brief Update the map frame coordinates
+    //! \brief Update the map frame coordinates, and the parallax effects of the camera movement
     void _UpdateMapFrame();
 
+    //! \brief Computes the map frame coordinates from the given camera position.
+    void _ComputeMapFrame(const vt_common::Position2D& camera_pos);
+
+    //! \brief Returns the camera position, including an ongoing camera movement.
+    vt_common::Position2D _GetCameraPosition() const;
+
     //! \brief Draws all visible map tiles and sprites to the screen
     void _DrawMapLayers();
 
@@ -24,6 +24,7 @@
 
 #include "common/global/global.h"
 #include "common/global/actors/global_character.h"
+#include "common/global/save/save_game_reader.h"
 
 #include "utils/utils_numeric.h"
 
@@ -232,7 +233,7 @@ void ObjectSupervisor::SortObjects()
     std::sort(_sky_objects.begin(), _sky_objects.end(), MapObject_Ptr_Less());
 }
 
-bool ObjectSupervisor::Load(vt_script::ReadScriptDescriptor &map_file)
+bool ObjectSupervisor::Load(vt_global::SaveGameReader& map_file)
 {
     if(!map_file.DoesTableExist("map_grid")) {
         PRINT_ERROR << "No map grid found in map file: " << map_file.GetFilename() << std::endl;
@@ -275,6 +276,14 @@ void ObjectSupervisor::Update()
     _UpdateAmbientSounds();
 }
 
+void ObjectSupervisor::StorePreviousPositions()
+{
+    for(uint32_t i = 0; i < _all_objects.size(); ++i) {
+        if(_all_objects[i])
+            _all_objects[i]->StorePreviousPosition();
+    }
+}
+
 void ObjectSupervisor::DrawMapPoints()
 {
     for(uint32_t i = 0; i < _save_points.size(); ++i) {
@@ -15,6 +15,11 @@
 
 #include "script/script_read.h"
 
+namespace vt_global
+{
+class SaveGameReader;
+}
+
 namespace vt_map
 {
 
@@ -102,18 +107,17 @@ public:
     void SortObjects();
 
     /** \brief Loads the collision grid data and saved state of all map objects
-    *** \param map_file A reference to the open map script file
+    *** \param map_file A reference to the map data file, with the 'map_data' table open
     *** \return Whether the collision data loading was successful.
-    ***
-    *** The file must be open prior to making this call and additionally must
-    *** be at the highest level scope (i.e., there are no actively open tables
-    *** in the script descriptor object).
     **/
-    bool Load(vt_script::ReadScriptDescriptor &map_file);
+    bool Load(vt_global::SaveGameReader& map_file);
 
     //! \brief Updates the state of all map zones and objects
     void Update();
 
+    //! \brief Stores the objects positions before a logic update. \see MapObject::GetDrawPosition()
+    void StorePreviousPositions();
+
     /** \brief Draws the various object layers to the screen
     *** \param frame A pointer to the information required to draw this frame
     *** \note These functions do not reset the coordinate system and hence depend that the proper coordinate system
@@ -81,9 +81,11 @@ bool MapObject::ShouldDraw()
     if(!GetGridImageRectangle().IntersectsWith(MM->GetMapFrame().screen_edges))
         return false;
 
-    // Move the drawing cursor to the appropriate coordinates for this sprite
-    float x_pos = MM->GetScreenXCoordinate(GetXPosition());
-    float y_pos = MM->GetScreenYCoordinate(GetYPosition());
+    // Move the drawing cursor to the appropriate coordinates for this sprite,
+    // interpolated between the last two logic updates.
+    Position2D draw_position = GetDrawPosition();
+    float x_pos = MM->GetScreenXCoordinate(draw_position.x);
+    float y_pos = MM->GetScreenYCoordinate(draw_position.y);
 
     vt_video::VideoManager->Move(x_pos, y_pos);
 
@@ -137,8 +139,9 @@ Rectangle2D MapObject::GetScreenImageRectangle() const
 {
     MapMode* mm = MapMode::CurrentInstance();
     Rectangle2D rect;
-    float x_screen_pos = mm->GetScreenXCoordinate(_tile_position.x);
-    float y_screen_pos = mm->GetScreenYCoordinate(_tile_position.y);
+    Position2D draw_position = GetDrawPosition();
+    float x_screen_pos = mm->GetScreenXCoordinate(draw_position.x);
+    float y_screen_pos = mm->GetScreenYCoordinate(draw_position.y);
     rect.left = x_screen_pos - _img_screen_half_width;
     rect.right = x_screen_pos + _img_screen_half_width;
     rect.top = y_screen_pos - _img_screen_height;
@@ -258,6 +258,16 @@ public:
         return _tile_position.x;
     }
 
+    //! \brief Stores the object position before a logic update, to interpolate the drawn position.
+    void StorePreviousPosition() {
+        _previous_tile_position = _tile_position;
+    }
+
+    //! \brief Gets the position to draw the object at, between the last two logic updates.
+    vt_common::Position2D GetDrawPosition() const {
+        return GetInterpolatedPosition(_previous_tile_position, _tile_position);
+    }
+
     float GetYPosition() const {
         return _tile_position.y;
     }
@@ -339,6 +349,9 @@ protected:
     **/
     vt_common::Position2D _tile_position;
 
+    //! \brief The object position before the last logic update. \see GetDrawPosition()
+    vt_common::Position2D _previous_tile_position;
+
     //! \brief The originally desired half-width and height of the image, in pixels
     //! Used as a base value to later get the screen and tile corresponding values.
     float _img_pixel_half_width;
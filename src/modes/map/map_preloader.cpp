@@ -0,0 +1,383 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_preloader.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the map files and assets preloading.
+*** ***************************************************************************/
+
+#include "modes/map/map_preloader.h"
+
+#include "common/global/save/save_game_data.h"
+
+#include "engine/audio/audio.h"
+#include "engine/video/video.h"
+
+#include "utils/utils_common.h"
+
+#include <fstream>
+#include <iterator>
+
+using namespace vt_audio;
+using namespace vt_global;
+using namespace vt_video;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The sprites and objects catalogs, used to find the animation files of the map script sprites and objects.
+const std::string MAP_SPRITES_FILENAME = "data/entities/map_sprites.lua";
+const std::string MAP_OBJECTS_FILENAME = "data/entities/map_objects.lua";
+
+//! \brief Tells whether a filename ends with the given extension.
+static bool _HasExtension(const std::string& filename, const std::string& extension)
+{
+    return filename.size() > extension.size()
+           && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+//! \brief Reads the quoted strings of a Lua text, skipping the line comments.
+static void _ReadQuotedStrings(const std::string& text, std::vector<std::string>& strings)
+{
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (c == '-' && i + 1 < text.size() && text[i + 1] == '-') {
+            i = text.find('\n', i);
+            if (i == std::string::npos)
+                return;
+        }
+        else if (c == '"' || c == '\'') {
+            size_t end = text.find(c, i + 1);
+            if (end == std::string::npos)
+                return;
+            strings.push_back(text.substr(i + 1, end - i - 1));
+            i = end;
+        }
+        ++i;
+    }
+}
+
+//! \brief Reads the string values of a table node.
+static void _ReadStringValues(const SaveGameNode* table, std::vector<std::string>& strings)
+{
+    if (table == nullptr || !table->IsTable())
+        return;
+
+    const std::map<std::string, std::unique_ptr<SaveGameNode> >& fields = table->GetFields();
+    for (std::map<std::string, std::unique_ptr<SaveGameNode> >::const_iterator it = fields.begin();
+            it != fields.end(); ++it) {
+        if (it->second->GetType() == SAVE_NODE_STRING)
+            strings.push_back(it->second->GetString());
+    }
+}
+
+MapPreloader::MapPreloader() :
+    _owner(nullptr),
+    _map_files_read(false),
+    _music_loaded(false),
+    _queued_images(0),
+    _next_upload(0),
+    _quit(false),
+    _thread(nullptr),
+    _mutex(nullptr),
+    _condition(nullptr)
+{
+}
+
+MapPreloader::~MapPreloader()
+{
+    if (_thread != nullptr) {
+        SDL_LockMutex(_mutex);
+        _quit = true;
+        SDL_UnlockMutex(_mutex);
+
+        SDL_WaitThread(_thread, nullptr);
+        _thread = nullptr;
+    }
+
+    if (_condition != nullptr)
+        SDL_DestroyCond(_condition);
+    if (_mutex != nullptr)
+        SDL_DestroyMutex(_mutex);
+}
+
+bool MapPreloader::Start(const std::string& map_data_filename, const std::string& map_script_filename,
+                         vt_mode_manager::GameMode* owner)
+{
+    if (_thread != nullptr)
+        return false;
+
+    _map_data_filename = map_data_filename;
+    _map_script_filename = map_script_filename;
+    _owner = owner;
+
+    _mutex = SDL_CreateMutex();
+    _condition = SDL_CreateCond();
+    if (_mutex == nullptr || _condition == nullptr) {
+        PRINT_WARNING << "Couldn't create the map preloader synchronization objects: "
+                      << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    _thread = SDL_CreateThread(_ThreadFunction, "MapPreloader", this);
+    if (_thread == nullptr) {
+        PRINT_WARNING << "Couldn't create the map preloader thread: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void MapPreloader::Update()
+{
+    if (_thread == nullptr)
+        return;
+
+    // Copy what the worker thread found so far.
+    SDL_LockMutex(_mutex);
+    std::vector<MapPreloadImage> images = _images;
+    std::string music_filename = _music_filename;
+    SDL_UnlockMutex(_mutex);
+
+    if (images.size() > _queued_images) {
+        // The files already loaded by the current map don't need to be decoded again.
+        std::vector<std::string> filenames;
+        for (uint32_t i = 0; i < images.size(); ++i) {
+            if (!TextureManager->IsImageFileLoaded(images[i].filename))
+                filenames.push_back(images[i].filename);
+        }
+        TextureManager->PreloadImages(filenames);
+        _queued_images = images.size();
+    }
+
+    if (!_music_loaded && !music_filename.empty()) {
+        AudioManager->LoadMusic(music_filename, _owner);
+        _music_loaded = true;
+        return; // The music loading is this frame's work.
+    }
+
+    // Upload a few decoded images, in the order they were found.
+    uint32_t uploads = 0;
+    while (uploads < MAP_PRELOAD_UPLOADS_PER_FRAME && _next_upload < images.size()) {
+        const MapPreloadImage& image = images[_next_upload];
+
+        // Already loaded by the current map.
+        if (TextureManager->IsImageFileLoaded(image.filename)) {
+            ++_next_upload;
+            continue;
+        }
+
+        if (!TextureManager->IsImagePreloaded(image.filename)) {
+            // Wait for the decoding, rather than doing it here.
+            if (TextureManager->IsImagePreloadPending(image.filename))
+                break;
+
+            // The file couldn't be decoded: the map loading will report it.
+            ++_next_upload;
+            continue;
+        }
+
+        _UploadImage(image);
+        ++_next_upload;
+        ++uploads;
+    }
+}
+
+SaveGameReader* MapPreloader::GetMapDataFile()
+{
+    if (_thread == nullptr)
+        return nullptr;
+
+    SDL_LockMutex(_mutex);
+    while (!_map_files_read)
+        SDL_CondWait(_condition, _mutex);
+    SDL_UnlockMutex(_mutex);
+
+    return _map_data_file.IsFileOpen() ? &_map_data_file : nullptr;
+}
+
+SaveGameReader* MapPreloader::GetTilesetFile(const std::string& filename)
+{
+    std::map<std::string, std::unique_ptr<SaveGameReader> >::iterator it = _tileset_files.find(filename);
+    if (it == _tileset_files.end() || !it->second->IsFileOpen())
+        return nullptr;
+    return it->second.get();
+}
+
+int MapPreloader::_ThreadFunction(void* data)
+{
+    MapPreloader* preloader = static_cast<MapPreloader*>(data);
+    preloader->_ReadMapFiles();
+    if (!preloader->_IsQuitting())
+        preloader->_FindScriptAssets();
+    return 0;
+}
+
+void MapPreloader::_ReadMapFiles()
+{
+    // The map loading doesn't access the files before _map_files_read is set.
+    std::vector<std::string> tileset_filenames;
+    if (_map_data_file.OpenFile(_map_data_filename) && _map_data_file.OpenTable("map_data")) {
+        _map_data_file.ReadStringVector("tileset_filenames", tileset_filenames);
+        _map_data_file.CloseTable(); // map_data
+    }
+
+    for (uint32_t i = 0; i < tileset_filenames.size() && !_IsQuitting(); ++i) {
+        std::unique_ptr<SaveGameReader> tileset_file(new SaveGameReader());
+        if (tileset_file->OpenFile(tileset_filenames[i]) && tileset_file->OpenTable("tileset")) {
+            // Each tileset image is made of 16 * 16 tiles.
+            _AddImage(tileset_file->ReadString("image"), 16, 16);
+            tileset_file->CloseTable(); // tileset
+        }
+        _tileset_files[tileset_filenames[i]] = std::move(tileset_file);
+    }
+
+    SDL_LockMutex(_mutex);
+    _map_files_read = true;
+    SDL_CondBroadcast(_condition);
+    SDL_UnlockMutex(_mutex);
+}
+
+void MapPreloader::_FindScriptAssets()
+{
+    std::ifstream file(_map_script_filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return;
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    // The default map music, set at the beginning of a line.
+    size_t music_position = text.find("music_filename");
+    while (music_position != std::string::npos) {
+        if (music_position == 0 || text[music_position - 1] == '\n') {
+            size_t line_end = text.find('\n', music_position);
+            size_t quote_start = text.find('"', music_position);
+            size_t quote_end = (quote_start != std::string::npos) ? text.find('"', quote_start + 1) : std::string::npos;
+            if (quote_end != std::string::npos && quote_end < line_end) {
+                SDL_LockMutex(_mutex);
+                _music_filename = text.substr(quote_start + 1, quote_end - quote_start - 1);
+                SDL_UnlockMutex(_mutex);
+            }
+            break;
+        }
+        music_position = text.find("music_filename", music_position + 1);
+    }
+
+    std::vector<std::string> strings;
+    _ReadQuotedStrings(text, strings);
+
+    // The sprites and objects are created from their catalog names.
+    SaveGameNode sprites_file;
+    SaveGameNode objects_file;
+    ReadLuaDataFile(MAP_SPRITES_FILENAME, sprites_file);
+    ReadLuaDataFile(MAP_OBJECTS_FILENAME, objects_file);
+    const SaveGameNode* sprites = sprites_file.GetField("sprites");
+    const SaveGameNode* objects = objects_file.GetField("objects");
+
+    std::vector<std::string> animation_filenames;
+    for (uint32_t i = 0; i < strings.size(); ++i) {
+        const std::string& value = strings[i];
+
+        if (_HasExtension(value, ".png") || _HasExtension(value, ".jpg")) {
+            _AddImage(value, 0, 0);
+        }
+        else if (_HasExtension(value, ".lua")) {
+            if (value.compare(0, 14, "data/entities/") == 0)
+                animation_filenames.push_back(value);
+        }
+        else if (sprites != nullptr && sprites->GetField(value) != nullptr) {
+            const SaveGameNode* sprite = sprites->GetField(value);
+            _ReadStringValues(sprite->GetField("standard_animations"), animation_filenames);
+            _ReadStringValues(sprite->GetField("custom_animations"), animation_filenames);
+
+            const SaveGameNode* portrait = sprite->GetField("face_portrait");
+            if (portrait != nullptr && portrait->GetType() == SAVE_NODE_STRING)
+                _AddImage(portrait->GetString(), 0, 0);
+        }
+        else if (objects != nullptr && objects->GetField(value) != nullptr) {
+            const SaveGameNode* animation = objects->GetField(value)->GetField("animation_filename");
+            if (animation != nullptr && animation->GetType() == SAVE_NODE_STRING)
+                animation_filenames.push_back(animation->GetString());
+        }
+    }
+
+    std::set<std::string> read_animations;
+    for (uint32_t i = 0; i < animation_filenames.size() && !_IsQuitting(); ++i) {
+        if (read_animations.insert(animation_filenames[i]).second)
+            _AddAnimationImage(animation_filenames[i]);
+    }
+}
+
+void MapPreloader::_AddAnimationImage(const std::string& animation_filename)
+{
+    SaveGameNode animation_file;
+    if (!ReadLuaDataFile(animation_filename, animation_file))
+        return;
+
+    // The map sprites use their own animation format, with the same image fields.
+    const SaveGameNode* animation = animation_file.GetField("animation");
+    if (animation == nullptr)
+        animation = animation_file.GetField("sprite_animation");
+    if (animation == nullptr || !animation->IsTable())
+        return;
+
+    const SaveGameNode* image = animation->GetField("image_filename");
+    const SaveGameNode* rows = animation->GetField("rows");
+    const SaveGameNode* columns = animation->GetField("columns");
+    if (image == nullptr || image->GetType() != SAVE_NODE_STRING
+            || rows == nullptr || !rows->IsNumber() || columns == nullptr || !columns->IsNumber()) {
+        return;
+    }
+
+    _AddImage(image->GetString(), static_cast<uint32_t>(rows->GetInteger()),
+              static_cast<uint32_t>(columns->GetInteger()));
+}
+
+void MapPreloader::_AddImage(const std::string& filename, uint32_t rows, uint32_t columns)
+{
+    if (filename.empty())
+        return;
+
+    SDL_LockMutex(_mutex);
+    // An image file is only decoded once, so it is uploaded with the first grid found.
+    if (_image_filenames.insert(filename).second)
+        _images.push_back(MapPreloadImage(filename, rows, columns));
+    SDL_UnlockMutex(_mutex);
+}
+
+bool MapPreloader::_IsQuitting()
+{
+    SDL_LockMutex(_mutex);
+    bool quit = _quit;
+    SDL_UnlockMutex(_mutex);
+    return quit;
+}
+
+void MapPreloader::_UploadImage(const MapPreloadImage& image)
+{
+    _uploaded_images.push_back(std::vector<StillImage>());
+    std::vector<StillImage>& images = _uploaded_images.back();
+
+    if (image.rows > 0 && image.columns > 0) {
+        ImageDescriptor::LoadMultiImageFromElementGrid(images, image.filename, image.rows, image.columns);
+    }
+    else {
+        images.push_back(StillImage());
+        images.back().Load(image.filename);
+    }
+}
+
+} // namespace private_map
+
+} // namespace vt_map
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_preloader.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the map files and assets preloading.
+***
+*** When transitioning to another map, the destination map files are read on a
+*** worker thread during the fade out, each one in its own private Lua state.
+*** The map data and tileset files are kept parsed, and given to the map
+*** loading, so that they are only read once.
+***
+*** The worker also looks for the assets the map will load: the tileset images,
+*** the sprite and object animation images found through the map script, the
+*** other image files it names, and its music. The images are then decoded by
+*** the texture controller image preloader, and uploaded a few per frame, so
+*** that the map loading finds them already loaded.
+*** ***************************************************************************/
+
+#ifndef __MAP_PRELOADER_HEADER__
+#define __MAP_PRELOADER_HEADER__
+
+#include "common/global/save/save_game_reader.h"
+
+#include "engine/video/image.h"
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace vt_mode_manager
+{
+class GameMode;
+}
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The number of preloaded image files uploaded per frame.
+const uint32_t MAP_PRELOAD_UPLOADS_PER_FRAME = 2;
+
+//! \brief An image file found by the map preloader.
+struct MapPreloadImage {
+    MapPreloadImage(const std::string& image_filename, uint32_t image_rows, uint32_t image_columns):
+        filename(image_filename),
+        rows(image_rows),
+        columns(image_columns)
+    {}
+
+    std::string filename;
+
+    //! \brief The image grid dimensions, or 0 when the file is loaded as a single image.
+    uint32_t rows;
+    uint32_t columns;
+};
+
+/** ****************************************************************************
+*** \brief Reads the files of a map, and preloads its assets, ahead of its loading.
+***
+*** The preloader is owned by the map mode preloading another map.
+*** \see MapMode::PreloadMap()
+*** ***************************************************************************/
+class MapPreloader
+{
+public:
+    MapPreloader();
+
+    //! \brief Stops the worker thread, once the file being read is done.
+    ~MapPreloader();
+
+    /** \brief Starts reading the map files on the worker thread.
+    *** \param map_data_filename The map data file.
+    *** \param map_script_filename The map script file, where the sprites and music are found.
+    *** \param owner The game mode owning the preloaded music until the map is loaded.
+    *** \return false if the worker thread couldn't be started.
+    **/
+    bool Start(const std::string& map_data_filename, const std::string& map_script_filename,
+               vt_mode_manager::GameMode* owner);
+
+    /** \brief Queues the image files found so far for decoding, loads the map music,
+    *** and uploads the next decoded images. Called once per frame while fading out.
+    **/
+    void Update();
+
+    /** \brief Returns the map data file, waiting for the worker thread if needed.
+    *** \return nullptr if the file couldn't be read.
+    **/
+    vt_global::SaveGameReader* GetMapDataFile();
+
+    /** \brief Returns a tileset file of the map.
+    *** Only valid once GetMapDataFile() has returned.
+    *** \return nullptr if the file isn't a tileset of the map, or couldn't be read.
+    **/
+    vt_global::SaveGameReader* GetTilesetFile(const std::string& filename);
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design.
+    MapPreloader(const MapPreloader& preloader);
+    MapPreloader& operator=(const MapPreloader& preloader);
+
+    //! \brief The thread entry point.
+    static int _ThreadFunction(void* data);
+
+    //! \brief Reads the map data and tileset files. Done first, as the map loading waits for them.
+    void _ReadMapFiles();
+
+    //! \brief Finds the music and the images used by the map script.
+    void _FindScriptAssets();
+
+    //! \brief Adds the image of an animation file.
+    void _AddAnimationImage(const std::string& animation_filename);
+
+    //! \brief Adds an image file to preload, unless already added.
+    void _AddImage(const std::string& filename, uint32_t rows, uint32_t columns);
+
+    //! \brief Tells whether the worker thread should stop.
+    bool _IsQuitting();
+
+    //! \brief Loads the textures of a decoded image file.
+    void _UploadImage(const MapPreloadImage& image);
+
+    std::string _map_data_filename;
+    std::string _map_script_filename;
+
+    //! \brief The game mode owning the preloaded music.
+    vt_mode_manager::GameMode* _owner;
+
+    //! \brief The parsed map data file, valid once _map_files_read is true.
+    vt_global::SaveGameReader _map_data_file;
+
+    //! \brief The parsed tileset files, by filename.
+    std::map<std::string, std::unique_ptr<vt_global::SaveGameReader> > _tileset_files;
+
+    //! \brief Whether the map data and tileset files have been read.
+    bool _map_files_read;
+
+    //! \brief The map music found by the worker thread.
+    std::string _music_filename;
+
+    //! \brief Whether the music has been loaded.
+    bool _music_loaded;
+
+    //! \brief The image files found by the worker thread, in loading order.
+    std::vector<MapPreloadImage> _images;
+
+    //! \brief The found image filenames, to add each file once.
+    std::set<std::string> _image_filenames;
+
+    //! \brief The number of images given to the image preloader so far.
+    uint32_t _queued_images;
+
+    //! \brief The index of the next image to upload.
+    uint32_t _next_upload;
+
+    //! \brief The uploaded images, keeping their textures loaded until the map loads them.
+    std::vector<std::vector<vt_video::StillImage> > _uploaded_images;
+
+    //! \brief Whether the worker thread should stop.
+    bool _quit;
+
+    SDL_Thread* _thread;
+    SDL_mutex* _mutex;
+    SDL_cond* _condition;
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_PRELOADER_HEADER__
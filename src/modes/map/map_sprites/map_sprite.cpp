@@ -19,6 +19,7 @@
 #include "common/rectangle_2d.h"
 
 #include "script/script_read.h"
+#include "engine/script_cache.h"
 #include "engine/system.h"
 #include "engine/video/image.h"
 
@@ -78,7 +79,7 @@ bool _LoadAnimations(std::vector<vt_video::AnimatedImage>& animations, const std
         animations.push_back(vt_video::AnimatedImage());
 
     vt_script::ReadScriptDescriptor animations_script;
-    if(!animations_script.OpenFile(filename))
+    if(!vt_script::OpenCachedScript(animations_script, filename))
         return false;
 
     if(!animations_script.DoesTableExist("sprite_animation")) {
@@ -22,6 +22,7 @@
 #include "common/global/global.h"
 #include "common/global/actors/global_character.h"
 
+#include "engine/script_profiler.h"
 #include "engine/video/video.h"
 
 using namespace vt_global;
@@ -371,21 +372,21 @@ void MapStatusEffectsSupervisor::_UpdatePassive()
     for(uint32_t i = 0; i < _equipment_status_effects.size(); ++i) {
         PassiveMapStatusEffect& effect = _equipment_status_effects.at(i);
 
-        if (!effect.GetUpdatePassiveFunction().is_valid())
+        // The passive effects state never changes, so only the ones with an update interval
+        // need their update function called.
+        if (!effect.IsUsingUpdateTimer() || !effect.GetUpdatePassiveFunction().is_valid())
             continue;
 
-        // Update the update timer if it is running
+        // Update the update timer
         vt_system::SystemTimer *update_timer = effect.GetUpdateTimer();
-        bool use_update_timer = effect.IsUsingUpdateTimer();
-        if (use_update_timer) {
-            uint32_t update_time = vt_system::SystemManager->GetUpdateTime();
-            update_timer->Update(update_time);
-        }
+        uint32_t update_time = vt_system::SystemManager->GetUpdateTime();
+        update_timer->Update(update_time);
 
-        if (!use_update_timer || update_timer->IsFinished()) {
+        if (effect.IsUpdateDue(false)) {
 
             // Call the update passive function
             try {
+                vt_system::ScriptProfilerCall profiler_call(effect.GetUpdatePassiveFunction());
                 luabind::call_function<void>(effect.GetUpdatePassiveFunction(), effect.GetAffectedCharacter(), effect.GetIntensity());
             } catch(const luabind::error& e) {
                 PRINT_ERROR << "Error while loading status effect MapUpdatePassive() function" << std::endl;
@@ -395,11 +396,9 @@ void MapStatusEffectsSupervisor::_UpdatePassive()
                 vt_script::ScriptManager->HandleCastError(e);
             }
 
-            // Restart the update timer when needed
-            if (use_update_timer) {
-                update_timer->Reset();
-                update_timer->Run();
-            }
+            // Restart the update timer
+            update_timer->Reset();
+            update_timer->Run();
         }
     }
 }
@@ -457,11 +456,13 @@ void MapStatusEffectsSupervisor::UpdateEffects()
             continue;
         }
 
-        // Update the effect according to the script function
-        if (!use_update_timer || update_timer->IsFinished()) {
+        // Update the effect according to the script function, at its update interval
+        // or when its intensity changed.
+        if (effect.IsUpdateDue(effect.HasIntensityChanged())) {
             if (effect.GetUpdateFunction().is_valid()) {
 
                 try {
+                    vt_system::ScriptProfilerCall profiler_call(effect.GetUpdateFunction());
                     luabind::call_function<void>(effect.GetUpdateFunction(), effect);
                 } catch(const luabind::error& e) {
                     PRINT_ERROR << "Error while loading status effect Update function" << std::endl;
@@ -674,6 +675,7 @@ void MapStatusEffectsSupervisor::_AddActiveStatusEffect(GlobalCharacter* charact
 
     // Call the apply script function now that this new status is active on the actor
     try {
+        vt_system::ScriptProfilerCall profiler_call(new_effect.GetApplyFunction());
         luabind::call_function<void>(new_effect.GetApplyFunction(), new_effect);
     } catch(const luabind::error& e) {
         PRINT_ERROR << "Error while loading status effect Apply function" << std::endl;
@@ -692,6 +694,7 @@ void MapStatusEffectsSupervisor::_RemoveActiveStatusEffect(ActiveMapStatusEffect
     // Remove the status effect from the active effects list if it registered there.
     if (status_effect.GetRemoveFunction().is_valid()) {
         try {
+            vt_system::ScriptProfilerCall profiler_call(status_effect.GetRemoveFunction());
             luabind::call_function<void>(status_effect.GetRemoveFunction(), status_effect);
         } catch(const luabind::error& e) {
             PRINT_ERROR << "Error while loading status effect Remove function" << std::endl;
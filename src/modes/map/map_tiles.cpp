@@ -18,10 +18,14 @@
 #include "modes/map/map_tiles.h"
 
 #include "modes/map/map_mode.h"
+#include "modes/map/map_preloader.h"
+
+#include "common/global/save/save_game_reader.h"
 
 #include "engine/video/video.h"
 
 using namespace vt_utils;
+using namespace vt_global;
 using namespace vt_script;
 using namespace vt_video;
 
@@ -59,7 +63,7 @@ TileSupervisor::~TileSupervisor()
     _animated_tile_images.clear();
 }
 
-bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
+bool TileSupervisor::Load(SaveGameReader& map_file, MapPreloader* preloader)
 {
     // Load the map dimensions and do some basic sanity checks
     _num_tile_on_y_axis = map_file.ReadInt("num_tile_rows");
@@ -71,26 +75,41 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     std::vector<std::string> tileset_filenames;
     // Temporarily retains all tile images loaded for each tileset. Each inner vector contains 256 StillImage objects
     std::vector<std::vector<StillImage> > tileset_images;
+    // The animated tiles of each tileset (every two elements of an animation corresponds to a pair of tile frame index and display time)
+    std::vector<std::vector<std::vector<uint32_t> > > tileset_animations;
 
     map_file.ReadStringVector("tileset_filenames", tileset_filenames);
 
     for(uint32_t i = 0; i < tileset_filenames.size(); i++) {
         std::string tileset_file = tileset_filenames[i];
 
-        ReadScriptDescriptor tileset_script;
-        if (!tileset_script.OpenFile(tileset_file)) {
-            PRINT_ERROR << "Couldn't open the tileset definition file: " << tileset_file << std::endl;
-            return false;
+        // The tileset file may have been read ahead of time.
+        SaveGameReader tileset_data;
+        SaveGameReader* tileset_script = (preloader != nullptr) ? preloader->GetTilesetFile(tileset_file) : nullptr;
+        if (tileset_script == nullptr) {
+            if (!OpenMapDataFile(tileset_data, tileset_file)) {
+                PRINT_ERROR << "Couldn't open the tileset definition file: " << tileset_file << std::endl;
+                return false;
+            }
+            tileset_script = &tileset_data;
         }
 
-        if (!tileset_script.OpenTable("tileset")) {
+        if (!tileset_script->OpenTable("tileset")) {
             PRINT_ERROR << "Couldn't open the 'tileset' table from file: " << tileset_file << std::endl;
-            tileset_script.CloseFile();
             return false;
         }
 
-        std::string image_filename = tileset_script.ReadString("image");
-        tileset_script.CloseFile();
+        std::string image_filename = tileset_script->ReadString("image");
+
+        tileset_animations.push_back(std::vector<std::vector<uint32_t> >());
+        if(tileset_script->OpenTable("animated_tiles")) {
+            for(int32_t j = 1; j <= static_cast<int32_t>(tileset_script->GetTableSize()); j++) {
+                tileset_animations.back().push_back(std::vector<uint32_t>());
+                tileset_script->ReadUIntVector(j, tileset_animations.back().back());
+            }
+            tileset_script->CloseTable(); // animated_tiles
+        }
+        tileset_script->CloseTable(); // tileset
 
         tileset_images.push_back(std::vector<StillImage>(TILES_PER_TILESET));
 
@@ -227,59 +246,34 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
         }
     }
 
-    // Parse all of the tileset definition files and create any animated tile images that will be used
+    // Create any animated tile images that will be used
 
-    // Used to access the tileset definition file
-    ReadScriptDescriptor tileset_script;
-    // Temporarily retains the animation data (every two elements corresponds to a pair of tile frame index and display time)
-    std::vector<uint32_t> animation_info;
     // Temporarily holds all animated tile images. The map key is the value of the tile index, before reference translation is done in the next step
     std::map<uint32_t, AnimatedImage *> tile_animations;
 
-    for(uint32_t i = 0; i < tileset_filenames.size(); i++) {
-        if (!tileset_script.OpenFile(tileset_filenames[i])) {
-            PRINT_ERROR << "map failed to load because it could not open a tileset definition file: "
-                << tileset_filenames[i] << std::endl;
-            return false;
-        }
+    for(uint32_t i = 0; i < tileset_animations.size(); i++) {
+        for(uint32_t j = 0; j < tileset_animations[i].size(); j++) {
+            const std::vector<uint32_t>& animation_info = tileset_animations[i][j];
 
-        if (!tileset_script.OpenTable("tileset")) {
-            PRINT_ERROR << "map failed to load because it could not open the 'tileset' table from file: "
-                << tileset_filenames[i] << std::endl;
-            tileset_script.CloseFile();
-            return false;
-        }
-
-        if(tileset_script.DoesTableExist("animated_tiles")) {
-            tileset_script.OpenTable("animated_tiles");
-            for(uint32_t j = 1; j <= tileset_script.GetTableSize(); j++) {
-                animation_info.clear();
-                tileset_script.ReadUIntVector(j, animation_info);
+            // The index of the first frame in the animation. (i * TILES_PER_TILESET) factors in which tileset the frame comes from
+            uint32_t first_frame_index = animation_info[0] + (i * TILES_PER_TILESET);
 
-                // The index of the first frame in the animation. (i * TILES_PER_TILESET) factors in which tileset the frame comes from
-                uint32_t first_frame_index = animation_info[0] + (i * TILES_PER_TILESET);
-
-                // If the first tile frame index of this animation was not referenced anywhere in the map, then the animation is unused and
-                // we can safely skip over it and move on to the next one. Otherwise if it is referenced, we have to construct the animated image
-                if(tile_references[first_frame_index] == -1) {
-                    continue;
-                }
+            // If the first tile frame index of this animation was not referenced anywhere in the map, then the animation is unused and
+            // we can safely skip over it and move on to the next one. Otherwise if it is referenced, we have to construct the animated image
+            if(tile_references[first_frame_index] == -1) {
+                continue;
+            }
 
-                AnimatedImage *new_animation = new AnimatedImage();
-                new_animation->SetDimensions(TILE_LENGTH, TILE_LENGTH);
+            AnimatedImage *new_animation = new AnimatedImage();
+            new_animation->SetDimensions(TILE_LENGTH, TILE_LENGTH);
 
-                // Each pair of entries in the animation info indicate the tile frame index (k) and the time (k+1)
-                for(uint32_t k = 0; k < animation_info.size(); k += 2) {
-                    new_animation->AddFrame(tileset_images[i][animation_info[k]], animation_info[k + 1]);
-                }
-                tile_animations.insert(std::make_pair(first_frame_index, new_animation));
+            // Each pair of entries in the animation info indicate the tile frame index (k) and the time (k+1)
+            for(uint32_t k = 0; k < animation_info.size(); k += 2) {
+                new_animation->AddFrame(tileset_images[i][animation_info[k]], animation_info[k + 1]);
             }
-            tileset_script.CloseTable();
+            tile_animations.insert(std::make_pair(first_frame_index, new_animation));
         }
-
-        tileset_script.CloseTable();
-        tileset_script.CloseFile();
-    } // for (uint32_t i = 0; i < tileset_filenames.size(); i++)
+    }
 
     // Add all referenced tiles to the _tile_images vector, in the proper order
 
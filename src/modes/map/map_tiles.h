@@ -25,6 +25,10 @@
 
 #include "script/script_read.h"
 
+namespace vt_global {
+class SaveGameReader;
+}
+
 namespace vt_video {
 class ImageDescriptor;
 class AnimatedImage;
@@ -38,6 +42,8 @@ class MapMode;
 namespace private_map
 {
 
+class MapPreloader;
+
 //! \brief Layer types: Drawn before, along, or after the map objects according to their types.
 enum LAYER_TYPE {
     GROUND_LAYER = 0,
@@ -77,10 +83,10 @@ public:
     ~TileSupervisor();
 
     /** \brief Handles all operations on loading tilesets and tile images from the map data file
-    *** \param map_file A reference to the Lua file containing the map data
-    *** \note The map file should already be opened with no Lua tables open
+    *** \param map_file A reference to the map data file, with the 'map_data' table open
+    *** \param preloader The preloader which read the tileset files ahead of time, or nullptr
     **/
-    bool Load(vt_script::ReadScriptDescriptor &map_file);
+    bool Load(vt_global::SaveGameReader& map_file, MapPreloader* preloader);
 
     //! \brief Updates all animated tile images
     void Update();
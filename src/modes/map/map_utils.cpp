@@ -15,8 +15,15 @@
 
 #include "map_utils.h"
 
+#include "common/global/save/save_game_reader.h"
+
+#include "engine/script_cache.h"
+#include "engine/system.h"
+
 #include "utils/utils_common.h"
 
+#include <cmath>
+
 namespace vt_map
 {
 
@@ -65,6 +72,32 @@ uint16_t GetOppositeDirection(const uint16_t direction)
     }
 }
 
+vt_common::Position2D GetInterpolatedPosition(const vt_common::Position2D& previous,
+                                              const vt_common::Position2D& current)
+{
+    float x_move = current.x - previous.x;
+    float y_move = current.y - previous.y;
+    if (std::fabs(x_move) > MAX_UPDATE_MOVE_DISTANCE || std::fabs(y_move) > MAX_UPDATE_MOVE_DISTANCE)
+        return current;
+
+    float interpolation = vt_system::SystemManager->GetRenderInterpolation();
+    return vt_common::Position2D(previous.x + x_move * interpolation,
+                                 previous.y + y_move * interpolation);
+}
+
+bool OpenMapDataFile(vt_global::SaveGameReader& file, const std::string& filename)
+{
+    const std::string compiled_filename = vt_script::GetCachedScriptFilename(filename);
+    if (file.OpenFile(compiled_filename))
+        return true;
+
+    if (compiled_filename == filename)
+        return false;
+
+    // The compiled file may not be loadable by this Lua build.
+    return file.OpenFile(filename);
+}
+
 } // namespace private_map
 
 } // namespace vt_map
@@ -26,6 +26,11 @@
 
 #include <vector>
 
+namespace vt_global
+{
+class SaveGameReader;
+}
+
 namespace vt_map
 {
 
@@ -119,6 +124,12 @@ const float FAST_SPEED       = 110.0f;
 const float VERY_FAST_SPEED  = 75.0f;
 //@}
 
+/** \brief The farthest a sprite can move on each axis in one logic update, in map grid units.
+*** Farther moves are teleports, and aren't interpolated when drawing.
+*** \see VirtualSprite::CalculateDistanceMoved()
+**/
+const float MAX_UPDATE_MOVE_DISTANCE = 1.0f;
+
 /** \name Sprite Direction Constants
 *** \brief Constants used for determining sprite directions
 *** Sprites are allowed to travel in eight different directions, however the sprite itself
@@ -220,6 +231,23 @@ void ScaleToMapZoomRatio(vt_video::ImageDescriptor& img);
 **/
 uint16_t GetOppositeDirection(const uint16_t direction);
 
+/** \brief Returns the position to draw, between the positions of the last two logic updates.
+*** \param previous The position before the last logic update.
+*** \param current The position after the last logic update.
+*** \note The current position is returned for moves farther than MAX_UPDATE_MOVE_DISTANCE.
+*** \see vt_system::SystemEngine::GetRenderInterpolation()
+**/
+vt_common::Position2D GetInterpolatedPosition(const vt_common::Position2D& previous,
+                                              const vt_common::Position2D& current);
+
+/** \brief Opens a map data or tileset file, from its compiled script when up to date.
+*** \param file The reader to open the file with.
+*** \param filename The Lua data source file.
+*** \return false if the file couldn't be read.
+*** \note Only call this from the game thread, as it may compile the file into the script cache.
+**/
+bool OpenMapDataFile(vt_global::SaveGameReader& file, const std::string& filename);
+
 /** ****************************************************************************
 *** \brief Retains information about how the next map frame should be drawn.
 ***
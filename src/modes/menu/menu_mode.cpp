@@ -59,6 +59,8 @@ MenuMode::MenuMode() :
 {
     _current_instance = this;
 
+    vt_mode_manager::ModeManager->GetAssetResidency().DeclareModeManifest(this, "menu");
+
     MapDataHandler& map_data = GlobalManager->GetMapData();
 
     // Init the controls parameters.
@@ -272,6 +274,7 @@ MenuMode::~MenuMode()
 void MenuMode::Reset()
 {
     _current_instance = this;
+    _render_cache.MarkDirty();
 
     // Reload the characters' information since
     // active status effects may have changed.
@@ -536,10 +539,13 @@ void MenuMode::UpdateEquipmentInfo(vt_global::GlobalCharacter* character,
 
 void MenuMode::Draw()
 {
-    _current_menu_state->Draw();
+    if(_render_cache.BeginDraw()) {
+        _current_menu_state->Draw();
 
-    if(_message_window)
-        _message_window->Draw();
+        if(_message_window)
+            _message_window->Draw();
+    }
+    _render_cache.EndDraw();
 }
 
 void MenuMode::DrawEquipmentInfo()
@@ -30,6 +30,7 @@
 #include "modes/menu/menu_windows/menu_worldmap_window.h"
 
 #include "common/character_window.h"
+#include "common/gui/render_cache.h"
 #include "engine/mode_manager.h"
 
 namespace vt_common {
@@ -207,6 +208,9 @@ private:
 
     vt_common::MessageWindow* _message_window;
 
+    //! \brief Only draws the menu again when its content changed.
+    vt_gui::GUIRenderCache _render_cache;
+
     //! \name Option boxes that are used in the various menu windows
     //@{
     vt_gui::OptionBox _menu_inventory;
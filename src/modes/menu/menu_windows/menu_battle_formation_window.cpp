@@ -136,7 +136,10 @@ void BattleFormationWindow::Update()
 
     // Update characters animations
     for (uint32_t i = 0; i < _character_sprites.size(); ++i) {
+        uint32_t frame = _character_sprites[i].GetCurrentFrameIndex();
         _character_sprites[i].Update();
+        if (frame != _character_sprites[i].GetCurrentFrameIndex())
+            GUIManager->MarkContentChanged();
     }
 
     // Update the status texts
@@ -18,6 +18,7 @@
 
 #include "engine/audio/audio.h"
 #include "engine/input.h"
+#include "engine/script_profiler.h"
 #include "engine/system.h"
 
 using namespace vt_menu::private_menu;
@@ -100,6 +101,8 @@ void InventoryWindow::_InitInventoryItems()
     _inventory_items.SetPosition(500.0f, 170.0f);
     _inventory_items.SetDimensions(400.0f, 360.0f, 1, 255, 1, 10);
     _inventory_items.SetTextStyle(TextStyle("text20"));
+    // Late game inventories can hold hundreds of items.
+    _inventory_items.SetVirtualized(true);
     _inventory_items.SetCursorOffset(-52.0f, -20.0f);
     _inventory_items.SetVerticalWrapMode(VIDEO_WRAP_MODE_STRAIGHT);
     _inventory_items.SetOptionAlignment(VIDEO_X_LEFT, VIDEO_Y_CENTER);
@@ -376,6 +379,7 @@ void InventoryWindow::Update()
 
                                 bool success = false;
                                 try {
+                                    vt_system::ScriptProfilerCall profiler_call(script_function);
                                     success = luabind::call_function<bool>(script_function, party);
                                 } catch(const luabind::error& e) {
                                     PRINT_ERROR << "Error while loading FieldUse() function" << std::endl;
@@ -410,6 +414,7 @@ void InventoryWindow::Update()
                             else { // Use on a single character only
                                 bool success = false;
                                 try {
+                                    vt_system::ScriptProfilerCall profiler_call(script_function);
                                     success = luabind::call_function<bool>(script_function, _character);
                                 } catch(const luabind::error& e) {
                                     PRINT_ERROR << "Error while loading FieldUse() function" << std::endl;
@@ -17,6 +17,7 @@
 
 #include "engine/audio/audio.h"
 #include "engine/input.h"
+#include "engine/script_profiler.h"
 #include "engine/system.h"
 
 using namespace vt_menu::private_menu;
@@ -79,6 +80,7 @@ void SkillsWindow::_InitSkillsList()
     _skills_list.SetPosition(500.0f, 170.0f);
     _skills_list.SetDimensions(180.0f, 360.0f, 1, 255, 1, 6);
     _skills_list.SetTextStyle(TextStyle("text20"));
+    _skills_list.SetVirtualized(true);
     _skills_list.SetCursorOffset(-52.0f, -20.0f);
     _skills_list.SetHorizontalWrapMode(VIDEO_WRAP_MODE_STRAIGHT);
     _skills_list.SetVerticalWrapMode(VIDEO_WRAP_MODE_STRAIGHT);
@@ -93,6 +95,7 @@ void SkillsWindow::_InitSkillsList()
     _skill_cost_list.SetPosition(700.0f, 170.0f);
     _skill_cost_list.SetDimensions(180.0f, 360.0f, 1, 255, 1, 6);
     _skill_cost_list.SetTextStyle(TextStyle("text20"));
+    _skill_cost_list.SetVirtualized(true);
     _skill_cost_list.SetCursorOffset(-52.0f, -20.0f);
     _skill_cost_list.SetHorizontalWrapMode(VIDEO_WRAP_MODE_STRAIGHT);
     _skill_cost_list.SetVerticalWrapMode(VIDEO_WRAP_MODE_STRAIGHT);
@@ -221,6 +224,7 @@ void SkillsWindow::Update()
 
             bool success = false;
             try {
+                vt_system::ScriptProfilerCall profiler_call(script_function);
                 success =
                     luabind::call_function<bool>(script_function, user, target);
             } catch(const luabind::error& e) {
@@ -178,7 +178,10 @@ void WorldMapWindow::Update()
             _SetSelectedLocation(world_map_goto);
         }
 
+        uint32_t frame = _location_marker.GetCurrentFrameIndex();
         _location_marker.Update();
+        if(frame != _location_marker.GetCurrentFrameIndex())
+            GUIManager->MarkContentChanged();
     }
 }
 
@@ -139,6 +139,7 @@ void BindModeCode()
             .def("SetAllEnemyStatesToDead", &MapMode::SetAllEnemyStatesToDead)
             .def("SetAutoSaveEnabled", &MapMode::SetAutoSaveEnabled)
             .def("GetAutoSaveEnabled", &MapMode::GetAutoSaveEnabled)
+            .def("PreloadMap", &MapMode::PreloadMap)
 
             // Namespace constants
             .enum_("constants") [
@@ -743,7 +744,27 @@ void BindModeCode()
                          &RndMagicalDamage),
             luabind::def("RndMagicalDamage",
                          (uint32_t(*)(BattleActor*, BattleActor*, vt_global::GLOBAL_ELEMENTAL))
-                         &RndMagicalDamage)
+                         &RndMagicalDamage),
+
+            luabind::def("RndPhysicalAttack",
+                         (uint32_t(*)(BattleActor*, BattleTarget*, uint32_t, float))
+                         &RndPhysicalAttack),
+            luabind::def("RndPhysicalAttack",
+                         (uint32_t(*)(BattleActor*, BattleTarget*, uint32_t))
+                         &RndPhysicalAttack),
+            luabind::def("RndPhysicalAttack",
+                         (uint32_t(*)(BattleActor*, BattleTarget*))
+                         &RndPhysicalAttack),
+
+            luabind::def("RndMagicalAttack",
+                         (uint32_t(*)(BattleActor*, BattleTarget*, vt_global::GLOBAL_ELEMENTAL, uint32_t, float))
+                         &RndMagicalAttack),
+            luabind::def("RndMagicalAttack",
+                         (uint32_t(*)(BattleActor*, BattleTarget*, vt_global::GLOBAL_ELEMENTAL, uint32_t))
+                         &RndMagicalAttack),
+            luabind::def("RndMagicalAttack",
+                         (uint32_t(*)(BattleActor*, BattleTarget*, vt_global::GLOBAL_ELEMENTAL))
+                         &RndMagicalAttack)
         ];
 
         luabind::module(vt_script::ScriptManager->GetGlobalState(), "vt_battle")
@@ -901,6 +922,7 @@ void BindModeCode()
             .def("GetAttackPoint", &BattleTarget::GetAttackPoint)
             .def("GetActor", &BattleTarget::GetActor)
             .def("GetPartyActor", &BattleTarget::GetPartyActor)
+            .def("GetHitActor", &BattleTarget::GetHitActor)
         ];
 
         luabind::module(vt_script::ScriptManager->GetGlobalState(), "vt_battle")
@@ -58,6 +58,7 @@ const uint8_t SAVE_MODE_SAVE_COMPLETE    = 4;
 const uint8_t SAVE_MODE_SAVE_FAILED      = 5;
 const uint8_t SAVE_MODE_FADING_OUT       = 6;
 const uint8_t SAVE_MODE_NO_VALID_SAVES   = 7;
+const uint8_t SAVE_MODE_WRITING_SAVE     = 8;
 //@}
 
 const uint32_t CHARACTERS_SHOWN_SLOTS = 4;
@@ -234,6 +235,8 @@ SaveMode::~SaveMode()
 
 void SaveMode::Reset()
 {
+    _render_cache.MarkDirty();
+
     // Save a copy of the current screen to use as the backdrop.
     try {
         _screen_capture = VideoManager->CaptureScreen();
@@ -261,6 +264,28 @@ void SaveMode::Update()
     _confirm_save_optionbox.Update();
     _load_auto_save_optionbox.Update();
 
+    // The save file is being written in the background.
+    if(_current_state == SAVE_MODE_WRITING_SAVE) {
+        if(GlobalManager->IsSaveInProgress())
+            return;
+
+        // The slot content changed.
+        _render_cache.MarkDirty();
+        uint32_t id = static_cast<uint32_t>(_file_list.GetSelection());
+        _save_previews.erase(_BuildSaveFilename(id));
+
+        if(GlobalManager->HasLastSaveSucceeded()) {
+            _current_state = SAVE_MODE_SAVE_COMPLETE;
+            AudioManager->PlaySound("data/sounds/save_successful_nick_bowler_oga.wav");
+            // Remove the autosave in that case.
+            _DeleteAutoSave(id);
+        } else {
+            _current_state = SAVE_MODE_SAVE_FAILED;
+            AudioManager->PlaySound("data/sounds/cancel.wav");
+        }
+        return;
+    }
+
     GlobalMedia& media = GlobalManager->Media();
 
     // Otherwise, it's time to start handling events.
@@ -282,10 +307,8 @@ void SaveMode::Update()
 
                 // Attempt to save the game
                 if(GlobalManager->SaveGame(_BuildSaveFilename(id), id, _x_position, _y_position)) {
-                    _current_state = SAVE_MODE_SAVE_COMPLETE;
-                    AudioManager->PlaySound("data/sounds/save_successful_nick_bowler_oga.wav");
-                    // Remove the autosave in that case.
-                    _DeleteAutoSave(id);
+                    // The result is known once the file is written.
+                    _current_state = SAVE_MODE_WRITING_SAVE;
                 } else {
                     _current_state = SAVE_MODE_SAVE_FAILED;
                     AudioManager->PlaySound("data/sounds/cancel.wav");
@@ -403,6 +426,11 @@ void SaveMode::Update()
 
 void SaveMode::DrawPostEffects()
 {
+    if(!_render_cache.BeginDraw()) {
+        _render_cache.EndDraw();
+        return;
+    }
+
     // Set the coordinate system for the background and draw
     float width = _screen_capture.GetWidth();
     float height = _screen_capture.GetHeight();
@@ -463,9 +491,12 @@ void SaveMode::DrawPostEffects()
         _load_auto_save_optionbox.Draw();
         break;
     default:
+    case SAVE_MODE_WRITING_SAVE:
     case SAVE_MODE_FADING_OUT:
         break;
     }
+
+    _render_cache.EndDraw();
 }
 
 bool SaveMode::_LoadGame(const std::string& filename)
@@ -537,156 +568,122 @@ void AddEp1ToMapPath(std::string& map_filename)
 
 bool SaveMode::_PreviewGame(const std::string& filename)
 {
-    // Check for the file existence, prevents a useless warning
-    if(!vt_utils::DoesFileExist(filename)) {
-        _ClearSaveData(false);
+    const SavePreview& preview = _GetSavePreview(filename);
+    if (!preview._valid) {
+        _ClearSaveData(preview._exists);
         return false;
     }
 
-    ReadScriptDescriptor file;
+    const SaveGameHeader& header = preview._header;
 
-    // Clear out the save data namespace to avoid loading false information
-    // when dealing with a save game that has an invalid namespace
-    ScriptManager->DropGlobalTable("save_game1");
+    // Loads only up to the first four slots (Visible battle characters)
+    for(uint32_t i = 0; i < CHARACTERS_SHOWN_SLOTS; ++i) {
+        // Don't show characters when there are none
+        if (i >= header._characters.size()) {
+            _character_window[i].SetCharacter(nullptr);
+            continue;
+        }
 
-    if(!file.OpenFile(filename)) {
-        _ClearSaveData(true);
-        return false;
-    }
+        // Create a new GlobalCharacter object using the provided id
+        // This loads all of the character's "static" data, such as their name, etc.
+        const SaveGameHeaderCharacter& header_character = header._characters[i];
+        GlobalCharacter character = GlobalCharacter(header_character._id, false);
+        character.SetExperienceLevel(header_character._experience_level);
+        character.SetTotalExperiencePoints(header_character._total_experience_points);
+        character.SetUnspentExperiencePoints(header_character._unspent_experience_points);
+        character.AddExperienceForNextLevel(header_character._experience_points_next);
+
+        character.SetMaxHitPoints(header_character._max_hit_points);
+        character.SetHitPoints(header_character._hit_points);
+        character.SetMaxSkillPoints(header_character._max_skill_points);
+        character.SetSkillPoints(header_character._skill_points);
 
-    if(!file.DoesTableExist("save_game1")) {
-        file.CloseFile();
-        _ClearSaveData(true);
-        return false;
+        _character_window[i].SetCharacter(&character);
     }
 
-    // open the namespace that the save game is encapsulated in.
-    file.OpenTable("save_game1");
+    std::ostringstream time_text;
+    time_text << (header._play_hours < 10 ? "0" : "") << header._play_hours << ":";
+    time_text << (header._play_minutes < 10 ? "0" : "") << header._play_minutes << ":";
+    time_text << (header._play_seconds < 10 ? "0" : "") << header._play_seconds;
+    _time_textbox.SetDisplayText(MakeUnicodeString(time_text.str()));
 
-    // The map file, tested after the save game is closed.
-    std::string map_script_filename = file.ReadString("map_script_filename");
-    std::string map_data_filename = file.ReadString("map_data_filename");
+    std::ostringstream drunes_amount;
+    drunes_amount << header._drunes;
+    _drunes_textbox.SetDisplayText(MakeUnicodeString(drunes_amount.str()));
 
-    // DEPRECATED: Remove this after episode II release
-    if (!vt_utils::DoesFileExist(map_data_filename)) {
-        AddEp1ToMapPath(map_data_filename);
-    }
-    if(!vt_utils::DoesFileExist(map_script_filename)) {
-        AddEp1ToMapPath(map_script_filename);
-    }
+    // The in-game location of the save
+    _map_name_textbox.SetDisplayText(UTranslate(preview._map_hud_name));
 
-    // Check whether the map data file is available
-    if (!vt_utils::DoesFileExist(map_data_filename)) {
-        file.CloseTable(); // save_game1
-        file.CloseFile();
-        _ClearSaveData(true);
-        return false;
+    // Loads the potential location image
+    if (preview._map_image_filename.empty()) {
+        _location_image.Clear();
     }
-
-    // Used to store temp data to populate text boxes
-    int32_t hours = file.ReadInt("play_hours");
-    int32_t minutes = file.ReadInt("play_minutes");
-    int32_t seconds = file.ReadInt("play_seconds");
-    int32_t drunes = file.ReadInt("drunes");
-
-    if(!file.DoesTableExist("characters")) {
-        file.CloseTable(); // save_game1
-        file.CloseFile();
-        _ClearSaveData(true);
-        return false;
+    else {
+        if (_location_image.Load(preview._map_image_filename))
+            _location_image.SetHeightKeepRatio(105.0f);
     }
 
-    // Read characters table content
-    file.OpenTable("characters");
-    std::vector<uint32_t> char_ids;
-    file.ReadUIntVector("order", char_ids);
-
-    // Loads only up to the first four slots (Visible battle characters)
-    // i < char_ids.size() &&
-    for(uint32_t i = 0; i < CHARACTERS_SHOWN_SLOTS; ++i) {
-        // Create a new GlobalCharacter object using the provided id
-        // This loads all of the character's "static" data, such as their name, etc.
-
-        // Don't show characters when there are none
-        if (i >= char_ids.size() || !file.DoesTableExist(char_ids[i])) {
-            _character_window[i].SetCharacter(nullptr);
-            continue;
-        }
+    return true;
+}
 
-        file.OpenTable(char_ids[i]);
+const SaveMode::SavePreview& SaveMode::_GetSavePreview(const std::string& filename)
+{
+    std::map<std::string, SavePreview>::iterator it = _save_previews.find(filename);
+    if (it != _save_previews.end())
+        return it->second;
 
-        // Read in all of the character's stats data
-        GlobalCharacter character = GlobalCharacter(char_ids[i], false);
-        character.SetExperienceLevel(file.ReadUInt("experience_level"));
-        character.SetTotalExperiencePoints(file.ReadUInt("total_experience_points"));
-        character.SetUnspentExperiencePoints(file.ReadUInt("unspent_experience_points"));
-        character.AddExperienceForNextLevel(file.ReadUInt("experience_points_next"));
+    SavePreview& preview = _save_previews[filename];
 
-        character.SetMaxHitPoints(file.ReadUInt("max_hit_points"));
-        character.SetHitPoints(file.ReadUInt("hit_points"));
-        character.SetMaxSkillPoints(file.ReadUInt("max_skill_points"));
-        character.SetSkillPoints(file.ReadUInt("skill_points"));
+    // Check for the file existence, prevents a useless warning
+    preview._exists = vt_utils::DoesFileExist(filename);
+    if (!preview._exists)
+        return preview;
 
-        _character_window[i].SetCharacter(&character);
+    // Saves written without a header are read as a whole.
+    SaveGameHeader& header = preview._header;
+    if (!header.Load(filename) && !header.LoadFromSaveGame(filename))
+        return preview;
 
-        file.CloseTable(); // character id
+    // DEPRECATED: Remove this after episode II release
+    if (!vt_utils::DoesFileExist(header._map_data_filename)) {
+        AddEp1ToMapPath(header._map_data_filename);
     }
-    file.CloseTable(); // characters
-
-    // Report any errors detected from the previous read operations
-    if(file.IsErrorDetected()) {
-        PRINT_WARNING << "One or more errors occurred while reading the save game file - they are listed below:"
-            << std::endl << file.GetErrorMessages() << std::endl;
-            file.ClearErrors();
+    if(!vt_utils::DoesFileExist(header._map_script_filename)) {
+        AddEp1ToMapPath(header._map_script_filename);
     }
 
-    file.CloseTable(); // save_game1
-    file.CloseFile();
-
-    std::ostringstream time_text;
-    time_text << (hours < 10 ? "0" : "") << static_cast<uint32_t>(hours) << ":";
-    time_text << (minutes < 10 ? "0" : "") << static_cast<uint32_t>(minutes) << ":";
-    time_text << (seconds < 10 ? "0" : "") << static_cast<uint32_t>(seconds);
-    _time_textbox.SetDisplayText(MakeUnicodeString(time_text.str()));
-
-    std::ostringstream drunes_amount;
-    drunes_amount << drunes;
-    _drunes_textbox.SetDisplayText(MakeUnicodeString(drunes_amount.str()));
-
-    // Test the map file
+    // Check whether the map data file is available
+    if (!vt_utils::DoesFileExist(header._map_data_filename))
+        return preview;
+
+    // The header gives the map hud name and image, without opening the map script.
+    if (header._has_map_preview) {
+        preview._map_hud_name = header._map_name;
+        preview._map_image_filename = header._map_image_filename;
+        preview._valid = true;
+        return preview;
+    }
 
+    // DEPRECATED: Older save games have no map hud name in their header.
     // Tests the map file and gets the untranslated map hud name from it.
     ReadScriptDescriptor map_file;
 
-    if(!map_file.OpenFile(map_script_filename)) {
-        _ClearSaveData(true);
-        return false;
-    }
+    if(!map_file.OpenFile(header._map_script_filename))
+        return preview;
 
     if (map_file.OpenTablespace().empty()) {
-        _ClearSaveData(true);
         map_file.CloseFile();
-        return false;
+        return preview;
     }
 
-    // Read the in-game location of the save
-    std::string map_hud_name = map_file.ReadString("map_name");
-    _map_name_textbox.SetDisplayText(UTranslate(map_hud_name));
-
-    // Loads the potential location image
-    std::string map_image_filename = map_file.ReadString("map_image_filename");
-    if (map_image_filename.empty()) {
-        _location_image.Clear();
-    }
-    else {
-        if (_location_image.Load(map_image_filename))
-            _location_image.SetHeightKeepRatio(105.0f);
-    }
+    preview._map_hud_name = map_file.ReadString("map_name");
+    preview._map_image_filename = map_file.ReadString("map_image_filename");
 
     map_file.CloseTable(); // Tablespace
     map_file.CloseFile();
 
-    return true;
+    preview._valid = true;
+    return preview;
 }
 
 bool SaveMode::_IsAutoSaveValid(uint32_t id)
@@ -701,7 +698,7 @@ bool SaveMode::_IsAutoSaveValid(uint32_t id)
         return false;
 
     // And check whether the autosave is valid.
-    if (!_PreviewGame(autosave_filename))
+    if (!_GetSavePreview(autosave_filename)._valid)
         return false;
 
     return true;
@@ -725,7 +722,7 @@ void SaveMode::_InitSaveSlots()
             _file_list.AddOptionElementPosition(i, 30);
         }
 
-        if (!_PreviewGame(_BuildSaveFilename(i))) {
+        if (!_GetSavePreview(_BuildSaveFilename(i))._valid) {
             _file_list.EnableOption(i, false);
 
             // If the current selection is disabled, reset it.
@@ -756,6 +753,8 @@ void SaveMode::_DeleteAutoSave(uint32_t id)
 {
     std::string filename = _BuildSaveFilename(id, true);
     vt_utils::DeleteAFile(filename.c_str());
+    vt_utils::DeleteAFile(SaveGameHeader::GetHeaderFilename(filename).c_str());
+    _save_previews.erase(filename);
 }
 
 } // namespace vt_save
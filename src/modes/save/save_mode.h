@@ -25,8 +25,13 @@
 #include "common/gui/menu_window.h"
 #include "common/gui/textbox.h"
 #include "common/gui/option.h"
+#include "common/gui/render_cache.h"
 #include "common/character_window.h"
 
+#include "common/global/save/save_game_header.h"
+
+#include <map>
+
 //! \brief All calls to save mode are wrapped in this namespace.
 namespace vt_save
 {
@@ -64,9 +69,32 @@ private:
     //! \Returns true on success, false on fail
     bool _LoadGame(const std::string& filename);
 
+    //! \brief The preview data of a save game, kept while the save mode is open.
+    struct SavePreview {
+        SavePreview():
+            _exists(false),
+            _valid(false)
+        {}
+
+        //! \brief Whether the save game file exists.
+        bool _exists;
+
+        //! \brief Whether the save game can be loaded.
+        bool _valid;
+
+        vt_global::SaveGameHeader _header;
+
+        //! \brief The untranslated map hud name, and the map image of the save location.
+        std::string _map_hud_name;
+        std::string _map_image_filename;
+    };
+
     //! \brief Loads preview data for the highlighted game
     bool _PreviewGame(const std::string& filename);
 
+    //! \brief Returns the preview data of a save game, reading it only the first time.
+    const SavePreview& _GetSavePreview(const std::string& filename);
+
     //! \brief Clears out the data saves. Used especially when the data is invalid.
     //! \param selected_file_exists Tells whether the selected file exists.
     void _ClearSaveData(bool selected_file_exists);
@@ -106,6 +134,9 @@ private:
     //! \brief The color used to dim the background screen capture image
     vt_video::Color _dim_color;
 
+    //! \brief Only draws the save menus again when their content changed.
+    vt_gui::GUIRenderCache _render_cache;
+
     //! \brief The list of files to save/load from
     vt_gui::OptionBox _file_list;
 
@@ -139,6 +170,9 @@ private:
 
     //! \brief Tells whether we're in save or load mode.
     bool _save_mode;
+
+    //! \brief The save games preview data already read, by filename.
+    std::map<std::string, SavePreview> _save_previews;
 }; // class SaveMode : public vt_mode_manager::GameMode
 
 } // namespace vt_save
@@ -277,8 +277,14 @@ void ShopObjectViewer::Update()
     // Update active character animations.
     std::vector<vt_video::AnimatedImage *>::iterator it = _character_sprites.begin();
     for(; it != _character_sprites.end(); ++it) {
-        if(!(*it)->IsGrayscale())
-            (*it)->Update();
+        if((*it)->IsGrayscale())
+            continue;
+
+        // The shop is only drawn again when the animations change frame.
+        uint32_t frame = (*it)->GetCurrentFrameIndex();
+        (*it)->Update();
+        if(frame != (*it)->GetCurrentFrameIndex())
+            GUIManager->MarkContentChanged();
     }
 
     _description_text.Update();
@@ -1016,6 +1022,8 @@ ShopMode::ShopMode(const std::string& shop_id) :
 {
     _current_instance = this;
 
+    ModeManager->GetAssetResidency().DeclareModeManifest(this, "shop:" + shop_id);
+
     // Create the menu windows and set their properties
     _top_window.Create(800.0f, 96.0f, ~VIDEO_MENU_EDGE_BOTTOM);
     _top_window.SetPosition(112.0f, 84.0f);
@@ -1178,6 +1186,7 @@ void ShopMode::_SaveShopData()
 void ShopMode::Reset()
 {
     _current_instance = this;
+    _render_cache.MarkDirty();
 
     VideoManager->SetStandardCoordSys();
     VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_BOTTOM, 0);
@@ -1240,11 +1249,8 @@ void ShopMode::Initialize()
     }
     _object_viewer->Initialize();
 
-    // Initialize all shop interfaces
+    // Initialize the root interface. The other ones build their lists once the player opens them.
     _root_interface->Reinitialize();
-    _buy_interface->Reinitialize();
-    _sell_interface->Reinitialize();
-    _trade_interface->Reinitialize();
 
     // Init the script component.
     GetScriptSupervisor().Initialize(this);
@@ -1252,21 +1258,28 @@ void ShopMode::Initialize()
 
 void ShopMode::_UpdateAvailableObjectsToSell()
 {
-    // Reinitialize the data.
-    for (auto item : _available_sell) {
-        assert(item.second != nullptr);
-        if (item.second != nullptr) {
-            delete item.second;
-            item.second = nullptr;
+    // The sell objects share their global object with the inventory, so only the ones
+    // added, removed or replaced in the inventory since the last update are changed.
+    const std::map<uint32_t, std::shared_ptr<GlobalObject>>& inventory =
+        GlobalManager->GetInventoryHandler().GetInventory();
+
+    // Remove the objects no longer in the inventory, or all of them if sell mode is disabled.
+    for (auto it = _available_sell.begin(); it != _available_sell.end();) {
+        auto inventory_it = inventory.find(it->first);
+        if (_sell_mode_enabled && inventory_it != inventory.end() &&
+                inventory_it->second == it->second->GetObject()) {
+            ++it;
+            continue;
         }
+
+        delete it->second;
+        it = _available_sell.erase(it);
     }
-    _available_sell.clear();
 
     // If sell mode is disabled, we can return now.
     if (!_sell_mode_enabled)
         return;
 
-    auto inventory = GlobalManager->GetInventoryHandler().GetInventory();
     for (auto it = inventory.begin(); it != inventory.end(); ++it) {
         // Don't consider 0 worth objects.
         if (it->second->GetPrice() == 0)
@@ -1277,22 +1290,34 @@ void ShopMode::_UpdateAvailableObjectsToSell()
             continue;
 
         // Check if the object already exists in the shop list and if so, set its ownership count
-        std::map<uint32_t, ShopObject *>::iterator shop_obj_iter = _available_sell.find(it->second->GetID());
+        uint32_t count = it->second->GetCount();
+        std::map<uint32_t, ShopObject *>::iterator shop_obj_iter = _available_sell.find(it->first);
         if (shop_obj_iter != _available_sell.end()) {
-            shop_obj_iter->second->IncrementOwnCount(it->second->GetCount());
+            ShopObject* shop_object = shop_obj_iter->second;
+            if (shop_object->GetOwnCount() < count)
+                shop_object->IncrementOwnCount(count - shop_object->GetOwnCount());
+            else if (shop_object->GetOwnCount() > count)
+                shop_object->DecrementOwnCount(shop_object->GetOwnCount() - count);
         } else {
             // Otherwise, add the shop object to the list.
             ShopObject *new_shop_object = new ShopObject(it->second);
-            new_shop_object->IncrementOwnCount(it->second->GetCount());
+            new_shop_object->IncrementOwnCount(count);
             new_shop_object->SetPricing(GetBuyPriceLevel(),
                                         GetSellPriceLevel());
-            _available_sell.insert(std::make_pair(it->second->GetID(), new_shop_object));
+            _available_sell.insert(std::make_pair(it->first, new_shop_object));
         }
     }
 }
 
 void ShopMode::_UpdateAvailableShopOptions()
 {
+    // Nothing to do when the same categories are still available.
+    if (_action_options.IsOptionEnabled(0) == !_available_buy.empty() &&
+            _action_options.IsOptionEnabled(1) == !_available_sell.empty() &&
+            _action_options.IsOptionEnabled(2) == !_available_trade.empty()) {
+        return;
+    }
+
     // Test the available categories
     //Switch back to buy
     _action_options.EnableOption(0, !_available_buy.empty());
@@ -1429,6 +1454,15 @@ void ShopMode::Update()
 
 void ShopMode::Draw()
 {
+    // The shop scripts may draw anything at any time.
+    if (GetScriptSupervisor().IsAnimated())
+        _render_cache.MarkDirty();
+
+    if (!_render_cache.BeginDraw()) {
+        _render_cache.EndDraw();
+        return;
+    }
+
     // Draw the background image. Set the system coordinates to the size of the window (same as the screen backdrop).
     VideoManager->SetCoordSys(0.0f, static_cast<float>(VideoManager->GetViewportWidth()),
                               static_cast<float>(VideoManager->GetViewportHeight()), 0.0f);
@@ -1498,6 +1532,8 @@ void ShopMode::Draw()
         _dialogue_supervisor->Draw();
 
     GetScriptSupervisor().DrawPostEffects();
+
+    _render_cache.EndDraw();
 }
 
 
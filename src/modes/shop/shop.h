@@ -27,6 +27,7 @@
 #include "common/global/global.h"
 
 #include "common/gui/menu_window.h"
+#include "common/gui/render_cache.h"
 
 #include "shop_utils.h"
 
@@ -745,6 +746,9 @@ private:
     //! \brief Stores and processes any dialogue that is to occur within the shop mode.
     vt_common::DialogueSupervisor* _dialogue_supervisor;
 
+    //! \brief Only draws the shop again when its content changed.
+    vt_gui::GUIRenderCache _render_cache;
+
     //! \brief Tells whether input should be processed.
     //! \note Useful for certain dialogues and other events such as tutorial
     bool _input_enabled;
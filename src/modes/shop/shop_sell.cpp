@@ -53,7 +53,8 @@ SellInterface::SellInterface() :
     _selected_object(nullptr),
     _sell_deal_types(0),
     _number_categories(0),
-    _current_category(0)
+    _current_category(0),
+    _lists_dirty(true)
 {
     _category_header.SetStyle(TextStyle("title24"));
     _category_header.SetText(UTranslate("Category"));
@@ -167,25 +168,25 @@ void SellInterface::_PopulateLists()
 {
     // ---------- (1): Prepare object data containers and determine category index mappings
     // Containers of object data used to populate the display lists
-    std::vector<std::vector<ShopObject *> > object_data;
+    _object_data.clear();
 
     for(uint32_t i = 0; i < _number_categories; i++) {
-        object_data.push_back(std::vector<ShopObject *>());
+        _object_data.push_back(std::vector<ShopObject *>());
     }
 
-    // Holds the index to the object_data vector where the container for a specific object type is located
+    // Holds the index to the _object_data vector where the container for a specific object type is located
     std::vector<uint32_t> type_index(GLOBAL_OBJECT_TOTAL, 0);
     // Used to set the appropriate data in the type_index vector
     uint32_t next_index = 0;
     // Used to do a bit-by-bit analysis of the deal_types variable
     uint8_t bit_x = 0x01;
 
-    // This loop determines where each type of object should be placed in the object_data container. For example,
-    // if the available categories in the shop are items, weapons, spirits, and all wares, the size of object_data
-    // will be four. When we go to add an object of one of these types into the object_data container, we need
+    // This loop determines where each type of object should be placed in the _object_data container. For example,
+    // if the available categories in the shop are items, weapons, spirits, and all wares, the size of _object_data
+    // will be four. When we go to add an object of one of these types into the _object_data container, we need
     // to know the correct index for each type of object. These indeces are stored in the type_index vector. The
     // size of this vector is the number of object types, so it becomes simple to map each object type to its correct
-    // location in object_data.
+    // location in _object_data.
     for(uint8_t i = 0; i < GLOBAL_OBJECT_TOTAL; i++, bit_x <<= 1) {
         // Check if the type is available by doing a bit-wise comparison
         if(_sell_deal_types & bit_x) {
@@ -193,7 +194,7 @@ void SellInterface::_PopulateLists()
         }
     }
 
-    // Populate the object_data containers
+    // Populate the _object_data containers
 
     // Pointer to the container of all objects that are bought/sold/traded in the ship
     std::map<uint32_t, ShopObject *>* shop_objects = ShopMode::CurrentInstance()->GetAvailableSell();
@@ -208,25 +209,25 @@ void SellInterface::_PopulateLists()
         if(obj->GetOwnCount() > 0) {
             switch(obj->GetObject()->GetObjectType()) {
             case GLOBAL_OBJECT_ITEM:
-                object_data[type_index[0]].push_back(obj);
+                _object_data[type_index[0]].push_back(obj);
                 break;
             case GLOBAL_OBJECT_WEAPON:
-                object_data[type_index[1]].push_back(obj);
+                _object_data[type_index[1]].push_back(obj);
                 break;
             case GLOBAL_OBJECT_HEAD_ARMOR:
-                object_data[type_index[2]].push_back(obj);
+                _object_data[type_index[2]].push_back(obj);
                 break;
             case GLOBAL_OBJECT_TORSO_ARMOR:
-                object_data[type_index[3]].push_back(obj);
+                _object_data[type_index[3]].push_back(obj);
                 break;
             case GLOBAL_OBJECT_ARM_ARMOR:
-                object_data[type_index[4]].push_back(obj);
+                _object_data[type_index[4]].push_back(obj);
                 break;
             case GLOBAL_OBJECT_LEG_ARMOR:
-                object_data[type_index[5]].push_back(obj);
+                _object_data[type_index[5]].push_back(obj);
                 break;
             case GLOBAL_OBJECT_SPIRIT:
-                object_data[type_index[6]].push_back(obj);
+                _object_data[type_index[6]].push_back(obj);
                 break;
             default:
                 IF_PRINT_WARNING(SHOP_DEBUG) << "added object of unknown type: "
@@ -237,47 +238,66 @@ void SellInterface::_PopulateLists()
 
             // If there is an "All Wares" category, make sure the object gets added there as well
             if(_number_categories > 1) {
-                object_data.back().push_back(obj);
+                _object_data.back().push_back(obj);
             }
         }
     }
 
-    // ---------- (3): Create the sell displays using the object data that is now ready
-    for(uint32_t i = 0; i < object_data.size(); i++) {
-        _list_displays[i]->PopulateList(object_data[i]);
-    }
 } // void SellInterface::_PopulateLists()
 
 
 void SellInterface::Reinitialize()
 {
     _RefreshItemCategories();
+    _PopulateLists();
 
-    // (Re)create the sell displays and populate them with the object data
+    // The sell displays are created and populated with the object data once their category is shown
     for(uint32_t i = 0; i < _list_displays.size(); ++i)
         delete _list_displays[i];
-    _list_displays.clear();
+    _list_displays.assign(_number_categories, nullptr);
+    _lists_dirty = false;
 
-    for(uint32_t i = 0; i < _number_categories; ++i)
-        _list_displays.push_back(new SellListDisplay());
-
-    _PopulateLists();
+    _ShowInitialCategory();
+}
 
-    // Initialize other class members and states appropriately
+void SellInterface::_ShowInitialCategory()
+{
     // Set the initial category to the last category that was added (this is usually "All Wares")
     _current_category = _number_categories > 0 ? _number_categories - 1 : 0;
+    _selected_object = nullptr;
+
+    for(uint32_t i = 0; i < _list_displays.size(); ++i) {
+        if(_list_displays[i] != nullptr)
+            _list_displays[i]->ResetSelection();
+    }
 
     // Initialize the category display with the initial category
     if(_number_categories > 0) {
         _category_display.ChangeCategory(_category_names[_current_category], _category_icons[_current_category]);
-        _selected_object = _list_displays[_current_category]->GetSelectedObject();
+        _selected_object = _GetListDisplay(_current_category)->GetSelectedObject();
     }
     ChangeViewMode(SHOP_VIEW_MODE_LIST);
 }
 
+SellListDisplay *SellInterface::_GetListDisplay(uint32_t category)
+{
+    if(category >= _list_displays.size())
+        return nullptr;
+
+    if(_list_displays[category] == nullptr) {
+        _list_displays[category] = new SellListDisplay();
+        _list_displays[category]->PopulateList(_object_data[category]);
+    }
+    return _list_displays[category];
+}
+
 void SellInterface::MakeActive()
 {
-    Reinitialize();
+    // The lists are only reconstructed when the owned objects changed since they were last shown.
+    if(_lists_dirty)
+        Reinitialize();
+    else
+        _ShowInitialCategory();
 
     if(_list_displays.empty()) {
         ShopMode::CurrentInstance()->ChangeState(SHOP_STATE_ROOT);
@@ -293,7 +313,8 @@ void SellInterface::MakeActive()
 
 void SellInterface::TransactionNotification()
 {
-    Reinitialize();
+    // The owned objects changed: the lists are reconstructed when next shown.
+    _lists_dirty = true;
 }
 
 void SellInterface::Update()
@@ -458,7 +479,7 @@ bool SellInterface::_ChangeCategory(bool left_or_right)
     _category_display.ChangeCategory(_category_names[_current_category], _category_icons[_current_category]);
 
     ShopObject *last_obj = _selected_object;
-    _selected_object = _list_displays[_current_category]->GetSelectedObject();
+    _selected_object = _GetListDisplay(_current_category)->GetSelectedObject();
     return last_obj != _selected_object;
 }
 
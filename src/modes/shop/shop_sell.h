@@ -55,13 +55,15 @@ public:
     SellInterface();
     virtual ~SellInterface() override;
 
-    //! \brief (Re)initializes the data containers and GUI objects to be used
+    /** \brief (Re)initializes the data containers and GUI objects to be used
+    *** Only the list display of the current category is populated, the others are when first shown.
+    **/
     void Reinitialize() override;
 
-    //! \brief Sets the selected object for the ShopObjectViewer class
+    //! \brief Sets the selected object for the ShopObjectViewer class, reinitializing the lists when needed
     void MakeActive() override;
 
-    //! \brief Completely reconstructs all display lists from the party's inventory
+    //! \brief Marks the display lists to be reconstructed from the party's inventory the next time the interface is shown
     void TransactionNotification() override;
 
     /** \brief Takes all necessary action for when the active view mode is to be altered
@@ -109,11 +111,18 @@ private:
     //! \brief Display manager for the current category of objects selected
     ObjectCategoryDisplay _category_display;
 
+    //! \brief The objects of each category, used to populate the list displays once shown
+    std::vector<std::vector<ShopObject *> > _object_data;
+
     /** \brief Class objects used to display the object data to the player
-    *** The size and contents of this container mimic that which is found in the _object_data container.
+    *** The size of this container mimics the _object_data container. The displays are nullptr
+    *** until their category is shown. \see _GetListDisplay()
     **/
     std::vector<SellListDisplay *> _list_displays;
 
+    //! \brief Whether the categories and display lists must be reinitialized before being shown
+    bool _lists_dirty;
+
     //! \brief A copy of the selected object's icon, scaled to 1/4 size
     vt_video::StillImage _selected_icon;
 
@@ -133,15 +142,23 @@ private:
     **/
     void _RefreshItemCategories();
 
-    /** \brief Clears out all list displays and rebuilds them from scratch using the party's inventory
-    *** This operation needs to be performed when the interface is initialized and whenever a transaction
-    *** occurs. The latter case is necessary because in a transaction, the player may have bought new
+    /** \brief Sorts the objects available to sell by category, from the party's inventory
+    *** This operation needs to be performed when the interface is initialized and after a transaction
+    *** occurred. The latter case is necessary because in a transaction, the player may have bought new
     *** objects which should be made available to sell immediately, or the player may have sold off all
     *** counts of objects that they already had and thus these objects should not appear on the sell list
     *** anymore.
     **/
     void _PopulateLists();
 
+    //! \brief Shows the initial category (usually "All Wares") with the first object selected
+    void _ShowInitialCategory();
+
+    /** \brief Returns the display list of a category, populating it first if needed
+    *** \return The display list, or nullptr if the category doesn't exist
+    **/
+    SellListDisplay *_GetListDisplay(uint32_t category);
+
     /** \brief Changes the current category and object list that is being displayed
     *** \param left_or_right False to move the category to the left, or true for the right
     *** \return True if the _selected_object member has changed
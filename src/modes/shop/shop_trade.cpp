@@ -50,7 +50,8 @@ TradeInterface::TradeInterface() :
     _selected_object(nullptr),
     _trade_deal_types(0),
     _number_categories(0),
-    _current_category(0)
+    _current_category(0),
+    _lists_dirty(true)
 {
     _category_header.SetStyle(TextStyle("title24"));
     _category_header.SetText(UTranslate("Category"));
@@ -162,19 +163,12 @@ void TradeInterface::Reinitialize()
 {
     _RefreshItemCategories();
 
-    // Set the initial category to the last category that was added (this is usually "All Wares")
-    _current_category = _number_categories > 0 ? _number_categories - 1 : 0;
-    // Initialize the category display with the initial category
-    if(_number_categories > 0)
-        _category_display.ChangeCategory(_category_names[_current_category],
-                                         _category_icons[_current_category]);
-
     // Prepare object data containers and determine category index mappings
     // Containers of object data used to populate the display lists
-    std::vector<std::vector<ShopObject *> > object_data;
+    _object_data.clear();
 
     for(uint32_t i = 0; i < _number_categories; ++i) {
-        object_data.push_back(std::vector<ShopObject *>());
+        _object_data.push_back(std::vector<ShopObject *>());
     }
 
     // Holds the index to the _object_data vector where the container for a specific object type is located
@@ -184,12 +178,12 @@ void TradeInterface::Reinitialize()
     // Used to do a bit-by-bit analysis of the deal_types variable
     uint8_t bit_x = 0x01;
 
-    // This loop determines where each type of object should be placed in the object_data container. For example,
-    // if the available categories in the shop are items, weapons, spirits, and all wares, the size of object_data
-    // will be four. When we go to add an object of one of these types into the object_data container, we need
+    // This loop determines where each type of object should be placed in the _object_data container. For example,
+    // if the available categories in the shop are items, weapons, spirits, and all wares, the size of _object_data
+    // will be four. When we go to add an object of one of these types into the _object_data container, we need
     // to know the correct index for each type of object. These indeces are stored in the type_index vector. The
     // size of this vector is the number of object types, so it becomes simple to map each object type to its correct
-    // location in object_data.
+    // location in _object_data.
     for(uint8_t i = 0; i < GLOBAL_OBJECT_TOTAL; ++i, bit_x <<= 1) {
         // Check if the type is available by doing a bit-wise comparison
         if(_trade_deal_types & bit_x) {
@@ -197,7 +191,7 @@ void TradeInterface::Reinitialize()
         }
     }
 
-    // Populate the object_data containers
+    // Populate the _object_data containers
 
     // Pointer to the container of all objects that are bought/sold/traded in the shop
     std::map<uint32_t, ShopObject *>* trade_objects = ShopMode::CurrentInstance()->GetAvailableTrade();
@@ -206,25 +200,25 @@ void TradeInterface::Reinitialize()
         ShopObject* obj = it->second;
         switch(obj->GetObject()->GetObjectType()) {
         case GLOBAL_OBJECT_ITEM:
-            object_data[type_index[0]].push_back(obj);
+            _object_data[type_index[0]].push_back(obj);
             break;
         case GLOBAL_OBJECT_WEAPON:
-            object_data[type_index[1]].push_back(obj);
+            _object_data[type_index[1]].push_back(obj);
             break;
         case GLOBAL_OBJECT_HEAD_ARMOR:
-            object_data[type_index[2]].push_back(obj);
+            _object_data[type_index[2]].push_back(obj);
             break;
         case GLOBAL_OBJECT_TORSO_ARMOR:
-            object_data[type_index[3]].push_back(obj);
+            _object_data[type_index[3]].push_back(obj);
             break;
         case GLOBAL_OBJECT_ARM_ARMOR:
-            object_data[type_index[4]].push_back(obj);
+            _object_data[type_index[4]].push_back(obj);
             break;
         case GLOBAL_OBJECT_LEG_ARMOR:
-            object_data[type_index[5]].push_back(obj);
+            _object_data[type_index[5]].push_back(obj);
             break;
         case GLOBAL_OBJECT_SPIRIT:
-            object_data[type_index[6]].push_back(obj);
+            _object_data[type_index[6]].push_back(obj);
             break;
         default:
             IF_PRINT_WARNING(SHOP_DEBUG) << "added object of unknown type: " << obj->GetObject()->GetObjectType() << std::endl;
@@ -233,30 +227,59 @@ void TradeInterface::Reinitialize()
 
         // If there is an "All Wares" category, make sure the object gets added there as well
         if(_number_categories > 1) {
-            object_data.back().push_back(obj);
+            _object_data.back().push_back(obj);
         }
     }
 
-    // Create the buy displays using the object data that is now ready
+    // The trade displays are created once their category is shown, using the object data that is now ready
     for(uint32_t i = 0; i < _list_displays.size(); ++i) {
         delete _list_displays[i];
     }
-    _list_displays.clear();
+    _list_displays.assign(_object_data.size(), nullptr);
+    _lists_dirty = false;
+
+    _ShowInitialCategory();
+}
 
-    for(uint32_t i = 0; i < object_data.size(); ++i) {
-        TradeListDisplay *new_list = new TradeListDisplay();
-        new_list->PopulateList(object_data[i]);
-        _list_displays.push_back(new_list);
+void TradeInterface::_ShowInitialCategory()
+{
+    // Set the initial category to the last category that was added (this is usually "All Wares")
+    _current_category = _number_categories > 0 ? _number_categories - 1 : 0;
+    _selected_object = nullptr;
+
+    for(uint32_t i = 0; i < _list_displays.size(); ++i) {
+        if(_list_displays[i] != nullptr)
+            _list_displays[i]->ResetSelection();
     }
 
-    if(_number_categories > 0)
-        _selected_object = _list_displays[_current_category]->GetSelectedObject();
+    // Initialize the category display with the initial category
+    if(_number_categories > 0) {
+        _category_display.ChangeCategory(_category_names[_current_category],
+                                         _category_icons[_current_category]);
+        _selected_object = _GetListDisplay(_current_category)->GetSelectedObject();
+    }
     ChangeViewMode(SHOP_VIEW_MODE_LIST);
 }
 
+TradeListDisplay *TradeInterface::_GetListDisplay(uint32_t category)
+{
+    if(category >= _list_displays.size())
+        return nullptr;
+
+    if(_list_displays[category] == nullptr) {
+        _list_displays[category] = new TradeListDisplay();
+        _list_displays[category]->PopulateList(_object_data[category]);
+    }
+    return _list_displays[category];
+}
+
 void TradeInterface::MakeActive()
 {
-    Reinitialize();
+    // The lists are only reconstructed when the shop objects changed since they were last shown.
+    if(_lists_dirty)
+        Reinitialize();
+    else
+        _ShowInitialCategory();
 
     _selected_object = _list_displays[_current_category]->GetSelectedObject();
     ShopMode::CurrentInstance()->ObjectViewer()->ChangeViewMode(_view_mode);
@@ -267,15 +290,8 @@ void TradeInterface::MakeActive()
 
 void TradeInterface::TransactionNotification()
 {
-    Reinitialize();
-
-    for(uint32_t i = 0; i < _list_displays.size(); ++i) {
-        _list_displays[i]->ReconstructList();
-        _list_displays[i]->ResetSelection();
-    }
-
-    _current_category = _number_categories > 0 ? _number_categories - 1 : 0;
-    _view_mode = SHOP_VIEW_MODE_LIST;
+    // The shop objects may have been removed: the lists are reconstructed when next shown.
+    _lists_dirty = true;
 }
 
 void TradeInterface::Update()
@@ -452,7 +468,7 @@ bool TradeInterface::_ChangeCategory(bool left_or_right)
                                      _category_icons[_current_category]);
 
     ShopObject *last_obj = _selected_object;
-    _selected_object = _list_displays[_current_category]->GetSelectedObject();
+    _selected_object = _GetListDisplay(_current_category)->GetSelectedObject();
     return last_obj != _selected_object;
 }
 
@@ -46,13 +46,15 @@ public:
     TradeInterface();
     virtual ~TradeInterface() override;
 
-    //! \brief (Re)initializes the data containers and GUI objects to be used
+    /** \brief (Re)initializes the data containers and GUI objects to be used
+    *** Only the list display of the current category is populated, the others are when first shown.
+    **/
     void Reinitialize() override;
 
-    //! \brief Sets the selected object for the ShopObjectViewer class
+    //! \brief Sets the selected object for the ShopObjectViewer class, reinitializing the lists when needed
     void MakeActive() override;
 
-    //! \brief Reconstructs all buy display lists and resets the current category
+    //! \brief Marks the display lists to be reconstructed the next time the interface is shown
     void TransactionNotification() override;
 
     /** \brief Takes all necessary action for when the active view mode is to be altered
@@ -100,9 +102,17 @@ private:
     //! \brief Display manager for the current category of objects selected
     ObjectCategoryDisplay _category_display;
 
-    //! \brief Class objects used to display the object data to the player
+    //! \brief The objects of each category, used to populate the list displays once shown
+    std::vector<std::vector<ShopObject *> > _object_data;
+
+    /** \brief Class objects used to display the object data to the player
+    *** The displays are nullptr until their category is shown. \see _GetListDisplay()
+    **/
     std::vector<TradeListDisplay *> _list_displays;
 
+    //! \brief Whether the categories and display lists must be reinitialized before being shown
+    bool _lists_dirty;
+
     //! \brief A copy of the selected object's icon, scaled to 1/4 size
     vt_video::StillImage _selected_icon;
 
@@ -122,6 +132,14 @@ private:
     **/
     void _RefreshItemCategories();
 
+    //! \brief Shows the initial category (usually "All Wares") with the first object selected
+    void _ShowInitialCategory();
+
+    /** \brief Returns the display list of a category, populating it first if needed
+    *** \return The display list, or nullptr if the category doesn't exist
+    **/
+    TradeListDisplay *_GetListDisplay(uint32_t category);
+
     /** \brief Changes the current category and object list that is being displayed
     *** \param left_or_right False to move the category to the left, or true for the right
     *** \return True if the _selected_object member has changed
@@ -467,6 +467,7 @@ ObjectListDisplay::ObjectListDisplay()
     _identify_list.SetDimensions(300.0f, 300.0f, 1, 255, 1, 8);
     _identify_list.SetOptionAlignment(VIDEO_X_LEFT, VIDEO_Y_CENTER);
     _identify_list.SetTextStyle(TextStyle("text22"));
+    _identify_list.SetVirtualized(true);
     _identify_list.SetCursorState(VIDEO_CURSOR_STATE_VISIBLE);
     _identify_list.SetSelectMode(VIDEO_SELECT_SINGLE);
     _identify_list.SetCursorOffset(-50.0f, -20.0f);
@@ -482,6 +483,7 @@ ObjectListDisplay::ObjectListDisplay()
     }
     _property_list.SetOptionAlignment(VIDEO_X_RIGHT, VIDEO_Y_CENTER);
     _property_list.SetTextStyle(TextStyle("text22"));
+    _property_list.SetVirtualized(true);
     _property_list.SetCursorState(VIDEO_CURSOR_STATE_HIDDEN);
     _property_list.SetHorizontalWrapMode(VIDEO_WRAP_MODE_NONE);
     _property_list.SetVerticalWrapMode(VIDEO_WRAP_MODE_STRAIGHT);